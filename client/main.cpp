@@ -65,6 +65,7 @@ std::vector<std::shared_ptr<Eng::Mesh>> boundingBoxMeshes;
 void updateChessPieceSelection();
 void initChessPieceSelection(Eng::Base& eng);
 void findChessPieces(std::shared_ptr<Eng::Node> node);
+bool isChessPieceName(const std::string& name);
 void updateBoundingBoxes(Eng::Base& eng);
 std::shared_ptr<Eng::Mesh> createLineMesh(const glm::vec3& start, const glm::vec3& end, const glm::vec3& color);
 void createBoundingBoxLines(Eng::Base& eng, const glm::vec3& min, const glm::vec3& max, const glm::vec3& color);
@@ -90,6 +91,17 @@ void setUpCameras(Eng::Base &eng);
 bool areHandsTogether();
 void updatePositionFromGesture();
 
+/*
+* Render stress test
+*/
+static const int STRESS_DEFAULT_MESHES = 5000;
+static const int STRESS_REPORT_INTERVAL = 600;
+
+// forward declarations
+void addStressScene(Eng::Base& eng, int meshCount);
+void setupSubmissionReport(Eng::Base& eng);
+void setupRenderModeCycling();
+
 
 /**
  * @brief Entry point of the application
@@ -115,9 +127,28 @@ int main(int argc, char *argv[]) {
    Eng::Base::getInstance().addPostProcessor(bloom);
    Eng::Base::getInstance().setPostProcessingEnabled(true);
 
+   // Merge the static board meshes at load time; the chess pieces are moved by the user
+   eng.getStaticBatcher().setDynamicFilter([](const Eng::Node& node) {
+       return isChessPieceName(node.getName());
+       });
+   eng.engEnable(ENG_STATIC_BATCHING);
+   // Generate levels of detail for meshes exported without them
+   eng.engEnable(ENG_LOD_GENERATION);
+   // Reorder triangles and vertices for the GPU caches, reporting ACMR/ATVR per mesh
+   eng.engEnable(ENG_MESH_OPTIMIZATION);
+   // Restore the parsed scene from its cooked copy, written on the first run
+   eng.engEnable(ENG_SCENE_CACHE);
+
    // Load scene
    eng.loadScene("..\\resources\\Chess.ovo");
 
+   // "--stress [count]" adds a synthetic scene to compare the submission modes
+   if (argc > 1 && std::string(argv[1]) == "--stress") {
+      addStressScene(eng, argc > 2 ? std::atoi(argv[2]) : STRESS_DEFAULT_MESHES);
+      setupSubmissionReport(eng);
+   }
+   setupRenderModeCycling();
+
    // Setup Motion and piece control
    setupLeapMotion(eng);
    initChessPieceSelection(eng);
@@ -505,9 +536,8 @@ std::shared_ptr<Eng::Mesh> createLineMesh(const glm::vec3& start, const glm::vec
 void findChessPieces(std::shared_ptr<Eng::Node> node) {
     if (!node) return;
     
-    std::string name = node->getName();
     // finds all meshes with name starting with B_ (black pieces) or W_
-    if ((name.length() >= 2 && (name.substr(0, 2) == "B_" || name.substr(0, 2) == "W_"))) {
+    if (isChessPieceName(node->getName())) {
         auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(node);
         if (mesh) {
             SelectablePiece piece;
@@ -526,17 +556,35 @@ void findChessPieces(std::shared_ptr<Eng::Node> node) {
         findChessPieces(child);
     }
 }
+
+/**
+ * @brief Checks whether a node name follows the chess piece naming convention
+ *
+ * @param name The node name
+ * @return True for names starting with "B_" (black pieces) or "W_" (white pieces)
+ */
+bool isChessPieceName(const std::string& name) {
+    return name.length() >= 2 && (name.substr(0, 2) == "B_" || name.substr(0, 2) == "W_");
+}
+
 /**
  * @brief Checks if a point is inside a chess piece's bounding box
  *
- * Transforms the local bounding box to world space and tests if the
- * specified point falls within the box, including a small tolerance margin.
+ * Pieces exported with physics hulls are tested against the hulls instead,
+ * which follow the piece shape. Otherwise the local bounding box is transformed
+ * to world space and tested. Both tests include a small tolerance margin.
  *
  * @param point The world-space point to test
  * @param piece The chess piece with its bounding box information
- * @return True if the point is inside the bounding box, false otherwise
+ * @return True if the point is inside the piece, false otherwise
  */
 bool isPointInBoundingBox(const glm::vec3& point, const SelectablePiece& piece) {
+    //ITA margine
+    const float EPS = 0.05f;
+
+    if (piece.mesh && !piece.mesh->getCollisionHulls().empty())
+        return piece.mesh->containsPoint(point, EPS);
+
     // get current final matrix
     glm::mat4 M = piece.node->getFinalMatrix();
 
@@ -556,8 +604,6 @@ bool isPointInBoundingBox(const glm::vec3& point, const SelectablePiece& piece)
         bbMaxW = glm::max(bbMaxW, cornerW);
     }
 
-    //ITA margine
-    const float EPS = 0.05f; 
     bbMinW -= glm::vec3(EPS);
     bbMaxW += glm::vec3(EPS);
 
@@ -834,17 +880,13 @@ void setupLeapMotion(Eng::Base& eng) {
     if (jointMeshes.empty()) {
         jointMeshes.reserve(MAX_HANDS * JOINTS_PER_HAND);
         for (int i = 0; i < MAX_HANDS * JOINTS_PER_HAND; ++i) {
-            // Create a mesh that shares vertices/indices with sphereMesh
+            // Create a mesh that shares its geometry with sphereMesh
             auto jointMesh = std::make_shared<Eng::Mesh>();
 
-            // Share the same vertex and index data
-            jointMesh->setVertices(sphereMesh->getVertices());
-            jointMesh->setIndices(sphereMesh->getIndices());
+            // Share the same vertex and index data (and GPU buffers)
+            jointMesh->setGeometry(sphereMesh->getGeometry());
             jointMesh->setMaterial(sphereMesh->getMaterial());
 
-            // Initialize buffers for this instance
-            jointMesh->initBuffers();
-
             // Add to the scene graph
             handsNode->addChild(jointMesh);
             jointMesh->setParent(handsNode.get());
@@ -860,10 +902,8 @@ void setupLeapMotion(Eng::Base& eng) {
         for (int i = 0; i < MAX_HANDS * bonesPerHand; ++i) {
             auto boneNode = std::make_shared<Eng::Node>();
             auto meshInst = std::make_shared<Eng::Mesh>();
-            meshInst->setVertices(cylinderMesh->getVertices());
-            meshInst->setIndices(cylinderMesh->getIndices());
+            meshInst->setGeometry(cylinderMesh->getGeometry());
             meshInst->setMaterial(cylinderMesh->getMaterial());
-            meshInst->initBuffers();
             boneNode->addChild(meshInst);
             meshInst->setParent(boneNode.get());
 
@@ -894,15 +934,21 @@ void updateLeapHands() {
 
     bool hasActiveHands = (frame->nHands > 0);
 
+    // One material per hand, shared by its joints so they can be drawn instanced
+    static const std::shared_ptr<Eng::Material> handMaterials[MAX_HANDS] = {
+        std::make_shared<Eng::Material>(glm::vec3(0.2f, 0.8f, 0.2f), 1.0f, 0.2f, glm::vec3(0)),
+        std::make_shared<Eng::Material>(glm::vec3(0.2f, 0.2f, 0.8f), 1.0f, 0.2f, glm::vec3(0))
+    };
+
     // Position all joint spheres
     for (unsigned h = 0; h < frame->nHands && h < MAX_HANDS; ++h) {
         const LEAP_HAND& hand = frame->pHands[h];
-        glm::vec3 handColor = (h == 0) ? glm::vec3(0.2f, 0.8f, 0.2f) : glm::vec3(0.2f, 0.2f, 0.8f);
+        const auto& handMaterial = handMaterials[h];
 
         auto setJoint = [&](const glm::vec3& pos) {
             if (jointIndex >= jointMeshes.size()) return;
             jointMeshes[jointIndex]
-                ->setMaterial(std::make_shared<Eng::Material>(handColor, 1.0f, 0.2f, glm::vec3(0)));
+                ->setMaterial(handMaterial);
             jointMeshes[jointIndex++]
                 ->setLocalMatrix(glm::translate(glm::mat4(1.0f), pos));
             };
@@ -1270,3 +1316,113 @@ void setUpCameras(Eng::Base &eng) {
                                          eng.SetActiveCamera(nextCamera);
                                       });
 }
+
+/**
+ * @brief Adds a synthetic grid of small spheres above the board
+ *
+ * Every mesh shares one of a few geometries and one of a few materials, the typical
+ * shape of a large static scene; together with the submission statistics printed by
+ * setupSubmissionReport() it is used to compare the submission modes.
+ *
+ * @param eng Reference to the engine instance
+ * @param meshCount Number of meshes to add
+ */
+void addStressScene(Eng::Base& eng, int meshCount) {
+    const int GEOMETRIES = 3;
+    const int MATERIALS = 8;
+    const float SPACING = 0.03f;
+
+    std::shared_ptr<Eng::Geometry> geometries[GEOMETRIES];
+    for (int i = 0; i < GEOMETRIES; i++)
+        geometries[i] = createSphereMesh(0.005f + 0.0025f * i)->getGeometry();
+
+    std::shared_ptr<Eng::Material> materials[MATERIALS];
+    for (int i = 0; i < MATERIALS; i++) {
+        const glm::vec3 color((i & 1) ? 1.0f : 0.2f, (i & 2) ? 1.0f : 0.2f, (i & 4) ? 1.0f : 0.2f);
+        materials[i] = std::make_shared<Eng::Material>(color, 1.0f, 0.2f, glm::vec3(0));
+    }
+
+    auto stressNode = std::make_shared<Eng::Node>();
+    stressNode->setName("StressScene");
+    eng.getRootNode()->addChild(stressNode);
+    stressNode->setParent(eng.getRootNode().get());
+
+    const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(meshCount))));
+    for (int i = 0; i < meshCount; i++) {
+        auto mesh = std::make_shared<Eng::Mesh>();
+        mesh->setName("Stress_" + std::to_string(i));
+        mesh->setGeometry(geometries[i % GEOMETRIES]);
+        mesh->setMaterial(materials[i % MATERIALS]);
+
+        const glm::vec3 position((i % side - side / 2) * SPACING, 0.3f, (i / side - side / 2) * SPACING);
+        mesh->setLocalMatrix(glm::translate(glm::mat4(1.0f), position));
+        stressNode->addChild(mesh);
+        mesh->setParent(stressNode.get());
+    }
+
+    std::cout << "Stress scene: " << meshCount << " meshes added" << std::endl;
+}
+
+/**
+ * @brief Periodically prints the submission statistics of the render pipeline
+ *
+ * Every STRESS_REPORT_INTERVAL frames, prints the CPU submission time, draw calls
+ * and triangles per level of detail averaged per view, then starts over.
+ *
+ * @param eng Reference to the engine instance
+ */
+void setupSubmissionReport(Eng::Base& eng) {
+    auto& callbackManager = Eng::CallbackManager::getInstance();
+    callbackManager.registerRenderCallback("submissionReport", [&eng]() {
+        static int frames = 0;
+        if (++frames < STRESS_REPORT_INTERVAL)
+            return;
+        frames = 0;
+        auto& renderPipeline = eng.getRenderPipeline();
+        Eng::RenderPipeline::printStats(renderPipeline.getSubmissionStats());
+        renderPipeline.resetSubmissionStats();
+        });
+}
+
+/**
+ * @brief Registers the keys cycling the engine draw submission and culling modes
+ *
+ * 'm' cycles multi-draw indirect, instanced and per mesh submission; with --stress
+ * the CPU submission time of the active mode is printed periodically.
+ * 'g' cycles CPU, GPU and verified GPU culling of multi-draw submissions.
+ */
+void setupRenderModeCycling() {
+    auto& callbackManager = Eng::CallbackManager::getInstance();
+    callbackManager.registerKeyBinding('m', "Cycle draw submission mode", [](unsigned char key, int x, int y) {
+        auto& eng = Eng::Base::getInstance();
+        if (eng.engIsEnabled(ENG_MULTIDRAW_RENDERING)) {
+            eng.engDisable(ENG_MULTIDRAW_RENDERING);
+            std::cout << "Draw submission: instanced" << std::endl;
+        }
+        else if (eng.engIsEnabled(ENG_INSTANCED_RENDERING)) {
+            eng.engDisable(ENG_INSTANCED_RENDERING);
+            std::cout << "Draw submission: per mesh" << std::endl;
+        }
+        else {
+            eng.engEnable(ENG_INSTANCED_RENDERING);
+            eng.engEnable(ENG_MULTIDRAW_RENDERING);
+            std::cout << "Draw submission: multi-draw indirect" << std::endl;
+        }
+        });
+    callbackManager.registerKeyBinding('g', "Cycle culling mode", [](unsigned char key, int x, int y) {
+        auto& eng = Eng::Base::getInstance();
+        switch (eng.getCullingMode()) {
+        case Eng::List::CullingMode::Cpu:
+            eng.setCullingMode(Eng::List::CullingMode::Gpu);
+            break;
+        case Eng::List::CullingMode::Gpu:
+            eng.setCullingMode(Eng::List::CullingMode::Verify);
+            break;
+        default:
+            eng.setCullingMode(Eng::List::CullingMode::Cpu);
+            break;
+        }
+        static const char* names[] = { "CPU", "GPU", "GPU, verified against CPU" };
+        std::cout << "Culling: " << names[static_cast<int>(eng.getCullingMode())] << std::endl;
+        });
+}
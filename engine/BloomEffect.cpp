@@ -161,18 +161,19 @@ bool Eng::BloomEffect::initShaders() {
    )";
 
     std::shared_ptr<Eng::VertexShader> brightVS = std::make_shared<Eng::VertexShader>();
-    brightVS->load(brightFilterVS);
+    brightVS->submit(brightFilterVS);
 
     std::shared_ptr<Eng::FragmentShader> brightFS = std::make_shared<Eng::FragmentShader>();
-    brightFS->load(brightFilterFS);
+    brightFS->submit(brightFilterFS);
 
     brightFilterProgram = std::make_shared<Eng::Program>();
     brightFilterProgram->bindAttribute(0, "aPos");
     brightFilterProgram->bindAttribute(1, "aTexCoords");
     brightFilterProgram->bindSampler(0, "sceneTex");
 
-    if (!brightFilterProgram->addShader(brightVS).addShader(brightFS).build()) {
-        std::cerr << "ERROR: Failed to build bright filter program" << std::endl;
+    brightFilterProgram->addShader(brightVS).addShader(brightFS);
+    if (!Eng::ShaderManager::getInstance().submitProgram(brightFilterProgram)) {
+        std::cerr << "ERROR: Failed to submit bright filter program" << std::endl;
         return false;
     }
 
@@ -231,18 +232,19 @@ bool Eng::BloomEffect::initShaders() {
     )";
 
     std::shared_ptr<Eng::VertexShader> blurVShader = std::make_shared<Eng::VertexShader>();
-    blurVShader->load(blurVS);
+    blurVShader->submit(blurVS);
 
     std::shared_ptr<Eng::FragmentShader> blurFShader = std::make_shared<Eng::FragmentShader>();
-    blurFShader->load(blurFS);
+    blurFShader->submit(blurFS);
 
     blurProgram = std::make_shared<Eng::Program>();
     blurProgram->bindAttribute(0, "aPos");
     blurProgram->bindAttribute(1, "aTexCoords");
     blurProgram->bindSampler(0, "image");
 
-    if (!blurProgram->addShader(blurVShader).addShader(blurFShader).build()) {
-        std::cerr << "ERROR: Failed to build blur program" << std::endl;
+    blurProgram->addShader(blurVShader).addShader(blurFShader);
+    if (!Eng::ShaderManager::getInstance().submitProgram(blurProgram)) {
+        std::cerr << "ERROR: Failed to submit blur program" << std::endl;
         return false;
     }
 
@@ -299,10 +301,10 @@ bool Eng::BloomEffect::initShaders() {
     )";
 
     std::shared_ptr<Eng::VertexShader> bloomFinalVShader = std::make_shared<Eng::VertexShader>();
-    bloomFinalVShader->load(bloomFinalVS);
+    bloomFinalVShader->submit(bloomFinalVS);
 
     std::shared_ptr<Eng::FragmentShader> bloomFinalFShader = std::make_shared<Eng::FragmentShader>();
-    bloomFinalFShader->load(bloomFinalFS);
+    bloomFinalFShader->submit(bloomFinalFS);
 
     bloomFinalProgram = std::make_shared<Eng::Program>();
     bloomFinalProgram->bindAttribute(0, "aPos");
@@ -310,11 +312,55 @@ bool Eng::BloomEffect::initShaders() {
     bloomFinalProgram->bindSampler(0, "sceneTex");
     bloomFinalProgram->bindSampler(1, "bloomTex");
 
-    if (!bloomFinalProgram->addShader(bloomFinalVShader).addShader(bloomFinalFShader).build()) {
-        std::cerr << "ERROR: Failed to build bloom final program" << std::endl;
+    bloomFinalProgram->addShader(bloomFinalVShader).addShader(bloomFinalFShader);
+    if (!Eng::ShaderManager::getInstance().submitProgram(bloomFinalProgram)) {
+        std::cerr << "ERROR: Failed to submit bloom final program" << std::endl;
         return false;
     }
 
+    // 4. Pass-through shader for the fallback copy
+    return initCopyProgram();
+}
+
+bool Eng::BloomEffect::initCopyProgram() {
+    static const char* basicVS = R"(
+    #version 440 core
+    layout (location = 0) in vec3 aPos;
+    layout (location = 1) in vec2 aTexCoords;
+    out vec2 TexCoords;
+    void main() {
+        TexCoords = aTexCoords;
+        gl_Position = vec4(aPos, 1.0);
+    }
+    )";
+
+    static const char* basicFS = R"(
+    #version 440 core
+    out vec4 FragColor;
+    in vec2 TexCoords;
+    uniform sampler2D inputTex;
+    void main() {
+        FragColor = texture(inputTex, TexCoords);
+    }
+    )";
+
+    std::shared_ptr<Eng::VertexShader> vs = std::make_shared<Eng::VertexShader>();
+    vs->submit(basicVS);
+
+    std::shared_ptr<Eng::FragmentShader> fs = std::make_shared<Eng::FragmentShader>();
+    fs->submit(basicFS);
+
+    copyProgram = std::make_shared<Eng::Program>();
+    copyProgram->bindAttribute(0, "aPos");
+    copyProgram->bindAttribute(1, "aTexCoords");
+    copyProgram->bindSampler(0, "inputTex");
+
+    copyProgram->addShader(vs).addShader(fs);
+    if (!Eng::ShaderManager::getInstance().submitProgram(copyProgram)) {
+        std::cerr << "ERROR: Failed to submit bloom copy program" << std::endl;
+        copyProgram = nullptr;
+        return false;
+    }
     return true;
 }
 
@@ -577,41 +623,8 @@ void Eng::BloomEffect::applyEffect(unsigned int inputTexture, unsigned int outpu
             glViewport(0, 0, width, height);
             glClear(GL_COLOR_BUFFER_BIT);
 
-            // Simple pass-through shader for copying the texture
-            static const char* basicVS = R"(
-            #version 440 core
-            layout (location = 0) in vec3 aPos;
-            layout (location = 1) in vec2 aTexCoords;
-            out vec2 TexCoords;
-            void main() {
-                TexCoords = aTexCoords;
-                gl_Position = vec4(aPos, 1.0);
-            }
-            )";
-
-            static const char* basicFS = R"(
-            #version 440 core
-            out vec4 FragColor;
-            in vec2 TexCoords;
-            uniform sampler2D inputTex;
-            void main() {
-                FragColor = texture(inputTex, TexCoords);
-            }
-            )";
-
-            // Create a one-time shader for copying the texture
-            std::shared_ptr<Eng::VertexShader> vs = std::make_shared<Eng::VertexShader>();
-            vs->load(basicVS);
-
-            std::shared_ptr<Eng::FragmentShader> fs = std::make_shared<Eng::FragmentShader>();
-            fs->load(basicFS);
-
-            std::shared_ptr<Eng::Program> copyProgram = std::make_shared<Eng::Program>();
-            copyProgram->bindAttribute(0, "aPos");
-            copyProgram->bindAttribute(1, "aTexCoords");
-            copyProgram->bindSampler(0, "inputTex");
-
-            if (copyProgram->addShader(vs).addShader(fs).build()) {
+            // Pass-through program, linked along with the others or, before init(), on first fallback
+            if ((copyProgram || initCopyProgram()) && copyProgram->finish()) {
                 copyProgram->render();
                 copyProgram->setInt(copyProgram->getParamLocation("inputTex"), 0);
 
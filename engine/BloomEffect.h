@@ -101,6 +101,8 @@ private:
     std::shared_ptr<Eng::Program> brightFilterProgram;
     std::shared_ptr<Eng::Program> blurProgram;
     std::shared_ptr<Eng::Program> bloomFinalProgram;
+    /** Pass-through program copying the input when bloom fails */
+    std::shared_ptr<Eng::Program> copyProgram;
 
     /** Geometry for full-screen rendering */
     unsigned int quadVAO;
@@ -120,6 +122,12 @@ private:
      */
     bool initShaders();
 
+    /**
+     * @brief Submits the pass-through program used when bloom processing fails
+     * @return true if the program was submitted, false otherwise
+     */
+    bool initCopyProgram();
+
     /**
      * @brief Renders a full-screen quad for post-processing
      */
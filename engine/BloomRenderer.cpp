@@ -192,11 +192,11 @@ bool Eng::BloomRenderer::setupShaders() {
     std::shared_ptr<Eng::VertexShader> blurVS = std::make_shared<Eng::VertexShader>();
     std::shared_ptr<Eng::FragmentShader> blurFS = std::make_shared<Eng::FragmentShader>();
 
-    if (!brightPassVS->load(brightPassVertexShaderSrc) ||
-        !brightPassFS->load(brightPassFragmentShaderSrc) ||
-        !blurVS->load(blurVertexShaderSrc) ||
-        !blurFS->load(blurFragmentShaderSrc)) {
-        std::cerr << "Failed to compile bloom shaders" << std::endl;
+    if (!brightPassVS->submit(brightPassVertexShaderSrc) ||
+        !brightPassFS->submit(brightPassFragmentShaderSrc) ||
+        !blurVS->submit(blurVertexShaderSrc) ||
+        !blurFS->submit(blurFragmentShaderSrc)) {
+        std::cerr << "Failed to submit bloom shaders" << std::endl;
         return false;
     }
 
@@ -208,8 +208,8 @@ bool Eng::BloomRenderer::setupShaders() {
     brightPassProgram->bindAttribute(1, "aTexCoords");
     brightPassProgram->bindSampler(0, "sceneTexture");
 
-    if (!brightPassProgram->build()) {
-        std::cerr << "Failed to build bright pass program" << std::endl;
+    if (!Eng::ShaderManager::getInstance().submitProgram(brightPassProgram)) {
+        std::cerr << "Failed to submit bright pass program" << std::endl;
         return false;
     }
 
@@ -220,8 +220,8 @@ bool Eng::BloomRenderer::setupShaders() {
     blurProgram->bindAttribute(1, "aTexCoords");
     blurProgram->bindSampler(0, "image");
 
-    if (!blurProgram->build()) {
-        std::cerr << "Failed to build blur program" << std::endl;
+    if (!Eng::ShaderManager::getInstance().submitProgram(blurProgram)) {
+        std::cerr << "Failed to submit blur program" << std::endl;
         return false;
     }
 
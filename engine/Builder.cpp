@@ -43,6 +43,15 @@ Eng::Builder& Eng::Builder::addVertices(const std::vector<Vertex>& verts) {
  * @param index The index value to append.
  * @return Reference to this Builder for chaining.
  */
+Eng::Builder& Eng::Builder::addVertices(std::vector<Vertex>&& verts) {
+	// Take the buffer over when nothing was accumulated yet
+	if (vertices.empty())
+		vertices = std::move(verts);
+	else
+		vertices.insert(vertices.end(), verts.begin(), verts.end());
+	return *this;
+}
+
 Eng::Builder& Eng::Builder::addIndex(unsigned int index) {
 	indices.push_back(index);
 	return *this;
@@ -67,6 +76,14 @@ Eng::Builder& Eng::Builder::addIndices(const std::vector<unsigned int>& inds) {
  * @param mat Shared pointer to the Material to assign.
  * @return Reference to this Builder for chaining.
  */
+Eng::Builder& Eng::Builder::addIndices(std::vector<unsigned int>&& inds) {
+	if (indices.empty())
+		indices = std::move(inds);
+	else
+		indices.insert(indices.end(), inds.begin(), inds.end());
+	return *this;
+}
+
 Eng::Builder& Eng::Builder::setMaterial(const std::shared_ptr<Eng::Material>& mat) {
 	material = mat;
 	return *this;
@@ -97,7 +114,8 @@ Eng::Builder& Eng::Builder::setLocalMatrix(const glm::mat4& matrix) {
 /**
  * @brief Builds the Mesh from accumulated data and uploads to GPU.
  *
- * Creates a new Mesh instance, assigns vertices, indices, material,
+ * Creates a new Mesh instance, assigns a Geometry holding the vertices and
+ * indices (shared with any existing mesh with the same data), material,
  * name, and local matrix, initializes GPU buffers, then resets the Builder's state.
  *
  * @return Shared pointer to the newly created Mesh.
@@ -105,8 +123,7 @@ Eng::Builder& Eng::Builder::setLocalMatrix(const glm::mat4& matrix) {
 std::shared_ptr<Eng::Mesh> Eng::Builder::build() {
 	// Create a new Mesh instance and assign accumulated data.
 	auto mesh = std::make_shared<Eng::Mesh>();
-	mesh->setVertices(vertices);
-	mesh->setIndices(indices);
+	mesh->setGeometry(Eng::Geometry::create(std::move(vertices), std::move(indices)));
 	mesh->setMaterial(material);
 	mesh->setName(std::move(meshName));
 	mesh->setLocalMatrix(localMatrix);
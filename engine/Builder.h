@@ -20,8 +20,10 @@ public:
 	// Interface methods to accumulate mesh data, used in chaining 
 	Builder& addVertex(const Eng::Vertex& vertex);
 	Builder& addVertices(const std::vector<Eng::Vertex>& verts);
+	Builder& addVertices(std::vector<Eng::Vertex>&& verts);
 	Builder& addIndex(unsigned int index);
 	Builder& addIndices(const std::vector<unsigned int>& inds);
+	Builder& addIndices(std::vector<unsigned int>&& inds);
 	Builder& setMaterial(const std::shared_ptr<Eng::Material>& mat);
 	Builder& setName(const std::string &name);
 	Builder& setLocalMatrix(const glm::mat4 &matrix);
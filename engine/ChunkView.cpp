@@ -0,0 +1,111 @@
+#include "Engine.h"
+
+/**
+ * @brief Creates a view over existing memory, which must outlive it.
+ *
+ * @param data Start of the bytes.
+ * @param size Number of bytes.
+ */
+Eng::ChunkView::ChunkView(const char* data, const size_t size) : data(data), size(data ? size : 0) {
+}
+
+/**
+ * @brief Reads a NUL-terminated string in place.
+ * @return std::string_view The string without its terminator, empty if it is not terminated within the view.
+ */
+std::string_view Eng::ChunkView::readString() {
+	if (failed || position == size) {
+		failed = true;
+		return {};
+	}
+
+	const void* terminator = std::memchr(data + position, '\0', size - position);
+	if (terminator == nullptr) {
+		failed = true;
+		return {};
+	}
+	const std::string_view value(data + position, static_cast<const char*>(terminator) - (data + position));
+	position += value.size() + 1;
+	return value;
+}
+
+/**
+ * @brief Consumes a block of elements and returns where it starts.
+ *
+ * The element count and size are checked separately, so corrupted counts
+ * cannot overflow the requested length.
+ *
+ * @param count       Number of elements.
+ * @param elementSize Bytes per element.
+ * @return const char* Start of the block, nullptr if out of bounds.
+ */
+const char* Eng::ChunkView::take(const size_t count, const size_t elementSize) {
+	if (failed)
+		return nullptr;
+	if (elementSize && count > (size - position) / elementSize) {
+		failed = true;
+		return nullptr;
+	}
+
+	const char* block = data + position;
+	position += count * elementSize;
+	return block;
+}
+
+/**
+ * @brief Consumes a block and returns a view restricted to it.
+ * @param bytes Size of the block.
+ * @return ChunkView View over the block, empty and failed if out of bounds.
+ */
+Eng::ChunkView Eng::ChunkView::subView(const size_t bytes) {
+	const char* block = take(bytes);
+	if (failed) {
+		ChunkView invalid;
+		invalid.failed = true;
+		return invalid;
+	}
+	return { block, bytes };
+}
+
+/**
+ * @brief Moves past a block of elements without reading them.
+ * @param count       Number of elements.
+ * @param elementSize Bytes per element.
+ * @return true if the block was in bounds.
+ */
+bool Eng::ChunkView::skip(const size_t count, const size_t elementSize) {
+	take(count, elementSize);
+	return !failed;
+}
+
+/**
+ * @brief Gets the offset of the next read.
+ * @return size_t Offset from the start of the view.
+ */
+size_t Eng::ChunkView::getPosition() const {
+	return position;
+}
+
+/**
+ * @brief Gets the size of the view.
+ * @return size_t Size in bytes.
+ */
+size_t Eng::ChunkView::getSize() const {
+	return size;
+}
+
+/**
+ * @brief Gets the bytes left to read.
+ * @return size_t Bytes after the current position, 0 once failed.
+ */
+size_t Eng::ChunkView::getRemaining() const {
+	return failed ? 0 : size - position;
+}
+
+/**
+ * @brief Checks whether every read so far was in bounds.
+ * @return true if no read failed.
+ */
+bool Eng::ChunkView::isValid() const {
+	return !failed;
+}
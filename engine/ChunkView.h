@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * @class ChunkView
+ * @brief Bounds-checked, non-owning reader over a block of bytes.
+ *
+ * Values are read in place from the underlying memory (e.g. a MappedFile) and
+ * copied out with memcpy, so unaligned fields are fine. Any read past the end
+ * puts the view in a failed state: the read returns a zeroed value or nullptr,
+ * the position does not move, and all further reads fail too. Parsers can
+ * therefore read a whole record and check isValid() once at the end.
+ */
+class ENG_API ChunkView final {
+public:
+	ChunkView() = default;
+	ChunkView(const char* data, size_t size);
+
+	/**
+	 * @brief Reads a trivially copyable value.
+	 * @return T The value, zero-initialized if out of bounds.
+	 */
+	template <typename T>
+	T read() {
+		static_assert(std::is_trivially_copyable_v<T>, "ChunkView can only read trivially copyable types");
+		T value{};
+		if (const char* bytes = take(1, sizeof(T)))
+			std::memcpy(&value, bytes, sizeof(T));
+		return value;
+	}
+
+	/**
+	 * @brief Copies an array of trivially copyable values straight into their destination.
+	 * @return true if the whole array was in bounds.
+	 */
+	template <typename T>
+	bool readArray(T* destination, const size_t count) {
+		static_assert(std::is_trivially_copyable_v<T>, "ChunkView can only read trivially copyable types");
+		const char* bytes = take(count, sizeof(T));
+		if (bytes && count)
+			std::memcpy(destination, bytes, count * sizeof(T));
+		return isValid();
+	}
+
+	std::string_view readString();
+	const char* take(size_t count, size_t elementSize = 1);
+	ChunkView subView(size_t bytes);
+	bool skip(size_t count, size_t elementSize = 1);
+
+	size_t getPosition() const;
+	size_t getSize() const;
+	size_t getRemaining() const;
+	bool isValid() const;
+
+private:
+	///> Start of the viewed bytes
+	const char* data = nullptr;
+	///> Number of viewed bytes
+	size_t size = 0;
+	///> Offset of the next read
+	size_t position = 0;
+	///> Set by the first out of bounds read
+	bool failed = false;
+};
@@ -0,0 +1,425 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+	///> Cosine above which two face normals are merged into one plane
+	constexpr float COPLANAR_COSINE = 1.0f - 1e-5f;
+	///> Iteration cap of GJK, reached only on badly conditioned input
+	constexpr int GJK_MAX_ITERATIONS = 64;
+	///> Relative progress below which GJK stops
+	constexpr float GJK_TOLERANCE = 1e-5f;
+
+	/**
+	 * @brief Vertex of a GJK simplex: support points of both shapes and their difference.
+	 */
+	struct SimplexVertex {
+		glm::vec3 first;
+		glm::vec3 second;
+		glm::vec3 difference;
+	};
+
+	/**
+	 * @brief GJK simplex, with the barycentric weights of its point closest to the origin.
+	 */
+	struct Simplex {
+		std::array<SimplexVertex, 4> vertices;
+		std::array<float, 4> weights;
+		int size = 0;
+
+		/**
+		 * @brief Keeps the listed vertices, with their weights.
+		 */
+		void keep(const std::array<int, 4>& indices, const std::array<float, 4>& newWeights, const int count) {
+			std::array<SimplexVertex, 4> kept;
+			for (int i = 0; i < count; i++)
+				kept[i] = vertices[indices[i]];
+			vertices = kept;
+			weights = newWeights;
+			size = count;
+		}
+	};
+
+	/**
+	 * @brief Barycentric weights of the point of triangle abc closest to the origin (Ericson, 5.1.5).
+	 */
+	glm::vec3 closestOnTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+		const glm::vec3 ab = b - a, ac = c - a;
+		const float d1 = glm::dot(ab, -a), d2 = glm::dot(ac, -a);
+		if (d1 <= 0.0f && d2 <= 0.0f)
+			return glm::vec3(1.0f, 0.0f, 0.0f);
+
+		const float d3 = glm::dot(ab, -b), d4 = glm::dot(ac, -b);
+		if (d3 >= 0.0f && d4 <= d3)
+			return glm::vec3(0.0f, 1.0f, 0.0f);
+
+		const float vc = d1 * d4 - d3 * d2;
+		if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+			const float v = d1 / (d1 - d3);
+			return glm::vec3(1.0f - v, v, 0.0f);
+		}
+
+		const float d5 = glm::dot(ab, -c), d6 = glm::dot(ac, -c);
+		if (d6 >= 0.0f && d5 <= d6)
+			return glm::vec3(0.0f, 0.0f, 1.0f);
+
+		const float vb = d5 * d2 - d1 * d6;
+		if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+			const float w = d2 / (d2 - d6);
+			return glm::vec3(1.0f - w, 0.0f, w);
+		}
+
+		const float va = d3 * d6 - d5 * d4;
+		if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+			const float w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+			return glm::vec3(0.0f, 1.0f - w, w);
+		}
+
+		const float denominator = 1.0f / (va + vb + vc);
+		const float v = vb * denominator, w = vc * denominator;
+		return glm::vec3(1.0f - v - w, v, w);
+	}
+
+	/**
+	 * @brief Reduces the simplex to the smallest feature holding its point closest to the origin.
+	 * @return bool False if the origin lies inside the simplex (a tetrahedron).
+	 */
+	bool reduceSimplex(Simplex& simplex, glm::vec3& closest) {
+		auto& v = simplex.vertices;
+		// Weighted vertices of a triangle, with the zero weights dropped
+		auto keepTriangle = [&simplex](const std::array<int, 3>& indices, const glm::vec3& weights) {
+			std::array<int, 4> kept{};
+			std::array<float, 4> keptWeights{};
+			int count = 0;
+			for (int i = 0; i < 3; i++) {
+				if (weights[i] > 0.0f) {
+					kept[count] = indices[i];
+					keptWeights[count++] = weights[i];
+				}
+			}
+			simplex.keep(kept, keptWeights, count);
+		};
+
+		switch (simplex.size) {
+		case 1:
+			simplex.weights[0] = 1.0f;
+			break;
+		case 2: {
+			const glm::vec3 segment = v[1].difference - v[0].difference;
+			const float length2 = glm::dot(segment, segment);
+			const float t = length2 > 0.0f ? glm::clamp(-glm::dot(v[0].difference, segment) / length2, 0.0f, 1.0f) : 0.0f;
+			if (t <= 0.0f)
+				simplex.keep({ 0 }, { 1.0f }, 1);
+			else if (t >= 1.0f)
+				simplex.keep({ 1 }, { 1.0f }, 1);
+			else
+				simplex.weights = { 1.0f - t, t };
+			break;
+		}
+		case 3:
+			keepTriangle({ 0, 1, 2 }, closestOnTriangle(v[0].difference, v[1].difference, v[2].difference));
+			break;
+		case 4: {
+			// Closest point over the faces the origin lies outside of; none means inside
+			constexpr std::array<std::array<int, 4>, 4> FACES = { { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } } };
+			float bestDistance = std::numeric_limits<float>::max();
+			std::array<int, 3> bestFace{};
+			glm::vec3 bestWeights(0.0f);
+			for (const auto& face : FACES) {
+				const glm::vec3& a = v[face[0]].difference;
+				const glm::vec3 normal = glm::cross(v[face[1]].difference - a, v[face[2]].difference - a);
+				const float originSide = glm::dot(normal, -a);
+				const float oppositeSide = glm::dot(normal, v[face[3]].difference - a);
+				if (oppositeSide != 0.0f && originSide * oppositeSide >= 0.0f)
+					continue;
+
+				const glm::vec3 weights = closestOnTriangle(a, v[face[1]].difference, v[face[2]].difference);
+				const glm::vec3 point = weights.x * a + weights.y * v[face[1]].difference + weights.z * v[face[2]].difference;
+				const float distance = glm::dot(point, point);
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					bestFace = { face[0], face[1], face[2] };
+					bestWeights = weights;
+				}
+			}
+			if (bestDistance == std::numeric_limits<float>::max())
+				return false;
+			keepTriangle(bestFace, bestWeights);
+			break;
+		}
+		default:
+			return false;
+		}
+
+		closest = glm::vec3(0.0f);
+		for (int i = 0; i < simplex.size; i++)
+			closest += simplex.weights[i] * v[i].difference;
+		return true;
+	}
+
+	/**
+	 * @brief Distance between two convex shapes given by their support functions (GJK).
+	 *
+	 * Iterates on the Minkowski difference: the simplex closest to the origin is
+	 * extended with the support point against its closest point, until that point
+	 * moves closer by less than the tolerance.
+	 */
+	template <typename FirstSupport, typename SecondSupport>
+	float gjkDistance(const FirstSupport& firstSupport, const SecondSupport& secondSupport, glm::vec3* firstPoint, glm::vec3* secondPoint) {
+		Simplex simplex;
+		const glm::vec3 first = firstSupport(glm::vec3(1.0f, 0.0f, 0.0f));
+		const glm::vec3 second = secondSupport(glm::vec3(-1.0f, 0.0f, 0.0f));
+		simplex.vertices[0] = { first, second, first - second };
+		simplex.weights[0] = 1.0f;
+		simplex.size = 1;
+		glm::vec3 closest = first - second;
+
+		bool overlap = false;
+		for (int iteration = 0; iteration < GJK_MAX_ITERATIONS; iteration++) {
+			// The origin on a simplex feature leaves rounding noise, judged against the simplex size
+			float scale2 = 0.0f;
+			for (int i = 0; i < simplex.size; i++)
+				scale2 = std::max(scale2, glm::dot(simplex.vertices[i].difference, simplex.vertices[i].difference));
+			const float closest2 = glm::dot(closest, closest);
+			if (closest2 <= GJK_TOLERANCE * GJK_TOLERANCE * scale2 || closest2 <= std::numeric_limits<float>::min()) {
+				overlap = true;
+				break;
+			}
+
+			const glm::vec3 a = firstSupport(-closest);
+			const glm::vec3 b = secondSupport(closest);
+			const glm::vec3 w = a - b;
+			if (closest2 - glm::dot(closest, w) <= GJK_TOLERANCE * closest2)
+				break;
+			bool repeated = false;
+			for (int i = 0; i < simplex.size; i++)
+				repeated = repeated || simplex.vertices[i].difference == w;
+			if (repeated)
+				break;
+
+			simplex.vertices[simplex.size++] = { a, b, w };
+			if (!reduceSimplex(simplex, closest)) {
+				overlap = true;
+				break;
+			}
+		}
+
+		glm::vec3 onFirst(0.0f), onSecond(0.0f);
+		for (int i = 0; i < simplex.size; i++) {
+			onFirst += simplex.weights[i] * simplex.vertices[i].first;
+			onSecond += simplex.weights[i] * simplex.vertices[i].second;
+		}
+		if (firstPoint)
+			*firstPoint = onFirst;
+		if (secondPoint)
+			*secondPoint = overlap ? onFirst : onSecond;
+		return overlap ? 0.0f : glm::length(closest);
+	}
+
+	/**
+	 * @brief World-space support point of a hull placed by a matrix.
+	 */
+	glm::vec3 placedSupport(const Eng::CollisionHull& hull, const glm::mat4& matrix, const glm::vec3& direction) {
+		const glm::vec3 local = hull.support(glm::transpose(glm::mat3(matrix)) * direction);
+		return glm::vec3(matrix * glm::vec4(local, 1.0f));
+	}
+}
+
+/**
+ * @brief Creates a hull from its vertices and outward face planes, as computed by create().
+ * @param vertices Vertices used by the faces.
+ * @param planes Outward face planes as (normal, offset).
+ */
+Eng::CollisionHull::CollisionHull(std::vector<glm::vec3>&& vertices, std::vector<glm::vec4>&& planes)
+	: vertices(std::move(vertices)), planes(std::move(planes)) {
+}
+
+/**
+ * @brief Builds a hull from the triangles of a convex shape.
+ *
+ * Faces are oriented outward from the vertex centroid, whatever their winding.
+ * Degenerate triangles are ignored, coplanar ones give a single plane, and
+ * vertices not used by any face are dropped.
+ *
+ * @param points Vertices of the shape.
+ * @param faces Triangles, three indices each.
+ * @return std::shared_ptr<Eng::CollisionHull> The hull, nullptr without vertices or with an index out of range.
+ */
+std::shared_ptr<Eng::CollisionHull> Eng::CollisionHull::create(const std::vector<glm::vec3>& points, const std::vector<unsigned int>& faces) {
+	if (points.empty())
+		return nullptr;
+	for (const unsigned int index : faces) {
+		if (index >= points.size()) {
+			std::cout << "ERROR: collision hull face refers to a missing vertex" << std::endl;
+			return nullptr;
+		}
+	}
+
+	glm::vec3 centroid(0.0f);
+	glm::vec3 minimum(std::numeric_limits<float>::max()), maximum(-std::numeric_limits<float>::max());
+	for (const auto& point : points) {
+		centroid += point;
+		minimum = glm::min(minimum, point);
+		maximum = glm::max(maximum, point);
+	}
+	centroid /= static_cast<float>(points.size());
+	const float offsetTolerance = 1e-5f * std::max(glm::length(maximum - minimum), 1e-6f);
+
+	std::vector<glm::vec4> planes;
+	std::vector<char> used(points.size(), faces.empty() ? 1 : 0);
+	for (size_t f = 0; f + 2 < faces.size(); f += 3) {
+		const glm::vec3& a = points[faces[f]];
+		glm::vec3 normal = glm::cross(points[faces[f + 1]] - a, points[faces[f + 2]] - a);
+		const float length = glm::length(normal);
+		if (length <= std::numeric_limits<float>::epsilon() * glm::dot(maximum - minimum, maximum - minimum))
+			continue;
+		for (size_t k = 0; k < 3; k++)
+			used[faces[f + k]] = 1;
+
+		normal /= length;
+		float offset = glm::dot(normal, a);
+		if (glm::dot(normal, centroid) > offset) {
+			normal = -normal;
+			offset = -offset;
+		}
+		const bool merged = std::any_of(planes.begin(), planes.end(), [&](const glm::vec4& plane) {
+			return glm::dot(glm::vec3(plane), normal) > COPLANAR_COSINE && std::abs(plane.w - offset) <= offsetTolerance;
+		});
+		if (!merged)
+			planes.emplace_back(normal, offset);
+	}
+
+	std::vector<glm::vec3> vertices;
+	for (size_t v = 0; v < points.size(); v++)
+		if (used[v])
+			vertices.push_back(points[v]);
+	return std::make_shared<Eng::CollisionHull>(std::move(vertices), std::move(planes));
+}
+
+/**
+ * @brief Gets the vertices of the hull.
+ * @return const std::vector<glm::vec3>& Vertices used by the faces, in local space.
+ */
+const std::vector<glm::vec3>& Eng::CollisionHull::getVertices() const {
+	return vertices;
+}
+
+/**
+ * @brief Gets the face planes of the hull.
+ * @return const std::vector<glm::vec4>& Outward planes as (normal, offset), in local space.
+ */
+const std::vector<glm::vec4>& Eng::CollisionHull::getPlanes() const {
+	return planes;
+}
+
+/**
+ * @brief Checks whether a point lies inside the hull.
+ * @param point Point in local space.
+ * @param tolerance Distance outside the faces still accepted.
+ * @return bool True inside or within tolerance of the surface; always false for a flat hull.
+ */
+bool Eng::CollisionHull::contains(const glm::vec3& point, const float tolerance) const {
+	if (planes.empty())
+		return false;
+	for (const auto& plane : planes)
+		if (glm::dot(glm::vec3(plane), point) - plane.w > tolerance)
+			return false;
+	return true;
+}
+
+/**
+ * @brief Finds where a ray enters the hull.
+ *
+ * The ray is clipped against every face plane; the direction need not be unit
+ * length, distances being measured in multiples of it.
+ *
+ * @param origin Ray origin in local space.
+ * @param direction Ray direction in local space.
+ * @param distance Receives the ray parameter of the entry point, 0 from inside.
+ * @return bool True if the ray hits the hull.
+ */
+bool Eng::CollisionHull::intersectRay(const glm::vec3& origin, const glm::vec3& direction, float& distance) const {
+	if (planes.empty())
+		return false;
+
+	float enter = 0.0f;
+	float exit = std::numeric_limits<float>::max();
+	for (const auto& plane : planes) {
+		const glm::vec3 normal(plane);
+		const float gap = plane.w - glm::dot(normal, origin);
+		const float speed = glm::dot(normal, direction);
+		if (speed == 0.0f) {
+			// Parallel to the face: all in or all out
+			if (gap < 0.0f)
+				return false;
+			continue;
+		}
+
+		const float t = gap / speed;
+		if (speed < 0.0f)
+			enter = std::max(enter, t);
+		else
+			exit = std::min(exit, t);
+		if (enter > exit)
+			return false;
+	}
+	distance = enter;
+	return true;
+}
+
+/**
+ * @brief Gets the hull vertex furthest along a direction.
+ * @param direction Direction in local space.
+ * @return glm::vec3 The support point, in local space.
+ */
+glm::vec3 Eng::CollisionHull::support(const glm::vec3& direction) const {
+	if (vertices.empty())
+		return glm::vec3(0.0f);
+
+	size_t best = 0;
+	float bestDot = glm::dot(vertices[0], direction);
+	for (size_t v = 1; v < vertices.size(); v++) {
+		const float value = glm::dot(vertices[v], direction);
+		if (value > bestDot) {
+			bestDot = value;
+			best = v;
+		}
+	}
+	return vertices[best];
+}
+
+/**
+ * @brief Computes the distance between two placed hulls with GJK.
+ *
+ * @param first First hull.
+ * @param firstMatrix Local to world matrix of the first hull.
+ * @param second Second hull.
+ * @param secondMatrix Local to world matrix of the second hull.
+ * @param firstPoint Optionally receives the closest point on the first hull, in world space.
+ * @param secondPoint Optionally receives the closest point on the second hull, in world space.
+ * @return float World-space distance, 0 if the hulls overlap (the points then being a common point).
+ */
+float Eng::CollisionHull::distance(const CollisionHull& first, const glm::mat4& firstMatrix,
+	const CollisionHull& second, const glm::mat4& secondMatrix, glm::vec3* firstPoint, glm::vec3* secondPoint) {
+	return gjkDistance(
+		[&](const glm::vec3& direction) { return placedSupport(first, firstMatrix, direction); },
+		[&](const glm::vec3& direction) { return placedSupport(second, secondMatrix, direction); },
+		firstPoint, secondPoint);
+}
+
+/**
+ * @brief Computes the distance from a point to a placed hull with GJK.
+ *
+ * @param hull The hull.
+ * @param matrix Local to world matrix of the hull.
+ * @param point Point in world space.
+ * @param hullPoint Optionally receives the closest point on the hull, in world space.
+ * @return float World-space distance, 0 inside the hull.
+ */
+float Eng::CollisionHull::distance(const CollisionHull& hull, const glm::mat4& matrix, const glm::vec3& point, glm::vec3* hullPoint) {
+	return gjkDistance(
+		[&](const glm::vec3& direction) { return placedSupport(hull, matrix, direction); },
+		[&](const glm::vec3&) { return point; },
+		hullPoint, nullptr);
+}
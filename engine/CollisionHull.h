@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @class CollisionHull
+ * @brief Convex collision shape of a mesh, in the mesh's local space.
+ *
+ * OVO files store the physics hulls of a mesh as vertices and triangles. A hull
+ * keeps the vertices used by its faces, for support mapping, and one outward
+ * plane per distinct face, coplanar triangles merged; that is all the queries
+ * need. Point containment tests the planes, rays are clipped against them, and
+ * distances between hulls, or between a hull and a point, are found with GJK.
+ *
+ * Queries taking a matrix work on the hull placed by that matrix (any affine
+ * transform, scaling included), without transforming its vertices.
+ */
+class ENG_API CollisionHull final {
+public:
+	CollisionHull(std::vector<glm::vec3>&& vertices, std::vector<glm::vec4>&& planes);
+
+	static std::shared_ptr<Eng::CollisionHull> create(const std::vector<glm::vec3>& points, const std::vector<unsigned int>& faces);
+
+	const std::vector<glm::vec3>& getVertices() const;
+	const std::vector<glm::vec4>& getPlanes() const;
+
+	bool contains(const glm::vec3& point, float tolerance = 0.0f) const;
+	bool intersectRay(const glm::vec3& origin, const glm::vec3& direction, float& distance) const;
+	glm::vec3 support(const glm::vec3& direction) const;
+
+	static float distance(const CollisionHull& first, const glm::mat4& firstMatrix,
+		const CollisionHull& second, const glm::mat4& secondMatrix,
+		glm::vec3* firstPoint = nullptr, glm::vec3* secondPoint = nullptr);
+	static float distance(const CollisionHull& hull, const glm::mat4& matrix, const glm::vec3& point, glm::vec3* hullPoint = nullptr);
+
+private:
+	///> Vertices used by the faces
+	std::vector<glm::vec3> vertices;
+	///> Outward face planes as (normal, offset): points inside satisfy dot(normal, p) <= offset
+	std::vector<glm::vec4> planes;
+};
@@ -0,0 +1,17 @@
+#include "Engine.h"
+// GLEW
+#include <GL/glew.h>
+
+/**
+ * @brief Creates the OpenGL compute shader object.
+ *
+ * Uses glCreateShader with GL_COMPUTE_SHADER to instantiate
+ * a compute-stage shader (OpenGL 4.3). This is called by the base
+ * Shader load routine prior to source upload and compilation.
+ *
+ * @return GLuint ID of the created shader object, or 0 on failure.
+ */
+unsigned int ENG_API Eng::ComputeShader::create()
+{
+	return glCreateShader(GL_COMPUTE_SHADER);
+}
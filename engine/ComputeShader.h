@@ -0,0 +1,13 @@
+#pragma once
+
+/**
+ * @class ComputeShader
+ * @brief Represents a GPU compute shader, running general purpose work outside the rasterization pipeline.
+ *
+ * ComputeShader compiles and encapsulates compute-stage GLSL code, linked alone into a Program and
+ * launched with glDispatchCompute. Inherits base loading, compilation, and rendering interface from Shader.
+ */
+class ENG_API ComputeShader : public Eng::Shader {
+protected:
+	unsigned int create() override;
+};
@@ -0,0 +1,584 @@
+#include "Engine.h"
+
+#include <GL/glew.h>
+
+#include <glm/gtc/packing.hpp>
+
+#include <mutex>
+
+namespace {
+	/**
+	 * @brief Interleaved vertex layout with packed normal and texture coordinates (20 bytes).
+	 *
+	 * The normal uses the same signed 10:10:10:2 encoding as the OVO files and the texture
+	 * coordinates the same half2 encoding, so data read from OVO round-trips exactly.
+	 */
+	struct PackedVertex {
+		glm::vec3 position;
+		uint32_t normal;		///< GL_INT_2_10_10_10_REV, normalized
+		uint32_t texCoords;		///< Two GL_HALF_FLOAT
+	};
+	static_assert(sizeof(PackedVertex) == 20, "PackedVertex must be tightly packed");
+
+	/**
+	 * @brief Interleaved full precision vertex layout (32 bytes).
+	 */
+	struct FloatVertex {
+		glm::vec3 position;
+		glm::vec3 normal;
+		glm::vec2 texCoords;
+	};
+	static_assert(sizeof(FloatVertex) == 32, "FloatVertex must be tightly packed");
+
+	///> Largest vertex count addressed with 16-bit indices
+	constexpr size_t MAX_SHORT_INDEX_VERTICES = 65536;
+
+	///> Vertex format used by newly created geometries
+	bool vertexCompression = true;
+
+	/**
+	 * @brief Registry of the geometries handed out by Geometry::create().
+	 *
+	 * Holds weak references only, so a geometry is released as soon as the
+	 * last mesh using it goes away; expired entries are pruned lazily.
+	 */
+	struct GeometryRegistry {
+		std::mutex mutex;
+		std::unordered_multimap<size_t, std::weak_ptr<Eng::Geometry>> entries;
+	};
+
+	GeometryRegistry& getGeometryRegistry() {
+		static GeometryRegistry registry;
+		return registry;
+	}
+}
+
+/**
+ * @brief Constructs a geometry from vertex and index data.
+ *
+ * Only the CPU copy is stored here; GPU buffers are created by initBuffers(),
+ * on first draw at the latest. Use create() to get a deduplicated instance.
+ *
+ * @param vertices Vertex attributes.
+ * @param indices  Triangle indices.
+ */
+Eng::Geometry::Geometry(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices)
+	: vertices(vertices), indices(indices), hash(computeHash(vertices, indices)), compressed(vertexCompression) {
+}
+
+/**
+ * @brief Constructs a geometry taking over vertex and index data, without copying it.
+ *
+ * @param vertices Vertex attributes.
+ * @param indices  Triangle indices.
+ */
+Eng::Geometry::Geometry(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices)
+	: vertices(std::move(vertices)), indices(std::move(indices)), hash(computeHash(this->vertices, this->indices)), compressed(vertexCompression) {
+}
+
+/**
+ * @brief Constructs a geometry whose content hash is already known.
+ *
+ * @param vertices Vertex attributes.
+ * @param indices  Triangle indices.
+ * @param hash     Content hash, as computeHash() would return it.
+ */
+Eng::Geometry::Geometry(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices, const size_t hash)
+	: vertices(std::move(vertices)), indices(std::move(indices)), hash(hash), compressed(vertexCompression) {
+}
+
+/**
+ * @brief Releases the GPU buffers, if they were created.
+ */
+Eng::Geometry::~Geometry() {
+	if (!buffersInitialized)
+		return;
+
+	const unsigned int buffers[] = { vbo, ebo, instanceVBO };
+	glDeleteBuffers(3, buffers);
+	glDeleteVertexArrays(1, &vao);
+}
+
+/**
+ * @brief Returns a geometry holding the given data, sharing it when possible.
+ *
+ * If a live geometry with the same content already exists it is returned,
+ * otherwise a new one is created and registered. Candidates are found by
+ * content hash and confirmed with a full comparison; only geometries using
+ * the current vertex format are shared.
+ *
+ * @param vertices Vertex attributes.
+ * @param indices  Triangle indices.
+ * @return std::shared_ptr<Eng::Geometry> The shared geometry.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Geometry::create(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices) {
+	auto& registry = getGeometryRegistry();
+	const size_t key = computeHash(vertices, indices);
+
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	if (auto existing = findRegistered(key, vertices, indices, vertexCompression))
+		return existing;
+
+	auto geometry = std::make_shared<Eng::Geometry>(vertices, indices);
+	registry.entries.emplace(key, geometry);
+	return geometry;
+}
+
+/**
+ * @brief Returns a geometry holding the given data, taking it over when no shared one exists.
+ *
+ * Same as the copying overload, but a new geometry moves the vectors in instead
+ * of copying them; loaders use it to hand their buffers over directly.
+ *
+ * @param vertices Vertex attributes, moved from if a new geometry is created.
+ * @param indices  Triangle indices, moved from if a new geometry is created.
+ * @return std::shared_ptr<Eng::Geometry> The shared geometry.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Geometry::create(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices) {
+	auto& registry = getGeometryRegistry();
+	const size_t key = computeHash(vertices, indices);
+
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	if (auto existing = findRegistered(key, vertices, indices, vertexCompression))
+		return existing;
+
+	auto geometry = std::make_shared<Eng::Geometry>(std::move(vertices), std::move(indices));
+	registry.entries.emplace(key, geometry);
+	return geometry;
+}
+
+/**
+ * @brief Returns a geometry restored from a cache, with its buffers already built.
+ *
+ * The hash is trusted rather than recomputed, and initBuffers() uploads the given
+ * buffer contents as they are instead of building them from the vertices. They must
+ * be in the current vertex format, as returned by getVertexData() and getIndexData().
+ * A live geometry with the same content is still shared.
+ *
+ * @param vertices   Vertex attributes, moved from if a new geometry is created.
+ * @param indices    Triangle indices, moved from if a new geometry is created.
+ * @param hash       Content hash of the data, from getHash().
+ * @param vertexData Vertex buffer contents.
+ * @param indexData  Index buffer contents.
+ * @return std::shared_ptr<Eng::Geometry> The shared geometry.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Geometry::createCooked(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices, const size_t hash,
+	std::vector<unsigned char>&& vertexData, std::vector<unsigned char>&& indexData) {
+	auto& registry = getGeometryRegistry();
+
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	if (auto existing = findRegistered(hash, vertices, indices, vertexCompression))
+		return existing;
+
+	// The constructor is private, so make_shared cannot be used
+	std::shared_ptr<Eng::Geometry> geometry(new Eng::Geometry(std::move(vertices), std::move(indices), hash));
+	geometry->cookedVertexData = std::move(vertexData);
+	geometry->cookedIndexData = std::move(indexData);
+	registry.entries.emplace(hash, geometry);
+	return geometry;
+}
+
+/**
+ * @brief Returns the registered geometry with the same content as the given one, registering it if none.
+ *
+ * Lets geometries built without create() join the registry, so copies made
+ * elsewhere end up shared. Only geometries with the same vertex format are shared.
+ *
+ * @param geometry Geometry to look up.
+ * @return std::shared_ptr<Eng::Geometry> The shared geometry, the given one if it is the first of its content.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Geometry::share(const std::shared_ptr<Eng::Geometry>& geometry) {
+	if (!geometry)
+		return nullptr;
+	auto& registry = getGeometryRegistry();
+
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	if (auto existing = findRegistered(geometry->hash, geometry->vertices, geometry->indices, geometry->compressed))
+		return existing;
+
+	registry.entries.emplace(geometry->hash, geometry);
+	return geometry;
+}
+
+/**
+ * @brief Looks up a live registered geometry with the given content, pruning expired entries.
+ *
+ * The registry lock must be held by the caller.
+ *
+ * @param hash       Content hash of the data.
+ * @param vertices   Vertex attributes.
+ * @param indices    Triangle indices.
+ * @param compressed Vertex format the geometry must use.
+ * @return std::shared_ptr<Eng::Geometry> The matching geometry, nullptr if none.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Geometry::findRegistered(const size_t hash, const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices,
+	const bool compressed) {
+	auto& registry = getGeometryRegistry();
+	auto range = registry.entries.equal_range(hash);
+	for (auto it = range.first; it != range.second;) {
+		if (auto existing = it->second.lock()) {
+			if (existing->compressed == compressed && existing->hasSameContent(vertices, indices))
+				return existing;
+			++it;
+		}
+		else {
+			it = registry.entries.erase(it);
+		}
+	}
+	return nullptr;
+}
+
+/**
+ * @brief Collects memory usage of the registered geometries.
+ *
+ * Savings are computed against every owner keeping a private copy,
+ * which is what each Mesh did before geometries were shared.
+ *
+ * @return Stats The current statistics.
+ */
+Eng::Geometry::Stats Eng::Geometry::getStats() {
+	auto& registry = getGeometryRegistry();
+	Stats stats;
+
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	for (auto it = registry.entries.begin(); it != registry.entries.end();) {
+		const long owners = it->second.use_count();
+		auto geometry = it->second.lock();
+		if (!geometry) {
+			it = registry.entries.erase(it);
+			continue;
+		}
+
+		const size_t cpu = geometry->getCpuMemoryUsage();
+		const size_t gpu = geometry->getGpuMemoryUsage();
+		stats.uniqueGeometries++;
+		stats.references += owners;
+		stats.cpuBytes += cpu;
+		stats.gpuBytes += gpu;
+		stats.cpuBytesSaved += cpu * (owners - 1);
+		stats.gpuBytesSaved += gpu * (owners - 1);
+		++it;
+	}
+	return stats;
+}
+
+/**
+ * @brief Prints the geometry memory statistics to the console.
+ */
+void Eng::Geometry::printStats() {
+	const Stats stats = getStats();
+	std::cout << "[Geometry] " << stats.uniqueGeometries << " unique geometries, "
+		<< stats.references << " references" << std::endl;
+	std::cout << "   RAM  . . : " << stats.cpuBytes / 1024 << " KB (saved " << stats.cpuBytesSaved / 1024 << " KB)" << std::endl;
+	std::cout << "   VRAM . . : " << stats.gpuBytes / 1024 << " KB (saved " << stats.gpuBytesSaved / 1024 << " KB)" << std::endl;
+	std::cout << "   Format . : " << (vertexCompression ? "compressed (20 B/vertex)" : "float (32 B/vertex)") << std::endl;
+}
+
+/**
+ * @brief Selects the vertex format of geometries created from now on.
+ *
+ * Compression packs normals into GL_INT_2_10_10_10_REV and texture coordinates into
+ * half floats; disable it for meshes that need full precision texture coordinates
+ * (e.g. heavily tiled UVs beyond the half float range). Existing geometries keep their format.
+ *
+ * @param enabled True to use the compressed format.
+ */
+void Eng::Geometry::setVertexCompression(const bool enabled) {
+	vertexCompression = enabled;
+}
+
+/**
+ * @brief Checks whether newly created geometries use the compressed vertex format.
+ * @return true if vertex compression is enabled.
+ */
+bool Eng::Geometry::isVertexCompressionEnabled() {
+	return vertexCompression;
+}
+
+/**
+ * @brief Initializes OpenGL buffers (VAO, VBO, EBO) for this geometry.
+ *
+ * Interleaves position, normal and texture coordinates into a single vertex
+ * buffer, packed or in full precision depending on the geometry format, and
+ * uploads the indices as 16-bit values when the vertex count allows it.
+ * Geometries from createCooked() upload their prebuilt contents instead.
+ */
+void Eng::Geometry::initBuffers() {
+	if (buffersInitialized)
+		return;
+
+	// Generate and bind the VAO.
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	// Interleaved VBO.
+	const std::vector<unsigned char> vertexData = cookedVertexData.empty() ? getVertexData() : std::move(cookedVertexData);
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, vertexData.size(), vertexData.data(), GL_STATIC_DRAW);
+	setupVertexAttributes(compressed);
+
+	// EBO for indices.
+	glGenBuffers(1, &ebo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+	const std::vector<unsigned char> indexData = cookedIndexData.empty() ? getIndexData() : std::move(cookedIndexData);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size(), indexData.data(), GL_STATIC_DRAW);
+	cookedVertexData = {};
+	cookedIndexData = {};
+
+	// Unbind VAO.
+	glBindVertexArray(0);
+
+	buffersInitialized = true;
+	std::cout << "Geometry buffers initialized. VAO: " << vao << ", " << getVertexStride() << " B/vertex, "
+		<< getIndexSize() * 8 << "-bit indices" << std::endl;
+}
+
+/**
+ * @brief Describes the interleaved vertex layout to the bound VAO.
+ *
+ * Sets the position, normal and texture coordinate attributes for the
+ * array buffer currently bound, in either vertex format.
+ *
+ * @param compressed True for the packed 20-byte layout, false for the float one.
+ */
+void Eng::Geometry::setupVertexAttributes(const bool compressed) {
+	if (compressed) {
+		constexpr GLsizei stride = sizeof(PackedVertex);
+		glVertexAttribPointer(ShaderManager::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, position));
+		glVertexAttribPointer(ShaderManager::NORMAL_LOCATION, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(PackedVertex, normal));
+		glVertexAttribPointer(ShaderManager::TEX_COORD_LOCATION, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(PackedVertex, texCoords));
+	}
+	else {
+		constexpr GLsizei stride = sizeof(FloatVertex);
+		glVertexAttribPointer(ShaderManager::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(FloatVertex, position));
+		glVertexAttribPointer(ShaderManager::NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(FloatVertex, normal));
+		glVertexAttribPointer(ShaderManager::TEX_COORD_LOCATION, 2, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(FloatVertex, texCoords));
+	}
+	glEnableVertexAttribArray(ShaderManager::POSITION_LOCATION);
+	glEnableVertexAttribArray(ShaderManager::NORMAL_LOCATION);
+	glEnableVertexAttribArray(ShaderManager::TEX_COORD_LOCATION);
+}
+
+/**
+ * @brief Issues a glDrawElements call for the whole geometry.
+ *
+ * Buffers are initialized on first use.
+ */
+void Eng::Geometry::draw() {
+	if (!buffersInitialized)
+		initBuffers();
+
+	glBindVertexArray(vao);
+	glDrawElements(GL_TRIANGLES,
+		static_cast<GLsizei>(indices.size()),
+		getIndexSize() == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+		nullptr);
+	glBindVertexArray(0);
+}
+
+/**
+ * @brief Draws the geometry once per model matrix with a single instanced call.
+ *
+ * The matrices are streamed into a per-instance buffer bound at
+ * ShaderManager::INSTANCE_MATRIX_LOCATION (one vec4 column per location,
+ * divisor 1).
+ *
+ * @param modelMatrices World matrices of the instances to draw.
+ */
+void Eng::Geometry::drawInstanced(const std::vector<glm::mat4>& modelMatrices) {
+	if (modelMatrices.empty())
+		return;
+
+	if (!buffersInitialized)
+		initBuffers();
+
+	glBindVertexArray(vao);
+
+	// Per-instance model matrix: a mat4 takes 4 consecutive attribute locations
+	if (!instanceVBO) {
+		glGenBuffers(1, &instanceVBO);
+		glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+		for (int i = 0; i < 4; i++) {
+			const int location = ShaderManager::INSTANCE_MATRIX_LOCATION + i;
+			glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * i));
+			glEnableVertexAttribArray(location);
+			glVertexAttribDivisor(location, 1);
+		}
+	}
+
+	// Orphan the previous storage so the driver never waits on in-flight draws
+	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+	instanceCapacity = std::max(instanceCapacity, modelMatrices.size());
+	glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(glm::mat4), nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, modelMatrices.size() * sizeof(glm::mat4), modelMatrices.data());
+
+	glDrawElementsInstanced(GL_TRIANGLES,
+		static_cast<GLsizei>(indices.size()),
+		getIndexSize() == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
+		nullptr,
+		static_cast<GLsizei>(modelMatrices.size()));
+	glBindVertexArray(0);
+}
+
+/**
+ * @brief Retrieves the vertices of the geometry.
+ * @return const std::vector<Eng::Vertex>& The vertex list.
+ */
+const std::vector<Eng::Vertex>& Eng::Geometry::getVertices() const {
+	return vertices;
+}
+
+/**
+ * @brief Retrieves the indices of the geometry.
+ * @return const std::vector<unsigned int>& The index list.
+ */
+const std::vector<unsigned int>& Eng::Geometry::getIndices() const {
+	return indices;
+}
+
+/**
+ * @brief Retrieves the content hash computed at construction.
+ * @return size_t The hash of vertices and indices.
+ */
+size_t Eng::Geometry::getHash() const {
+	return hash;
+}
+
+/**
+ * @brief Computes the RAM used by the CPU copy of the data.
+ * @return size_t Size in bytes.
+ */
+size_t Eng::Geometry::getCpuMemoryUsage() const {
+	return vertices.capacity() * sizeof(Eng::Vertex) + indices.capacity() * sizeof(unsigned int);
+}
+
+/**
+ * @brief Builds the interleaved vertex buffer contents in the geometry's format.
+ * @return std::vector<unsigned char> getVertexStride() bytes per vertex.
+ */
+std::vector<unsigned char> Eng::Geometry::getVertexData() const {
+	std::vector<unsigned char> data(vertices.size() * getVertexStride());
+
+	if (compressed) {
+		auto* out = reinterpret_cast<PackedVertex*>(data.data());
+		for (const auto& v : vertices)
+			*out++ = { v.getPosition(), glm::packSnorm3x10_1x2(glm::vec4(v.getNormal(), 0.0f)), glm::packHalf2x16(v.getTexCoords()) };
+	}
+	else {
+		auto* out = reinterpret_cast<FloatVertex*>(data.data());
+		for (const auto& v : vertices)
+			*out++ = { v.getPosition(), v.getNormal(), v.getTexCoords() };
+	}
+	return data;
+}
+
+/**
+ * @brief Builds the index buffer contents, 16-bit when the vertex count allows it.
+ * @return std::vector<unsigned char> getIndexSize() bytes per index.
+ */
+std::vector<unsigned char> Eng::Geometry::getIndexData() const {
+	std::vector<unsigned char> data(indices.size() * getIndexSize());
+
+	if (getIndexSize() == sizeof(uint16_t)) {
+		auto* out = reinterpret_cast<uint16_t*>(data.data());
+		for (const unsigned int index : indices)
+			*out++ = static_cast<uint16_t>(index);
+	}
+	else if (!indices.empty()) {
+		std::memcpy(data.data(), indices.data(), data.size());
+	}
+	return data;
+}
+
+/**
+ * @brief Checks whether the geometry uses the compressed vertex format.
+ * @return true if normals and texture coordinates are packed.
+ */
+bool Eng::Geometry::isCompressed() const {
+	return compressed;
+}
+
+/**
+ * @brief Retrieves the size of one vertex in the vertex buffer.
+ * @return size_t Stride in bytes (20 compressed, 32 otherwise).
+ */
+size_t Eng::Geometry::getVertexStride() const {
+	return getVertexStride(compressed);
+}
+
+/**
+ * @brief Retrieves the size of one vertex in the given format.
+ * @param compressed True for the packed layout, false for the float one.
+ * @return size_t Stride in bytes.
+ */
+size_t Eng::Geometry::getVertexStride(const bool compressed) {
+	return compressed ? sizeof(PackedVertex) : sizeof(FloatVertex);
+}
+
+/**
+ * @brief Retrieves the size of one index in the index buffer.
+ * @return size_t 2 for meshes with fewer than 65536 vertices, 4 otherwise.
+ */
+size_t Eng::Geometry::getIndexSize() const {
+	return vertices.size() < MAX_SHORT_INDEX_VERTICES ? sizeof(uint16_t) : sizeof(unsigned int);
+}
+
+/**
+ * @brief Computes the VRAM used by the vertex and index buffers.
+ *
+ * Reports the size the buffers have (or will have once initialized),
+ * excluding the per-instance stream.
+ *
+ * @return size_t Size in bytes.
+ */
+size_t Eng::Geometry::getGpuMemoryUsage() const {
+	return vertices.size() * getVertexStride() + indices.size() * getIndexSize();
+}
+
+/**
+ * @brief Computes a content hash of vertex attributes and indices (FNV-1a).
+ *
+ * @param vertices Vertex attributes.
+ * @param indices  Triangle indices.
+ * @return size_t The hash.
+ */
+size_t Eng::Geometry::computeHash(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices) {
+	uint64_t value = 14695981039346656037ull;
+	auto mix = [&value](const void* data, size_t size) {
+		const auto* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; i++) {
+			value ^= bytes[i];
+			value *= 1099511628211ull;
+		}
+	};
+
+	for (const auto& v : vertices) {
+		mix(glm::value_ptr(v.getPosition()), sizeof(glm::vec3));
+		mix(glm::value_ptr(v.getNormal()), sizeof(glm::vec3));
+		mix(glm::value_ptr(v.getTexCoords()), sizeof(glm::vec2));
+	}
+	mix(indices.data(), indices.size() * sizeof(unsigned int));
+
+	return static_cast<size_t>(value);
+}
+
+/**
+ * @brief Compares this geometry's data with another vertex and index list.
+ *
+ * @param otherVertices Vertex attributes to compare.
+ * @param otherIndices  Triangle indices to compare.
+ * @return true if both lists are identical.
+ */
+bool Eng::Geometry::hasSameContent(const std::vector<Eng::Vertex>& otherVertices, const std::vector<unsigned int>& otherIndices) const {
+	if (vertices.size() != otherVertices.size() || indices != otherIndices)
+		return false;
+
+	for (size_t i = 0; i < vertices.size(); i++) {
+		if (vertices[i].getPosition() != otherVertices[i].getPosition() ||
+			vertices[i].getNormal() != otherVertices[i].getNormal() ||
+			vertices[i].getTexCoords() != otherVertices[i].getTexCoords())
+			return false;
+	}
+	return true;
+}
\ No newline at end of file
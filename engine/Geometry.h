@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @class Geometry
+ * @brief Vertex and index data, with its GPU buffers, shared by any number of Mesh nodes.
+ *
+ * A Geometry owns the CPU copy of the vertices and indices together with the VAO
+ * and buffers uploaded from them. Meshes reference it through a shared_ptr, so the
+ * same data is stored and uploaded only once. Geometries obtained through create()
+ * are deduplicated by content hash; the GPU buffers are released with the last reference.
+ *
+ * Vertices are uploaded interleaved in a single buffer. With vertex compression
+ * (the default) normals are packed as GL_INT_2_10_10_10_REV and texture coordinates
+ * as half floats, 20 bytes per vertex instead of 32; meshes with fewer than 65536
+ * vertices use 16-bit indices.
+ */
+class ENG_API Geometry final {
+public:
+	/**
+	 * @brief Memory usage summary of the geometries registered through create().
+	 */
+	struct Stats {
+		size_t uniqueGeometries = 0;	///< Live registered geometries
+		size_t references = 0;			///< Owners (meshes) pointing at them
+		size_t cpuBytes = 0;			///< RAM held by the unique geometries
+		size_t gpuBytes = 0;			///< VRAM held by the unique geometries
+		size_t cpuBytesSaved = 0;		///< RAM one copy per owner would have needed on top
+		size_t gpuBytesSaved = 0;		///< VRAM one copy per owner would have needed on top
+	};
+
+	Geometry(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices);
+	Geometry(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices);
+	~Geometry();
+
+	Geometry(const Geometry&) = delete;
+	Geometry& operator=(const Geometry&) = delete;
+
+	static std::shared_ptr<Eng::Geometry> create(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices);
+	static std::shared_ptr<Eng::Geometry> create(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices);
+	static std::shared_ptr<Eng::Geometry> createCooked(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices, size_t hash,
+		std::vector<unsigned char>&& vertexData, std::vector<unsigned char>&& indexData);
+	static std::shared_ptr<Eng::Geometry> share(const std::shared_ptr<Eng::Geometry>& geometry);
+	static Stats getStats();
+	static void printStats();
+	static void setVertexCompression(bool enabled);
+	static bool isVertexCompressionEnabled();
+	static void setupVertexAttributes(bool compressed);
+	static size_t getVertexStride(bool compressed);
+
+	void initBuffers();
+	void draw();
+	void drawInstanced(const std::vector<glm::mat4>& modelMatrices);
+
+	const std::vector<Eng::Vertex>& getVertices() const;
+	const std::vector<unsigned int>& getIndices() const;
+	size_t getHash() const;
+	std::vector<unsigned char> getVertexData() const;
+	std::vector<unsigned char> getIndexData() const;
+
+	size_t getCpuMemoryUsage() const;
+	size_t getGpuMemoryUsage() const;
+	size_t getVertexStride() const;
+	size_t getIndexSize() const;
+	bool isCompressed() const;
+
+private:
+	Geometry(std::vector<Eng::Vertex>&& vertices, std::vector<unsigned int>&& indices, size_t hash);
+
+	static std::shared_ptr<Eng::Geometry> findRegistered(size_t hash, const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices,
+		bool compressed);
+	static size_t computeHash(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices);
+	bool hasSameContent(const std::vector<Eng::Vertex>& otherVertices, const std::vector<unsigned int>& otherIndices) const;
+
+	///> Vertex attributes (position, normal, texture coordinates)
+	std::vector<Eng::Vertex> vertices;
+	///> Triangle indices
+	std::vector<unsigned int> indices;
+	///> Content hash of vertices and indices
+	size_t hash = 0;
+	///> Packed normals and texture coordinates in the vertex buffer (fixed at construction)
+	bool compressed = true;
+	///> Upload-ready vertex buffer contents given by createCooked(), released once uploaded
+	std::vector<unsigned char> cookedVertexData;
+	///> Upload-ready index buffer contents given by createCooked(), released once uploaded
+	std::vector<unsigned char> cookedIndexData;
+
+	// Hold GPU resource IDs
+	unsigned int vao = 0;
+	unsigned int vbo = 0;
+	unsigned int ebo = 0;
+	unsigned int instanceVBO = 0;
+	///> Capacity of the instance buffer, in matrices
+	size_t instanceCapacity = 0;
+
+	bool buffersInitialized = false;
+};
\ No newline at end of file
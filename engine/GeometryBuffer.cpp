@@ -0,0 +1,430 @@
+#include "Engine.h"
+
+#include <GL/glew.h>
+
+#include <numeric>
+
+namespace {
+	///> Smallest allocation of the shared buffers, in vertices and indices
+	constexpr size_t MIN_GEOMETRY_CAPACITY = 1 << 16;
+	///> Smallest allocation of the per-draw buffers, in draws
+	constexpr size_t MIN_DRAW_CAPACITY = 1024;
+
+	/**
+	 * @brief Replaces a buffer with a larger one, keeping its contents.
+	 *
+	 * @param buffer   Buffer id, updated to the new buffer.
+	 * @param oldSize  Bytes to preserve.
+	 * @param newSize  Size of the new buffer in bytes.
+	 */
+	void growBuffer(unsigned int& buffer, const size_t oldSize, const size_t newSize) {
+		unsigned int newBuffer = 0;
+		glGenBuffers(1, &newBuffer);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer);
+		glBufferData(GL_COPY_WRITE_BUFFER, newSize, nullptr, GL_STATIC_DRAW);
+
+		if (buffer) {
+			if (oldSize) {
+				glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+				glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, oldSize);
+			}
+			glDeleteBuffers(1, &buffer);
+		}
+		buffer = newBuffer;
+	}
+
+	/**
+	 * @brief Re-specifies a streamed buffer and fills its beginning.
+	 *
+	 * The previous storage is orphaned so the driver never waits on draws still using it.
+	 */
+	void streamBuffer(const GLenum target, const unsigned int buffer, const size_t capacity, const size_t size, const void* data) {
+		glBindBuffer(target, buffer);
+		glBufferData(target, capacity, nullptr, GL_STREAM_DRAW);
+		glBufferSubData(target, 0, size, data);
+	}
+
+	/**
+	 * @brief Takes the first free range large enough, keeping the rest of it free.
+	 *
+	 * @param freeRanges Free ranges, first element to length.
+	 * @param count      Elements needed.
+	 * @param offset     Receives the first element of the range.
+	 * @return true if a free range was large enough.
+	 */
+	bool takeFree(std::map<size_t, size_t>& freeRanges, const size_t count, size_t& offset) {
+		for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+			if (it->second < count)
+				continue;
+			offset = it->first;
+			if (it->second > count)
+				freeRanges.emplace(it->first + count, it->second - count);
+			freeRanges.erase(it);
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Gives a range back, merging it with its free neighbours.
+	 *
+	 * A free range ending at the end of the used space shrinks the used space instead.
+	 *
+	 * @param freeRanges Free ranges, first element to length.
+	 * @param offset     First element of the range.
+	 * @param count      Elements in the range.
+	 * @param used       End of the used space, lowered when the range is at its end.
+	 */
+	void giveBack(std::map<size_t, size_t>& freeRanges, size_t offset, size_t count, size_t& used) {
+		if (!count)
+			return;
+
+		auto next = freeRanges.lower_bound(offset);
+		if (next != freeRanges.end() && offset + count == next->first) {
+			count += next->second;
+			next = freeRanges.erase(next);
+		}
+		if (next != freeRanges.begin()) {
+			const auto previous = std::prev(next);
+			if (previous->first + previous->second == offset) {
+				offset = previous->first;
+				count += previous->second;
+				freeRanges.erase(previous);
+			}
+		}
+
+		if (offset + count == used)
+			used = offset;
+		else
+			freeRanges.emplace(offset, count);
+	}
+
+	/**
+	 * @brief Checks whether a range can be placed without growing a buffer.
+	 */
+	bool fits(const std::map<size_t, size_t>& freeRanges, const size_t count, const size_t used, const size_t capacity) {
+		if (used + count <= capacity)
+			return true;
+		for (const auto& [offset, length] : freeRanges)
+			if (length >= count)
+				return true;
+		return false;
+	}
+}
+
+/**
+ * @brief Gets the singleton instance of the GeometryBuffer.
+ * @return GeometryBuffer& Reference to the singleton instance.
+ */
+Eng::GeometryBuffer& Eng::GeometryBuffer::getInstance() {
+	static GeometryBuffer instance;
+	return instance;
+}
+
+/**
+ * @brief Checks whether the context supports multi-draw indirect submission.
+ *
+ * Requires indirect multi-draws, shader storage buffers and base instances
+ * (core in OpenGL 4.3).
+ *
+ * @return true if GeometryBuffer can be used.
+ */
+bool Eng::GeometryBuffer::isSupported() {
+	return GLEW_VERSION_4_3 ||
+		(GLEW_ARB_multi_draw_indirect && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_base_instance);
+}
+
+/**
+ * @brief Finds or stores a geometry in the shared buffers.
+ *
+ * Geometries are uploaded the first time they are requested and stay while they live.
+ * New geometries reuse the ranges of destroyed ones, which are only collected when the
+ * buffers would have to grow, so the ranges handed out during a frame never move.
+ * Only compressed geometries are accepted, as the shared vertex buffer has a single layout.
+ *
+ * @param geometry The geometry to look up.
+ * @param range    Receives the placement of the geometry.
+ * @return true if the geometry can be drawn from the shared buffers.
+ */
+bool Eng::GeometryBuffer::acquire(const std::shared_ptr<Eng::Geometry>& geometry, Range& range) {
+	auto it = entries.find(geometry.get());
+	if (it != entries.end()) {
+		if (it->second.geometry.lock() == geometry) {
+			range = it->second.range;
+			return true;
+		}
+		// Address reused by a new geometry: the old data is free again
+		release(it->second);
+		entries.erase(it);
+	}
+
+	if (!geometry->isCompressed() || geometry->getIndices().empty())
+		return false;
+
+	const auto& indices = geometry->getIndices();
+	const size_t vertices = geometry->getVertices().size();
+	if (!vao || !fits(freeVertices, vertices, vertexCount, vertexCapacity) || !fits(freeIndices, indices.size(), indexCount, indexCapacity))
+		reclaim();
+
+	size_t vertexOffset = vertexCount;
+	size_t indexOffset = indexCount;
+	const bool reuseVertices = takeFree(freeVertices, vertices, vertexOffset);
+	const bool reuseIndices = takeFree(freeIndices, indices.size(), indexOffset);
+	reserve(vertexCount + (reuseVertices ? 0 : vertices), indexCount + (reuseIndices ? 0 : indices.size()));
+	if (!reuseVertices)
+		vertexCount += vertices;
+	if (!reuseIndices)
+		indexCount += indices.size();
+
+	const std::vector<unsigned char> vertexData = geometry->getVertexData();
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferSubData(GL_ARRAY_BUFFER, vertexOffset * Eng::Geometry::getVertexStride(true), vertexData.size(), vertexData.data());
+	glBindBuffer(GL_COPY_WRITE_BUFFER, ebo);
+	glBufferSubData(GL_COPY_WRITE_BUFFER, indexOffset * sizeof(unsigned int), indices.size() * sizeof(unsigned int), indices.data());
+
+	range.firstIndex = static_cast<unsigned int>(indexOffset);
+	range.indexCount = static_cast<unsigned int>(indices.size());
+	range.baseVertex = static_cast<int>(vertexOffset);
+	entries[geometry.get()] = { geometry, range, vertices };
+	return true;
+}
+
+/**
+ * @brief Uploads the indirect commands, per-draw model matrices and texture layers of a submission.
+ *
+ * The matrices are bound at ShaderManager::DRAW_DATA_BINDING and the layers at
+ * ShaderManager::DRAW_TEXTURE_BINDING; command i must use base instance i so the
+ * vertex shader reads its draw id from DRAW_ID_LOCATION.
+ *
+ * @param commands      Indirect draw commands.
+ * @param modelMatrices World matrix of each draw, indexed by base instance.
+ * @param textureLayers Layer of each draw's diffuse texture in the bound texture array,
+ *                      -1 to sample the material's own texture; indexed by base instance.
+ */
+void Eng::GeometryBuffer::uploadDraws(const std::vector<DrawCommand>& commands, const std::vector<glm::mat4>& modelMatrices,
+	const std::vector<int>& textureLayers) {
+	reserveDraws(std::max({ commands.size(), modelMatrices.size(), textureLayers.size() }));
+
+	streamBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer, drawCapacity * sizeof(DrawCommand), commands.size() * sizeof(DrawCommand), commands.data());
+	streamBuffer(GL_SHADER_STORAGE_BUFFER, drawDataSSBO, drawCapacity * sizeof(glm::mat4), modelMatrices.size() * sizeof(glm::mat4), modelMatrices.data());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::DRAW_DATA_BINDING, drawDataSSBO);
+	streamBuffer(GL_SHADER_STORAGE_BUFFER, drawTextureSSBO, drawCapacity * sizeof(int), textureLayers.size() * sizeof(int), textureLayers.data());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::DRAW_TEXTURE_BINDING, drawTextureSSBO);
+}
+
+/**
+ * @brief Issues a glMultiDrawElementsIndirect call over uploaded commands.
+ *
+ * @param firstCommand Index of the first command to draw.
+ * @param commandCount Number of consecutive commands to draw.
+ */
+void Eng::GeometryBuffer::draw(const size_t firstCommand, const size_t commandCount) {
+	drawIndirect(indirectBuffer, firstCommand, commandCount, 0, 0);
+}
+
+/**
+ * @brief Issues a multi-draw over commands stored in another indirect buffer.
+ *
+ * Used to draw commands produced on the GPU (e.g. by the GpuCuller). When a draw
+ * count buffer is given, the number of draws is read from it at drawCountIndex and
+ * clamped to maxCommands (GL_ARB_indirect_parameters).
+ *
+ * @param commands       Buffer holding DrawCommand entries.
+ * @param firstCommand   Index of the first command to draw.
+ * @param maxCommands    Number of commands to draw, or the upper bound with a count buffer.
+ * @param drawCounts     Buffer of unsigned int draw counts, 0 to draw maxCommands.
+ * @param drawCountIndex Index of the count to use in drawCounts.
+ */
+void Eng::GeometryBuffer::drawIndirect(const unsigned int commands, const size_t firstCommand, const size_t maxCommands,
+	const unsigned int drawCounts, const size_t drawCountIndex) {
+	if (!maxCommands)
+		return;
+
+	glBindVertexArray(vao);
+	glBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands);
+	if (drawCounts) {
+		glBindBuffer(GL_PARAMETER_BUFFER_ARB, drawCounts);
+		glMultiDrawElementsIndirectCountARB(GL_TRIANGLES,
+			GL_UNSIGNED_INT,
+			(void*)(firstCommand * sizeof(DrawCommand)),
+			static_cast<GLintptr>(drawCountIndex * sizeof(unsigned int)),
+			static_cast<GLsizei>(maxCommands),
+			0);
+	}
+	else {
+		glMultiDrawElementsIndirect(GL_TRIANGLES,
+			GL_UNSIGNED_INT,
+			(void*)(firstCommand * sizeof(DrawCommand)),
+			static_cast<GLsizei>(maxCommands),
+			0);
+	}
+	glBindVertexArray(0);
+}
+
+/**
+ * @brief Releases the shared buffers and forgets every stored geometry.
+ */
+void Eng::GeometryBuffer::clear() {
+	if (vao) {
+		const unsigned int buffers[] = { vbo, ebo, drawIdVBO, drawDataSSBO, drawTextureSSBO, indirectBuffer };
+		glDeleteBuffers(6, buffers);
+		glDeleteVertexArrays(1, &vao);
+	}
+
+	entries.clear();
+	freeVertices.clear();
+	freeIndices.clear();
+	vao = vbo = ebo = drawIdVBO = drawDataSSBO = drawTextureSSBO = indirectBuffer = 0;
+	vertexCount = vertexCapacity = indexCount = indexCapacity = drawCapacity = 0;
+}
+
+/**
+ * @brief Retrieves the buffer holding the last uploaded indirect commands.
+ * @return unsigned int OpenGL buffer id.
+ */
+unsigned int Eng::GeometryBuffer::getCommandBuffer() const {
+	return indirectBuffer;
+}
+
+/**
+ * @brief Retrieves the buffer holding the last uploaded per-draw model matrices.
+ * @return unsigned int OpenGL buffer id.
+ */
+unsigned int Eng::GeometryBuffer::getDrawDataBuffer() const {
+	return drawDataSSBO;
+}
+
+/**
+ * @brief Retrieves the number of geometries stored in the shared buffers.
+ * @return size_t Number of geometries.
+ */
+size_t Eng::GeometryBuffer::getGeometryCount() const {
+	return entries.size();
+}
+
+/**
+ * @brief Computes the VRAM allocated for the shared vertex and index buffers.
+ * @return size_t Size in bytes.
+ */
+size_t Eng::GeometryBuffer::getMemoryUsage() const {
+	return vertexCapacity * Eng::Geometry::getVertexStride(true)
+		+ indexCapacity * sizeof(unsigned int);
+}
+
+/**
+ * @brief Computes the VRAM of the shared buffers not holding a live geometry.
+ *
+ * Covers the free ranges and the space after the last range handed out; ranges
+ * of geometries destroyed since the buffers last needed room are not counted.
+ *
+ * @return size_t Size in bytes.
+ */
+size_t Eng::GeometryBuffer::getFreeMemory() const {
+	size_t vertices = vertexCapacity - vertexCount;
+	for (const auto& [offset, count] : freeVertices)
+		vertices += count;
+	size_t indices = indexCapacity - indexCount;
+	for (const auto& [offset, count] : freeIndices)
+		indices += count;
+	return vertices * Eng::Geometry::getVertexStride(true) + indices * sizeof(unsigned int);
+}
+
+/**
+ * @brief Gives the ranges of a stored geometry back to the free lists.
+ * @param entry The geometry to release.
+ */
+void Eng::GeometryBuffer::release(const Entry& entry) {
+	giveBack(freeVertices, static_cast<size_t>(entry.range.baseVertex), entry.vertexCount, vertexCount);
+	giveBack(freeIndices, entry.range.firstIndex, entry.range.indexCount, indexCount);
+}
+
+/**
+ * @brief Releases the ranges of the geometries destroyed since they were stored.
+ */
+void Eng::GeometryBuffer::reclaim() {
+	for (auto it = entries.begin(); it != entries.end();) {
+		if (it->second.geometry.expired()) {
+			release(it->second);
+			it = entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+/**
+ * @brief Makes room for the given number of vertices and indices.
+ *
+ * Buffers grow geometrically and keep their contents; the VAO is
+ * re-pointed at the new buffers.
+ *
+ * @param vertices Total vertices to hold.
+ * @param indices  Total indices to hold.
+ */
+void Eng::GeometryBuffer::reserve(const size_t vertices, const size_t indices) {
+	if (vao && vertices <= vertexCapacity && indices <= indexCapacity)
+		return;
+
+	if (!vao)
+		glGenVertexArrays(1, &vao);
+	reserveDraws(MIN_DRAW_CAPACITY);
+	glBindVertexArray(vao);
+
+	if (!vbo || vertices > vertexCapacity) {
+		const size_t stride = Eng::Geometry::getVertexStride(true);
+		const size_t capacity = std::max({ vertices, vertexCapacity * 2, MIN_GEOMETRY_CAPACITY });
+		growBuffer(vbo, vertexCount * stride, capacity * stride);
+		vertexCapacity = capacity;
+
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		Eng::Geometry::setupVertexAttributes(true);
+	}
+
+	if (!ebo || indices > indexCapacity) {
+		const size_t capacity = std::max({ indices, indexCapacity * 2, MIN_GEOMETRY_CAPACITY });
+		growBuffer(ebo, indexCount * sizeof(unsigned int), capacity * sizeof(unsigned int));
+		indexCapacity = capacity;
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+	}
+
+	glBindVertexArray(0);
+}
+
+/**
+ * @brief Makes room for the given number of draws per submission.
+ *
+ * The draw id stream holds 0..n-1 and is read once per instance, so with
+ * one instance per command each draw reads its own base instance.
+ *
+ * @param draws Number of draws to hold.
+ */
+void Eng::GeometryBuffer::reserveDraws(const size_t draws) {
+	if (draws <= drawCapacity)
+		return;
+
+	if (!vao)
+		glGenVertexArrays(1, &vao);
+
+	drawCapacity = std::max({ draws, drawCapacity * 2, MIN_DRAW_CAPACITY });
+
+	if (!indirectBuffer)
+		glGenBuffers(1, &indirectBuffer);
+	if (!drawDataSSBO)
+		glGenBuffers(1, &drawDataSSBO);
+	if (!drawTextureSSBO)
+		glGenBuffers(1, &drawTextureSSBO);
+	if (!drawIdVBO)
+		glGenBuffers(1, &drawIdVBO);
+
+	std::vector<unsigned int> drawIds(drawCapacity);
+	std::iota(drawIds.begin(), drawIds.end(), 0u);
+
+	glBindVertexArray(vao);
+	glBindBuffer(GL_ARRAY_BUFFER, drawIdVBO);
+	glBufferData(GL_ARRAY_BUFFER, drawIds.size() * sizeof(unsigned int), drawIds.data(), GL_STATIC_DRAW);
+	glVertexAttribIPointer(ShaderManager::DRAW_ID_LOCATION, 1, GL_UNSIGNED_INT, 0, nullptr);
+	glEnableVertexAttribArray(ShaderManager::DRAW_ID_LOCATION);
+	glVertexAttribDivisor(ShaderManager::DRAW_ID_LOCATION, 1);
+	glBindVertexArray(0);
+}
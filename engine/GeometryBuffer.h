@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @class GeometryBuffer
+ * @brief Shared vertex and index storage for submitting many meshes with one multi-draw call.
+ *
+ * The GeometryBuffer implements the Singleton pattern. Compressed geometries are appended
+ * once to a single interleaved vertex buffer and a single 32-bit index buffer, all described
+ * by one VAO, so meshes can be drawn together with glMultiDrawElementsIndirect. Per-draw
+ * model matrices are streamed into a shader storage buffer indexed by the draw id, which
+ * reaches the vertex shader through the base instance of each indirect command. A second
+ * buffer gives each draw the layer of its diffuse texture in a TextureArrayPool array.
+ *
+ * The ranges of destroyed geometries go to free lists and are handed out again before
+ * the buffers grow, so streaming and LOD changes do not make them grow without bound.
+ */
+class ENG_API GeometryBuffer final {
+public:
+	/**
+	 * @brief Placement of a geometry inside the shared buffers.
+	 */
+	struct Range {
+		unsigned int firstIndex = 0;	///< First index in the shared index buffer
+		unsigned int indexCount = 0;	///< Number of indices
+		int baseVertex = 0;				///< Offset added to each index
+	};
+
+	/**
+	 * @brief One indirect draw, laid out as GL's DrawElementsIndirectCommand.
+	 */
+	struct DrawCommand {
+		unsigned int count;			///< Number of indices
+		unsigned int instanceCount;	///< Always 1
+		unsigned int firstIndex;	///< First index in the shared index buffer
+		int baseVertex;				///< Offset added to each index
+		unsigned int baseInstance;	///< Draw id, index into the per-draw data
+	};
+
+	static GeometryBuffer& getInstance();
+	static bool isSupported();
+
+	GeometryBuffer(const GeometryBuffer&) = delete;
+	GeometryBuffer& operator=(const GeometryBuffer&) = delete;
+
+	bool acquire(const std::shared_ptr<Eng::Geometry>& geometry, Range& range);
+	void uploadDraws(const std::vector<DrawCommand>& commands, const std::vector<glm::mat4>& modelMatrices, const std::vector<int>& textureLayers);
+	void draw(size_t firstCommand, size_t commandCount);
+	void drawIndirect(unsigned int commands, size_t firstCommand, size_t maxCommands, unsigned int drawCounts, size_t drawCountIndex);
+	void clear();
+
+	unsigned int getCommandBuffer() const;
+	unsigned int getDrawDataBuffer() const;
+	size_t getGeometryCount() const;
+	size_t getMemoryUsage() const;
+	size_t getFreeMemory() const;
+
+private:
+	/** @brief Private constructor to enforce singleton pattern */
+	GeometryBuffer() = default;
+
+	void reserve(size_t vertices, size_t indices);
+	void reserveDraws(size_t draws);
+
+	/**
+	 * @brief A geometry stored in the shared buffers.
+	 */
+	struct Entry {
+		std::weak_ptr<Eng::Geometry> geometry;	///< Detects reuse of the address by another geometry
+		Range range;							///< Where its data lives
+		size_t vertexCount = 0;					///< Vertices stored from range.baseVertex
+	};
+
+	void release(const Entry& entry);
+	void reclaim();
+
+	///> Stored geometries, by address
+	std::unordered_map<const Eng::Geometry*, Entry> entries;
+
+	// Hold GPU resource IDs
+	unsigned int vao = 0;
+	unsigned int vbo = 0;
+	unsigned int ebo = 0;
+	unsigned int drawIdVBO = 0;
+	unsigned int drawDataSSBO = 0;
+	unsigned int drawTextureSSBO = 0;
+	unsigned int indirectBuffer = 0;
+
+	///> End of the vertex and index ranges handed out, and allocated
+	size_t vertexCount = 0;
+	size_t vertexCapacity = 0;
+	size_t indexCount = 0;
+	size_t indexCapacity = 0;
+	///> Ranges given back below vertexCount and indexCount, first element to length
+	std::map<size_t, size_t> freeVertices;
+	std::map<size_t, size_t> freeIndices;
+	///> Draws the draw id, per-draw data and indirect buffers can hold
+	size_t drawCapacity = 0;
+};
@@ -0,0 +1,290 @@
+#include "Engine.h"
+
+#include <GL/glew.h>
+
+namespace {
+	///> Threads per work group of the culling shader
+	constexpr unsigned int CULL_GROUP_SIZE = 64;
+
+	/**
+	 * @brief Culling compute shader.
+	 *
+	 * Mirrors Eng::List::isWithinCullingSphere: the draw's bounding sphere is moved to eye
+	 * space, its radius scaled by the length of the first model-view column, and tested
+	 * against the sphere enclosing the eye frustum.
+	 */
+	const std::string CULL_SHADER_CODE = R"(
+#version 440 core
+
+layout(local_size_x = 64) in;
+
+struct DrawCommand {
+   uint count;
+   uint instanceCount;
+   uint firstIndex;
+   int baseVertex;
+   uint baseInstance;
+};
+
+struct DrawBounds {
+   vec4 sphere;
+   uint bucket;
+   uint bucketFirst;
+   uint padding0;
+   uint padding1;
+};
+
+layout(std430, binding = ShaderManager::DRAW_DATA_BINDING) readonly buffer DrawData { mat4 drawModel[]; };
+layout(std430, binding = ShaderManager::CULL_SOURCE_COMMANDS_BINDING) readonly buffer SourceCommands { DrawCommand sourceCommands[]; };
+layout(std430, binding = ShaderManager::CULL_BOUNDS_BINDING) readonly buffer Bounds { DrawBounds bounds[]; };
+layout(std430, binding = ShaderManager::CULL_COMMANDS_BINDING) writeonly buffer CulledCommands { DrawCommand culledCommands[]; };
+layout(std430, binding = ShaderManager::CULL_DRAW_COUNTS_BINDING) buffer DrawCounts { uint drawCounts[]; };
+layout(std430, binding = ShaderManager::CULL_VISIBILITY_BINDING) writeonly buffer Visibility { uint visibility[]; };
+
+uniform mat4 viewMatrix;
+uniform vec4 cullingSphere;    // eye-space center (xyz) and radius (w)
+uniform int drawCount;
+uniform bool compact;
+
+void main()
+{
+   uint draw = gl_GlobalInvocationID.x;
+   if (draw >= uint(drawCount))
+      return;
+
+   mat4 modelView = viewMatrix * drawModel[draw];
+   vec3 eyeCenter = vec3(modelView * vec4(bounds[draw].sphere.xyz, 1.0));
+   float radius = bounds[draw].sphere.w * length(vec3(modelView[0]));
+
+   vec3 diff = eyeCenter - cullingSphere.xyz;
+   float sumRadii = radius + cullingSphere.w;
+   bool visible = dot(diff, diff) <= sumRadii * sumRadii;
+
+   visibility[draw] = visible ? 1u : 0u;
+
+   DrawCommand command = sourceCommands[draw];
+   if (compact) {
+      // Survivors are packed at the front of their bucket, counted per bucket
+      if (visible) {
+         uint slot = atomicAdd(drawCounts[bounds[draw].bucket], 1u);
+         culledCommands[bounds[draw].bucketFirst + slot] = command;
+      }
+   }
+   else {
+      // Culled commands stay in place and draw nothing
+      command.instanceCount = visible ? command.instanceCount : 0u;
+      culledCommands[draw] = command;
+   }
+}
+)";
+}
+
+/**
+ * @brief Gets the singleton instance of the GpuCuller.
+ * @return GpuCuller& Reference to the singleton instance.
+ */
+Eng::GpuCuller& Eng::GpuCuller::getInstance() {
+	static GpuCuller instance;
+	return instance;
+}
+
+/**
+ * @brief Checks whether the context supports compute culling.
+ *
+ * Requires compute shaders on top of the GeometryBuffer requirements (OpenGL 4.3).
+ *
+ * @return true if GpuCuller can be used.
+ */
+bool Eng::GpuCuller::isSupported() {
+	return Eng::GeometryBuffer::isSupported() && (GLEW_VERSION_4_3 || GLEW_ARB_compute_shader);
+}
+
+/**
+ * @brief Checks whether culled commands can be compacted.
+ *
+ * Compaction needs the draw count to be read from a GPU buffer (GL_ARB_indirect_parameters).
+ *
+ * @return true if compacted output is used.
+ */
+bool Eng::GpuCuller::isCompactionSupported() {
+	return GLEW_ARB_indirect_parameters;
+}
+
+/**
+ * @brief Issues the compile and link of the culling program without waiting for them.
+ *
+ * Called with the other programs at load time, so the first cull does not stall
+ * on the compiler; otherwise the first cull submits it.
+ *
+ * @return true if the program was submitted.
+ */
+bool Eng::GpuCuller::submit() {
+	initialized = false;
+	shader = std::make_shared<Eng::ComputeShader>();
+	program = std::make_shared<Eng::Program>();
+	program->addShader(shader);
+	if (!shader->submit(ShaderManager::preprocessShaderCode(CULL_SHADER_CODE).c_str()) ||
+		!ShaderManager::getInstance().submitProgram(program)) {
+		std::cerr << "[ERROR] GpuCuller: unable to submit the culling program" << std::endl;
+		program = nullptr;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Collects the culling program on first use, submitting it if needed.
+ * @return true if the program is ready.
+ */
+bool Eng::GpuCuller::init() {
+	if (initialized)
+		return program != nullptr;
+	if (!program)
+		submit();
+	initialized = true;
+
+	if (!program || !program->finish()) {
+		std::cerr << "[ERROR] GpuCuller: unable to build the culling program" << std::endl;
+		program = nullptr;
+		return false;
+	}
+
+	viewMatrixLoc = program->getParamLocation("viewMatrix");
+	cullingSphereLoc = program->getParamLocation("cullingSphere");
+	drawCountLoc = program->getParamLocation("drawCount");
+	compactLoc = program->getParamLocation("compact");
+	return true;
+}
+
+/**
+ * @brief Culls the draws last uploaded to the GeometryBuffer.
+ *
+ * Reads its indirect commands and per-draw matrices, tests each draw and writes
+ * the survivors to the culler's own indirect buffer, ready for draw(). The
+ * previously bound program is restored.
+ *
+ * @param bounds        Bounding sphere and bucket of each draw, in command order.
+ * @param bucketCount   Number of buckets the commands are split into.
+ * @param viewMatrix    Eye view matrix.
+ * @param cullingSphere Eye-space sphere enclosing the view frustum (center, radius).
+ * @return true if the draws were culled; false if the culling program is unavailable.
+ */
+bool Eng::GpuCuller::cull(const std::vector<DrawBounds>& bounds, const size_t bucketCount, const glm::mat4& viewMatrix, const glm::vec4& cullingSphere) {
+	if (bounds.empty())
+		return true;
+	if (!init())
+		return false;
+
+	reserve(bounds.size(), bucketCount);
+	auto& geometryBuffer = Eng::GeometryBuffer::getInstance();
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, boundsBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, bounds.size() * sizeof(DrawBounds), bounds.data());
+
+	const std::vector<unsigned int> zeroCounts(bucketCount, 0);
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, zeroCounts.size() * sizeof(unsigned int), zeroCounts.data());
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::DRAW_DATA_BINDING, geometryBuffer.getDrawDataBuffer());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::CULL_SOURCE_COMMANDS_BINDING, geometryBuffer.getCommandBuffer());
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::CULL_BOUNDS_BINDING, boundsBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::CULL_COMMANDS_BINDING, commandBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::CULL_DRAW_COUNTS_BINDING, countBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, ShaderManager::CULL_VISIBILITY_BINDING, visibilityBuffer);
+
+	const auto previousProgram = ShaderManager::getInstance().getCurrentProgram();
+	program->render();
+	program->setMatrix(viewMatrixLoc, viewMatrix);
+	program->setVec4(cullingSphereLoc, cullingSphere);
+	program->setInt(drawCountLoc, static_cast<int>(bounds.size()));
+	program->setInt(compactLoc, isCompactionSupported() ? 1 : 0);
+
+	const auto groups = static_cast<GLuint>((bounds.size() + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE);
+	glDispatchCompute(groups, 1, 1);
+	glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+
+	// Only the active program changed: the ShaderManager's cached locations stay valid
+	if (previousProgram)
+		previousProgram->render();
+	return true;
+}
+
+/**
+ * @brief Draws one bucket of the culled commands.
+ *
+ * With compaction the number of draws is read from the GPU counter of the bucket,
+ * up to commandCount; otherwise all commands are issued, culled ones with zero instances.
+ *
+ * @param firstCommand First command of the bucket.
+ * @param commandCount Number of commands in the bucket before culling.
+ * @param bucket       Index of the bucket.
+ */
+void Eng::GpuCuller::draw(const size_t firstCommand, const size_t commandCount, const size_t bucket) {
+	Eng::GeometryBuffer::getInstance().drawIndirect(commandBuffer, firstCommand, commandCount,
+		isCompactionSupported() ? countBuffer : 0, bucket);
+}
+
+/**
+ * @brief Reads back the visibility computed by the last cull().
+ *
+ * Stalls until the GPU has finished culling; meant for verification only.
+ *
+ * @param drawCount Number of draws of the last cull().
+ * @return std::vector<unsigned int> 1 for each visible draw, 0 for culled ones.
+ */
+std::vector<unsigned int> Eng::GpuCuller::readVisibility(const size_t drawCount) {
+	std::vector<unsigned int> visibility(std::min(drawCount, drawCapacity), 0);
+	if (visibility.empty())
+		return visibility;
+
+	glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibilityBuffer);
+	glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, visibility.size() * sizeof(unsigned int), visibility.data());
+	return visibility;
+}
+
+/**
+ * @brief Releases the culling program and buffers.
+ */
+void Eng::GpuCuller::clear() {
+	if (drawCapacity) {
+		const unsigned int buffers[] = { boundsBuffer, commandBuffer, countBuffer, visibilityBuffer };
+		glDeleteBuffers(4, buffers);
+	}
+	boundsBuffer = commandBuffer = countBuffer = visibilityBuffer = 0;
+	drawCapacity = bucketCapacity = 0;
+
+	shader = nullptr;
+	program = nullptr;
+	initialized = false;
+}
+
+/**
+ * @brief Makes room for the given number of draws and buckets.
+ *
+ * @param draws   Draws to hold.
+ * @param buckets Buckets to hold.
+ */
+void Eng::GpuCuller::reserve(const size_t draws, const size_t buckets) {
+	if (!drawCapacity) {
+		glGenBuffers(1, &boundsBuffer);
+		glGenBuffers(1, &commandBuffer);
+		glGenBuffers(1, &countBuffer);
+		glGenBuffers(1, &visibilityBuffer);
+	}
+
+	if (draws > drawCapacity) {
+		drawCapacity = std::max(draws, drawCapacity * 2);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, boundsBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, drawCapacity * sizeof(DrawBounds), nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, commandBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, drawCapacity * sizeof(Eng::GeometryBuffer::DrawCommand), nullptr, GL_STREAM_DRAW);
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibilityBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, drawCapacity * sizeof(unsigned int), nullptr, GL_STREAM_READ);
+	}
+
+	if (buckets > bucketCapacity || !bucketCapacity) {
+		bucketCapacity = std::max<size_t>({ buckets, bucketCapacity * 2, 1 });
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, countBuffer);
+		glBufferData(GL_SHADER_STORAGE_BUFFER, bucketCapacity * sizeof(unsigned int), nullptr, GL_STREAM_DRAW);
+	}
+}
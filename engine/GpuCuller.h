@@ -0,0 +1,64 @@
+#pragma once
+
+/**
+ * @class GpuCuller
+ * @brief Culls the draws of a GeometryBuffer submission in a compute shader.
+ *
+ * The GpuCuller implements the Singleton pattern. It reads the indirect commands and
+ * per-draw matrices uploaded to the GeometryBuffer together with each draw's bounding
+ * sphere, runs the same bounding-sphere test as Eng::List on the GPU and writes the
+ * surviving commands to its own indirect buffer. When GL_ARB_indirect_parameters is
+ * available the output is compacted per bucket and drawn with a GPU-side draw count;
+ * otherwise culled commands are kept in place with zero instances.
+ */
+class ENG_API GpuCuller final {
+public:
+	/**
+	 * @brief Culling input of one draw, laid out as the compute shader reads it (std430).
+	 */
+	struct DrawBounds {
+		glm::vec4 sphere;			///< Bounding sphere center (xyz) and radius (w), in model space
+		unsigned int bucket;		///< Bucket the draw belongs to
+		unsigned int bucketFirst;	///< First command of that bucket
+		unsigned int padding[2];
+	};
+
+	static GpuCuller& getInstance();
+	static bool isSupported();
+	static bool isCompactionSupported();
+
+	GpuCuller(const GpuCuller&) = delete;
+	GpuCuller& operator=(const GpuCuller&) = delete;
+
+	bool submit();
+	bool cull(const std::vector<DrawBounds>& bounds, size_t bucketCount, const glm::mat4& viewMatrix, const glm::vec4& cullingSphere);
+	void draw(size_t firstCommand, size_t commandCount, size_t bucket);
+	std::vector<unsigned int> readVisibility(size_t drawCount);
+	void clear();
+
+private:
+	/** @brief Private constructor to enforce singleton pattern */
+	GpuCuller() = default;
+
+	bool init();
+	void reserve(size_t draws, size_t buckets);
+
+	std::shared_ptr<Eng::ComputeShader> shader;
+	std::shared_ptr<Eng::Program> program;
+	bool initialized = false;
+
+	int viewMatrixLoc = -1;
+	int cullingSphereLoc = -1;
+	int drawCountLoc = -1;
+	int compactLoc = -1;
+
+	// Hold GPU resource IDs
+	unsigned int boundsBuffer = 0;
+	unsigned int commandBuffer = 0;
+	unsigned int countBuffer = 0;
+	unsigned int visibilityBuffer = 0;
+
+	///> Draws and buckets the buffers can hold
+	size_t drawCapacity = 0;
+	size_t bucketCapacity = 0;
+};
@@ -132,14 +132,14 @@ bool Eng::HolographicMaterial::initShader() {
 
     //compiles shaders
     std::shared_ptr<Eng::VertexShader> vertexShader = std::make_shared<Eng::VertexShader>();
-    if (!vertexShader->load(ShaderManager::preprocessShaderCode(vertexShaderCode).c_str())) {
-        std::cerr << "Failed to compile holographic vertex shader" << std::endl;
+    if (!vertexShader->submit(ShaderManager::preprocessShaderCode(vertexShaderCode).c_str())) {
+        std::cerr << "Failed to submit holographic vertex shader" << std::endl;
         return false;
     }
 
     std::shared_ptr<Eng::FragmentShader> fragmentShader = std::make_shared<Eng::FragmentShader>();
-    if (!fragmentShader->load(fragmentShaderCode.c_str())) {
-        std::cerr << "Failed to compile holographic fragment shader" << std::endl;
+    if (!fragmentShader->submit(fragmentShaderCode.c_str())) {
+        std::cerr << "Failed to submit holographic fragment shader" << std::endl;
         return false;
     }
 
@@ -149,8 +149,9 @@ bool Eng::HolographicMaterial::initShader() {
     holographicShader->bindAttribute(ShaderManager::NORMAL_LOCATION, "in_Normal");
     holographicShader->bindAttribute(ShaderManager::TEX_COORD_LOCATION, "in_TexCoord");
 
-    if (!holographicShader->addShader(vertexShader).addShader(fragmentShader).build()) {
-        std::cerr << "Failed to link holographic shader program" << std::endl;
+    holographicShader->addShader(vertexShader).addShader(fragmentShader);
+    if (!ShaderManager::getInstance().submitProgram(holographicShader)) {
+        std::cerr << "Failed to submit holographic shader program" << std::endl;
         return false;
     }
 
@@ -299,4 +300,12 @@ void Eng::HolographicMaterial::setSecondaryColor(const glm::vec3& color) {
  */
 glm::vec3 Eng::HolographicMaterial::getSecondaryColor() const {
     return secondaryColor;
+}
+
+/**
+ * @brief Holographic meshes are never batched into instanced draws.
+ * @return false, the holographic shader reads no per-instance transform.
+ */
+bool Eng::HolographicMaterial::supportsInstancing() const {
+    return false;
 }
\ No newline at end of file
@@ -31,6 +31,12 @@ public:
      */
     void render() override;
 
+    /**
+     * @brief The holographic shader has no per-instance transform input.
+     * @return false, meshes using this material are always drawn one by one.
+     */
+    bool supportsInstancing() const override;
+
     /**
      * @brief Sets the base color of the holographic effect.
      * @param color The new base color.
@@ -0,0 +1,84 @@
+#include "Engine.h"
+
+#include <chrono>
+#include <functional>
+#include <map>
+
+/**
+ * @brief Shares identical geometries and counts the meshes that can be drawn instanced.
+ *
+ * Every level of detail is replaced by the registered geometry with the same
+ * content, if any. Meshes are then grouped by their levels and material; groups
+ * of two or more are the ones the render list will draw instanced.
+ *
+ * @param root Root of the scene graph.
+ * @return Stats Merged geometries, instance groups and the savings they bring.
+ */
+Eng::InstanceDetector::Stats Eng::InstanceDetector::detect(const std::shared_ptr<Eng::Node>& root) {
+	Stats stats;
+	const auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::shared_ptr<Eng::Mesh>> meshes;
+	std::function<void(const std::shared_ptr<Eng::Node>&)> collect = [&](const std::shared_ptr<Eng::Node>& node) {
+		if (const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(node); mesh && mesh->getGeometry())
+			meshes.push_back(mesh);
+		for (const auto& child : *node->getChildren())
+			collect(child);
+	};
+	if (root)
+		collect(root);
+	stats.meshes = meshes.size();
+
+	// Shared geometry -> levels of detail drawing it
+	std::map<std::shared_ptr<Eng::Geometry>, size_t> references;
+	for (const auto& mesh : meshes) {
+		for (size_t level = 0; level < mesh->getLodCount(); level++) {
+			const auto geometry = mesh->getLodGeometry(level);
+			const auto shared = Eng::Geometry::share(geometry);
+			if (shared != geometry) {
+				mesh->setLodGeometry(level, shared);
+				stats.geometriesMerged++;
+			}
+			references[shared]++;
+		}
+	}
+
+	for (const auto& [geometry, owners] : references) {
+		stats.cpuBytesSaved += geometry->getCpuMemoryUsage() * (owners - 1);
+		stats.gpuBytesSaved += geometry->getGpuMemoryUsage() * (owners - 1);
+	}
+
+	// (levels, material) -> meshes drawing them
+	std::map<std::pair<std::vector<const Eng::Geometry*>, const Eng::Material*>, std::vector<Eng::Mesh*>> groups;
+	for (const auto& mesh : meshes) {
+		if (!mesh->getMaterial())
+			continue;
+		std::vector<const Eng::Geometry*> levels;
+		for (size_t level = 0; level < mesh->getLodCount(); level++)
+			levels.push_back(mesh->getLodGeometry(level).get());
+		groups[{ levels, mesh->getMaterial().get() }].push_back(mesh.get());
+	}
+	for (const auto& [key, group] : groups) {
+		if (group.size() < 2)
+			continue;
+		stats.groups++;
+		stats.instancedMeshes += group.size();
+		stats.drawCallsSaved += group.size() - 1;
+	}
+
+	stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return stats;
+}
+
+/**
+ * @brief Prints the outcome of a detect() call.
+ * @param stats Stats returned by detect().
+ */
+void Eng::InstanceDetector::printStats(const Stats& stats) {
+	constexpr double MB = 1024.0 * 1024.0;
+	std::cout << "[InstanceDetector] " << stats.instancedMeshes << " of " << stats.meshes << " meshes in "
+		<< stats.groups << " instance groups, found in " << stats.milliseconds << " ms" << std::endl;
+	std::cout << "   Geometries : " << stats.geometriesMerged << " duplicates merged, "
+		<< stats.cpuBytesSaved / MB << " MB RAM and " << stats.gpuBytesSaved / MB << " MB VRAM saved by sharing" << std::endl;
+	std::cout << "   Draw calls : " << stats.drawCallsSaved << " fewer per pass" << std::endl;
+}
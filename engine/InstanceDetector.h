@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * @class InstanceDetector
+ * @brief Finds meshes drawing identical geometry at load time so they can be drawn instanced.
+ *
+ * Exported scenes repeat the same object many times (every pawn, every chair),
+ * each copy being a separate mesh. Geometries built through Geometry::create()
+ * are already shared by content, but geometries built any other way are not, and
+ * a mesh with its own copy can only be drawn on its own.
+ *
+ * The detector walks a loaded scene graph and hands the geometry of every level
+ * of detail to Geometry::share(), so levels with identical vertices and indices
+ * reference one Geometry, stored and uploaded once. The render list then groups
+ * the meshes drawing the same geometry and material by itself; the detector only
+ * reports the groups it expects.
+ */
+class ENG_API InstanceDetector final {
+public:
+	/**
+	 * @brief Outcome of a detect() call.
+	 */
+	struct Stats {
+		size_t meshes = 0;				///< Meshes with geometry visited
+		size_t geometriesMerged = 0;	///< Duplicated geometries replaced by a shared one
+		size_t groups = 0;				///< Sets of two or more meshes drawn with one instanced call
+		size_t instancedMeshes = 0;		///< Meshes in those sets
+		size_t drawCallsSaved = 0;		///< Draws per pass replaced by instanced calls
+		size_t cpuBytesSaved = 0;		///< RAM one geometry copy per mesh would have needed on top
+		size_t gpuBytesSaved = 0;		///< VRAM one geometry copy per mesh would have needed on top
+		double milliseconds = 0.0;		///< Wall-clock time
+	};
+
+	static Stats detect(const std::shared_ptr<Eng::Node>& root);
+	static void printStats(const Stats& stats);
+};
@@ -68,3 +68,13 @@ void Eng::Light::setupLightBase(const int &lightId) const {
 void Eng::Light::setColor(const glm::vec3 &color) {
    this->color = color;
 }
+
+/**
+ * @brief Gets the color of the light source
+ *
+ * @return glm::vec3 RGB color of the light
+ */
+
+glm::vec3 Eng::Light::getColor() const {
+   return color;
+}
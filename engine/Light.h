@@ -12,6 +12,7 @@ public:
    explicit Light(const glm::vec3 &color);
 
    void setColor(const glm::vec3 &color);
+   glm::vec3 getColor() const;
    void render() override;
 
 private:
@@ -5,6 +5,9 @@
 
 #include <GL/freeglut.h>
 
+#include <limits>
+#include <map>
+
 /**
  * @brief Constructs a new render List with default settings.
  *
@@ -109,6 +112,7 @@ void Eng::List::clear() {
    lightsIteratorCached = nullptr;
    opaqueIteratorCached = nullptr;
    transparentIteratorCached = nullptr;
+   instanceGroupsCached.clear();
 }
 
 /**
@@ -148,6 +152,100 @@ bool Eng::List::isWithinCullingSphere(const std::shared_ptr<Eng::Mesh>& mesh) {
         return true;
 }
 
+/**
+ * @brief Computes how large an element's bounding sphere appears on screen.
+ *
+ * The size is the projected diameter over the viewport height, from the eye
+ * projection matrix; it grows without bound as the eye gets inside the sphere.
+ *
+ * @param element The element to measure.
+ * @return float Projected size, 0 for non-mesh elements.
+ */
+float Eng::List::getProjectedSize(const std::shared_ptr<Eng::ListElement>& element) const {
+    const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(element->getNode());
+    if (!mesh)
+        return 0.0f;
+
+    const glm::mat4 modelViewMatrix = eyeViewMatrix * element->getWorldCoordinates();
+    const glm::vec3 eyeCenter = glm::vec3(modelViewMatrix * glm::vec4(mesh->getBoundingSphereCenter(), 1.0f));
+    const float radius = mesh->getBoundingSphereRadius() * glm::length(glm::vec3(modelViewMatrix[0]));
+
+    // Orthographic projections do not shrink with distance
+    const float scale = eyeProjectionMatrix[1][1];
+    if (eyeProjectionMatrix[3][3] == 1.0f)
+        return radius * scale;
+
+    const float distance = -eyeCenter.z;
+    if (distance <= radius)
+        return std::numeric_limits<float>::max();
+    return radius * scale / distance;
+}
+
+/**
+ * @brief Selects the level of detail of every mesh for the current view.
+ *
+ * Must be called once the eye matrices are set and before the list is rendered;
+ * the selection is kept per view index so each eye switches levels on its own.
+ */
+void Eng::List::selectLods() {
+    for (const auto& element : elements) {
+        const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(element->getNode());
+        if (mesh && mesh->getLodCount() > 1)
+            mesh->selectLod(getProjectedSize(element), viewIndex);
+    }
+    instanceGroupsCached.clear();
+}
+
+/**
+ * @brief Retrieves the sphere enclosing the eye frustum, as used by isWithinCullingSphere().
+ * @return glm::vec4 Eye-space center (xyz) and radius (w).
+ */
+glm::vec4 Eng::List::getCullingSphere() {
+    if (!cullingSphereCached) {
+        computeCullingSphere();
+    }
+    return glm::vec4(cullingSphereCached->center, cullingSphereCached->radius);
+}
+
+/**
+ * @brief Selects where the visibility of the meshes is decided.
+ *
+ * GPU modes need compute shader support; otherwise the list stays on CPU culling.
+ * The mode is kept across clear().
+ *
+ * @param mode The culling mode.
+ */
+void Eng::List::setCullingMode(CullingMode mode) {
+    if (mode != CullingMode::Cpu && !Eng::GpuCuller::isSupported()) {
+        std::cerr << "WARNING: [List] GPU culling not supported, using CPU culling" << std::endl;
+        mode = CullingMode::Cpu;
+    }
+    cullingMode = mode;
+}
+
+/**
+ * @brief Compares a GPU culling result with the CPU test.
+ *
+ * Non-mesh elements are always visible. Elements lying exactly on the culling
+ * boundary may differ because of floating point rounding.
+ *
+ * @param culledElements Elements in the order they were culled.
+ * @param visibility     GPU result per element, non-zero for visible.
+ * @return size_t Number of elements whose visibility differs.
+ */
+size_t Eng::List::countCullingMismatches(const std::vector<std::shared_ptr<Eng::ListElement>>& culledElements, const std::vector<unsigned int>& visibility) {
+    const size_t count = std::min(culledElements.size(), visibility.size());
+    size_t mismatches = std::max(culledElements.size(), visibility.size()) - count;
+
+    for (size_t i = 0; i < count; i++) {
+        const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(culledElements[i]->getNode());
+        const bool expected = mesh ? isWithinCullingSphere(mesh) : true;
+        if (expected != (visibility[i] != 0))
+            mismatches++;
+    }
+    return mismatches;
+}
+
 /**
  * @brief Recomputes the culling sphere from the view frustum corners.
  *
@@ -320,3 +418,44 @@ std::shared_ptr<std::vector<std::shared_ptr<Eng::ListElement>>> Eng::List::getEl
     }
     return layerElements;
 }
+
+/**
+ * @brief Groups the elements of a layer that can be drawn with one instanced call.
+ *
+ * Meshes drawing the same Geometry (at their active level of detail) with the
+ * same material instance end up in the same group, in order of first
+ * appearance. Everything else (non-mesh nodes, materials that do not support
+ * instancing) gets a group of its own. The result is cached until clear().
+ *
+ * @param layer The render layer to group.
+ * @return Reference to the cached groups for the layer.
+ */
+const std::vector<std::vector<std::shared_ptr<Eng::ListElement>>>& Eng::List::getInstanceGroups(const Eng::RenderLayer& layer) {
+    auto cached = instanceGroupsCached.find(layer);
+    if (cached != instanceGroupsCached.end())
+        return cached->second;
+
+    auto& groups = instanceGroupsCached[layer];
+    // (geometry, material) -> index in groups
+    std::map<std::pair<const void*, const void*>, size_t> groupByKey;
+
+    for (const auto& element : *getElements(layer)) {
+        const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(element->getNode());
+        const auto material = mesh ? mesh->getMaterial() : nullptr;
+        if (!material || !mesh->getGeometry() || !material->supportsInstancing()) {
+            groups.push_back({ element });
+            continue;
+        }
+
+        const auto key = std::make_pair<const void*, const void*>(mesh->getActiveGeometry().get(), material.get());
+        const auto it = groupByKey.find(key);
+        if (it != groupByKey.end()) {
+            groups[it->second].push_back(element);
+            continue;
+        }
+
+        groupByKey[key] = groups.size();
+        groups.push_back({ element });
+    }
+    return groups;
+}
\ No newline at end of file
@@ -11,6 +11,15 @@
  */
 class ENG_API List final : public Eng::Object {
 public:
+	/**
+	 * @brief Where the visibility of the meshes is decided.
+	 */
+	enum class CullingMode {
+		Cpu,	///< Each element is tested on the CPU while rendering
+		Gpu,	///< Multi-draw submissions are culled by a compute shader (GpuCuller)
+		Verify	///< As Gpu, with the GPU result read back and compared to the CPU test
+	};
+
 	List();
 	~List();
 
@@ -19,6 +28,16 @@ public:
 	void clear();
 
 	bool isWithinCullingSphere(const std::shared_ptr<Eng::Mesh>& mesh);
+	glm::vec4 getCullingSphere();
+
+	void setViewIndex(unsigned int index) { viewIndex = index; }
+	unsigned int getViewIndex() const { return viewIndex; }
+	float getProjectedSize(const std::shared_ptr<Eng::ListElement>& element) const;
+	void selectLods();
+
+	void setCullingMode(CullingMode mode);
+	CullingMode getCullingMode() const { return cullingMode; }
+	size_t countCullingMismatches(const std::vector<std::shared_ptr<Eng::ListElement>>& culledElements, const std::vector<unsigned int>& visibility);
 
 	void setEyeViewMatrix(glm::mat4& viewMatrix);
 	void setEyeProjectionMatrix(glm::mat4& eyeProjectionMatrix);
@@ -35,6 +54,8 @@ public:
 
 	Eng::ListIterator getLayerIterator(const Eng::RenderLayer& layer);
 
+	const std::vector<std::vector<std::shared_ptr<Eng::ListElement>>>& getInstanceGroups(const Eng::RenderLayer& layer);
+
 	glm::vec3 getGlobalLightColor() const { return globalLightColor; }
 
 	glm::mat4 getEyeViewMatrix() const { return eyeViewMatrix; }
@@ -62,6 +83,9 @@ private:
 	glm::vec3 globalLightColor = glm::vec3(0.0f, 0.0f, 0.0f);
 
 	std::shared_ptr<Eng::Fbo> currentFBO = nullptr;
+	CullingMode cullingMode = CullingMode::Cpu;
+	///> View being rendered (e.g. the eye), keeps per-view LOD selections apart
+	unsigned int viewIndex = 0;
 
 	// Computed private values
 
@@ -75,6 +99,8 @@ private:
 	std::shared_ptr<Eng::ListIterator> lightsIteratorCached = nullptr;
 	std::shared_ptr<Eng::ListIterator> opaqueIteratorCached = nullptr;
 	std::shared_ptr<Eng::ListIterator> transparentIteratorCached = nullptr;
+	///> Elements of each layer grouped by identical geometry and material
+	std::unordered_map<Eng::RenderLayer, std::vector<std::vector<std::shared_ptr<Eng::ListElement>>>> instanceGroupsCached;
 
 	// Private Methods
 
@@ -0,0 +1,167 @@
+#include "Engine.h"
+
+#ifdef _WINDOWS
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace {
+	/**
+	 * @brief Maps a whole file read-only.
+	 * @return const char* Start of the mapping, nullptr on failure or for empty files.
+	 */
+	const char* mapFile(const std::string& filename, size_t& size) {
+#ifdef _WINDOWS
+		const HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		LARGE_INTEGER fileSize;
+		const void* view = nullptr;
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+			// The view keeps the mapping alive once both handles are closed
+			const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			if (mapping) {
+				view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+				CloseHandle(mapping);
+			}
+			size = static_cast<size_t>(fileSize.QuadPart);
+		}
+		CloseHandle(file);
+		return static_cast<const char*>(view);
+#else
+		const int descriptor = ::open(filename.c_str(), O_RDONLY);
+		if (descriptor < 0)
+			return nullptr;
+
+		struct stat status;
+		void* view = MAP_FAILED;
+		if (fstat(descriptor, &status) == 0 && S_ISREG(status.st_mode) && status.st_size > 0) {
+			size = static_cast<size_t>(status.st_size);
+			view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (view != MAP_FAILED)
+				madvise(view, size, MADV_SEQUENTIAL);
+		}
+		::close(descriptor);
+		return view != MAP_FAILED ? static_cast<const char*>(view) : nullptr;
+#endif
+	}
+
+	/**
+	 * @brief Releases a mapping returned by mapFile().
+	 */
+	void unmapFile(const char* data, const size_t size) {
+#ifdef _WINDOWS
+		(void)size;
+		UnmapViewOfFile(data);
+#else
+		munmap(const_cast<char*>(data), size);
+#endif
+	}
+}
+
+/**
+ * @brief Releases the mapping, if any.
+ */
+Eng::MappedFile::~MappedFile() {
+	close();
+}
+
+/**
+ * @brief Maps a file, or reads it when it cannot be mapped.
+ *
+ * Any previously opened file is closed first. Empty files open successfully
+ * with no data.
+ *
+ * @param filename Path of the file.
+ * @return true if the content is available.
+ */
+bool Eng::MappedFile::open(const std::string& filename) {
+	close();
+
+	size_t mappedSize = 0;
+	if (const char* view = mapFile(filename, mappedSize)) {
+		data = view;
+		size = mappedSize;
+		mapped = true;
+		opened = true;
+		return true;
+	}
+
+	FILE* file = fopen(filename.c_str(), "rb");
+	if (file == nullptr)
+		return false;
+
+	char chunk[65536];
+	size_t read;
+	while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+		buffer.insert(buffer.end(), chunk, chunk + read);
+	const bool failed = ferror(file) != 0;
+	fclose(file);
+	if (failed) {
+		buffer.clear();
+		return false;
+	}
+
+	data = buffer.empty() ? nullptr : buffer.data();
+	size = buffer.size();
+	opened = true;
+	return true;
+}
+
+/**
+ * @brief Releases the file content; views into it become invalid.
+ */
+void Eng::MappedFile::close() {
+	if (mapped)
+		unmapFile(data, size);
+	buffer.clear();
+	buffer.shrink_to_fit();
+	data = nullptr;
+	size = 0;
+	mapped = false;
+	opened = false;
+}
+
+/**
+ * @brief Gets the file content.
+ * @return const char* Start of the content, nullptr when closed or empty.
+ */
+const char* Eng::MappedFile::getData() const {
+	return data;
+}
+
+/**
+ * @brief Gets the size of the file content.
+ * @return size_t Size in bytes.
+ */
+size_t Eng::MappedFile::getSize() const {
+	return size;
+}
+
+/**
+ * @brief Checks whether a file is open.
+ * @return true after a successful open(), until close().
+ */
+bool Eng::MappedFile::isOpen() const {
+	return opened;
+}
+
+/**
+ * @brief Checks whether the content is memory-mapped rather than read.
+ * @return true if mapped.
+ */
+bool Eng::MappedFile::isMapped() const {
+	return mapped;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file, memory-mapped when the platform allows it.
+ *
+ * Mapping lets parsers walk large files in place: pages are faulted in on demand
+ * and nothing is copied into intermediate buffers. If the file cannot be mapped
+ * (e.g. it is not a regular file) its content is read into memory instead, so
+ * callers always get one contiguous block. The mapping is released on close()
+ * or destruction.
+ */
+class ENG_API MappedFile final {
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool open(const std::string& filename);
+	void close();
+
+	const char* getData() const;
+	size_t getSize() const;
+	bool isOpen() const;
+	bool isMapped() const;
+
+private:
+	///> Start of the file content
+	const char* data = nullptr;
+	///> Bytes of file content
+	size_t size = 0;
+	///> Whether data points into a mapping rather than into buffer
+	bool mapped = false;
+	///> Whether open() succeeded
+	bool opened = false;
+	///> Content read from the file when it could not be mapped
+	std::vector<char> buffer;
+};
@@ -64,7 +64,7 @@ void Eng::Material::render() {
    sm.setMaterialSpecular(glm::vec3(albedo.r * 0.4f, albedo.g * 0.4f, albedo.b * 0.4f));
    sm.setMaterialShininess((1.0f - std::sqrt(this->shininess)) * 128.0f);
 
-   //Texture
+   //Texture, a white placeholder while it is still streaming
    if (diffuseTexture) {
        sm.setUseTexture(true);
        diffuseTexture->render();
@@ -84,6 +84,18 @@ void Eng::Material::render() {
    }
 }
 
+/**
+ * @brief Tells whether meshes using this material can be drawn in a single instanced call.
+ *
+ * The engine's lighting programs read a per-instance model matrix, so plain
+ * materials support instancing. Materials binding their own program override this.
+ *
+ * @return true for the base material.
+ */
+bool Eng::Material::supportsInstancing() const {
+   return true;
+}
+
 /**
  * @brief Sets the diffuse texture for the material.
  *
@@ -125,6 +137,15 @@ glm::vec3 Eng::Material::getAlbedo() const {
    return glm::vec3(albedo.r, albedo.g, albedo.b);
 }
 
+/**
+ * @brief Retrieves the shininess of the material.
+ *
+ * @return float The shininess (specular exponent).
+ */
+float Eng::Material::getShininess() const {
+   return shininess;
+}
+
 /**
  * @brief Retrieves the emission  of the material.
  *
@@ -13,11 +13,14 @@ public:
 
    virtual void render() override;
 
+   virtual bool supportsInstancing() const;
+
    void setDiffuseTexture(const std::shared_ptr<Eng::Texture> &texture);
    std::shared_ptr<Eng::Texture> getDiffuseTexture() const;
 
    glm::vec3 getAlbedo() const;
    float getAlpha() const;
+   float getShininess() const;
    void setAlpha(const float newAlpha);
    glm::vec4 getAlbedoWithAlpha() const;
    glm::vec3 getEmission() const;
@@ -3,12 +3,22 @@
 #include <GL/glew.h>
 #include <GL/freeglut.h>
 
+#include <algorithm>
+#include <limits>
+
 #ifdef _WINDOWS
 
 #else
 #include <execinfo.h>
 #endif
 
+namespace {
+   ///> Projected sizes below which each coarser level is used, finest first
+   std::vector<float> lodThresholds = { 0.1f, 0.04f, 0.015f };
+   ///> Relative margin around each threshold before switching level
+   float lodHysteresis = 0.15f;
+}
+
 
 /**
  * @brief Default constructor for the Mesh class.
@@ -26,24 +36,80 @@ Eng::Mesh::~Mesh() = default;
  * @brief Sets the vertices of the mesh.
  *
  * Assigns a vector of vertex data to the mesh. Each vertex includes position,
- * normal, and texture coordinate information.
+ * normal, and texture coordinate information. The data goes into a shared
+ * Geometry together with the current indices (see Geometry::create()); while
+ * the mesh has no indices yet, the geometry is kept out of the registry, so
+ * setting vertices then indices looks the shared geometry up only once.
+ * Prefer setGeometryData() when both arrays are at hand.
  *
  * @param verts A vector of Vertex objects representing the geometry of the mesh.
  */
 void Eng::Mesh::setVertices(const std::vector<Vertex> &verts) {
-   vertices = verts;
+   if (getIndices().empty())
+      geometry = std::make_shared<Eng::Geometry>(verts, getIndices());
+   else
+      geometry = Eng::Geometry::create(verts, getIndices());
 }
 
 /**
  * @brief Sets the indices for defining the mesh's faces.
  *
  * The indices define the order in which vertices are combined into triangles
- * for rendering. Each set of three indices forms one triangle.
+ * for rendering. Each set of three indices forms one triangle. The data goes
+ * into a shared Geometry together with the current vertices; like in
+ * setVertices(), the registry is only consulted once both arrays are set.
  *
  * @param inds A vector of unsigned integers representing the triangle vertex order.
  */
 void Eng::Mesh::setIndices(const std::vector<unsigned int> &inds) {
-   indices = inds;
+   if (getVertices().empty())
+      geometry = std::make_shared<Eng::Geometry>(getVertices(), inds);
+   else
+      geometry = Eng::Geometry::create(getVertices(), inds);
+}
+
+/**
+ * @brief Sets the vertices and indices of the mesh at once.
+ *
+ * The data is hashed and looked up in the shared Geometry registry a single
+ * time, instead of once per array as with setVertices() and setIndices().
+ *
+ * @param verts Vertex attributes.
+ * @param inds  Triangle indices.
+ */
+void Eng::Mesh::setGeometryData(const std::vector<Vertex> &verts, const std::vector<unsigned int> &inds) {
+   geometry = Eng::Geometry::create(verts, inds);
+}
+
+/**
+ * @brief Sets the vertices and indices of the mesh at once, taking over the data without copying it.
+ *
+ * @param verts Vertex attributes.
+ * @param inds  Triangle indices.
+ */
+void Eng::Mesh::setGeometryData(std::vector<Vertex> &&verts, std::vector<unsigned int> &&inds) {
+   geometry = Eng::Geometry::create(std::move(verts), std::move(inds));
+}
+
+/**
+ * @brief Makes this mesh reference an existing geometry.
+ *
+ * Meshes drawing the same shape should share one Geometry so that
+ * its data is stored and uploaded to the GPU only once.
+ *
+ * @param geom A shared pointer to the geometry.
+ */
+void Eng::Mesh::setGeometry(const std::shared_ptr<Eng::Geometry> &geom) {
+   geometry = geom;
+}
+
+/**
+ * @brief Retrieves the geometry referenced by the mesh.
+ *
+ * @return std::shared_ptr<Eng::Geometry> The geometry, nullptr if none was set.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Mesh::getGeometry() const {
+   return geometry;
 }
 
 /**
@@ -68,73 +134,158 @@ std::shared_ptr<Eng::Material> Eng::Mesh::getMaterial() const {
 }
 
 /**
- * @brief Initializes OpenGL buffers (VAO, VBOs, EBO) for this mesh.
+ * @brief Appends a lower level of detail.
  *
- * Extracts separate arrays for positions, normals, and texture coordinates
- * from the vertex list, creates a Vertex Array Object, and allocates
- * GPU buffers for efficient rendering.
+ * Levels are expected coarsest last; level 0 is the geometry set with
+ * setGeometry() or setVertices()/setIndices().
+ *
+ * @param lodGeometry Geometry of the new level.
  */
-void Eng::Mesh::initBuffers() {
-    if (buffersInitialized)
-        return;
+void Eng::Mesh::addLod(const std::shared_ptr<Eng::Geometry> &lodGeometry) {
+   if (lodGeometry)
+      lods.push_back(lodGeometry);
+}
 
-    // Extract separate arrays for positions, normals, and texture coordinates.
-    std::vector<float> positions;
-    std::vector<float> normals;
-    std::vector<float> texCoords;
-    positions.reserve(vertices.size() * 3);
-    normals.reserve(vertices.size() * 3);
-    texCoords.reserve(vertices.size() * 2);
-
-    for (const auto& v : vertices) {
-        // Position (vec3)
-        positions.push_back(v.getPosition().x);
-        positions.push_back(v.getPosition().y);
-        positions.push_back(v.getPosition().z);
-        // Normal (vec3)
-        normals.push_back(v.getNormal().x);
-        normals.push_back(v.getNormal().y);
-        normals.push_back(v.getNormal().z);
-        // Texture coordinates (vec2)
-        texCoords.push_back(v.getTexCoords().x);
-        texCoords.push_back(v.getTexCoords().y);
-    }
+/**
+ * @brief Retrieves the number of levels of detail, the full-detail one included.
+ *
+ * @return size_t Number of levels (0 without geometry).
+ */
+size_t Eng::Mesh::getLodCount() const {
+   return geometry ? lods.size() + 1 : 0;
+}
 
-    // Generate and bind the VAO.
-    glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
+/**
+ * @brief Retrieves the geometry of a level of detail.
+ *
+ * @param level Level, 0 being the full detail.
+ * @return std::shared_ptr<Eng::Geometry> The geometry, nullptr for a missing level.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Mesh::getLodGeometry(const size_t level) const {
+   if (level == 0)
+      return geometry;
+   return level <= lods.size() ? lods[level - 1] : nullptr;
+}
 
-    // VBO for positions.
-    glGenBuffers(1, &posVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, posVBO);
-    glBufferData(GL_ARRAY_BUFFER, positions.size() * sizeof(float), positions.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(ShaderManager::POSITION_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(ShaderManager::POSITION_LOCATION);
+/**
+ * @brief Replaces the geometry of an existing level of detail.
+ *
+ * Used by load-time passes that rebuild a level (e.g. reordered indices)
+ * without changing its shape. Missing levels and null geometries are ignored.
+ *
+ * @param level       Level, 0 being the full detail.
+ * @param lodGeometry New geometry of the level.
+ */
+void Eng::Mesh::setLodGeometry(const size_t level, const std::shared_ptr<Eng::Geometry> &lodGeometry) {
+   if (!lodGeometry)
+      return;
+   if (level == 0)
+      geometry = lodGeometry;
+   else if (level <= lods.size())
+      lods[level - 1] = lodGeometry;
+}
 
-    // VBO for normals.
-    glGenBuffers(1, &normVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, normVBO);
-    glBufferData(GL_ARRAY_BUFFER, normals.size() * sizeof(float), normals.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(ShaderManager::NORMAL_LOCATION, 3, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(ShaderManager::NORMAL_LOCATION);
+/**
+ * @brief Picks the level of detail to draw in a view from the mesh's projected size.
+ *
+ * Level L is used while the size lies between thresholds L-1 and L (see
+ * setLodThresholds()). A level only changes once the size moves past a threshold
+ * by the hysteresis margin, so a mesh hovering around it does not pop back and
+ * forth. Each view keeps its own selection; the result becomes the active level.
+ *
+ * @param screenSize Bounding sphere diameter over the viewport height.
+ * @param view       View index (e.g. the eye), below MAX_LOD_VIEWS.
+ * @return size_t The selected level.
+ */
+size_t Eng::Mesh::selectLod(const float screenSize, const unsigned int view) {
+   const size_t levels = getLodCount();
+   size_t &level = viewLods[std::min(view, MAX_LOD_VIEWS - 1)];
+   level = std::min(level, levels ? levels - 1 : 0);
+
+   while (level + 1 < levels && level < lodThresholds.size() && screenSize < lodThresholds[level] * (1.0f - lodHysteresis))
+      level++;
+   while (level > 0 && (level > lodThresholds.size() || screenSize > lodThresholds[level - 1] * (1.0f + lodHysteresis)))
+      level--;
+
+   activeLod = level;
+   return level;
+}
 
-    // VBO for texture coordinates.
-    glGenBuffers(1, &texVBO);
-    glBindBuffer(GL_ARRAY_BUFFER, texVBO);
-    glBufferData(GL_ARRAY_BUFFER, texCoords.size() * sizeof(float), texCoords.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(ShaderManager::TEX_COORD_LOCATION, 2, GL_FLOAT, GL_FALSE, 0, (void*)0);
-    glEnableVertexAttribArray(ShaderManager::TEX_COORD_LOCATION);
+/**
+ * @brief Retrieves the level of detail drawn by render().
+ *
+ * @return size_t The level last selected, 0 being the full detail.
+ */
+size_t Eng::Mesh::getActiveLod() const {
+   return activeLod;
+}
 
-    // EBO for indices.
-    glGenBuffers(1, &ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+/**
+ * @brief Retrieves the geometry drawn by render().
+ *
+ * @return std::shared_ptr<Eng::Geometry> Geometry of the active level of detail.
+ */
+std::shared_ptr<Eng::Geometry> Eng::Mesh::getActiveGeometry() const {
+   const auto lodGeometry = getLodGeometry(activeLod);
+   return lodGeometry ? lodGeometry : geometry;
+}
 
-    // Unbind VAO.
-    glBindVertexArray(0);
+/**
+ * @brief Sets the projected sizes at which meshes switch to coarser levels of detail.
+ *
+ * Entry i is the size below which level i+1 replaces level i; values are sorted
+ * in decreasing order. Levels beyond the last threshold are never used.
+ *
+ * @param thresholds Bounding sphere diameters over the viewport height.
+ */
+void Eng::Mesh::setLodThresholds(const std::vector<float> &thresholds) {
+   lodThresholds = thresholds;
+   std::sort(lodThresholds.begin(), lodThresholds.end(), std::greater<float>());
+}
 
-    buffersInitialized = true;
-    std::cout << "Mesh buffers initialized. VAO: " << vao << std::endl;
+/**
+ * @brief Retrieves the projected sizes at which meshes switch level of detail.
+ *
+ * @return std::vector<float> Thresholds, finest level first.
+ */
+std::vector<float> Eng::Mesh::getLodThresholds() {
+   return lodThresholds;
+}
+
+/**
+ * @brief Sets the margin a projected size must clear past a threshold to switch level.
+ *
+ * @param hysteresis Fraction of the threshold, clamped to [0, 0.9].
+ */
+void Eng::Mesh::setLodHysteresis(const float hysteresis) {
+   lodHysteresis = glm::clamp(hysteresis, 0.0f, 0.9f);
+}
+
+/**
+ * @brief Retrieves the level of detail hysteresis margin.
+ *
+ * @return float Fraction of each threshold.
+ */
+float Eng::Mesh::getLodHysteresis() {
+   return lodHysteresis;
+}
+
+/**
+ * @brief Uploads every level of detail of the mesh.
+ *
+ * With multi-draw submission active, levels it can draw are stored in the shared
+ * GeometryBuffer only; the others get buffers of their own. Levels already
+ * uploaded, e.g. by another mesh sharing them, are left as they are.
+ */
+void Eng::Mesh::initBuffers() {
+    auto& geometryBuffer = Eng::GeometryBuffer::getInstance();
+    const bool shared = Eng::Base::engIsEnabled(ENG_MULTIDRAW_RENDERING) && !Eng::Base::engIsEnabled(ENG_RENDER_NORMAL) &&
+        Eng::GeometryBuffer::isSupported() && material && material->supportsInstancing();
+    for (size_t l = 0; l < getLodCount(); l++) {
+        Eng::GeometryBuffer::Range range;
+        if (!shared || !geometryBuffer.acquire(getLodGeometry(l), range))
+            getLodGeometry(l)->initBuffers();
+    }
 }
 
 /**
@@ -158,15 +309,8 @@ void Eng::Mesh::render()
 
     material->render();
 
-    if (!buffersInitialized)
-        initBuffers();
-
-    glBindVertexArray(vao);
-    glDrawElements(GL_TRIANGLES,
-        static_cast<GLsizei>(indices.size()),
-        GL_UNSIGNED_INT,
-        nullptr);
-    glBindVertexArray(0);
+    if (const auto activeGeometry = getActiveGeometry())
+        activeGeometry->draw();
 
     // restore previous program if changed
     if (prevProgram && sm.getCurrentProgram() != prevProgram) {
@@ -177,15 +321,53 @@ void Eng::Mesh::render()
         renderNormals();
 }
 
+/**
+ * @brief Renders this mesh once per model matrix with a single instanced draw.
+ *
+ * Binds the material and lets the geometry stream the matrices into its
+ * per-instance buffer (see Geometry::drawInstanced()). The caller is expected
+ * to have loaded view-only matrices in the ShaderManager and enabled
+ * instancing with setUseInstancing().
+ *
+ * @param modelMatrices World matrices of the instances to draw.
+ */
+void Eng::Mesh::renderInstanced(const std::vector<glm::mat4>& modelMatrices)
+{
+    if (modelMatrices.empty())
+        return;
+
+    if (!material) {
+        std::cerr << "ERROR: Material is not set for the mesh: "
+            << getName() << " ID: " << getId() << std::endl;
+        return;
+    }
+
+    auto& sm = ShaderManager::getInstance();
+
+    //materials can have other programs, so save the current one
+    auto prevProgram = sm.getCurrentProgram();
+
+    material->render();
+
+    if (const auto activeGeometry = getActiveGeometry())
+        activeGeometry->drawInstanced(modelMatrices);
+
+    // restore previous program if changed
+    if (prevProgram && sm.getCurrentProgram() != prevProgram) {
+        sm.loadProgram(prevProgram);
+    }
+}
+
 /**
  * @brief Retrieves the vertices of the mesh.
  *
  * Provides access to the list of vertices that define the geometry of the mesh.
  *
- * @return std::vector<Eng::Vertex>& A reference to the vector of vertices.
+ * @return const std::vector<Eng::Vertex>& A reference to the vector of vertices (empty without geometry).
  */
-std::vector<Eng::Vertex> &Eng::Mesh::getVertices() {
-   return vertices;
+const std::vector<Eng::Vertex> &Eng::Mesh::getVertices() const {
+   static const std::vector<Eng::Vertex> empty;
+   return geometry ? geometry->getVertices() : empty;
 }
 
 /**
@@ -194,10 +376,11 @@ std::vector<Eng::Vertex> &Eng::Mesh::getVertices() {
  * The indices define how the vertices are connected to form triangles in the mesh.
  * These are essential for rendering the mesh efficiently.
  *
- * @return std::vector<unsigned int>& A reference to the vector of indices.
+ * @return const std::vector<unsigned int>& A reference to the vector of indices (empty without geometry).
  */
-std::vector<unsigned int> &Eng::Mesh::getIndices() {
-   return indices;
+const std::vector<unsigned int> &Eng::Mesh::getIndices() const {
+   static const std::vector<unsigned int> empty;
+   return geometry ? geometry->getIndices() : empty;
 }
 
 /**
@@ -211,7 +394,7 @@ void Eng::Mesh::renderNormals() const {
    glDisable(GL_LIGHTING);
    glColor3f(1.0f, 1.0f, 0.0f);
    glBegin(GL_LINES);
-   for (const auto& vertex : vertices) {
+   for (const auto& vertex : getVertices()) {
       glm::vec3 pos = vertex.getPosition();
       glm::vec3 normal = vertex.getNormal();
       glm::vec3 end = pos + normal * 0.5f;
@@ -286,4 +469,98 @@ glm::vec3 Eng::Mesh::getBoundingBoxMin() const {
  */
 glm::vec3 Eng::Mesh::getBoundingBoxMax() const {
     return boundingBoxMax;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Sets the convex collision hulls of this mesh.
+ *
+ * @param hulls Hulls in local space, possibly shared with other meshes.
+ */
+void Eng::Mesh::setCollisionHulls(const std::vector<std::shared_ptr<Eng::CollisionHull>> &hulls) {
+    collisionHulls = hulls;
+}
+
+/**
+ * @brief Gets the convex collision hulls of this mesh.
+ *
+ * @return Local-space hulls, empty when the mesh has none.
+ */
+const std::vector<std::shared_ptr<Eng::CollisionHull>> &Eng::Mesh::getCollisionHulls() const {
+    return collisionHulls;
+}
+
+/**
+ * @brief Checks whether a world-space point lies inside one of the collision hulls.
+ *
+ * @param point World-space point.
+ * @param tolerance World-space distance a point may lie outside and still count as inside.
+ * @return True if the point is inside a hull, false otherwise or without hulls.
+ */
+bool Eng::Mesh::containsPoint(const glm::vec3 &point, const float tolerance) const {
+    if (collisionHulls.empty())
+        return false;
+
+    const glm::vec3 local = glm::vec3(glm::inverse(getFinalMatrix()) * glm::vec4(point, 1.0f));
+    for (const auto &hull : collisionHulls)
+        if (hull->contains(local))
+            return true;
+    return tolerance > 0.0f && getDistance(point) <= tolerance;
+}
+
+/**
+ * @brief Intersects a world-space ray with the collision hulls.
+ *
+ * @param origin World-space ray origin.
+ * @param direction World-space ray direction, not necessarily normalized.
+ * @param distance Set to the nearest hit, in units of direction, if any.
+ * @return True if the ray hits a hull, false otherwise or without hulls.
+ */
+bool Eng::Mesh::intersectRay(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const {
+    if (collisionHulls.empty())
+        return false;
+
+    // The ray parameter is preserved by the affine transform to local space
+    const glm::mat4 inverse = glm::inverse(getFinalMatrix());
+    const glm::vec3 localOrigin = glm::vec3(inverse * glm::vec4(origin, 1.0f));
+    const glm::vec3 localDirection = glm::vec3(inverse * glm::vec4(direction, 0.0f));
+
+    bool hit = false;
+    for (const auto &hull : collisionHulls) {
+        float hullDistance;
+        if (hull->intersectRay(localOrigin, localDirection, hullDistance) && (!hit || hullDistance < distance)) {
+            distance = hullDistance;
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+/**
+ * @brief Gets the world-space distance from a point to the collision hulls.
+ *
+ * @param point World-space point.
+ * @return Distance to the nearest hull, 0 inside one, infinity without hulls.
+ */
+float Eng::Mesh::getDistance(const glm::vec3 &point) const {
+    const glm::mat4 matrix = getFinalMatrix();
+    float nearest = std::numeric_limits<float>::infinity();
+    for (const auto &hull : collisionHulls)
+        nearest = std::min(nearest, Eng::CollisionHull::distance(*hull, matrix, point));
+    return nearest;
+}
+
+/**
+ * @brief Gets the world-space distance between the collision hulls of two meshes.
+ *
+ * @param other Mesh to measure against.
+ * @return Distance between the nearest hulls, 0 if they overlap, infinity if either mesh has none.
+ */
+float Eng::Mesh::getDistance(const Mesh &other) const {
+    const glm::mat4 matrix = getFinalMatrix();
+    const glm::mat4 otherMatrix = other.getFinalMatrix();
+    float nearest = std::numeric_limits<float>::infinity();
+    for (const auto &hull : collisionHulls)
+        for (const auto &otherHull : other.collisionHulls)
+            nearest = std::min(nearest, Eng::CollisionHull::distance(*hull, matrix, *otherHull, otherMatrix));
+    return nearest;
+}
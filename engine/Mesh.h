@@ -2,7 +2,14 @@
 
 /**
  * @class Mesh
- * @brief Represents a 3D mesh with vertices, indices, and material data.
+ * @brief Represents a 3D mesh node referencing shared geometry and material data.
+ *
+ * Besides its full-detail geometry a mesh can hold lower levels of detail. The
+ * level is picked per view from the projected size of the bounding sphere
+ * (see selectLod()), and is the one drawn until the next selection.
+ *
+ * A mesh can also carry convex collision hulls, in its local space, for exact
+ * picking and collision queries placed by its final matrix.
  */
 class ENG_API Mesh : public Eng::Node {
 public:
@@ -12,14 +19,37 @@ public:
 
    void setVertices(const std::vector<Eng::Vertex> &vertices);
    void setIndices(const std::vector<unsigned int> &indices);
+   void setGeometryData(const std::vector<Eng::Vertex> &vertices, const std::vector<unsigned int> &indices);
+   void setGeometryData(std::vector<Eng::Vertex> &&vertices, std::vector<unsigned int> &&indices);
 
-   std::vector<Eng::Vertex> &getVertices();
-   std::vector<unsigned int> &getIndices();
+   const std::vector<Eng::Vertex> &getVertices() const;
+   const std::vector<unsigned int> &getIndices() const;
+
+   void setGeometry(const std::shared_ptr<Eng::Geometry> &geometry);
+   std::shared_ptr<Eng::Geometry> getGeometry() const;
 
    void setMaterial(const std::shared_ptr<Eng::Material> &material);
    std::shared_ptr<Eng::Material> getMaterial() const;
 
+   // Levels of detail
+   void addLod(const std::shared_ptr<Eng::Geometry> &lodGeometry);
+   size_t getLodCount() const;
+   std::shared_ptr<Eng::Geometry> getLodGeometry(size_t level) const;
+   void setLodGeometry(size_t level, const std::shared_ptr<Eng::Geometry> &lodGeometry);
+   size_t selectLod(float screenSize, unsigned int view);
+   size_t getActiveLod() const;
+   std::shared_ptr<Eng::Geometry> getActiveGeometry() const;
+
+   static void setLodThresholds(const std::vector<float> &thresholds);
+   static std::vector<float> getLodThresholds();
+   static void setLodHysteresis(float hysteresis);
+   static float getLodHysteresis();
+
+   ///> Views (eyes) keeping their own LOD selection
+   static constexpr unsigned int MAX_LOD_VIEWS = 2;
+
    void render() override;
+   void renderInstanced(const std::vector<glm::mat4>& modelMatrices);
 
    // method to initialize GPU buffers
    void initBuffers();
@@ -35,27 +65,32 @@ public:
    glm::vec3 getBoundingBoxMin() const;
    glm::vec3 getBoundingBoxMax() const;
 
+   // Collision
+   void setCollisionHulls(const std::vector<std::shared_ptr<Eng::CollisionHull>> &hulls);
+   const std::vector<std::shared_ptr<Eng::CollisionHull>> &getCollisionHulls() const;
+   bool containsPoint(const glm::vec3 &point, float tolerance = 0.0f) const;
+   bool intersectRay(const glm::vec3 &origin, const glm::vec3 &direction, float &distance) const;
+   float getDistance(const glm::vec3 &point) const;
+   float getDistance(const Mesh &other) const;
+
 private:
    void renderNormals() const;
-   ///> Vector of vertex positions.
-   std::vector<Eng::Vertex> vertices;
-   ///> Vector of indices defining the mesh faces.
-   std::vector<unsigned int> indices;
+   ///> Vertex and index data, possibly shared with other meshes.
+   std::shared_ptr<Eng::Geometry> geometry;
    ///> The material applied to the mesh.
    std::shared_ptr<Eng::Material> material;
-
-   // Hold GPU resource IDs
-   unsigned int vao = 0;
-   unsigned int posVBO = 0;
-   unsigned int normVBO = 0;
-   unsigned int texVBO = 0;
-   unsigned int ebo = 0;
-
-   bool buffersInitialized = false;
+   ///> Lower levels of detail, coarsest last (level 0 is geometry).
+   std::vector<std::shared_ptr<Eng::Geometry>> lods;
+   ///> Level selected for each view, and the one drawn by render().
+   std::array<size_t, MAX_LOD_VIEWS> viewLods{};
+   size_t activeLod = 0;
 
    // Virtual Environment
    glm::vec3 boundingSphereCenter = glm::vec3(0.0f);
    float boundingSphereRadius = 0.0f;
    glm::vec3 boundingBoxMin = glm::vec3(0.0f);
    glm::vec3 boundingBoxMax = glm::vec3(0.0f);
+
+   ///> Convex collision shapes, in local space, possibly shared with other meshes.
+   std::vector<std::shared_ptr<Eng::CollisionHull>> collisionHulls;
 };
@@ -0,0 +1,451 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+	// Forsyth's scoring constants ("Linear-Speed Vertex Cache Optimisation")
+	constexpr float CACHE_DECAY_POWER = 1.5f;
+	constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+	constexpr float VALENCE_BOOST_SCALE = 2.0f;
+	constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+	///> Marks a vertex outside the cache, or no triangle to continue from
+	constexpr size_t NONE = std::numeric_limits<size_t>::max();
+
+	/**
+	 * @brief Score of a vertex from its cache position and the triangles still using it.
+	 */
+	float vertexScore(const size_t cachePosition, const unsigned int remainingTriangles) {
+		if (remainingTriangles == 0)
+			return -1.0f;
+
+		float score = 0.0f;
+		if (cachePosition < 3)
+			score = LAST_TRIANGLE_SCORE;
+		else if (cachePosition != NONE) {
+			const float scaler = 1.0f / static_cast<float>(Eng::MeshOptimizer::CACHE_SIZE - 3);
+			score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+		}
+		// Favour vertices with few triangles left, so they are finished instead of left alone
+		return score + VALENCE_BOOST_SCALE * std::pow(static_cast<float>(remainingTriangles), -VALENCE_BOOST_POWER);
+	}
+
+	/**
+	 * @brief Simulates a FIFO cache and returns the misses of each triangle.
+	 */
+	std::vector<unsigned int> simulateFifo(const std::vector<unsigned int>& indices, const size_t vertexCount, const unsigned int cacheSize) {
+		// A vertex is cached while fewer than cacheSize misses happened since it was loaded
+		std::vector<size_t> loadedAt(vertexCount, NONE);
+		std::vector<unsigned int> misses(indices.size() / 3, 0);
+		size_t time = 0;
+
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			for (size_t k = 0; k < 3; k++) {
+				const unsigned int vertex = indices[i + k];
+				if (loadedAt[vertex] == NONE || time - loadedAt[vertex] >= cacheSize) {
+					loadedAt[vertex] = time++;
+					misses[i / 3]++;
+				}
+			}
+		}
+		return misses;
+	}
+
+	/**
+	 * @brief Checks that every index refers to an existing vertex.
+	 */
+	bool isValid(const std::vector<unsigned int>& indices, const size_t vertexCount) {
+		return indices.size() % 3 == 0 && std::all_of(indices.begin(), indices.end(), [vertexCount](const unsigned int index) {
+			return index < vertexCount;
+		});
+	}
+}
+
+/**
+ * @brief Sets how much worse than the whole mesh a cluster's ACMR may be for the overdraw pass to close it.
+ *
+ * Higher values give more, smaller clusters: better overdraw, more vertex cache misses.
+ * Values below 1 are ignored.
+ *
+ * @param threshold ACMR ratio, 1 or more.
+ */
+void Eng::MeshOptimizer::setOverdrawThreshold(const float threshold) {
+	if (threshold < 1.0f) {
+		std::cerr << "WARNING: [MeshOptimizer] Invalid overdraw threshold " << threshold << ", keeping " << overdrawThreshold << std::endl;
+		return;
+	}
+	overdrawThreshold = threshold;
+}
+
+/**
+ * @brief Gets the ACMR ratio at which the overdraw pass closes a cluster.
+ * @return float ACMR ratio.
+ */
+float Eng::MeshOptimizer::getOverdrawThreshold() const {
+	return overdrawThreshold;
+}
+
+/**
+ * @brief Optimizes every geometry of the meshes below the given root.
+ *
+ * Geometries shared by several meshes, or by several levels, are optimized once
+ * and the optimized copy replaces them everywhere. A geometry whose ACMR would not
+ * improve is kept as loaded; optimized copies go through Geometry::share(), so
+ * identical results stay shared.
+ *
+ * @param root Root of the scene graph.
+ * @return Stats Cache efficiency of each geometry before and after.
+ */
+Eng::MeshOptimizer::Stats Eng::MeshOptimizer::optimize(const std::shared_ptr<Eng::Node>& root) const {
+	Stats stats;
+	const auto start = std::chrono::steady_clock::now();
+
+	// Source geometry -> optimized one and its report; sources are kept alive so addresses stay unique
+	std::unordered_map<const Eng::Geometry*, std::pair<std::shared_ptr<Eng::Geometry>, size_t>> optimized;
+	std::vector<std::shared_ptr<Eng::Geometry>> sources;
+	size_t trianglesTotal = 0, verticesTotal = 0;
+	double missesBefore = 0.0, missesAfter = 0.0;
+
+	std::function<void(const std::shared_ptr<Eng::Node>&)> visit = [&](const std::shared_ptr<Eng::Node>& node) {
+		if (const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(node)) {
+			for (size_t level = 0; level < mesh->getLodCount(); level++) {
+				const auto geometry = mesh->getLodGeometry(level);
+				const auto found = optimized.find(geometry.get());
+				if (found != optimized.end()) {
+					mesh->setLodGeometry(level, found->second.first);
+					if (found->second.second != NONE)
+						stats.reports[found->second.second].meshes++;
+					continue;
+				}
+
+				std::vector<Eng::Vertex> vertices = geometry->getVertices();
+				std::vector<unsigned int> indices = geometry->getIndices();
+				if (indices.empty() || !isValid(indices, vertices.size())) {
+					optimized.emplace(geometry.get(), std::make_pair(geometry, NONE));
+					continue;
+				}
+
+				Report report;
+				report.name = mesh->getName();
+				report.level = level;
+				report.meshes = 1;
+				report.triangles = indices.size() / 3;
+				report.before = analyzeVertexCache(indices, vertices.size());
+
+				indices = optimizeVertexCache(indices, vertices.size());
+				indices = optimizeOverdraw(indices, vertices, overdrawThreshold);
+				optimizeVertexFetch(vertices, indices);
+				report.after = analyzeVertexCache(indices, vertices.size());
+
+				if (report.after.acmr < report.before.acmr) {
+					const size_t vertexCount = vertices.size();
+					const auto result = Eng::Geometry::share(std::make_shared<Eng::Geometry>(std::move(vertices), std::move(indices)));
+					mesh->setLodGeometry(level, result);
+					optimized.emplace(geometry.get(), std::make_pair(result, stats.reports.size()));
+					optimized.try_emplace(result.get(), std::make_pair(result, stats.reports.size()));
+					sources.push_back(geometry);
+					verticesTotal += vertexCount;
+				} else {
+					// The loaded order is as good already: the reordering would only cost a new upload
+					report.after = report.before;
+					report.replaced = false;
+					optimized.emplace(geometry.get(), std::make_pair(geometry, stats.reports.size()));
+					verticesTotal += geometry->getVertices().size();
+				}
+
+				trianglesTotal += report.triangles;
+				missesBefore += static_cast<double>(report.before.acmr) * static_cast<double>(report.triangles);
+				missesAfter += static_cast<double>(report.after.acmr) * static_cast<double>(report.triangles);
+				stats.reports.push_back(report);
+			}
+		}
+		for (const auto& child : *node->getChildren())
+			visit(child);
+	};
+	if (root)
+		visit(root);
+
+	if (trianglesTotal) {
+		stats.before.acmr = static_cast<float>(missesBefore / static_cast<double>(trianglesTotal));
+		stats.after.acmr = static_cast<float>(missesAfter / static_cast<double>(trianglesTotal));
+		stats.before.atvr = static_cast<float>(missesBefore / static_cast<double>(verticesTotal));
+		stats.after.atvr = static_cast<float>(missesAfter / static_cast<double>(verticesTotal));
+	}
+	stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return stats;
+}
+
+/**
+ * @brief Prints the outcome of an optimize() call, one line per geometry.
+ * @param stats Stats returned by optimize().
+ */
+void Eng::MeshOptimizer::printStats(const Stats& stats) {
+	std::cout << "[MeshOptimizer] " << stats.reports.size() << " geometries reordered in " << stats.milliseconds << " ms" << std::endl;
+	for (const auto& report : stats.reports) {
+		std::cout << "   " << report.name;
+		if (report.level)
+			std::cout << " (LOD " << report.level << ")";
+		if (report.meshes > 1)
+			std::cout << " x" << report.meshes;
+		std::cout << ": " << report.triangles << " triangles, ACMR " << report.before.acmr << " -> " << report.after.acmr
+			<< ", ATVR " << report.before.atvr << " -> " << report.after.atvr;
+		if (!report.replaced)
+			std::cout << " (kept as loaded)";
+		std::cout << std::endl;
+	}
+	std::cout << "   Total: ACMR " << stats.before.acmr << " -> " << stats.after.acmr
+		<< ", ATVR " << stats.before.atvr << " -> " << stats.after.atvr << std::endl;
+}
+
+/**
+ * @brief Measures the post-transform cache efficiency of an index buffer.
+ *
+ * @param indices     Triangle list.
+ * @param vertexCount Vertices the indices refer to.
+ * @param cacheSize   Entries of the simulated FIFO cache.
+ * @return CacheStats ACMR and ATVR, zero for an empty or invalid buffer.
+ */
+Eng::MeshOptimizer::CacheStats Eng::MeshOptimizer::analyzeVertexCache(const std::vector<unsigned int>& indices, const size_t vertexCount, const unsigned int cacheSize) {
+	CacheStats stats;
+	if (indices.empty() || cacheSize == 0 || !isValid(indices, vertexCount))
+		return stats;
+
+	size_t transformed = 0;
+	for (const unsigned int misses : simulateFifo(indices, vertexCount, cacheSize))
+		transformed += misses;
+
+	std::vector<bool> used(vertexCount, false);
+	size_t usedCount = 0;
+	for (const unsigned int index : indices) {
+		if (!used[index]) {
+			used[index] = true;
+			usedCount++;
+		}
+	}
+
+	stats.acmr = static_cast<float>(transformed) / static_cast<float>(indices.size() / 3);
+	stats.atvr = static_cast<float>(transformed) / static_cast<float>(usedCount);
+	return stats;
+}
+
+/**
+ * @brief Reorders triangles to reuse the post-transform vertex cache (Forsyth).
+ *
+ * Triangles are emitted greedily: the next one is the best scored among those
+ * touching the vertices in a simulated LRU cache of CACHE_SIZE entries.
+ *
+ * @param indices     Triangle list.
+ * @param vertexCount Vertices the indices refer to.
+ * @return std::vector<unsigned int> The same triangles in cache-friendly order (the input if invalid).
+ */
+std::vector<unsigned int> Eng::MeshOptimizer::optimizeVertexCache(const std::vector<unsigned int>& indices, const size_t vertexCount) {
+	if (!isValid(indices, vertexCount))
+		return indices;
+	const size_t triangleCount = indices.size() / 3;
+
+	// Triangles of each vertex; the first remaining[v] entries are the ones not emitted yet
+	std::vector<unsigned int> remaining(vertexCount, 0);
+	for (const unsigned int index : indices)
+		remaining[index]++;
+	std::vector<size_t> offsets(vertexCount + 1, 0);
+	for (size_t v = 0; v < vertexCount; v++)
+		offsets[v + 1] = offsets[v] + remaining[v];
+	std::vector<unsigned int> adjacency(indices.size());
+	{
+		std::vector<size_t> fill(offsets.begin(), offsets.end() - 1);
+		for (size_t i = 0; i < indices.size(); i++)
+			adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+	}
+
+	std::vector<size_t> cachePositions(vertexCount, NONE);
+	std::vector<float> vertexScores(vertexCount);
+	for (size_t v = 0; v < vertexCount; v++)
+		vertexScores[v] = vertexScore(NONE, remaining[v]);
+
+	std::vector<float> triangleScores(triangleCount);
+	size_t best = NONE;
+	for (size_t t = 0; t < triangleCount; t++) {
+		triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+		if (best == NONE || triangleScores[t] > triangleScores[best])
+			best = t;
+	}
+
+	std::vector<bool> emitted(triangleCount, false);
+	std::vector<unsigned int> cache, nextCache;
+	cache.reserve(CACHE_SIZE + 3);
+	nextCache.reserve(CACHE_SIZE + 3);
+	std::vector<unsigned int> result;
+	result.reserve(indices.size());
+	size_t cursor = 0;
+
+	for (size_t count = 0; count < triangleCount; count++) {
+		// Nothing in the cache to continue from: restart from the next triangle in input order
+		if (best == NONE) {
+			while (emitted[cursor])
+				cursor++;
+			best = cursor;
+		}
+
+		const unsigned int* corners = &indices[best * 3];
+		result.insert(result.end(), corners, corners + 3);
+		emitted[best] = true;
+
+		for (size_t k = 0; k < 3; k++) {
+			const unsigned int vertex = corners[k];
+			unsigned int* first = &adjacency[offsets[vertex]];
+			unsigned int* last = first + remaining[vertex];
+			unsigned int* found = std::find(first, last, static_cast<unsigned int>(best));
+			if (found != last) {
+				*found = *(last - 1);
+				remaining[vertex]--;
+			}
+		}
+
+		// Move the triangle's vertices to the front of the LRU cache
+		nextCache.clear();
+		for (size_t k = 0; k < 3; k++) {
+			if (std::find(nextCache.begin(), nextCache.end(), corners[k]) == nextCache.end())
+				nextCache.push_back(corners[k]);
+		}
+		for (const unsigned int vertex : cache) {
+			if (std::find(nextCache.begin(), nextCache.end(), vertex) == nextCache.end())
+				nextCache.push_back(vertex);
+		}
+
+		for (size_t i = 0; i < nextCache.size(); i++) {
+			const unsigned int vertex = nextCache[i];
+			cachePositions[vertex] = i < CACHE_SIZE ? i : NONE;
+			vertexScores[vertex] = vertexScore(cachePositions[vertex], remaining[vertex]);
+		}
+
+		// Rescore the triangles around the vertices that moved, evicted ones included
+		best = NONE;
+		for (const unsigned int vertex : nextCache) {
+			for (size_t a = offsets[vertex]; a < offsets[vertex] + remaining[vertex]; a++) {
+				const unsigned int t = adjacency[a];
+				triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+				if (best == NONE || triangleScores[t] > triangleScores[best])
+					best = t;
+			}
+		}
+
+		if (nextCache.size() > CACHE_SIZE)
+			nextCache.resize(CACHE_SIZE);
+		std::swap(cache, nextCache);
+	}
+	return result;
+}
+
+/**
+ * @brief Reorders clusters of triangles so that outer surfaces tend to be drawn first.
+ *
+ * The input order, expected cache-optimized, is split into clusters where the
+ * cache restarts: always where a triangle misses on all three vertices, and where
+ * it misses on two once the cluster's ACMR is within threshold times the mesh's.
+ * Clusters are then sorted by how far they face away from the mesh center.
+ *
+ * @param indices   Triangle list, in cache-friendly order.
+ * @param vertices  Vertices the indices refer to.
+ * @param threshold ACMR ratio allowing a soft split.
+ * @return std::vector<unsigned int> The same triangles, clusters reordered (the input if invalid).
+ */
+std::vector<unsigned int> Eng::MeshOptimizer::optimizeOverdraw(const std::vector<unsigned int>& indices, const std::vector<Eng::Vertex>& vertices, const float threshold) {
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount < 2 || !isValid(indices, vertices.size()))
+		return indices;
+
+	const auto misses = simulateFifo(indices, vertices.size(), ANALYSIS_CACHE_SIZE);
+	size_t totalMisses = 0;
+	for (const unsigned int triangleMisses : misses)
+		totalMisses += triangleMisses;
+	const float meshAcmr = static_cast<float>(totalMisses) / static_cast<float>(triangleCount);
+
+	std::vector<size_t> clusterStarts = { 0 };
+	size_t clusterMisses = misses[0];
+	for (size_t t = 1; t < triangleCount; t++) {
+		const size_t clusterSize = t - clusterStarts.back();
+		const float clusterAcmr = static_cast<float>(clusterMisses) / static_cast<float>(clusterSize);
+		if (misses[t] == 3 || (misses[t] == 2 && clusterAcmr <= meshAcmr * threshold)) {
+			clusterStarts.push_back(t);
+			clusterMisses = 0;
+		}
+		clusterMisses += misses[t];
+	}
+	if (clusterStarts.size() < 2)
+		return indices;
+	clusterStarts.push_back(triangleCount);
+
+	// Area-weighted centroid and normal of each cluster
+	const size_t clusterCount = clusterStarts.size() - 1;
+	std::vector<glm::vec3> centroids(clusterCount, glm::vec3(0.0f));
+	std::vector<glm::vec3> normals(clusterCount, glm::vec3(0.0f));
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+
+	for (size_t c = 0; c < clusterCount; c++) {
+		float clusterArea = 0.0f;
+		for (size_t t = clusterStarts[c]; t < clusterStarts[c + 1]; t++) {
+			const glm::vec3& a = vertices[indices[t * 3]].getPosition();
+			const glm::vec3& b = vertices[indices[t * 3 + 1]].getPosition();
+			const glm::vec3& d = vertices[indices[t * 3 + 2]].getPosition();
+			const glm::vec3 cross = glm::cross(b - a, d - a);
+			const float area = glm::length(cross) * 0.5f;
+			centroids[c] += (a + b + d) * (area / 3.0f);
+			normals[c] += cross;
+			clusterArea += area;
+		}
+		meshCentroid += centroids[c];
+		meshArea += clusterArea;
+		if (clusterArea > 0.0f)
+			centroids[c] /= clusterArea;
+	}
+	if (meshArea > 0.0f)
+		meshCentroid /= meshArea;
+
+	std::vector<float> keys(clusterCount, 0.0f);
+	for (size_t c = 0; c < clusterCount; c++) {
+		if (glm::dot(normals[c], normals[c]) > 0.0f)
+			keys[c] = glm::dot(centroids[c] - meshCentroid, glm::normalize(normals[c]));
+	}
+
+	std::vector<size_t> order(clusterCount);
+	for (size_t c = 0; c < clusterCount; c++)
+		order[c] = c;
+	std::stable_sort(order.begin(), order.end(), [&keys](const size_t a, const size_t b) { return keys[a] > keys[b]; });
+
+	std::vector<unsigned int> result;
+	result.reserve(indices.size());
+	for (const size_t c : order)
+		result.insert(result.end(), indices.begin() + clusterStarts[c] * 3, indices.begin() + clusterStarts[c + 1] * 3);
+	return result;
+}
+
+/**
+ * @brief Stores vertices in the order the indices first use them.
+ *
+ * Vertex fetches then walk the vertex buffer mostly forward; vertices no index
+ * refers to are dropped. Invalid index buffers are left untouched.
+ *
+ * @param vertices Vertices, reordered in place.
+ * @param indices  Triangle list, remapped in place.
+ */
+void Eng::MeshOptimizer::optimizeVertexFetch(std::vector<Eng::Vertex>& vertices, std::vector<unsigned int>& indices) {
+	if (!isValid(indices, vertices.size()))
+		return;
+
+	std::vector<unsigned int> remap(vertices.size(), std::numeric_limits<unsigned int>::max());
+	std::vector<Eng::Vertex> reordered;
+	reordered.reserve(vertices.size());
+	for (unsigned int& index : indices) {
+		if (remap[index] == std::numeric_limits<unsigned int>::max()) {
+			remap[index] = static_cast<unsigned int>(reordered.size());
+			reordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	vertices = std::move(reordered);
+}
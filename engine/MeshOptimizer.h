@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @class MeshOptimizer
+ * @brief Reorders the triangles and vertices of loaded geometries for the GPU.
+ *
+ * Meshes are drawn once per light pass, so the vertex shader cost is paid many
+ * times per frame and depends on how often the post-transform cache misses. Each
+ * geometry (every level of detail included) goes through three passes:
+ *  - vertex cache: triangles are reordered greedily by Forsyth's vertex scores;
+ *  - overdraw: the cache-friendly order is cut into clusters where the cache
+ *    restarts anyway, and clusters facing away from the mesh center are drawn
+ *    first so they occlude the rest;
+ *  - vertex fetch: vertices are stored in first-use order, dropping unused ones.
+ *
+ * Cache efficiency is reported as ACMR (vertices transformed per triangle) and
+ * ATVR (vertices transformed per vertex used), simulated on a FIFO cache. A
+ * geometry the passes would not improve is left as loaded.
+ */
+class ENG_API MeshOptimizer final {
+public:
+	/**
+	 * @brief Simulated post-transform cache efficiency of an index buffer.
+	 */
+	struct CacheStats {
+		float acmr = 0.0f;	///< Average cache miss ratio: transformed vertices per triangle
+		float atvr = 0.0f;	///< Average transformed vertex ratio: transformed vertices per vertex used
+	};
+
+	/**
+	 * @brief Outcome for one optimized geometry.
+	 */
+	struct Report {
+		std::string name;		///< Name of the first mesh using the geometry
+		size_t level = 0;		///< Level of detail of the geometry in that mesh
+		size_t meshes = 0;		///< Meshes sharing the geometry
+		size_t triangles = 0;	///< Triangles of the geometry
+		CacheStats before;		///< Efficiency of the loaded order
+		CacheStats after;		///< Efficiency of the optimized order
+		bool replaced = true;	///< Whether the optimized copy replaced the geometry, false when it would not improve ACMR
+	};
+
+	/**
+	 * @brief Outcome of an optimize() call.
+	 */
+	struct Stats {
+		std::vector<Report> reports;	///< One entry per unique geometry
+		CacheStats before;				///< Efficiency over all geometries, before
+		CacheStats after;				///< Efficiency over all geometries, after
+		double milliseconds = 0.0;		///< Wall-clock time
+	};
+
+	///> Cache size assumed by the vertex cache pass
+	static constexpr unsigned int CACHE_SIZE = 32;
+	///> FIFO cache size used to measure ACMR and ATVR
+	static constexpr unsigned int ANALYSIS_CACHE_SIZE = 16;
+	///> ACMR increase, relative to the whole mesh, accepted to split an overdraw cluster
+	static constexpr float DEFAULT_OVERDRAW_THRESHOLD = 1.05f;
+
+	void setOverdrawThreshold(float threshold);
+	float getOverdrawThreshold() const;
+
+	Stats optimize(const std::shared_ptr<Eng::Node>& root) const;
+	static void printStats(const Stats& stats);
+
+	static CacheStats analyzeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount, unsigned int cacheSize = ANALYSIS_CACHE_SIZE);
+	static std::vector<unsigned int> optimizeVertexCache(const std::vector<unsigned int>& indices, size_t vertexCount);
+	static std::vector<unsigned int> optimizeOverdraw(const std::vector<unsigned int>& indices, const std::vector<Eng::Vertex>& vertices, float threshold);
+	static void optimizeVertexFetch(std::vector<Eng::Vertex>& vertices, std::vector<unsigned int>& indices);
+
+private:
+	///> ACMR increase accepted to split an overdraw cluster
+	float overdrawThreshold = DEFAULT_OVERDRAW_THRESHOLD;
+};
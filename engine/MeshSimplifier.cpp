@@ -0,0 +1,555 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <queue>
+#include <thread>
+#include <tuple>
+
+namespace {
+	///> Weight of the attribute change of a collapse, against the normalized geometric error
+	constexpr double ATTRIBUTE_WEIGHT = 0.001;
+	///> Weight of the planes holding open borders in place
+	constexpr double BORDER_WEIGHT = 10.0;
+	///> Smallest cosine between a triangle normal before and after a collapse
+	constexpr double MIN_NORMAL_COSINE = 0.2;
+	///> A level must have at most this fraction of the previous level's triangles
+	constexpr float MIN_LOD_REDUCTION = 0.9f;
+
+	/**
+	 * @brief Symmetric 4x4 quadric measuring the squared distance to a set of planes.
+	 */
+	struct Quadric {
+		double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+		double b2 = 0.0, bc = 0.0, bd = 0.0;
+		double c2 = 0.0, cd = 0.0;
+		double d2 = 0.0;
+
+		/**
+		 * @brief Builds the quadric of the plane n.p + d = 0.
+		 */
+		static Quadric fromPlane(const glm::dvec3& n, const double d, const double weight) {
+			Quadric q;
+			q.a2 = n.x * n.x * weight; q.ab = n.x * n.y * weight; q.ac = n.x * n.z * weight; q.ad = n.x * d * weight;
+			q.b2 = n.y * n.y * weight; q.bc = n.y * n.z * weight; q.bd = n.y * d * weight;
+			q.c2 = n.z * n.z * weight; q.cd = n.z * d * weight;
+			q.d2 = d * d * weight;
+			return q;
+		}
+
+		void add(const Quadric& q) {
+			a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+			b2 += q.b2; bc += q.bc; bd += q.bd;
+			c2 += q.c2; cd += q.cd;
+			d2 += q.d2;
+		}
+
+		double evaluate(const glm::dvec3& p) const {
+			return a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z + 2.0 * ad * p.x
+				+ b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y
+				+ c2 * p.z * p.z + 2.0 * cd * p.z
+				+ d2;
+		}
+	};
+
+	/**
+	 * @brief Squared difference of the normal and texture coordinates of two vertices.
+	 */
+	double attributeDistance(const Eng::Vertex& a, const Eng::Vertex& b) {
+		const glm::vec3 normal = a.getNormal() - b.getNormal();
+		const glm::vec2 texCoords = a.getTexCoords() - b.getTexCoords();
+		return glm::dot(normal, normal) + glm::dot(texCoords, texCoords);
+	}
+
+	/**
+	 * @brief Edge collapse state of one simplification.
+	 *
+	 * Vertices ("wedges") sharing a position are simplified together: a collapse
+	 * moves a position onto a neighbouring one and remaps each of its wedges to
+	 * the closest wedge there.
+	 */
+	class Collapser {
+	public:
+		Collapser(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices);
+
+		float run(size_t targetTriangles, float maxError);
+		void output(std::vector<Eng::Vertex>& outVertices, std::vector<unsigned int>& outIndices) const;
+
+	private:
+		/**
+		 * @brief Collapse of position 'from' onto position 'to', valid while both versions hold.
+		 */
+		struct Candidate {
+			double cost;
+			unsigned int from;
+			unsigned int to;
+			unsigned int fromVersion;
+			unsigned int toVersion;
+
+			bool operator>(const Candidate& other) const { return cost > other.cost; }
+		};
+
+		void push(unsigned int from, unsigned int to);
+		void pushEdges(unsigned int position);
+		double cost(unsigned int from, unsigned int to) const;
+		unsigned int closestWedge(unsigned int wedge, unsigned int position) const;
+		bool flips(unsigned int from, unsigned int to) const;
+		void collapse(unsigned int from, unsigned int to);
+
+		const std::vector<Eng::Vertex>& vertices;
+
+		// Per position
+		std::vector<glm::dvec3> positions;
+		std::vector<std::vector<unsigned int>> positionWedges;
+		std::vector<std::vector<unsigned int>> positionTriangles;
+		std::vector<Quadric> quadrics;
+		std::vector<unsigned int> versions;
+		std::vector<bool> positionAlive;
+
+		// Per wedge (input vertex)
+		std::vector<unsigned int> wedgePosition;
+
+		// Per triangle
+		std::vector<std::array<unsigned int, 3>> triangles;
+		std::vector<bool> triangleAlive;
+		size_t aliveTriangles = 0;
+
+		std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+	};
+
+	/**
+	 * @brief Welds positions, accumulates the quadrics and queues every edge.
+	 */
+	Collapser::Collapser(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices) : vertices(vertices) {
+		// Normalize to the bounding sphere so errors do not depend on the mesh size
+		glm::vec3 boxMin(std::numeric_limits<float>::max());
+		glm::vec3 boxMax(std::numeric_limits<float>::lowest());
+		for (const auto& vertex : vertices) {
+			boxMin = glm::min(boxMin, vertex.getPosition());
+			boxMax = glm::max(boxMax, vertex.getPosition());
+		}
+		const glm::dvec3 center = glm::dvec3(boxMin + boxMax) * 0.5;
+		double radius = 0.0;
+		for (const auto& vertex : vertices)
+			radius = std::max(radius, glm::length(glm::dvec3(vertex.getPosition()) - center));
+		const double scale = radius > 0.0 ? 1.0 / radius : 1.0;
+
+		std::map<std::tuple<float, float, float>, unsigned int> positionIds;
+		wedgePosition.resize(vertices.size());
+		for (size_t w = 0; w < vertices.size(); w++) {
+			const glm::vec3& p = vertices[w].getPosition();
+			const auto [it, inserted] = positionIds.try_emplace(std::make_tuple(p.x, p.y, p.z), static_cast<unsigned int>(positions.size()));
+			if (inserted) {
+				positions.push_back((glm::dvec3(p) - center) * scale);
+				positionWedges.emplace_back();
+			}
+			wedgePosition[w] = it->second;
+			positionWedges[it->second].push_back(static_cast<unsigned int>(w));
+		}
+
+		positionTriangles.resize(positions.size());
+		quadrics.resize(positions.size());
+		versions.resize(positions.size(), 0);
+		positionAlive.resize(positions.size(), true);
+
+		// Face planes, weighted by area; edges used once are open borders
+		std::map<std::pair<unsigned int, unsigned int>, std::pair<unsigned int, glm::dvec3>> edges;
+		for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+			if (indices[i] >= vertices.size() || indices[i + 1] >= vertices.size() || indices[i + 2] >= vertices.size())
+				continue;
+			const std::array<unsigned int, 3> corners = { indices[i], indices[i + 1], indices[i + 2] };
+			const unsigned int p[3] = { wedgePosition[corners[0]], wedgePosition[corners[1]], wedgePosition[corners[2]] };
+			if (p[0] == p[1] || p[1] == p[2] || p[0] == p[2])
+				continue;
+
+			const glm::dvec3 cross = glm::cross(positions[p[1]] - positions[p[0]], positions[p[2]] - positions[p[0]]);
+			const double doubleArea = glm::length(cross);
+			if (doubleArea <= 0.0)
+				continue;
+			const glm::dvec3 normal = cross / doubleArea;
+
+			const auto plane = Quadric::fromPlane(normal, -glm::dot(normal, positions[p[0]]), doubleArea * 0.5);
+			const auto t = static_cast<unsigned int>(triangles.size());
+			for (int k = 0; k < 3; k++) {
+				quadrics[p[k]].add(plane);
+				positionTriangles[p[k]].push_back(t);
+
+				const auto key = std::minmax(p[k], p[(k + 1) % 3]);
+				auto& edge = edges[{ key.first, key.second }];
+				edge.first++;
+				edge.second = normal;
+			}
+			triangles.push_back(corners);
+		}
+		triangleAlive.resize(triangles.size(), true);
+		aliveTriangles = triangles.size();
+
+		for (const auto& [key, edge] : edges) {
+			if (edge.first != 1)
+				continue;
+			const glm::dvec3 direction = positions[key.second] - positions[key.first];
+			const glm::dvec3 cross = glm::cross(direction, edge.second);
+			if (glm::dot(cross, cross) <= 0.0)
+				continue;
+			const glm::dvec3 normal = glm::normalize(cross);
+			const auto plane = Quadric::fromPlane(normal, -glm::dot(normal, positions[key.first]), BORDER_WEIGHT * glm::dot(direction, direction));
+			quadrics[key.first].add(plane);
+			quadrics[key.second].add(plane);
+		}
+
+		for (const auto& [key, edge] : edges) {
+			push(key.first, key.second);
+			push(key.second, key.first);
+		}
+	}
+
+	/**
+	 * @brief Collapses the cheapest edges until the target or the error limit is reached.
+	 * @return float Largest error of the collapses applied.
+	 */
+	float Collapser::run(const size_t targetTriangles, const float maxError) {
+		double largestError = 0.0;
+		while (aliveTriangles > targetTriangles && !queue.empty()) {
+			const Candidate candidate = queue.top();
+			queue.pop();
+
+			if (!positionAlive[candidate.from] || !positionAlive[candidate.to] ||
+				versions[candidate.from] != candidate.fromVersion || versions[candidate.to] != candidate.toVersion)
+				continue;
+			if (candidate.cost > maxError)
+				break;
+			if (flips(candidate.from, candidate.to))
+				continue;
+
+			collapse(candidate.from, candidate.to);
+			largestError = std::max(largestError, candidate.cost);
+		}
+		return static_cast<float>(largestError);
+	}
+
+	/**
+	 * @brief Writes the remaining triangles, keeping only the vertices they use.
+	 */
+	void Collapser::output(std::vector<Eng::Vertex>& outVertices, std::vector<unsigned int>& outIndices) const {
+		outVertices.clear();
+		outIndices.clear();
+		outIndices.reserve(aliveTriangles * 3);
+
+		std::vector<unsigned int> remap(vertices.size(), std::numeric_limits<unsigned int>::max());
+		for (size_t t = 0; t < triangles.size(); t++) {
+			if (!triangleAlive[t])
+				continue;
+			for (const unsigned int wedge : triangles[t]) {
+				if (remap[wedge] == std::numeric_limits<unsigned int>::max()) {
+					remap[wedge] = static_cast<unsigned int>(outVertices.size());
+					outVertices.push_back(vertices[wedge]);
+				}
+				outIndices.push_back(remap[wedge]);
+			}
+		}
+	}
+
+	void Collapser::push(const unsigned int from, const unsigned int to) {
+		queue.push({ cost(from, to), from, to, versions[from], versions[to] });
+	}
+
+	/**
+	 * @brief Queues both directions of every edge around a position.
+	 */
+	void Collapser::pushEdges(const unsigned int position) {
+		for (const unsigned int t : positionTriangles[position]) {
+			for (const unsigned int wedge : triangles[t]) {
+				const unsigned int other = wedgePosition[wedge];
+				if (other == position)
+					continue;
+				push(position, other);
+				push(other, position);
+			}
+		}
+	}
+
+	/**
+	 * @brief Error of moving 'from' onto 'to': quadric distance plus attribute change.
+	 */
+	double Collapser::cost(const unsigned int from, const unsigned int to) const {
+		Quadric quadric = quadrics[from];
+		quadric.add(quadrics[to]);
+		double error = std::max(0.0, quadric.evaluate(positions[to]));
+
+		for (const unsigned int wedge : positionWedges[from])
+			error += ATTRIBUTE_WEIGHT * attributeDistance(vertices[wedge], vertices[closestWedge(wedge, to)]);
+		return error;
+	}
+
+	/**
+	 * @brief Finds the wedge of a position whose attributes best match the given wedge.
+	 */
+	unsigned int Collapser::closestWedge(const unsigned int wedge, const unsigned int position) const {
+		unsigned int best = positionWedges[position].front();
+		double bestDistance = std::numeric_limits<double>::max();
+		for (const unsigned int candidate : positionWedges[position]) {
+			const double distance = attributeDistance(vertices[wedge], vertices[candidate]);
+			if (distance < bestDistance) {
+				bestDistance = distance;
+				best = candidate;
+			}
+		}
+		return best;
+	}
+
+	/**
+	 * @brief Checks whether moving 'from' onto 'to' would fold or degenerate a surviving triangle.
+	 */
+	bool Collapser::flips(const unsigned int from, const unsigned int to) const {
+		for (const unsigned int t : positionTriangles[from]) {
+			if (!triangleAlive[t])
+				continue;
+
+			glm::dvec3 before[3], after[3];
+			bool shared = false;
+			for (int k = 0; k < 3; k++) {
+				const unsigned int position = wedgePosition[triangles[t][k]];
+				shared |= position == to;
+				before[k] = positions[position];
+				after[k] = positions[position == from ? to : position];
+			}
+			// Triangles on the collapsed edge disappear
+			if (shared)
+				continue;
+
+			const glm::dvec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+			const glm::dvec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+			const double lengths = glm::length(normalBefore) * glm::length(normalAfter);
+			if (lengths <= 0.0 || glm::dot(normalBefore, normalAfter) < MIN_NORMAL_COSINE * lengths)
+				return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Moves 'from' onto 'to', removing the triangles that become degenerate.
+	 */
+	void Collapser::collapse(const unsigned int from, const unsigned int to) {
+		std::vector<std::pair<unsigned int, unsigned int>> wedgeRemap;
+		for (const unsigned int wedge : positionWedges[from])
+			wedgeRemap.emplace_back(wedge, closestWedge(wedge, to));
+
+		for (const unsigned int t : positionTriangles[from]) {
+			if (!triangleAlive[t])
+				continue;
+
+			auto& corners = triangles[t];
+			for (auto& corner : corners) {
+				for (const auto& [oldWedge, newWedge] : wedgeRemap) {
+					if (corner == oldWedge) {
+						corner = newWedge;
+						break;
+					}
+				}
+			}
+
+			const unsigned int p0 = wedgePosition[corners[0]], p1 = wedgePosition[corners[1]], p2 = wedgePosition[corners[2]];
+			if (p0 == p1 || p1 == p2 || p0 == p2) {
+				triangleAlive[t] = false;
+				aliveTriangles--;
+			}
+			else {
+				positionTriangles[to].push_back(t);
+			}
+		}
+
+		quadrics[to].add(quadrics[from]);
+		positionAlive[from] = false;
+		positionTriangles[from].clear();
+		versions[to]++;
+
+		auto& around = positionTriangles[to];
+		std::sort(around.begin(), around.end());
+		around.erase(std::unique(around.begin(), around.end()), around.end());
+		around.erase(std::remove_if(around.begin(), around.end(), [this](const unsigned int t) { return !triangleAlive[t]; }), around.end());
+
+		pushEdges(to);
+	}
+}
+
+/**
+ * @brief Sets the levels of detail to generate.
+ *
+ * Each setting gives the fraction of triangles to keep and the error at which
+ * simplification stops earlier; entries are expected finest first.
+ *
+ * @param settings One entry per generated level.
+ */
+void Eng::MeshSimplifier::setLodSettings(const std::vector<LodSetting>& settings) {
+	lodSettings = settings;
+}
+
+/**
+ * @brief Gets the levels of detail to generate.
+ * @return const std::vector<LodSetting>& One entry per generated level, finest first.
+ */
+const std::vector<Eng::MeshSimplifier::LodSetting>& Eng::MeshSimplifier::getLodSettings() const {
+	return lodSettings;
+}
+
+/**
+ * @brief Sets how many threads generateLods() uses.
+ * @param count Worker threads, 0 for one per hardware thread.
+ */
+void Eng::MeshSimplifier::setThreadCount(const unsigned int count) {
+	threadCount = count;
+}
+
+/**
+ * @brief Gets how many threads generateLods() uses.
+ * @return unsigned int Worker threads, 0 for one per hardware thread.
+ */
+unsigned int Eng::MeshSimplifier::getThreadCount() const {
+	return threadCount;
+}
+
+/**
+ * @brief Adds generated levels of detail to the meshes of a scene graph.
+ *
+ * Only meshes with a single level and at least MIN_TRIANGLES triangles are
+ * simplified. Geometries shared by several meshes are simplified once and the
+ * resulting levels are shared as well.
+ *
+ * @param root Root of the scene graph.
+ * @return Stats What was generated.
+ */
+Eng::MeshSimplifier::Stats Eng::MeshSimplifier::generateLods(const std::shared_ptr<Eng::Node>& root) const {
+	Stats stats;
+	const auto start = std::chrono::steady_clock::now();
+
+	// Unique source geometries and the meshes using them
+	std::vector<std::shared_ptr<Eng::Geometry>> sources;
+	std::vector<std::vector<std::shared_ptr<Eng::Mesh>>> owners;
+	std::unordered_map<const Eng::Geometry*, size_t> sourceIndex;
+
+	std::function<void(const std::shared_ptr<Eng::Node>&)> collect = [&](const std::shared_ptr<Eng::Node>& node) {
+		const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(node);
+		if (mesh && mesh->getLodCount() == 1 && mesh->getIndices().size() / 3 >= MIN_TRIANGLES) {
+			const auto geometry = mesh->getGeometry();
+			const auto [it, inserted] = sourceIndex.try_emplace(geometry.get(), sources.size());
+			if (inserted) {
+				sources.push_back(geometry);
+				owners.emplace_back();
+			}
+			owners[it->second].push_back(mesh);
+		}
+		for (const auto& child : *node->getChildren())
+			collect(child);
+	};
+	if (root)
+		collect(root);
+
+	// Geometries are independent: workers pick the next one until none is left
+	std::vector<std::vector<std::shared_ptr<Eng::Geometry>>> results(sources.size());
+	std::atomic<size_t> next{ 0 };
+	auto worker = [&]() {
+		for (size_t i = next++; i < sources.size(); i = next++)
+			results[i] = buildLods(*sources[i]);
+	};
+
+	const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+	const size_t workers = std::min<size_t>(threadCount ? threadCount : hardwareThreads, sources.size());
+	std::vector<std::thread> threads;
+	for (size_t t = 1; t < workers; t++)
+		threads.emplace_back(worker);
+	worker();
+	for (auto& thread : threads)
+		thread.join();
+
+	for (size_t i = 0; i < sources.size(); i++) {
+		if (results[i].empty())
+			continue;
+
+		stats.geometries++;
+		stats.lods += results[i].size();
+		if (stats.triangles.size() < results[i].size() + 1)
+			stats.triangles.resize(results[i].size() + 1, 0);
+		stats.triangles[0] += sources[i]->getIndices().size() / 3;
+		for (size_t level = 0; level < results[i].size(); level++)
+			stats.triangles[level + 1] += results[i][level]->getIndices().size() / 3;
+
+		for (const auto& mesh : owners[i]) {
+			for (const auto& lod : results[i])
+				mesh->addLod(lod);
+			stats.meshes++;
+		}
+	}
+
+	stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return stats;
+}
+
+/**
+ * @brief Prints the outcome of a generateLods() call.
+ * @param stats Stats returned by generateLods().
+ */
+void Eng::MeshSimplifier::printStats(const Stats& stats) {
+	std::cout << "[MeshSimplifier] " << stats.lods << " levels generated for " << stats.geometries
+		<< " geometries (" << stats.meshes << " meshes) in " << stats.milliseconds << " ms" << std::endl;
+	if (stats.triangles.empty())
+		return;
+	std::cout << "   Triangles:";
+	for (size_t level = 0; level < stats.triangles.size(); level++)
+		std::cout << " [" << level << "] " << stats.triangles[level];
+	std::cout << std::endl;
+}
+
+/**
+ * @brief Simplifies a triangle mesh by quadric error edge collapses.
+ *
+ * Stops once the mesh has at most targetTriangles triangles, or when the next
+ * collapse would exceed maxError. The output vertices are a subset of the input.
+ *
+ * @param vertices        Input vertices.
+ * @param indices         Input triangles.
+ * @param targetTriangles Triangles to reach.
+ * @param maxError        Largest collapse error, relative to the squared bounding radius.
+ * @param outVertices     Receives the remaining vertices.
+ * @param outIndices      Receives the remaining triangles.
+ * @return float Largest error of the collapses applied.
+ */
+float Eng::MeshSimplifier::simplify(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices,
+	const size_t targetTriangles, const float maxError, std::vector<Eng::Vertex>& outVertices, std::vector<unsigned int>& outIndices) {
+	Collapser collapser(vertices, indices);
+	const float error = collapser.run(targetTriangles, maxError);
+	collapser.output(outVertices, outIndices);
+	return error;
+}
+
+/**
+ * @brief Simplifies one geometry into the configured levels of detail.
+ *
+ * Each level is simplified from the full-detail geometry, so its error is measured
+ * against the original surface. Levels that do not remove enough triangles end
+ * the chain.
+ *
+ * @param geometry Full-detail geometry.
+ * @return std::vector<std::shared_ptr<Eng::Geometry>> Generated levels, finest first.
+ */
+std::vector<std::shared_ptr<Eng::Geometry>> Eng::MeshSimplifier::buildLods(const Eng::Geometry& geometry) const {
+	std::vector<std::shared_ptr<Eng::Geometry>> lods;
+	const size_t fullTriangles = geometry.getIndices().size() / 3;
+	size_t previousTriangles = fullTriangles;
+
+	std::vector<Eng::Vertex> lodVertices;
+	std::vector<unsigned int> lodIndices;
+	for (const auto& setting : lodSettings) {
+		const auto target = static_cast<size_t>(static_cast<float>(fullTriangles) * setting.triangleRatio);
+		simplify(geometry.getVertices(), geometry.getIndices(), target, setting.maxError, lodVertices, lodIndices);
+
+		const size_t triangles = lodIndices.size() / 3;
+		if (triangles == 0 || static_cast<float>(triangles) > static_cast<float>(previousTriangles) * MIN_LOD_REDUCTION)
+			break;
+		lods.push_back(Eng::Geometry::create(lodVertices, lodIndices));
+		previousTriangles = triangles;
+	}
+	return lods;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * @class MeshSimplifier
+ * @brief Generates lower levels of detail for meshes that only have their full-detail geometry.
+ *
+ * Simplification collapses edges in order of quadric error (Garland-Heckbert), with
+ * extra quadrics holding open borders in place. Collapses are half-edge collapses,
+ * so every remaining vertex keeps its original attributes; vertices split on normal
+ * or texture seams are matched by closest attributes, and the attribute change adds
+ * to the collapse cost. Errors are measured relative to the squared bounding radius,
+ * so the same thresholds suit meshes of any size.
+ *
+ * generateLods() simplifies each unique geometry of a scene graph once, spreading the
+ * geometries across worker threads, and adds the resulting levels to every mesh using it.
+ */
+class ENG_API MeshSimplifier final {
+public:
+	/**
+	 * @brief Target of one generated level of detail.
+	 */
+	struct LodSetting {
+		float triangleRatio;	///< Triangles to keep, as a fraction of the full-detail mesh
+		float maxError;			///< Largest collapse error allowed, relative to the squared bounding radius
+	};
+
+	/**
+	 * @brief Outcome of a generateLods() call.
+	 */
+	struct Stats {
+		size_t meshes = 0;				///< Meshes that received generated levels
+		size_t geometries = 0;			///< Unique geometries simplified
+		size_t lods = 0;				///< Levels created, per unique geometry
+		std::vector<size_t> triangles;	///< Triangles at each level, summed over the unique geometries
+		double milliseconds = 0.0;		///< Wall-clock time
+	};
+
+	///> Meshes with fewer triangles are not worth simplifying
+	static constexpr size_t MIN_TRIANGLES = 64;
+
+	void setLodSettings(const std::vector<LodSetting>& settings);
+	const std::vector<LodSetting>& getLodSettings() const;
+
+	void setThreadCount(unsigned int count);
+	unsigned int getThreadCount() const;
+
+	Stats generateLods(const std::shared_ptr<Eng::Node>& root) const;
+	static void printStats(const Stats& stats);
+
+	static float simplify(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices,
+		size_t targetTriangles, float maxError, std::vector<Eng::Vertex>& outVertices, std::vector<unsigned int>& outIndices);
+
+private:
+	std::vector<std::shared_ptr<Eng::Geometry>> buildLods(const Eng::Geometry& geometry) const;
+
+	///> Generated levels, finest first
+	std::vector<LodSetting> lodSettings = { { 0.5f, 0.0005f }, { 0.25f, 0.002f }, { 0.1f, 0.01f } };
+	///> Worker threads, 0 for one per hardware thread
+	unsigned int threadCount = 0;
+};
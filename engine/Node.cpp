@@ -78,6 +78,26 @@ const glm::mat4 &Eng::Node::getLocalMatrix() const {
    return localMatrix;
 }
 
+/**
+ * @brief Marks the node as moved at runtime.
+ *
+ * Dynamic nodes and their subtrees are never merged by the StaticBatcher.
+ *
+ * @param isDynamic True if the client will move the node.
+ */
+void ENG_API Eng::Node::setDynamic(const bool isDynamic) {
+   dynamic = isDynamic;
+}
+
+/**
+ * @brief Checks whether the node is moved at runtime.
+ *
+ * @return true if the node is excluded from static batching.
+ */
+bool Eng::Node::isDynamic() const {
+   return dynamic;
+}
+
 /**
  * @brief Retrieves the list of children for the current node.
  *
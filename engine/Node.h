@@ -21,6 +21,9 @@ public:
 
    glm::mat4 getFinalMatrix() const;
 
+   void setDynamic(bool isDynamic);
+   bool isDynamic() const;
+
    virtual void render() override {}
 
 protected:
@@ -30,4 +33,6 @@ protected:
    std::vector<std::shared_ptr<Node> > children;
    ///> local matrix
    glm::mat4 localMatrix;
+   ///> moved at runtime, excluded from static batching together with its subtree
+   bool dynamic = false;
 };
@@ -3,7 +3,12 @@
 //
 
 #include "Engine.h"
-#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
 
 
 class ENG_API OvObject final {
@@ -34,14 +39,22 @@ public:
 
 /**
  * @brief Parses an OVO file and constructs the scene graph.
+ *
+ * The file is mapped rather than read, and each chunk is parsed in place through
+ * a ChunkView bounded by the chunk size. With the scene cache enabled, an up to
+ * date cooked copy is restored instead, and a missing or stale one is rewritten.
+ * With a streamer set, the graph is returned before mesh payloads and textures
+ * are loaded; the cooked copy is then written once streaming completes.
+ *
  * @param filename The path to the OVO file to be parsed.
- * @return A shared pointer to the root node of the constructed scene graph.
+ * @return A shared pointer to the root node of the constructed scene graph, nullptr on error.
  */
 std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filename) {
    using namespace std;
 
-   FILE *dat = fopen(filename.c_str(), "rb");
-   if (dat == nullptr) {
+   const auto start = chrono::steady_clock::now();
+   const auto file = std::make_shared<MappedFile>();
+   if (!file->open(filename)) {
       cout << "ERROR: unable to open file '" << filename << "'" << endl;
       return nullptr;
    }
@@ -53,41 +66,52 @@ std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filen
       basePath = "./";
    }
 
+   // Cooked copy of the same bytes, if any:
+   const std::string cacheFile = SceneCache::getCachePath(filename);
+   const uint64_t sourceHash = sceneCache ? SceneCache::hashSource(file->getData(), file->getSize()) : 0;
+   const SceneCache::ImportSettings importSettings = { vertexWelding, weldEpsilon };
+   if (sceneCache) {
+      if (auto cached = SceneCache::load(cacheFile, sourceHash, importSettings, textureStreamer)) {
+         root = cached;
+         const auto loadTime = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+         cout << "\nScene restored from cache in " << loadTime << " ms" << endl;
+         return root;
+      }
+   }
+
    // Configure stream:
    cout.precision(2);
    cout << fixed;
 
    /////////////////
    // Parse chuncks:
-   unsigned int chunkId, chunkSize;
-   while (true) {
-      fread(&chunkId, sizeof(unsigned int), 1, dat);
-      if (feof(dat))
-         break;
-      fread(&chunkSize, sizeof(unsigned int), 1, dat);
-
-      cout << "\n[chunk id: " << chunkId << ", chunk size: " << chunkSize << ", chunk type: ";
-
-      // Load whole chunk into memory:
-      char *data = new char[chunkSize];
-      if (fread(data, sizeof(char), chunkSize, dat) != chunkSize) {
+   // Headers are read serially; mesh payloads are only located here and decoded afterwards.
+   std::vector<PendingNode> pending;
+   std::vector<MeshPayload> meshPayloads;
+   ChunkView fileView(file->getData(), file->getSize());
+   while (fileView.getRemaining() > 0) {
+      const auto chunkId = fileView.read<unsigned int>();
+      const auto chunkSize = fileView.read<unsigned int>();
+
+      // The whole chunk must lie within the file:
+      ChunkView chunk = fileView.subView(chunkSize);
+      if (!fileView.isValid()) {
          cout << "ERROR: unable to read from file '" << filename << "'" << endl;
-         fclose(dat);
-         delete[] data;
          return nullptr;
       }
 
-      // Parse chunk information according to its type:
-      unsigned int position = 0;
+      cout << "\n[chunk id: " << chunkId << ", chunk size: " << chunkSize << ", chunk type: ";
 
+      // Parse chunk information according to its type:
       shared_ptr<Node> node = nullptr;
       unsigned int children = 0;
+      bool isMesh = false;
 
       switch (static_cast<OvObject::Type>(chunkId)) {
          ///////////////////////////////
          case OvObject::Type::OBJECT: //
          {
-            analyzeObject(position, data);
+            analyzeObject(chunk);
          }
          break;
 
@@ -95,7 +119,7 @@ std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filen
          /////////////////////////////
          case OvObject::Type::NODE: //
          {
-            node = analyzeNode(position, data, children);
+            node = analyzeNode(chunk, children);
          }
          break;
 
@@ -103,7 +127,7 @@ std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filen
          /////////////////////////////////
          case OvObject::Type::MATERIAL: //
          {
-            parseMaterial(position, data);
+            parseMaterial(chunk);
          }
          break;
 
@@ -111,7 +135,8 @@ std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filen
          ////////////////////////////////
          case OvObject::Type::MESH: //
          case OvObject::Type::SKINNED: {
-            node = parseMesh(position, chunkId, data, children);
+            meshPayloads.emplace_back();
+            isMesh = parseMesh(chunk, chunkId, children, meshPayloads.back());
          }
          break;
 
@@ -119,7 +144,7 @@ std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filen
          //////////////////////////////
          case OvObject::Type::LIGHT: //
          {
-            node = parseLight(position, data);
+            node = parseLight(chunk);
          }
          break;
 
@@ -127,7 +152,7 @@ std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filen
          /////////////////////////////
          case OvObject::Type::BONE: //
          {
-            parseBone(position, data);
+            parseBone(chunk);
          }
          break;
 
@@ -136,21 +161,92 @@ std::shared_ptr<Eng::Node> Eng::OvoReader::parseOvoFile(const std::string &filen
          default: //
             cout << "UNKNOWN]" << endl;
             cout << "ERROR: corrupted or bad data in file " << filename << endl;
-            fclose(dat);
-            delete[] data;
             return nullptr;
       }
 
-      if (node != nullptr) {
-         manageSceneGraph(node, children);
+      // A field ran past the end of its chunk:
+      if (!chunk.isValid()) {
+         cout << "ERROR: corrupted or bad data in file " << filename << endl;
+         return nullptr;
+      }
+
+      if (isMesh) {
+         pending.push_back({ nullptr, meshPayloads.size() - 1, children });
+      } else if (node != nullptr) {
+         pending.push_back({ node, 0, children });
+      }
+   }
+   const auto indexEnd = chrono::steady_clock::now();
+
+   if (streamer) {
+      // Graph first: meshes get their bounds now and their geometry once streamed
+      const auto welding = make_shared<VertexWelder::Stats>();
+      for (auto &entry : pending) {
+         shared_ptr<Node> node = entry.node;
+         if (!node) {
+            const auto mesh = buildMesh(meshPayloads[entry.mesh]);
+            streamMesh(mesh, std::move(meshPayloads[entry.mesh]), file, welding);
+            node = mesh;
+         }
+         manageSceneGraph(node, entry.children);
+      }
+
+      // Textures were only named while parsing materials; shared ones are streamed once
+      size_t textures = 0;
+      unordered_set<const Texture *> queued;
+      // (unless a TextureStreamer already has them)
+      for (const auto &[name, material] : materials) {
+         const auto texture = material->getDiffuseTexture();
+         if (textureStreamer || !texture || texture->isLoaded() || !queued.insert(texture.get()).second)
+            continue;
+         const string texturePath = texture->getFilePath();
+         streamer->enqueue([texture, texturePath]() -> SceneStreamer::Upload {
+            auto image = make_shared<Texture::Image>();
+            if (!Texture::decodeFile(texturePath, *image))
+               return nullptr;
+            return [texture, image]() { texture->upload(*image); };
+         });
+         textures++;
       }
-      // Release chunk memory:
-      delete[] data;
+
+      cout << "\nFile indexed in " << chrono::duration<double, milli>(indexEnd - start).count() << " ms ("
+           << meshPayloads.size() << " meshes and " << textures << " textures streaming)" << endl;
+      if (vertexWelding && !meshPayloads.empty())
+         streamer->whenComplete([welding]() { VertexWelder::printStats(*welding); });
+
+      // Cooked once complete, before anything registered later changes the graph
+      if (sceneCache && root) {
+         const auto scene = root;
+         streamer->whenComplete([cacheFile, scene, sourceHash, importSettings]() { SceneCache::save(cacheFile, scene, sourceHash, importSettings); });
+      }
+      return root;
    }
 
-   fclose(dat);
-   cout << "\nFile parsed" << endl;
+   // Decode mesh payloads in parallel, then stitch the graph in file order:
+   if (!decodeMeshes(meshPayloads)) {
+      cout << "ERROR: corrupted or bad data in file " << filename << endl;
+      return nullptr;
+   }
+   const auto decodeEnd = chrono::steady_clock::now();
+   for (auto &entry : pending) {
+      shared_ptr<Node> node = entry.node ? entry.node : buildMesh(meshPayloads[entry.mesh]);
+      manageSceneGraph(node, entry.children);
+   }
+
+   const auto parseTime = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+   cout << "\nFile parsed in " << parseTime << " ms (" << file->getSize() / (1024.0 * 1024.0) << " MB "
+        << (file->isMapped() ? "mapped" : "read") << ", chunks "
+        << chrono::duration<double, milli>(indexEnd - start).count() << " ms, mesh decoding "
+        << chrono::duration<double, milli>(decodeEnd - indexEnd).count() << " ms)" << endl;
+   if (vertexWelding && !meshPayloads.empty()) {
+      VertexWelder::Stats welding;
+      for (const auto &payload : meshPayloads)
+         welding += payload.welding;
+      VertexWelder::printStats(welding);
+   }
 
+   if (sceneCache && root)
+      SceneCache::save(cacheFile, root, sourceHash, importSettings);
    return root;
 }
 
@@ -184,149 +280,112 @@ void ENG_API Eng::OvoReader::manageSceneGraph(std::shared_ptr<Node>& node, const
 
 /**
  * @brief Parses bone data from the OVO file.
- * @param position Current position in the data buffer.
- * @param data Pointer to the data buffer containing bone information.
+ * @param chunk View over the chunk containing bone information.
  */
-void ENG_API Eng::OvoReader::parseBone(unsigned int &position, const char *data) {
+void ENG_API Eng::OvoReader::parseBone(ChunkView &chunk) {
    using namespace std;
    cout << "bone]" << endl;
 
    // Bone name:
-   char boneName[FILENAME_MAX];
-   strcpy(boneName, data + position);
+   const string_view boneName = chunk.readString();
    cout << "   Name  . . . . :  " << boneName << endl;
-   position += (unsigned int) strlen(boneName) + 1;
 
    // Bone matrix:
-   glm::mat4 matrix;
-   memcpy(&matrix, data + position, sizeof(glm::mat4));
-   position += sizeof(glm::mat4);
+   chunk.skip(1, sizeof(glm::mat4));
 
    // Nr. of children nodes:
-   unsigned int children;
-   memcpy(&children, data + position, sizeof(unsigned int));
+   const auto children = chunk.read<unsigned int>();
    cout << "   Nr. children  :  " << children << endl;
-   position += sizeof(unsigned int);
 
    // Optional target node, or [none] if not used:
-   char targetName[FILENAME_MAX];
-   strcpy(targetName, data + position);
+   const string_view targetName = chunk.readString();
    cout << "   Target node . :  " << targetName << endl;
-   position += static_cast<unsigned int>(strlen(targetName)) + 1;
 
    // Mesh bounding box minimum corner:
-   glm::vec3 bBoxMin;
-   memcpy(&bBoxMin, data + position, sizeof(glm::vec3));
+   const auto bBoxMin = chunk.read<glm::vec3>();
    cout << "   BBox minimum  :  " << bBoxMin.x << ", " << bBoxMin.y << ", " << bBoxMin.z << endl;
-   position += sizeof(glm::vec3);
 
    // Mesh bounding box maximum corner:
-   glm::vec3 bBoxMax;
-   memcpy(&bBoxMax, data + position, sizeof(glm::vec3));
+   const auto bBoxMax = chunk.read<glm::vec3>();
    cout << "   BBox maximum  :  " << bBoxMax.x << ", " << bBoxMax.y << ", " << bBoxMax.z << endl;
-   position += sizeof(glm::vec3);
 }
 
 /**
  * @brief Parses light data from the OVO file.
- * @param position Current position in the data buffer.
- * @param data Pointer to the data buffer containing light information.
+ * @param chunk View over the chunk containing light information.
  * @return Shared pointer to the created light node.
  */
-std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseLight(unsigned int &position, const char *data) {
+std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseLight(ChunkView &chunk) {
    using namespace std;
    cout << "light]" << endl;
 
    // Light name:
-   char lightName[FILENAME_MAX];
-   strcpy(lightName, data + position);
+   const string_view lightName = chunk.readString();
    cout << "   Name  . . . . :  " << lightName << endl;
-   position += static_cast<unsigned int>(strlen(lightName)) + 1;
 
    // Light matrix:
-   glm::mat4 matrix;
-   memcpy(&matrix, data + position, sizeof(glm::mat4));
+   const auto matrix = chunk.read<glm::mat4>();
 
    cout << "MATRIX: " << glm::to_string(matrix) << endl;
 
-   position += sizeof(glm::mat4);
-
    // Nr. of children nodes:
-   unsigned int children;
-   memcpy(&children, data + position, sizeof(unsigned int));
+   const auto children = chunk.read<unsigned int>();
    cout << "   Nr. children  :  " << children << endl;
-   position += sizeof(unsigned int);
 
    // Optional target node name, or [none] if not used:
-   char targetName[FILENAME_MAX];
-   strcpy(targetName, data + position);
+   const string_view targetName = chunk.readString();
    cout << "   Target node . :  " << targetName << endl;
-   position += static_cast<unsigned int>(strlen(targetName)) + 1;
 
    // Light subtype (see OvLight SUBTYPE enum):
-   unsigned char subtype;
-   memcpy(&subtype, data + position, sizeof(unsigned char));
-   char subtypeName[FILENAME_MAX];
+   const auto subtype = chunk.read<unsigned char>();
+   const char *subtypeName;
    switch (static_cast<OvLight::Subtype>(subtype)) {
-      case OvLight::Subtype::DIRECTIONAL: strcpy(subtypeName, "directional");
+      case OvLight::Subtype::DIRECTIONAL: subtypeName = "directional";
          break;
-      case OvLight::Subtype::OMNI: strcpy(subtypeName, "omni");
+      case OvLight::Subtype::OMNI: subtypeName = "omni";
          break;
-      case OvLight::Subtype::SPOT: strcpy(subtypeName, "spot");
+      case OvLight::Subtype::SPOT: subtypeName = "spot";
          break;
-      default: strcpy(subtypeName, "UNDEFINED");
+      default: subtypeName = "UNDEFINED";
    }
    cout << "   Subtype . . . :  " << static_cast<int>(subtype) << " (" << subtypeName << ")" << endl;
-   position += sizeof(unsigned char);
 
    // Light color:
-   glm::vec3 color;
-   memcpy(&color, data + position, sizeof(glm::vec3));
+   const auto color = chunk.read<glm::vec3>();
    cout << "   Color . . . . :  " << color.r << ", " << color.g << ", " << color.b << endl;
-   position += sizeof(glm::vec3);
 
    // Influence radius:
-   float radius;
-   memcpy(&radius, data + position, sizeof(float));
+   const auto radius = chunk.read<float>();
    cout << "   Radius  . . . :  " << radius << endl;
-   position += sizeof(float);
 
    // Direction:
-   glm::vec3 direction;
-   memcpy(&direction, data + position, sizeof(glm::vec3));
+   const auto direction = chunk.read<glm::vec3>();
    cout << "   Direction . . :  " << direction.r << ", " << direction.g << ", " << direction.b << endl;
-   position += sizeof(glm::vec3);
 
    // Cutoff:
-   float cutoff;
-   memcpy(&cutoff, data + position, sizeof(float));
+   const auto cutoff = chunk.read<float>();
    cout << "   Cutoff  . . . :  " << cutoff << endl;
-   position += sizeof(float);
 
    // Exponent:
-   float spotExponent;
-   memcpy(&spotExponent, data + position, sizeof(float));
+   const auto spotExponent = chunk.read<float>();
    cout << "   Spot exponent :  " << spotExponent << endl;
-   position += sizeof(float);
 
    // Cast shadow flag:
-   unsigned char castShadows;
-   memcpy(&castShadows, data + position, sizeof(unsigned char));
+   const auto castShadows = chunk.read<unsigned char>();
    cout << "   Cast shadows  :  " << static_cast<int>(castShadows) << endl;
-   position += sizeof(unsigned char);
 
    // Volumetric lighting flag:
-   unsigned char isVolumetric;
-   memcpy(&isVolumetric, data + position, sizeof(unsigned char));
+   const auto isVolumetric = chunk.read<unsigned char>();
    cout << "   Volumetric  . :  " << static_cast<int>(isVolumetric) << endl;
-   position += sizeof(unsigned char);
 
+   if (!chunk.isValid())
+      return nullptr;
 
    std::shared_ptr<Eng::Node> light;
    switch (static_cast<OvLight::Subtype>(subtype)) {
       case OvLight::Subtype::DIRECTIONAL: {
          auto dirLight = std::make_shared<Eng::DirectionalLight>(color, direction);
-         dirLight->setName(lightName);
+         dirLight->setName(std::string(lightName));
          dirLight->setLocalMatrix(matrix);
 
          light = std::static_pointer_cast<Eng::Node>(dirLight);
@@ -334,7 +393,7 @@ std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseLight(unsigned int &posi
       }
       case OvLight::Subtype::OMNI: {
          auto pointLight = std::make_shared<Eng::PointLight>(color, radius);
-         pointLight->setName(lightName);
+         pointLight->setName(std::string(lightName));
          pointLight->setLocalMatrix(matrix);
          light = std::static_pointer_cast<Eng::Node>(pointLight);
          break;
@@ -342,7 +401,7 @@ std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseLight(unsigned int &posi
       case OvLight::Subtype::SPOT: {
          auto spotLight = std::make_shared<Eng::SpotLight>(
             color, direction, cutoff, spotExponent, radius);
-         spotLight->setName(lightName);
+         spotLight->setName(std::string(lightName));
          spotLight->setLocalMatrix(matrix);
          light = std::static_pointer_cast<Eng::Node>(spotLight);
          break;
@@ -354,223 +413,178 @@ std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseLight(unsigned int &posi
 
 /**
   * @brief Analyzes object header information from the OVO file.
-  * @param position Current position in the data buffer.
-  * @param data Pointer to the data buffer containing object information.
+  * @param chunk View over the chunk containing object information.
   */
-void ENG_API Eng::OvoReader::analyzeObject(unsigned int &position, char *data) {
+void ENG_API Eng::OvoReader::analyzeObject(ChunkView &chunk) {
    using namespace std;
    cout << "version]" << endl;
 
    // OVO revision number:
-   unsigned int versionId;
-   memcpy(&versionId, data + position, sizeof(unsigned int));
+   const auto versionId = chunk.read<unsigned int>();
    cout << "   Version . . . :  " << versionId << endl;
-   position += sizeof(unsigned int);
 }
 
 /**
      * @brief Analyzes node data from the OVO file.
-     * @param position Current position in the data buffer.
-     * @param data Pointer to the data buffer containing node information.
+     * @param chunk View over the chunk containing node information.
      * @param children Reference to store the number of child nodes.
      * @return Shared pointer to the created node.
      */
-std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::analyzeNode(unsigned int &position, const char *data,
-                                                               unsigned int &children) {
+std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::analyzeNode(ChunkView &chunk, unsigned int &children) {
    using namespace std;
    cout << "node]" << endl;
 
    const auto newNode = std::make_shared<Node>();
 
    // Node name:
-   char nodeName[FILENAME_MAX];
-   strcpy(nodeName, data + position);
+   const string_view nodeName = chunk.readString();
    cout << "   Name  . . . . :  " << nodeName << endl;
-   position += static_cast<unsigned int>(strlen(nodeName)) + 1;
 
-   newNode->setName(nodeName);
+   newNode->setName(std::string(nodeName));
 
    // Node matrix:
-   glm::mat4 matrix;
-   memcpy(&matrix, data + position, sizeof(glm::mat4));
-   position += sizeof(glm::mat4);
-
-   newNode->setLocalMatrix(matrix);
+   newNode->setLocalMatrix(chunk.read<glm::mat4>());
 
-   memcpy(&children, data + position, sizeof(unsigned int));
+   children = chunk.read<unsigned int>();
    cout << "   Nr. children :  " << children << endl;
-   position += sizeof(unsigned int);
 
    // Optional target node, [none] if not used:
-   char targetName[FILENAME_MAX];
-   strcpy(targetName, data + position);
+   const string_view targetName = chunk.readString();
    cout << "   Target node . :  " << targetName << endl;
-   position += static_cast<unsigned int>(strlen(targetName)) + 1;
 
-   return newNode;
+   return chunk.isValid() ? newNode : nullptr;
 }
 
 /**
  * @brief Parses material data from the OVO file.
- * @param position Current position in the data buffer.
- * @param data Pointer to the data buffer containing material information.
+ * @param chunk View over the chunk containing material information.
  */
 
-void ENG_API Eng::OvoReader::parseMaterial(unsigned int &position, const char *data) {
+void ENG_API Eng::OvoReader::parseMaterial(ChunkView &chunk) {
    using namespace std;
    cout << "material]" << endl;
 
    // Material name:
-   char materialName[FILENAME_MAX];
-   strcpy(materialName, data + position);
+   const string_view materialName = chunk.readString();
    cout << "   Name  . . . . :  " << materialName << endl;
-   position += static_cast<unsigned int>(strlen(materialName)) + 1;
 
    // Material term colors, starting with emissive:
-   glm::vec3 emission, albedo;
-   memcpy(&emission, data + position, sizeof(glm::vec3));
+   const auto emission = chunk.read<glm::vec3>();
    cout << "   Emission  . . :  " << emission.r << ", " << emission.g << ", " << emission.b << endl;
-   position += sizeof(glm::vec3);
 
    // Albedo:
-   memcpy(&albedo, data + position, sizeof(glm::vec3));
+   const auto albedo = chunk.read<glm::vec3>();
    cout << "   Albedo  . . . :  " << albedo.r << ", " << albedo.g << ", " << albedo.b << endl;
-   position += sizeof(glm::vec3);
 
    // Roughness factor:
-   float roughness;
-   memcpy(&roughness, data + position, sizeof(float));
+   const auto roughness = chunk.read<float>();
    cout << "   Roughness . . :  " << roughness << endl;
-   position += sizeof(float);
 
    // Metalness factor:
-   float metalness;
-   memcpy(&metalness, data + position, sizeof(float));
+   const auto metalness = chunk.read<float>();
    cout << "   Metalness . . :  " << metalness << endl;
-   position += sizeof(float);
 
    // Transparency factor:
-   float alpha;
-   memcpy(&alpha, data + position, sizeof(float));
+   const auto alpha = chunk.read<float>();
    cout << "   Transparency  :  " << alpha << endl;
-   position += sizeof(float);
 
    // Albedo texture filename, or [none] if not used:
-   char textureName[FILENAME_MAX];
-   strcpy(textureName, data + position);
+   const string_view textureName = chunk.readString();
    cout << "   Albedo tex. . :  " << textureName << endl;
-   position += static_cast<unsigned int>(strlen(textureName)) + 1;
-
-   // add material
-   const auto material = std::make_shared<Eng::Material>(albedo, alpha, roughness, emission);
-
-   if (strcmp(textureName, "[none]") != 0) {
-      std::string texturePath = basePath + std::string(textureName);
-      const auto texture = std::make_shared<Eng::Texture>(texturePath);
-      material->setDiffuseTexture(texture);
-   }
-   materials[materialName] = material;
-
 
    // Normal map filename, or [none] if not used:
-   char normalMapName[FILENAME_MAX];
-   std::strcpy(normalMapName, data + position);
+   const string_view normalMapName = chunk.readString();
    cout << "   Normalmap tex.:  " << normalMapName << endl;
-   position += static_cast<unsigned int>(strlen(normalMapName)) + 1;
 
    // Height map filename, or [none] if not used:
-   char heightMapName[FILENAME_MAX];
-   strcpy(heightMapName, data + position);
+   const string_view heightMapName = chunk.readString();
    cout << "   Heightmap tex.:  " << heightMapName << endl;
-   position += static_cast<unsigned int>(strlen(heightMapName)) + 1;
 
    // Roughness map filename, or [none] if not used:
-   char roughnessMapName[FILENAME_MAX];
-   strcpy(roughnessMapName, data + position);
+   const string_view roughnessMapName = chunk.readString();
    cout << "   Roughness tex.:  " << roughnessMapName << endl;
-   position += static_cast<unsigned int>(strlen(roughnessMapName)) + 1;
 
    // Metalness map filename, or [none] if not used:
-   char metalnessMapName[FILENAME_MAX];
-   strcpy(metalnessMapName, data + position);
+   const string_view metalnessMapName = chunk.readString();
    cout << "   Metalness tex.:  " << metalnessMapName << endl;
-   position += static_cast<unsigned int>(strlen(metalnessMapName)) + 1;
+
+   if (!chunk.isValid())
+      return;
+
+   // add material
+   const auto material = std::make_shared<Eng::Material>(albedo, alpha, roughness, emission);
+
+   if (textureName != "[none]") {
+      std::string texturePath = basePath + std::string(textureName);
+      // Shared with every material naming the same file; when streaming, the file is read later on a streaming thread
+      const auto texture = Eng::TextureManager::getInstance().load(texturePath, streamer == nullptr && textureStreamer == nullptr);
+      if (textureStreamer)
+         textureStreamer->enqueue(texture);
+      material->setDiffuseTexture(texture);
+   }
+   materials[std::string(materialName)] = material;
 }
 
 /**
   * @brief Parses mesh data from the OVO file.
-  * @param position Current position in the data buffer.
+  *
+  * Only the headers are read here: vertex and face blocks are bounds-checked and
+  * recorded in the payload, to be decoded by decodeMeshes().
+  *
+  * @param chunk View over the chunk containing mesh information.
   * @param chunkId ID of the chunk being parsed.
-  * @param data Pointer to the data buffer containing mesh information.
   * @param children Reference to store the number of child nodes.
-  * @return Shared pointer to the created mesh node.
+  * @param payload Receives the mesh properties and the location of its data.
+  * @return true if the chunk holds a whole mesh.
   */
-std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseMesh(
-    unsigned int& position, unsigned int chunkId, char* data, unsigned int& children)
+bool ENG_API Eng::OvoReader::parseMesh(
+    ChunkView& chunk, unsigned int chunkId, unsigned int& children, MeshPayload& payload)
 {
     using namespace std;
 
     // Parse mesh name.
-    char meshName[FILENAME_MAX];
-    strcpy(meshName, data + position);
-    position += static_cast<unsigned int>(strlen(meshName)) + 1;
+    const string_view meshName = chunk.readString();
     cout << "   Name  . . . . :  " << meshName << endl;
 
     // Parse transformation matrix.
-    glm::mat4 matrix;
-    memcpy(&matrix, data + position, sizeof(glm::mat4));
-    position += sizeof(glm::mat4);
+    const auto matrix = chunk.read<glm::mat4>();
     cout << "MATRIX: " << glm::to_string(matrix) << endl;
 
     // Parse number of children.
-    memcpy(&children, data + position, sizeof(unsigned int));
+    children = chunk.read<unsigned int>();
     cout << "   Nr. children:  " << children << endl;
-    position += sizeof(unsigned int);
 
     // Parse target node.
-    char targetName[FILENAME_MAX];
-    strcpy(targetName, data + position);
+    const string_view targetName = chunk.readString();
     cout << "   Target node . :  " << targetName << endl;
-    position += static_cast<unsigned int>(strlen(targetName)) + 1;
 
     // Parse mesh subtype.
-    unsigned char subtype;
-    memcpy(&subtype, data + position, sizeof(unsigned char));
-    position += sizeof(unsigned char);
-    char subtypeName[FILENAME_MAX];
+    const auto subtype = chunk.read<unsigned char>();
+    const char* subtypeName;
     switch (static_cast<OvMesh::Subtype>(subtype)) {
-    case OvMesh::Subtype::DEFAULT: strcpy(subtypeName, "standard"); break;
-    case OvMesh::Subtype::NORMALMAPPED: strcpy(subtypeName, "normal-mapped"); break;
-    case OvMesh::Subtype::TESSELLATED: strcpy(subtypeName, "tessellated"); break;
-    default: strcpy(subtypeName, "UNDEFINED");
+    case OvMesh::Subtype::DEFAULT: subtypeName = "standard"; break;
+    case OvMesh::Subtype::NORMALMAPPED: subtypeName = "normal-mapped"; break;
+    case OvMesh::Subtype::TESSELLATED: subtypeName = "tessellated"; break;
+    default: subtypeName = "UNDEFINED";
     }
     cout << "   Subtype . . . :  " << (int)subtype << " (" << subtypeName << ")" << endl;
 
     // Parse material name.
-    char materialName[FILENAME_MAX];
-    strcpy(materialName, data + position);
+    const string_view materialName = chunk.readString();
     cout << "   Material  . . :  " << materialName << endl;
-    position += static_cast<unsigned int>(strlen(materialName)) + 1;
 
     // Parse bounding sphere radius.
-    float radius;
-    memcpy(&radius, data + position, sizeof(float));
+    const auto radius = chunk.read<float>();
     cout << "   Radius  . . . :  " << radius << endl;
-    position += sizeof(float);
 
     // Parse bounding box.
-    glm::vec3 bBoxMin, bBoxMax;
-    memcpy(&bBoxMin, data + position, sizeof(glm::vec3));
-    position += sizeof(glm::vec3);
+    const auto bBoxMin = chunk.read<glm::vec3>();
     cout << "   BBox minimum  :  " << bBoxMin.x << ", " << bBoxMin.y << ", " << bBoxMin.z << endl;
-    memcpy(&bBoxMax, data + position, sizeof(glm::vec3));
-    position += sizeof(glm::vec3);
+    const auto bBoxMax = chunk.read<glm::vec3>();
     cout << "   BBox maximum  :  " << bBoxMax.x << ", " << bBoxMax.y << ", " << bBoxMax.z << endl;
 
     // Parse physics properties if present.
-    unsigned char hasPhysics;
-    memcpy(&hasPhysics, data + position, sizeof(unsigned char));
-    position += sizeof(unsigned char);
+    const auto hasPhysics = chunk.read<unsigned char>();
     cout << "   Physics . . . :  " << (int)hasPhysics << endl;
     if (hasPhysics) {
         struct PhysProps {
@@ -589,9 +603,8 @@ std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseMesh(
             unsigned int _pad;
             void* physObj;
             void* hull;
-        } mp;
-        memcpy(&mp, data + position, sizeof(PhysProps));
-        position += sizeof(PhysProps);
+        };
+        const auto mp = chunk.read<PhysProps>();
         cout << "      Type . . . :  " << (int)mp.type << endl;
         cout << "      Hull type  :  " << (int)mp.hullType << endl;
         cout << "      Cont. coll.:  " << (int)mp.contCollisionDetection << endl;
@@ -604,168 +617,372 @@ std::shared_ptr<Eng::Node> ENG_API Eng::OvoReader::parseMesh(
         cout << "      Linear . . :  " << mp.linearDamping << endl;
         cout << "      Angular  . :  " << mp.angularDamping << endl;
         cout << "      Nr. hulls  :  " << mp.nrOfHulls << endl;
-        if (mp.nrOfHulls) {
-            for (unsigned int c = 0; c < mp.nrOfHulls; c++) {
-                unsigned int nrOfVertices;
-                memcpy(&nrOfVertices, data + position, sizeof(unsigned int));
-                position += sizeof(unsigned int);
-                unsigned int nrOfFaces;
-                memcpy(&nrOfFaces, data + position, sizeof(unsigned int));
-                position += sizeof(unsigned int);
-                glm::vec3 centroid;
-                memcpy(&centroid, data + position, sizeof(glm::vec3));
-                position += sizeof(glm::vec3);
-                for (unsigned int v = 0; v < nrOfVertices; v++) {
-                    glm::vec3 vertex;
-                    memcpy(&vertex, data + position, sizeof(glm::vec3));
-                    position += sizeof(glm::vec3);
-                }
-                for (unsigned int f = 0; f < nrOfFaces; f++) {
-                    unsigned int face[3];
-                    memcpy(face, data + position, sizeof(unsigned int) * 3);
-                    position += sizeof(unsigned int) * 3;
-                }
-            }
+        for (unsigned int c = 0; c < mp.nrOfHulls && chunk.isValid(); c++) {
+            const auto nrOfVertices = chunk.read<unsigned int>();
+            const auto nrOfFaces = chunk.read<unsigned int>();
+            // Centroid, recomputed by the hull
+            chunk.skip(1, sizeof(glm::vec3));
+            const char *vertexData = chunk.take(nrOfVertices, sizeof(glm::vec3));
+            const char *faceData = chunk.take(nrOfFaces, sizeof(unsigned int) * 3);
+            if (!chunk.isValid())
+                break;
+
+            // Kept as collision data: vertices and outward face planes
+            std::vector<glm::vec3> hullVertices(nrOfVertices);
+            std::vector<unsigned int> hullFaces(static_cast<size_t>(nrOfFaces) * 3);
+            if (!hullVertices.empty())
+                std::memcpy(hullVertices.data(), vertexData, hullVertices.size() * sizeof(glm::vec3));
+            if (!hullFaces.empty())
+                std::memcpy(hullFaces.data(), faceData, hullFaces.size() * sizeof(unsigned int));
+            if (const auto hull = Eng::CollisionHull::create(hullVertices, hullFaces))
+                payload.hulls.push_back(hull);
         }
+        cout << "      Hull planes:  ";
+        for (const auto &hull : payload.hulls)
+            cout << hull->getPlanes().size() << " ";
+        cout << endl;
     }
 
     // Parse LOD count.
-    unsigned int LODs;
-    memcpy(&LODs, data + position, sizeof(unsigned int));
-    position += sizeof(unsigned int);
+    const auto LODs = chunk.read<unsigned int>();
     cout << "   Nr. of LODs   :  " << LODs << endl;
+    if (!chunk.isValid())
+        return false;
 
-    vector<unsigned int> verticesPerLOD(LODs);
-    std::vector<Eng::Vertex> finalVerts;
-    std::vector<unsigned int> finalIndices;
+    // Vertices and faces of each level of detail, full detail first; counts are
+    // checked against the chunk here, the data is decoded later
+    constexpr size_t OVO_VERTEX_SIZE = sizeof(glm::vec3) + 3 * sizeof(unsigned int);
     for (unsigned int l = 0; l < LODs; l++) {
         cout << "   Current LOD . :  " << l + 1 << "/" << LODs << endl;
-        unsigned int vertexCount, faceCount;
-        memcpy(&vertexCount, data + position, sizeof(unsigned int));
-        position += sizeof(unsigned int);
-        cout << "   Nr. vertices  :  " << vertexCount << endl;
-        verticesPerLOD[l] = vertexCount;
-        memcpy(&faceCount, data + position, sizeof(unsigned int));
-        position += sizeof(unsigned int);
-        cout << "   Nr. faces . . :  " << faceCount << endl;
-
-        std::vector<Eng::Vertex> verts;
-        for (unsigned int c = 0; c < vertexCount; c++) {
-            Eng::Vertex newVertex;
-            glm::vec3 pos;
-            memcpy(&pos, data + position, sizeof(glm::vec3));
-            position += sizeof(glm::vec3);
-            newVertex.setPosition(pos);
-            unsigned int normalData;
-            memcpy(&normalData, data + position, sizeof(unsigned int));
-            position += sizeof(unsigned int);
-            newVertex.setNormal(decompressNormal(normalData));
-            unsigned int textureData;
-            memcpy(&textureData, data + position, sizeof(unsigned int));
-            position += sizeof(unsigned int);
-            newVertex.setTexCoords(decompressTexCoords(textureData));
-            unsigned int tangentData;
-            memcpy(&tangentData, data + position, sizeof(unsigned int));
-            position += sizeof(unsigned int);
-            if (l == 0) {
-                verts.push_back(newVertex);
-            }
-        }
-
-        std::vector<unsigned int> meshIndices;
-        if (l == 0) {
-            meshIndices.reserve(faceCount * 3);
-        }
-        for (unsigned int c = 0; c < faceCount; c++) {
-            unsigned int face[3];
-            memcpy(face, data + position, sizeof(unsigned int) * 3);
-            position += sizeof(unsigned int) * 3;
-            if (l == 0) {
-                meshIndices.push_back(face[0]);
-                meshIndices.push_back(face[1]);
-                meshIndices.push_back(face[2]);
-            }
-        }
-        if (l == 0) {
-            // Store LOD 0 data.
-            // (finalVerts and finalIndices hold the geometry we want to use)
-            finalVerts = verts;
-            finalIndices = meshIndices;
-        }
+        MeshPayload::Lod lod;
+        lod.vertexCount = chunk.read<unsigned int>();
+        cout << "   Nr. vertices  :  " << lod.vertexCount << endl;
+        lod.faceCount = chunk.read<unsigned int>();
+        cout << "   Nr. faces . . :  " << lod.faceCount << endl;
+        lod.vertexData = chunk.take(lod.vertexCount, OVO_VERTEX_SIZE);
+        lod.faceData = chunk.take(lod.faceCount, sizeof(unsigned int) * 3);
+        if (!chunk.isValid())
+            return false;
+        payload.lods.push_back(lod);
     }
 
     if (chunkId == static_cast<unsigned int>(OvObject::Type::SKINNED)) {
-        glm::mat4 poseMatrix;
-        memcpy(&poseMatrix, data + position, sizeof(glm::mat4));
-        position += sizeof(glm::vec4);
-        unsigned int nrOfBones;
-        memcpy(&nrOfBones, data + position, sizeof(unsigned int));
-        position += sizeof(unsigned int);
+        // Pose matrix:
+        chunk.skip(1, sizeof(glm::mat4));
+        const auto nrOfBones = chunk.read<unsigned int>();
         cout << "   Nr. bones . . :  " << nrOfBones << endl;
-        for (unsigned int c = 0; c < nrOfBones; c++) {
-            char boneName[FILENAME_MAX];
-            strcpy(boneName, data + position);
-            position += static_cast<unsigned int>(strlen(boneName)) + 1;
+        for (unsigned int c = 0; c < nrOfBones && chunk.isValid(); c++) {
+            const string_view boneName = chunk.readString();
             cout << "      Bone name  :  " << boneName << " (" << c << ")" << endl;
-            glm::mat4 boneMatrix;
-            memcpy(&boneMatrix, data + position, sizeof(glm::mat4));
-            position += sizeof(glm::mat4);
+            chunk.skip(1, sizeof(glm::mat4));
         }
         for (unsigned int l = 0; l < LODs; l++) {
             cout << "   Current LOD . :  " << l + 1 << "/" << LODs << endl;
-            for (unsigned int c = 0; c < verticesPerLOD[l]; c++) {
-                unsigned int boneIndex[4];
-                memcpy(boneIndex, data + position, sizeof(unsigned int) * 4);
-                position += sizeof(unsigned int) * 4;
-                unsigned short boneWeightData[4];
-                memcpy(boneWeightData, data + position, sizeof(unsigned short) * 4);
-                position += sizeof(unsigned short) * 4;
-            }
+            // Four bone indices and four 16-bit weights per vertex
+            chunk.skip(payload.lods[l].vertexCount, sizeof(unsigned int) * 4 + sizeof(unsigned short) * 4);
+        }
+    }
+    if (!chunk.isValid())
+        return false;
+
+    const auto material = materials.find(std::string(materialName));
+    payload.name = std::string(meshName);
+    payload.matrix = matrix;
+    payload.material = material != materials.end() ? material->second : nullptr;
+    payload.radius = radius;
+    payload.bBoxMin = bBoxMin;
+    payload.bBoxMax = bBoxMax;
+    return true;
+}
+
+/**
+ * @brief Decodes the payloads of all meshes, spreading them across worker threads.
+ *
+ * Payloads are independent and only read the mapped file, so each one is decoded
+ * by whichever worker picks it; the results do not depend on the thread count.
+ *
+ * @param payloads Meshes recorded by the serial pass.
+ * @return true if every mesh was decoded, false if one holds invalid faces.
+ */
+bool Eng::OvoReader::decodeMeshes(std::vector<MeshPayload> &payloads) const {
+    std::atomic<size_t> next{ 0 };
+    std::atomic<bool> valid{ true };
+    auto worker = [this, &payloads, &next, &valid]() {
+        for (size_t i = next++; i < payloads.size(); i = next++)
+            if (!decodeMesh(payloads[i], vertexWelding, weldEpsilon))
+                valid = false;
+    };
+
+    const unsigned int hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const size_t workers = std::min<size_t>(threadCount ? threadCount : hardwareThreads, payloads.size());
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < workers; t++)
+        threads.emplace_back(worker);
+    worker();
+    for (auto &thread : threads)
+        thread.join();
+    return valid;
+}
+
+/**
+ * @brief Decodes the levels of detail of one mesh into shared geometries.
+ * @param payload Mesh whose data was located by parseMesh(); receives the welding counts.
+ * @param weld Whether duplicated vertices are welded.
+ * @param weldEpsilon Largest difference per vertex component between welded vertices.
+ * @return true if decoded, false if a face refers to a missing vertex; the payload then has no geometry.
+ */
+bool Eng::OvoReader::decodeMesh(MeshPayload &payload, const bool weld, const float weldEpsilon) {
+    // A mesh without levels still gets an (empty) geometry
+    if (payload.lods.empty())
+        payload.geometries.push_back(Eng::Geometry::create(std::vector<Eng::Vertex>(), std::vector<unsigned int>()));
+    payload.geometries.reserve(payload.lods.size());
+    for (const auto &lod : payload.lods) {
+        std::vector<Eng::Vertex> vertices;
+        decodeVertices(lod.vertexData, lod.vertexCount, vertices);
+
+        // Faces are three 32-bit indices each, copied as they are and checked against the vertices
+        std::vector<unsigned int> indices(static_cast<size_t>(lod.faceCount) * 3);
+        if (!indices.empty())
+            std::memcpy(indices.data(), lod.faceData, indices.size() * sizeof(unsigned int));
+        const auto vertexCount = lod.vertexCount;
+        if (std::any_of(indices.begin(), indices.end(), [vertexCount](const unsigned int index) { return index >= vertexCount; })) {
+            std::cout << "ERROR: mesh face refers to a missing vertex (" << vertexCount << " vertices)" << std::endl;
+            payload.geometries.clear();
+            return false;
         }
+        if (weld)
+            payload.welding += Eng::VertexWelder::weld(vertices, indices, weldEpsilon);
+
+        payload.geometries.push_back(Eng::Geometry::create(std::move(vertices), std::move(indices)));
     }
+    return true;
+}
 
-    // Use Builder chaining to create the final mesh.
-    auto& builder = Eng::Builder::getInstance();
-    std::shared_ptr<Eng::Mesh> finalMesh =
-        builder.setName(std::move(std::string(meshName)))
-        .setLocalMatrix(matrix)
-        .addVertices(finalVerts)
-        .addIndices(finalIndices)
-        .setMaterial(materials.find(materialName) != materials.end() ? materials.at(materialName) : nullptr)
-        .build();
+/**
+ * @brief Creates the mesh node of a payload.
+ *
+ * GPU buffers are not created here: the load-time passes may still replace the
+ * geometry, and buffers are created on first draw at the latest. A payload not
+ * decoded yet gives a mesh without geometry, filled in by streamMesh().
+ *
+ * @param payload Mesh, decoded or not.
+ * @return std::shared_ptr<Eng::Mesh> The mesh, with its levels of detail, bounds and collision hulls.
+ */
+std::shared_ptr<Eng::Mesh> Eng::OvoReader::buildMesh(MeshPayload &payload) {
+    auto mesh = std::make_shared<Eng::Mesh>();
+    mesh->setName(std::move(payload.name));
+    mesh->setLocalMatrix(payload.matrix);
+    mesh->setMaterial(payload.material);
+    attachGeometries(*mesh, payload.geometries);
 
     // Virtual Environemnt
     // 
     // 'radius' was read from the OVO file as the bounding sphere radius.
     // bBoxMin and bBoxMax were also parsed.
     // Compute a center as the midpoint of the bounding box.
-    glm::vec3 sphereCenter = (bBoxMin + bBoxMax) * 0.5f;
+    glm::vec3 sphereCenter = (payload.bBoxMin + payload.bBoxMax) * 0.5f;
+
+    mesh->setBoundingSphereCenter(sphereCenter);
+    mesh->setBoundingSphereRadius(payload.radius);
+    mesh->setBoundingBox(payload.bBoxMin, payload.bBoxMax);
+    mesh->setCollisionHulls(payload.hulls);
+    return mesh;
+}
+
+/**
+ * @brief Sets the levels of detail of a mesh.
+ * @param mesh Mesh without geometry.
+ * @param geometries Decoded levels, full detail first; none leaves the mesh as it is.
+ */
+void Eng::OvoReader::attachGeometries(Eng::Mesh &mesh, const std::vector<std::shared_ptr<Eng::Geometry>> &geometries) {
+    if (geometries.empty())
+        return;
+    mesh.setGeometry(geometries[0]);
+
+    // Lower levels of detail, selected at render time from the projected size
+    for (size_t l = 1; l < geometries.size(); l++)
+        mesh.addLod(geometries[l]);
+}
+
+/**
+ * @brief Queues the decoding and upload of a mesh built without geometry.
+ *
+ * The payload points into the mapped file, which the job keeps alive until it
+ * ran. All levels are attached and uploaded together on the render thread, so the
+ * mesh is skipped by rendering until it can be drawn at any level. Uploading them
+ * at once lets the mesh render before the load-time passes, at the cost of the
+ * buffers of the geometries those passes replace.
+ *
+ * @param mesh Mesh built from the payload.
+ * @param payload Mesh data located by parseMesh().
+ * @param file Mapped file the payload points into.
+ * @param welding Welding counts of the streamed meshes, added to on upload.
+ */
+void Eng::OvoReader::streamMesh(const std::shared_ptr<Eng::Mesh> &mesh, MeshPayload &&payload, const std::shared_ptr<Eng::MappedFile> &file,
+                                const std::shared_ptr<Eng::VertexWelder::Stats> &welding) const {
+    const auto shared = std::make_shared<MeshPayload>(std::move(payload));
+    const bool weld = vertexWelding;
+    const float epsilon = weldEpsilon;
+    streamer->enqueue([mesh, shared, file, welding, weld, epsilon]() -> Eng::SceneStreamer::Upload {
+        // An invalid mesh is left without geometry, and skipped by rendering
+        if (!decodeMesh(*shared, weld, epsilon))
+            return nullptr;
+        return [mesh, shared, welding]() {
+            attachGeometries(*mesh, shared->geometries);
+            mesh->initBuffers();
+            *welding += shared->welding;
+        };
+    });
+}
+
+/**
+ * @brief Decodes a block of packed vertices.
+ *
+ * Each OVO vertex is a position followed by a packed normal, packed texture
+ * coordinates and a packed tangent (unused). The packed attributes are gathered
+ * and decoded in batches by the VertexDecoder. The block must have been
+ * bounds-checked by the caller.
+ *
+ * @param data Start of the first vertex.
+ * @param vertexCount Number of vertices.
+ * @param vertices Receives the decoded vertices.
+ */
+void ENG_API Eng::OvoReader::decodeVertices(const char *data, const unsigned int vertexCount, std::vector<Eng::Vertex> &vertices) {
+    constexpr size_t OVO_VERTEX_SIZE = sizeof(glm::vec3) + 3 * sizeof(unsigned int);
+
+    std::vector<unsigned int> packed(static_cast<size_t>(vertexCount) * 2);
+    unsigned int *packedNormals = packed.data();
+    unsigned int *packedTexCoords = packedNormals + vertexCount;
+    for (unsigned int c = 0; c < vertexCount; c++) {
+        const char *vertex = data + c * OVO_VERTEX_SIZE + sizeof(glm::vec3);
+        std::memcpy(packedNormals + c, vertex, sizeof(unsigned int));
+        std::memcpy(packedTexCoords + c, vertex + sizeof(unsigned int), sizeof(unsigned int));
+    }
+
+    // Components are decoded into separate arrays: x, y, z, u, v
+    std::vector<float> decoded(static_cast<size_t>(vertexCount) * 5);
+    float *x = decoded.data(), *y = x + vertexCount, *z = y + vertexCount, *u = z + vertexCount, *v = u + vertexCount;
+    Eng::VertexDecoder::decodeNormals(packedNormals, vertexCount, x, y, z);
+    Eng::VertexDecoder::decodeTexCoords(packedTexCoords, vertexCount, u, v);
+
+    vertices.resize(vertexCount);
+    for (unsigned int c = 0; c < vertexCount; c++, data += OVO_VERTEX_SIZE) {
+        glm::vec3 pos;
+        std::memcpy(&pos, data, sizeof(glm::vec3));
+        vertices[c] = Eng::Vertex(pos, glm::vec3(x[c], y[c], z[c]), glm::vec2(u[c], v[c]));
+    }
+}
+
+/**
+ * @brief Sets how many threads decode mesh payloads.
+ * @param count Worker threads, 1 to decode on the calling thread only, 0 for one per hardware thread.
+ */
+void Eng::OvoReader::setThreadCount(const unsigned int count) {
+   threadCount = count;
+}
+
+/**
+ * @brief Gets how many threads decode mesh payloads.
+ * @return unsigned int Worker threads, 0 for one per hardware thread.
+ */
+unsigned int Eng::OvoReader::getThreadCount() const {
+   return threadCount;
+}
+
+/**
+ * @brief Enables cooking parsed scenes into a SceneCache and restoring them from it.
+ * @param enabled True to use the scene cache.
+ */
+void Eng::OvoReader::setSceneCache(const bool enabled) {
+   sceneCache = enabled;
+}
+
+/**
+ * @brief Checks whether parsed scenes go through a SceneCache.
+ * @return true if the scene cache is used.
+ */
+bool Eng::OvoReader::isSceneCacheEnabled() const {
+   return sceneCache;
+}
+
+/**
+ * @brief Makes parsing return the graph first and stream mesh payloads and textures.
+ *
+ * The streamer must outlive the jobs queued on it; call its update() every frame
+ * to upload them. A scene restored from the cache is not streamed.
+ *
+ * @param streamer Streamer to queue on, nullptr to load everything while parsing.
+ */
+void Eng::OvoReader::setStreamer(Eng::SceneStreamer *streamer) {
+   this->streamer = streamer;
+}
+
+/**
+ * @brief Gets the streamer used for progressive loading.
+ * @return Eng::SceneStreamer* The streamer, nullptr when loading while parsing.
+ */
+Eng::SceneStreamer *Eng::OvoReader::getStreamer() const {
+   return streamer;
+}
 
-    finalMesh->setBoundingSphereCenter(sphereCenter);
-    finalMesh->setBoundingSphereRadius(radius);
-    finalMesh->setBoundingBox(bBoxMin, bBoxMax);
+/**
+ * @brief Makes parsing queue textures on a TextureStreamer instead of loading them.
+ *
+ * Materials get their textures at once, rendered as placeholders until the
+ * streamer's update() uploads them. Takes over the textures of a SceneStreamer
+ * set with setStreamer(). The streamer must outlive the parse.
+ *
+ * @param textureStreamer Streamer to queue textures on, nullptr to load them otherwise.
+ */
+void Eng::OvoReader::setTextureStreamer(Eng::TextureStreamer *textureStreamer) {
+   this->textureStreamer = textureStreamer;
+}
 
-    return std::static_pointer_cast<Eng::Node>(finalMesh);
+/**
+ * @brief Gets the streamer textures are queued on.
+ * @return Eng::TextureStreamer* The streamer, nullptr when textures are loaded otherwise.
+ */
+Eng::TextureStreamer *Eng::OvoReader::getTextureStreamer() const {
+   return textureStreamer;
 }
 
 /**
- * @brief Decompresses a packed normal vector.
- * @param packedNormal Compressed normal data.
- * @return Decompressed normal vector.
+ * @brief Enables welding duplicated vertices of the decoded meshes.
+ * @param enabled True to weld, false to keep the vertices as stored in the file.
  */
+void Eng::OvoReader::setVertexWelding(const bool enabled) {
+   vertexWelding = enabled;
+}
 
-glm::vec3 ENG_API Eng::OvoReader::decompressNormal(const unsigned int packedNormal) {
-   glm::vec4 normal = glm::unpackSnorm3x10_1x2(packedNormal);
-   return {normal.x, normal.y, normal.z};
+/**
+ * @brief Checks whether decoded meshes are welded.
+ * @return true if duplicated vertices are welded.
+ */
+bool Eng::OvoReader::isVertexWeldingEnabled() const {
+   return vertexWelding;
+}
+
+/**
+ * @brief Sets how far apart vertices may be and still be welded.
+ *
+ * Negative values are ignored.
+ *
+ * @param epsilon Largest difference per position, normal and texture coordinate component, 0 for bit-identical vertices only.
+ */
+void Eng::OvoReader::setWeldEpsilon(const float epsilon) {
+   if (epsilon < 0.0f) {
+      std::cerr << "WARNING: [OvoReader] Invalid weld epsilon " << epsilon << ", keeping " << weldEpsilon << std::endl;
+      return;
+   }
+   weldEpsilon = epsilon;
 }
 
 /**
- * @brief Decompresses packed texture coordinates.
- * @param packedTexCoords Compressed texture coordinate data.
- * @return Decompressed texture coordinates.
+ * @brief Gets how far apart vertices may be and still be welded.
+ * @return float Largest difference per vertex component, 0 for bit-identical vertices only.
  */
-glm::vec2 ENG_API Eng::OvoReader::decompressTexCoords(const unsigned int packedTexCoords) {
-   return glm::unpackHalf2x16(packedTexCoords);
+float Eng::OvoReader::getWeldEpsilon() const {
+   return weldEpsilon;
 }
 
 /**
@@ -12,6 +12,29 @@
  * constructing a scene graph with meshes, materials, lights, and other 3D scene elements.
  * It maintains internal state about the scene hierarchy and manages the relationships
  * between different scene elements during the parsing process.
+ *
+ * The file is memory-mapped and its chunks are parsed in place through bounds-checked
+ * views; vertex and index payloads are decoded straight into the buffers that become
+ * the meshes' geometry. Truncated or corrupted files are rejected instead of read past.
+ *
+ * Parsing runs in three steps: a serial pass over the chunks reads every header and
+ * records where mesh payloads lie, the payloads are then decoded on worker threads,
+ * and the scene graph is finally stitched in file order, so it does not depend on
+ * the number of threads.
+ *
+ * Decoded levels of detail are welded by a VertexWelder unless disabled: duplicated
+ * vertices are merged and the triangles they collapse dropped, and the before and
+ * after counts are reported once the meshes are decoded.
+ *
+ * With the scene cache enabled, the parsed graph is also cooked into a SceneCache
+ * file next to the source, and later parses of the unchanged file restore it from
+ * there instead.
+ *
+ * With a SceneStreamer set, parsing returns as soon as the chunks are read: meshes
+ * come with their bounds and materials but no geometry, and their payloads and
+ * textures are decoded on the streamer's threads and uploaded by its update().
+ * With a TextureStreamer set, textures are queued there instead, whether or not
+ * the rest of the scene streams.
  */
 class ENG_API OvoReader final {
 public:
@@ -19,6 +42,19 @@ public:
    std::shared_ptr<Eng::Node> parseOvoFile(const std::string &filename);
    void printGraph() const;
 
+   void setThreadCount(unsigned int count);
+   unsigned int getThreadCount() const;
+   void setSceneCache(bool enabled);
+   bool isSceneCacheEnabled() const;
+   void setStreamer(Eng::SceneStreamer *streamer);
+   Eng::SceneStreamer *getStreamer() const;
+   void setTextureStreamer(Eng::TextureStreamer *textureStreamer);
+   Eng::TextureStreamer *getTextureStreamer() const;
+   void setVertexWelding(bool enabled);
+   bool isVertexWeldingEnabled() const;
+   void setWeldEpsilon(float epsilon);
+   float getWeldEpsilon() const;
+
 
 private:
 
@@ -37,17 +73,57 @@ private:
       std::shared_ptr<Eng::Node> node; ///< The node being tracked
    };
 
-   static void parseBone(unsigned int &position, const char *data);
-   static glm::vec3  decompressNormal(unsigned int packedNormal);
-   static glm::vec2 decompressTexCoords(unsigned int packedTexCoords);
-   static std::shared_ptr<Eng::Node> parseLight(unsigned int &position, const char *data);
-   static void analyzeObject(unsigned int &position, char *data);
-   static std::shared_ptr<Eng::Node> analyzeNode(unsigned int &position, const char *data, unsigned int &children);
+   /**
+   * @brief Mesh chunk whose payload is decoded after the serial pass.
+   */
+   struct MeshPayload {
+      /**
+      * @brief Location of one level of detail inside the mapped file.
+      */
+      struct Lod {
+         const char *vertexData; ///< Packed vertices
+         unsigned int vertexCount; ///< Number of vertices
+         const char *faceData; ///< Triangles, three 32-bit indices each
+         unsigned int faceCount; ///< Number of triangles
+      };
+
+      std::string name; ///< Mesh name
+      glm::mat4 matrix; ///< Local matrix
+      std::shared_ptr<Eng::Material> material; ///< Material, nullptr if not found
+      float radius; ///< Bounding sphere radius
+      glm::vec3 bBoxMin; ///< Bounding box minimum corner
+      glm::vec3 bBoxMax; ///< Bounding box maximum corner
+      std::vector<Lod> lods; ///< Levels of detail, full detail first
+      std::vector<std::shared_ptr<Eng::CollisionHull>> hulls; ///< Physics hulls, in local space
+      std::vector<std::shared_ptr<Eng::Geometry>> geometries; ///< Decoded levels
+      Eng::VertexWelder::Stats welding; ///< Counts before and after welding, over all levels
+   };
+
+   /**
+   * @brief Scene graph entry recorded by the serial pass, in file order.
+   */
+   struct PendingNode {
+      std::shared_ptr<Eng::Node> node; ///< Parsed node, nullptr for a mesh still to build
+      size_t mesh; ///< Index of the mesh payload, when node is nullptr
+      unsigned int children; ///< Number of children of the node
+   };
+
+   static void parseBone(Eng::ChunkView &chunk);
+   static std::shared_ptr<Eng::Node> parseLight(Eng::ChunkView &chunk);
+   static void analyzeObject(Eng::ChunkView &chunk);
+   static std::shared_ptr<Eng::Node> analyzeNode(Eng::ChunkView &chunk, unsigned int &children);
+   static void decodeVertices(const char *data, unsigned int vertexCount, std::vector<Eng::Vertex> &vertices);
+   static bool decodeMesh(MeshPayload &payload, bool weld, float weldEpsilon);
+   static std::shared_ptr<Eng::Mesh> buildMesh(MeshPayload &payload);
+   static void attachGeometries(Eng::Mesh &mesh, const std::vector<std::shared_ptr<Eng::Geometry>> &geometries);
    static void printGraphHelper(const std::shared_ptr<Eng::Node> &node, int depth);
 
    void manageSceneGraph(std::shared_ptr<Eng::Node> &node, unsigned int children);
-   void parseMaterial(unsigned int &position, const char *data);
-   std::shared_ptr<Eng::Node> parseMesh(unsigned int &position, unsigned int chunkId, char *data, unsigned int &children);
+   void parseMaterial(Eng::ChunkView &chunk);
+   bool parseMesh(Eng::ChunkView &chunk, unsigned int chunkId, unsigned int &children, MeshPayload &payload);
+   bool decodeMeshes(std::vector<MeshPayload> &payloads) const;
+   void streamMesh(const std::shared_ptr<Eng::Mesh> &mesh, MeshPayload &&payload, const std::shared_ptr<Eng::MappedFile> &file,
+                   const std::shared_ptr<Eng::VertexWelder::Stats> &welding) const;
 
    ///< Stack for managing node hierarchy during parsing
    std::stack<NodeInfo> nodeStack;
@@ -57,5 +133,17 @@ private:
    std::unordered_map<std::string, std::shared_ptr<Eng::Material>> materials;
    ///< directory of the file
    std::string basePath;
+   ///< Threads decoding mesh payloads, 0 for one per hardware thread
+   unsigned int threadCount = 0;
+   ///< Whether parsed scenes are cooked and restored through a SceneCache
+   bool sceneCache = false;
+   ///< Streamer loading payloads and textures progressively, nullptr to load them during parsing
+   Eng::SceneStreamer *streamer = nullptr;
+   ///< Streamer decoding and uploading textures, nullptr to load them during parsing or with the SceneStreamer
+   Eng::TextureStreamer *textureStreamer = nullptr;
+   ///< Whether decoded geometry is welded
+   bool vertexWelding = true;
+   ///< Largest difference per vertex component between welded vertices, 0 for bit-identical only
+   float weldEpsilon = 0.0f;
 };
 
@@ -46,3 +46,12 @@ void Eng::PointLight::configureLight(const glm::mat4 &viewMatrix) {
 glm::vec3 Eng::PointLight::getPosition() const {
    return glm::vec3(getFinalMatrix()[3]);
 }
+
+/**
+ * @brief Gets the attenuation of the point light.
+ *
+ * @return float The attenuation, read from OVO files as the influence radius.
+ */
+float Eng::PointLight::getAttenuation() const {
+   return attenuation;
+}
@@ -13,6 +13,7 @@ public:
    PointLight(const glm::vec3 &color, float attenuation);
 
    glm::vec3 getPosition() const;
+   float getAttenuation() const;
 
 private:
    void configureLight(const glm::mat4 &viewMatrix) override;
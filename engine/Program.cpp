@@ -7,7 +7,7 @@
  *
  * Initializes the internal program ID to zero.
  */
-ENG_API Eng::Program::Program() : id(0)
+ENG_API Eng::Program::Program() : id(0), checked(false), linked(false)
 {
 }
 
@@ -34,15 +34,30 @@ ENG_API Eng::Program& Eng::Program::addShader(const std::shared_ptr<Eng::Shader>
 /**
  * @brief Creates and links the OpenGL shader program.
  *
- * Deletes any existing program, recreates it, attaches all shaders,
- * links and validates the program, and applies attribute bindings.
+ * Blocking helper equivalent to submit() followed by finish().
  * @return True on successful link and validation; false on failure.
  */
 bool ENG_API Eng::Program::build()
+{
+	return submit() && finish();
+}
+
+/**
+ * @brief Issues the link of the OpenGL shader program without waiting for it.
+ *
+ * Deletes any existing program, recreates it, applies attribute bindings,
+ * attaches all shaders and links. No status is queried, so the shaders'
+ * compiles and this link can proceed on the driver's compiler threads;
+ * the result is collected lazily by finish() on first use.
+ * @return True if the link was submitted; false on failure.
+ */
+bool ENG_API Eng::Program::submit()
 {
 	// Delete if already used:
 	if (id)
 		glDeleteProgram(id);
+	checked = false;
+	linked = false;
 
 	// Create program:
 	id = glCreateProgram();
@@ -52,6 +67,11 @@ bool ENG_API Eng::Program::build()
 		return false;
 	}
 
+	// Attribute locations only take effect at link time:
+	for (const auto& attrib : attributeBindings) {
+		glBindAttribLocation(id, attrib.first, attrib.second.c_str());
+	}
+
 	for (const auto& shader : shaders) {
 		glAttachShader(id, shader->getGlId());
 	}
@@ -59,6 +79,53 @@ bool ENG_API Eng::Program::build()
 	// Link program:
 	glLinkProgram(id);
 
+	// Done:
+	return true;
+}
+
+/**
+ * @brief Polls whether the driver has finished linking the program.
+ *
+ * Uses GL_COMPLETION_STATUS_KHR when parallel compilation is supported;
+ * otherwise the link is assumed to be complete (finish() will block).
+ * @return True if finish() can be called without stalling.
+ */
+bool ENG_API Eng::Program::isReady()
+{
+	if (checked || id == 0 || !Eng::Shader::isParallelCompileSupported())
+		return true;
+
+	// The link cannot be done before the compiles it depends on
+	for (const auto& shader : shaders) {
+		if (!shader->isReady())
+			return false;
+	}
+
+	int done = GL_FALSE;
+	glGetProgramiv(id, GL_COMPLETION_STATUS_KHR, &done);
+	return done == GL_TRUE;
+}
+
+/**
+ * @brief Waits for the submitted link and validates the program.
+ *
+ * Reports compile errors of the attached shaders, then the link status and
+ * validation. The result is cached, so calling it every frame is free.
+ * @return True on successful link and validation; false on failure.
+ */
+bool ENG_API Eng::Program::finish()
+{
+	if (checked)
+		return linked;
+	if (id == 0)
+		return false;
+	checked = true;
+
+	for (const auto& shader : shaders) {
+		if (!shader->finish())
+			return false;
+	}
+
 	// Verify program:
 	int status;
 	char buffer[MAX_LOGSIZE];
@@ -66,9 +133,9 @@ bool ENG_API Eng::Program::build()
 	memset(buffer, 0, MAX_LOGSIZE);
 
 	glGetProgramiv(id, GL_LINK_STATUS, &status);
-	glGetProgramInfoLog(id, MAX_LOGSIZE, &length, buffer);
 	if (status == false)
 	{
+		glGetProgramInfoLog(id, MAX_LOGSIZE, &length, buffer);
 		std::cout << "[ERROR] Program link error: " << buffer << std::endl;
 		return false;
 	}
@@ -81,23 +148,21 @@ bool ENG_API Eng::Program::build()
 		return false;
 	}
 
-	for (const auto& attrib : attributeBindings) {
-		glBindAttribLocation(id, attrib.first, attrib.second.c_str());
-	}
-
 	// Done:
+	linked = true;
 	return true;
 }
 
 /**
  * @brief Activates this Program for rendering.
  *
- * Calls glUseProgram and sets sampler uniforms to their bound units.
+ * Waits for a pending link on first use, then calls glUseProgram
+ * and sets sampler uniforms to their bound units.
  */
 void ENG_API Eng::Program::render()
 {
 	// Activate program:
-	if (id) {
+	if (id && finish()) {
 		glUseProgram(id);
 
 		for (const auto& sampler : samplerBindings) {
@@ -202,7 +267,7 @@ void ENG_API Eng::Program::setVec4(int param, const glm::vec4& vect)
 /**
  * @brief Binds a vertex attribute location for linking.
  *
- * Must be called before build().
+ * Must be called before build() or submit().
  * @param location Explicit attribute index.
  * @param attribName Name of the attribute in the shader.
  * @return Reference to this Program.
@@ -17,6 +17,9 @@ public:
 	~Program();
 	Program& addShader(const std::shared_ptr<Eng::Shader>& shader);
 	bool build();
+	bool submit();
+	bool isReady();
+	bool finish();
 	void render() override;
 
 	unsigned int getGlId();
@@ -43,6 +46,8 @@ public:
 private:
 	// OGL id:
 	unsigned int id;
+	bool checked;	///< True once the link status has been queried
+	bool linked;	///< Result of the last link status query
 	std::vector<std::shared_ptr<Eng::Shader>> shaders;
 	std::unordered_map<int, std::string> attributeBindings;
 	std::unordered_map<int, std::string> samplerBindings;
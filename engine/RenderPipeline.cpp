@@ -2,6 +2,10 @@
 
 #include <GL/glew.h>
 
+#include <algorithm>
+#include <chrono>
+#include <tuple>
+
 #define SHADOWMAP_WIDTH 2048
 #define SHADOWMAP_HEIGHT 2048
 
@@ -26,6 +30,26 @@ struct Eng::RenderPipeline::RenderContext {
 	bool isTransparent;
 };
 
+// Marks a multi-draw bucket whose materials bind their own diffuse texture
+static constexpr size_t NO_TEXTURE_ARRAY = static_cast<size_t>(-1);
+
+// Helper struct holding the multi-draw submission of one layer, shared by the passes of a view
+struct Eng::RenderPipeline::MultiDrawSet {
+    struct Bucket {
+        std::shared_ptr<Material> material;
+        size_t textureArray;	// Texture array sampled by the draws, or NO_TEXTURE_ARRAY
+        size_t index;			// Bucket index among all the sets of the view, as culled
+        size_t firstCommand;
+        size_t commandCount;
+    };
+    RenderLayer layer;
+    bool useCulling;
+    std::vector<Bucket> buckets;
+    std::vector<std::shared_ptr<ListElement>> singles;	// Visible elements rendered one by one
+    std::vector<size_t> lodTriangles;					// Triangles of the bucketed draws, per level of detail
+    size_t meshes = 0;
+};
+
 /**
  * @brief Constructs a new RenderPipeline object.
  */
@@ -88,9 +112,11 @@ void Eng::RenderPipeline::shadowPass(std::shared_ptr <Eng::DirectionalLight>& li
  * This method executes sequential rendering passes for the scene,
  * including base color, lighting, and shadow passes.
  * For each pass it sets up the render context and shader program.
+ * Levels of detail are selected once for the view, before the first pass.
  *
  */
 void Eng::RenderPipeline::runOn(Eng::List* renderList) {
+    const auto submissionStart = std::chrono::steady_clock::now();
     glEnable(GL_DEPTH_TEST);
     auto& sm = ShaderManager::getInstance();
 
@@ -98,6 +124,17 @@ void Eng::RenderPipeline::runOn(Eng::List* renderList) {
 	std::shared_ptr<RenderContext> context = std::make_shared<RenderContext>();
 	context->renderList = renderList;
 
+    // Every pass of this view draws the same levels of detail, and the same multi-draw commands
+    renderList->selectLods();
+    multiDrawSets.clear();
+    drawCommands.clear();
+    drawMatrices.clear();
+    drawTextureLayers.clear();
+    drawBounds.clear();
+    drawElements.clear();
+    multiDrawBuckets = 0;
+    multiDrawUploaded = false;
+
     // Base color pass
 
 	context->layers = { RenderLayer::Opaque };
@@ -164,6 +201,78 @@ void Eng::RenderPipeline::runOn(Eng::List* renderList) {
 
     glDepthMask(GL_TRUE);
     glDepthFunc(GL_LESS);
+
+    submissionStats.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - submissionStart).count();
+    submissionStats.views++;
+}
+
+/**
+ * @brief Retrieves the submission statistics accumulated since the last reset.
+ *
+ * The time covers building and issuing the GL commands in runOn, not their
+ * execution on the GPU, which makes the submission modes directly comparable.
+ *
+ * @return const SubmissionStats& The accumulated statistics
+ */
+const Eng::RenderPipeline::SubmissionStats& Eng::RenderPipeline::getSubmissionStats() const {
+    return submissionStats;
+}
+
+/**
+ * @brief Clears the accumulated submission statistics.
+ */
+void Eng::RenderPipeline::resetSubmissionStats() {
+    submissionStats = SubmissionStats();
+}
+
+/**
+ * @brief Prints submission statistics, averaged per view, to the console.
+ *
+ * Reports the active submission mode, and the TextureArrayPool contents when
+ * ENG_TEXTURE_ARRAYS is in use.
+ *
+ * @param stats Statistics returned by getSubmissionStats().
+ */
+void Eng::RenderPipeline::printStats(const SubmissionStats& stats) {
+    if (!stats.views)
+        return;
+
+    const char* mode = Eng::Base::engIsEnabled(ENG_MULTIDRAW_RENDERING) && Eng::GeometryBuffer::isSupported() ? "multi-draw indirect"
+        : Eng::Base::engIsEnabled(ENG_INSTANCED_RENDERING) ? "instanced" : "per mesh";
+    std::cout << "[RenderPipeline] CPU submission: " << stats.milliseconds / stats.views
+        << " ms per view (" << mode << ")" << std::endl;
+    std::cout << "   Draw calls per view: " << static_cast<double>(stats.drawCalls) / stats.views << " for "
+        << static_cast<double>(stats.drawnMeshes) / stats.views << " meshes" << std::endl;
+    if (!stats.lodTriangles.empty()) {
+        std::cout << "   Triangles per view by LOD:";
+        for (size_t level = 0; level < stats.lodTriangles.size(); level++)
+            std::cout << " [" << level << "] " << stats.lodTriangles[level] / stats.views;
+        std::cout << std::endl;
+    }
+    if (Eng::Base::engIsEnabled(ENG_TEXTURE_ARRAYS) && Eng::TextureArrayPool::isSupported())
+        Eng::TextureArrayPool::printStats(Eng::TextureArrayPool::getInstance().getStats());
+}
+
+/**
+ * @brief Adds the meshes of a draw, and their triangles per LOD, to the statistics.
+ *
+ * Counts every submitted draw, in all passes; with GPU culling the draws
+ * culled on the GPU are included.
+ *
+ * @param mesh      The mesh drawn, at its active level of detail.
+ * @param instances Number of copies drawn.
+ */
+void Eng::RenderPipeline::countTriangles(const std::shared_ptr<Mesh>& mesh, const size_t instances) {
+    const auto geometry = mesh->getActiveGeometry();
+    if (!geometry)
+        return;
+
+    submissionStats.drawnMeshes += instances;
+    const size_t level = mesh->getActiveLod();
+    auto& lodTriangles = submissionStats.lodTriangles;
+    if (lodTriangles.size() <= level)
+        lodTriangles.resize(level + 1, 0);
+    lodTriangles[level] += geometry->getIndices().size() / 3 * instances;
 }
 
 
@@ -172,13 +281,15 @@ void Eng::RenderPipeline::runOn(Eng::List* renderList) {
  *
  * This method caches the current OpenGL state, sets up blending and depth
  * based on the provided context, iterates through the render list,
- * and renders each element in the specified layers.
+ * and renders each element in the specified layers. When ENG_MULTIDRAW_RENDERING
+ * is enabled and supported, each layer is submitted through the shared GeometryBuffer
+ * with one multi-draw per material. Otherwise, when ENG_INSTANCED_RENDERING is enabled,
+ * visible elements sharing geometry and material are drawn together with a single
+ * instanced call.
  *
  * @param context A shared pointer to the RenderContext containing rendering parameters.
  */
 void Eng::RenderPipeline::renderPass(const std::shared_ptr<RenderContext>& context) {
-    auto& sm = ShaderManager::getInstance();
-
     // rembember current OpenGL state
     prevStatus->blendingEnabled = glIsEnabled(GL_BLEND);
 
@@ -216,61 +327,352 @@ void Eng::RenderPipeline::renderPass(const std::shared_ptr<RenderContext>& conte
     }
 
 
+    // Normals are drawn by Mesh::render, so their debug view keeps per-mesh draws
+    const bool useMultiDraw = Eng::Base::engIsEnabled(ENG_MULTIDRAW_RENDERING) &&
+        !Eng::Base::engIsEnabled(ENG_RENDER_NORMAL) && GeometryBuffer::isSupported();
+
 	for (const auto& layer : context->layers) {
-        auto renderIterator = context->renderList->getLayerIterator(layer);
-        std::shared_ptr<ListElement> element;
+        if (useMultiDraw) {
+            renderMultiDraw(context, layer);
+            continue;
+        }
+
+        if (!Eng::Base::engIsEnabled(ENG_INSTANCED_RENDERING)) {
+            auto renderIterator = context->renderList->getLayerIterator(layer);
+            while (renderIterator.hasNext()) {
+                const auto element = renderIterator.next();
+                if (isVisible(context, element))
+                    renderElement(context, element);
+            }
+            continue;
+        }
 
-        while (renderIterator.hasNext()) {
-			element = renderIterator.next();
-            if (context->useCulling) {
-                if (const auto& mesh = std::dynamic_pointer_cast<Mesh>(element->getNode())) {
-                    if (!context->renderList->isWithinCullingSphere(mesh))
-                        continue;
-                }
+        // Elements sharing geometry and material are drawn with one instanced call
+        std::vector<glm::mat4> instanceMatrices;
+        for (const auto& group : context->renderList->getInstanceGroups(layer)) {
+            instanceMatrices.clear();
+            std::shared_ptr<ListElement> lastVisible;
+            for (const auto& element : group) {
+                if (!isVisible(context, element))
+                    continue;
+                instanceMatrices.push_back(element->getWorldCoordinates());
+                lastVisible = element;
             }
 
-			glm::mat4 eyeViewMatrix = context->renderList->getEyeViewMatrix();
+            if (instanceMatrices.size() == 1)
+                renderElement(context, lastVisible);
+            else if (instanceMatrices.size() > 1)
+                renderInstances(context, std::static_pointer_cast<Mesh>(lastVisible->getNode()), instanceMatrices);
+        }
+	}
+
+    // Reset previous OpenGL blending state
+    if (prevStatus->blendingEnabled) {
+        glEnable(GL_BLEND);
+        glBlendFunc(prevStatus->blendSrcRGB, prevStatus->blendDstRGB);
+    }
+    else {
+        glDisable(GL_BLEND);
+    }
+}
+
+/**
+ * @brief Tells whether an element survives the culling of the given pass.
+ *
+ * @param context The render context of the current pass.
+ * @param element The element to test.
+ * @return true if the element has to be drawn.
+ */
+bool Eng::RenderPipeline::isVisible(const std::shared_ptr<RenderContext>& context, const std::shared_ptr<ListElement>& element) {
+    if (!context->useCulling)
+        return true;
+    if (const auto& mesh = std::dynamic_pointer_cast<Mesh>(element->getNode()))
+        return context->renderList->isWithinCullingSphere(mesh);
+    return true;
+}
+
+/**
+ * @brief Loads the per-pass uniforms shared by single and instanced draws.
+ *
+ * @param context     The render context of the current pass.
+ * @param modelMatrix Model matrix folded into the model-view, normal and light-space uniforms
+ *                    (identity for instanced draws, whose model matrices come per instance).
+ */
+void Eng::RenderPipeline::loadTransforms(const std::shared_ptr<RenderContext>& context, const glm::mat4& modelMatrix) {
+    auto& sm = ShaderManager::getInstance();
+
+    glm::mat4 eyeViewMatrix = context->renderList->getEyeViewMatrix();
+
+    // Load global light color
+    sm.setGlobalLightColor(context->renderList->getGlobalLightColor());
+
+    // Load projection matrix
+    sm.setProjectionMatrix(context->renderList->getEyeProjectionMatrix());
 
-            // Load global light color
-            sm.setGlobalLightColor(context->renderList->getGlobalLightColor());
+    // Generate modelView matrix
+    glm::mat4 modelViewMatrix = eyeViewMatrix * modelMatrix;
 
-            // Load projection matrix
-            sm.setProjectionMatrix(context->renderList->getEyeProjectionMatrix());
+    // glLoadMatrixf(glm::value_ptr(modelViewMatrix));    unsupported 4.4
 
-            glm::mat4 modelMatrix = element->getWorldCoordinates();
+    // Send 4x4 modelview matrix
+    sm.setModelViewMatrix(modelViewMatrix);
 
-            // Generate modelView matrix
-            glm::mat4 modelViewMatrix = eyeViewMatrix * modelMatrix;
+    // Send 3x3 inverse-transpose for normals
+    glm::mat3 normalMat = glm::inverseTranspose(glm::mat3(modelViewMatrix));
+    sm.setNormalMatrix(normalMat);
 
-            // glLoadMatrixf(glm::value_ptr(modelViewMatrix));    unsupported 4.4
+    // Send lightSpaceModel matrix
+    glm::mat4 modelLightMatrix = lightSpaceMatrix * modelMatrix;
+    sm.setLightSpaceMatrix(modelLightMatrix);
 
-            // Send 4x4 modelview matrix
-            sm.setModelViewMatrix(modelViewMatrix);
+    // Send eye front vector: this is the camera front vector in world coordinates
+    // which corresponds to the third column of the view matrix
+    glm::vec3 eyeFront = -glm::vec3(glm::transpose(glm::mat3(eyeViewMatrix))[2]);
+    sm.setEyeFront(eyeFront);
+}
 
-            // Send 3x3 inverse-transpose for normals
-            glm::mat3 normalMat = glm::inverseTranspose(glm::mat3(modelViewMatrix));
-            sm.setNormalMatrix(normalMat);
+/**
+ * @brief Renders a single list element with its own model matrix.
+ *
+ * @param context The render context of the current pass.
+ * @param element The element to render.
+ */
+void Eng::RenderPipeline::renderElement(const std::shared_ptr<RenderContext>& context, const std::shared_ptr<ListElement>& element) {
+    loadTransforms(context, element->getWorldCoordinates());
+    element->getNode()->render();
+    submissionStats.drawCalls++;
+    if (const auto mesh = std::dynamic_pointer_cast<Mesh>(element->getNode()))
+        countTriangles(mesh, 1);
+}
 
-            // Send lightSpaceModel matrix
-            glm::mat4 modelLightMatrix = lightSpaceMatrix * modelMatrix;
-            sm.setLightSpaceMatrix(modelLightMatrix);
+/**
+ * @brief Renders several copies of a mesh with one instanced draw.
+ *
+ * The uniforms are loaded with an identity model matrix and the shaders apply
+ * each instance's world matrix on top of them.
+ *
+ * @param context        The render context of the current pass.
+ * @param mesh           Mesh providing geometry and material for every instance.
+ * @param modelMatrices  World matrices of the visible instances.
+ */
+void Eng::RenderPipeline::renderInstances(const std::shared_ptr<RenderContext>& context, const std::shared_ptr<Mesh>& mesh, const std::vector<glm::mat4>& modelMatrices) {
+    auto& sm = ShaderManager::getInstance();
 
-            // Send eye front vector: this is the camera front vector in world coordinates
-            // which corresponds to the third column of the view matrix
-            glm::vec3 eyeFront = -glm::vec3(glm::transpose(glm::mat3(eyeViewMatrix))[2]);
-            sm.setEyeFront(eyeFront);
+    loadTransforms(context, glm::mat4(1.0f));
+    sm.setUseInstancing(true);
+    mesh->renderInstanced(modelMatrices);
+    sm.setUseInstancing(false);
+    submissionStats.drawCalls++;
+    countTriangles(mesh, modelMatrices.size());
+}
 
-            element->getNode()->render();
+/**
+ * @brief Renders the visible elements of a layer with multi-draw indirect calls.
+ *
+ * The draws of a layer are gathered by buildMultiDraw() the first time a pass of
+ * the view draws it, and uploaded with the other layers of the view; later passes
+ * (one per light) only load their material and issue one glMultiDrawElementsIndirect
+ * per bucket. Elements multi-draw cannot submit are rendered one by one.
+ *
+ * @param context The render context of the current pass.
+ * @param layer   The layer to render.
+ */
+void Eng::RenderPipeline::renderMultiDraw(const std::shared_ptr<RenderContext>& context, const RenderLayer& layer) {
+    auto& sm = ShaderManager::getInstance();
+    auto& geometryBuffer = GeometryBuffer::getInstance();
+    auto& gpuCuller = GpuCuller::getInstance();
+    auto& texturePool = TextureArrayPool::getInstance();
+
+    const auto found = std::find_if(multiDrawSets.begin(), multiDrawSets.end(), [&context, &layer](const MultiDrawSet& set) {
+        return set.layer == layer && set.useCulling == context->useCulling;
+    });
+    const size_t index = found != multiDrawSets.end() ? static_cast<size_t>(found - multiDrawSets.begin()) : buildMultiDraw(context, layer);
+    if (!multiDrawUploaded)
+        uploadMultiDraws(context->renderList);
+    const MultiDrawSet& set = multiDrawSets[index];
+
+    for (const auto& element : set.singles)
+        renderElement(context, element);
+    if (set.buckets.empty())
+        return;
+
+    submissionStats.drawnMeshes += set.meshes;
+    auto& lodTriangles = submissionStats.lodTriangles;
+    if (lodTriangles.size() < set.lodTriangles.size())
+        lodTriangles.resize(set.lodTriangles.size(), 0);
+    for (size_t level = 0; level < set.lodTriangles.size(); level++)
+        lodTriangles[level] += set.lodTriangles[level];
+
+    const bool culledOnGpu = set.useCulling && multiDrawCulledOnGpu;
+    loadTransforms(context, glm::mat4(1.0f));
+    sm.setUseMultiDraw(true);
+    for (const auto& bucket : set.buckets) {
+        bucket.material->render();
+        if (bucket.textureArray != NO_TEXTURE_ARRAY)
+            texturePool.bind(bucket.textureArray);
+        if (culledOnGpu)
+            gpuCuller.draw(bucket.firstCommand, bucket.commandCount, bucket.index);
+        else
+            geometryBuffer.draw(bucket.firstCommand, bucket.commandCount);
+        submissionStats.drawCalls++;
+    }
+    sm.setUseMultiDraw(false);
+}
+
+/**
+ * @brief Gathers the draws of a layer and appends their commands to the ones of the view.
+ *
+ * Meshes whose geometry lives in the shared GeometryBuffer are bucketed by material;
+ * the commands of a bucket are contiguous and their base instance indexes the per-draw
+ * model matrix. With ENG_TEXTURE_ARRAYS, diffuse textures are packed in the TextureArrayPool
+ * and materials with the same parameters share a bucket, each draw sampling its own layer.
+ * Other elements (custom materials, uncompressed geometry, non-mesh nodes) are kept to be
+ * rendered one by one. When the list uses a GPU culling mode, every draw gets its bounds
+ * and culled layers skip the CPU test, left to uploadMultiDraws().
+ *
+ * @param context The render context of the first pass drawing the layer.
+ * @param layer   The layer to gather.
+ * @return size_t Index of the new set in multiDrawSets.
+ */
+size_t Eng::RenderPipeline::buildMultiDraw(const std::shared_ptr<RenderContext>& context, const RenderLayer& layer) {
+    auto& geometryBuffer = GeometryBuffer::getInstance();
+    auto& texturePool = TextureArrayPool::getInstance();
+    auto* renderList = context->renderList;
+    const bool gpuCulling = renderList->getCullingMode() != List::CullingMode::Cpu;
+    const bool textureArrays = Eng::Base::engIsEnabled(ENG_TEXTURE_ARRAYS) && TextureArrayPool::isSupported();
+
+    MultiDrawSet set;
+    set.layer = layer;
+    set.useCulling = context->useCulling;
+
+    // Buckets in first-seen order, each holding its draws. With texture arrays, materials differing
+    // only by a packed diffuse texture share a bucket, keyed by their array and parameters instead
+    struct Draw {
+        GeometryBuffer::Range range;
+        std::shared_ptr<ListElement> element;
+        int textureLayer;
+    };
+    using BucketKey = std::tuple<const Material*, size_t, std::array<float, 8>>;
+    std::map<BucketKey, size_t> bucketIndex;
+    std::vector<std::vector<Draw>> bucketDraws;
+
+    auto renderIterator = renderList->getLayerIterator(layer);
+    while (renderIterator.hasNext()) {
+        const auto element = renderIterator.next();
+        const auto mesh = std::dynamic_pointer_cast<Mesh>(element->getNode());
+        GeometryBuffer::Range range;
+        if (!mesh || !mesh->getMaterial() || !mesh->getMaterial()->supportsInstancing() ||
+            !mesh->getActiveGeometry() || !geometryBuffer.acquire(mesh->getActiveGeometry(), range)) {
+            if (isVisible(context, element))
+                set.singles.push_back(element);
+            continue;
         }
-	}
 
-    // Reset previous OpenGL blending state
-    if (prevStatus->blendingEnabled) {
-        glEnable(GL_BLEND);
-        glBlendFunc(prevStatus->blendSrcRGB, prevStatus->blendDstRGB);
+        if (!(set.useCulling && gpuCulling) && !isVisible(context, element))
+            continue;
+
+        const auto& material = mesh->getMaterial();
+        const auto& texture = material->getDiffuseTexture();
+        BucketKey key = { material.get(), NO_TEXTURE_ARRAY, {} };
+        TextureArrayPool::Slot slot;
+        if (textureArrays && (!texture || texturePool.acquire(texture, slot))) {
+            const glm::vec4 albedo = material->getAlbedoWithAlpha();
+            const glm::vec3 emission = material->getEmission();
+            key = { nullptr, texture ? slot.array : NO_TEXTURE_ARRAY,
+                { albedo.r, albedo.g, albedo.b, albedo.a, material->getShininess(), emission.r, emission.g, emission.b } };
+            // Only the bucket's first material binds its texture, the others are sampled from the array
+            if (texture)
+                texture->touch();
+        }
+
+        const auto [it, inserted] = bucketIndex.try_emplace(key, set.buckets.size());
+        if (inserted) {
+            set.buckets.push_back({ material, std::get<1>(key), 0, 0, 0 });
+            bucketDraws.emplace_back();
+        }
+        bucketDraws[it->second].push_back({ range, element, texture ? slot.layer : -1 });
     }
-    else {
-        glDisable(GL_BLEND);
+
+    for (size_t b = 0; b < set.buckets.size(); b++) {
+        auto& bucket = set.buckets[b];
+        bucket.index = multiDrawBuckets++;
+        bucket.firstCommand = drawCommands.size();
+        bucket.commandCount = bucketDraws[b].size();
+        for (const auto& [range, element, textureLayer] : bucketDraws[b]) {
+            drawCommands.push_back({ range.indexCount, 1, range.firstIndex, range.baseVertex, static_cast<unsigned int>(drawMatrices.size()) });
+            drawMatrices.push_back(element->getWorldCoordinates());
+            drawTextureLayers.push_back(textureLayer);
+
+            const auto mesh = std::static_pointer_cast<Mesh>(element->getNode());
+            const size_t level = mesh->getActiveLod();
+            if (set.lodTriangles.size() <= level)
+                set.lodTriangles.resize(level + 1, 0);
+            set.lodTriangles[level] += mesh->getActiveGeometry()->getIndices().size() / 3;
+            set.meshes++;
+            if (gpuCulling) {
+                drawBounds.push_back({ glm::vec4(mesh->getBoundingSphereCenter(), mesh->getBoundingSphereRadius()),
+                    static_cast<unsigned int>(bucket.index), static_cast<unsigned int>(bucket.firstCommand), { 0, 0 } });
+                drawElements.push_back(element);
+            }
+        }
+    }
+
+    if (!set.buckets.empty())
+        multiDrawUploaded = false;
+    multiDrawSets.push_back(std::move(set));
+    return multiDrawSets.size() - 1;
+}
+
+/**
+ * @brief Uploads the multi-draw commands gathered for the view and culls them on the GPU.
+ *
+ * Only needed when a layer was gathered since the last upload, so a view uploads once
+ * per layer it draws whatever its number of lights. When the list uses a GPU culling
+ * mode and a gathered layer is culled, the GpuCuller culls every command; if it fails,
+ * the culled layers are tested on the CPU for this view, and the next view tries the
+ * GPU again.
+ *
+ * @param renderList The list of the view.
+ */
+void Eng::RenderPipeline::uploadMultiDraws(Eng::List* renderList) {
+    auto& geometryBuffer = GeometryBuffer::getInstance();
+    multiDrawUploaded = true;
+    multiDrawCulledOnGpu = false;
+    if (drawCommands.empty())
+        return;
+    geometryBuffer.uploadDraws(drawCommands, drawMatrices, drawTextureLayers);
+
+    const auto cullingMode = renderList->getCullingMode();
+    const bool culled = std::any_of(multiDrawSets.begin(), multiDrawSets.end(), [](const MultiDrawSet& set) {
+        return set.useCulling && !set.buckets.empty();
+    });
+    if (cullingMode == List::CullingMode::Cpu || !culled)
+        return;
+
+    auto& gpuCuller = GpuCuller::getInstance();
+    multiDrawCulledOnGpu = gpuCuller.cull(drawBounds, multiDrawBuckets, renderList->getEyeViewMatrix(), renderList->getCullingSphere());
+    if (!multiDrawCulledOnGpu) {
+        // Cull on the CPU for this view only: the culled commands stay in place and draw nothing
+        if (!gpuCullingFailureReported) {
+            std::cerr << "ERROR: GPU culling failed, culling on the CPU until it succeeds" << std::endl;
+            gpuCullingFailureReported = true;
+        }
+        for (const auto& set : multiDrawSets) {
+            if (!set.useCulling)
+                continue;
+            for (const auto& bucket : set.buckets)
+                for (size_t i = bucket.firstCommand; i < bucket.firstCommand + bucket.commandCount; i++)
+                    if (!renderList->isWithinCullingSphere(std::static_pointer_cast<Mesh>(drawElements[i]->getNode())))
+                        drawCommands[i].instanceCount = 0;
+        }
+        geometryBuffer.uploadDraws(drawCommands, drawMatrices, drawTextureLayers);
+    }
+    else if (cullingMode == List::CullingMode::Verify) {
+        const auto visibility = gpuCuller.readVisibility(drawElements.size());
+        const size_t mismatches = renderList->countCullingMismatches(drawElements, visibility);
+        if (mismatches)
+            std::cout << "[GpuCuller] Verification: " << mismatches << " of " << drawElements.size()
+                << " draws differ from the CPU test" << std::endl;
     }
 }
 
@@ -339,8 +741,11 @@ bool Eng::RenderPipeline::setupShadowMap(int width, int height) {
 /**
  * @brief Initializes the render pipeline by setting up shaders and shadow map.
  *
- * This method loads the shaders, sets up the shadow map framebuffer object (FBO),
- * and prepares the rendering context for the pipeline.
+ * This method submits the shaders, sets up the shadow map framebuffer object (FBO),
+ * and prepares the rendering context for the pipeline. All compiles and links are
+ * issued back to back without querying their status, so a driver supporting
+ * parallel compilation works on them concurrently; each program is waited on
+ * the first time it is loaded by the ShaderManager.
  *
  * @return true if initialization is successful, false otherwise.
  */
@@ -360,51 +765,94 @@ bool Eng::RenderPipeline::init() {
    uniform mat4 ShaderManager::UNIFORM_PROJECTION_MATRIX;
    uniform mat4 ShaderManager::UNIFORM_MODELVIEW_MATRIX;
    uniform mat3 ShaderManager::UNIFORM_NORMAL_MATRIX;
+   uniform bool ShaderManager::UNIFORM_USE_INSTANCING;
+   uniform bool ShaderManager::UNIFORM_USE_MULTIDRAW;
+
+   // Per-draw model matrices of multi-draw submissions
+   layout(std430, binding = ShaderManager::DRAW_DATA_BINDING) readonly buffer DrawData {
+      mat4 drawModel[];
+   };
+
+   // Per-draw diffuse texture array layers of multi-draw submissions, -1 for none
+   layout(std430, binding = ShaderManager::DRAW_TEXTURE_BINDING) readonly buffer DrawTextures {
+      int drawLayer[];
+   };
 
    // Attributes
    layout(location = ShaderManager::POSITION_LOCATION) in vec3 in_Position;
    layout(location = ShaderManager::NORMAL_LOCATION) in vec3 in_Normal;
    layout(location = ShaderManager::TEX_COORD_LOCATION) in vec2 in_TexCoord;  // Aggiunto per texture
+   layout(location = ShaderManager::INSTANCE_MATRIX_LOCATION) in mat4 in_InstanceModel;
+   layout(location = ShaderManager::DRAW_ID_LOCATION) in uint in_DrawId;
 
    // Varying (Passing to fragment shader):
    out vec4 fragPos;
    out vec3 fragNormal;
    out vec2 texCoord;  // Aggiunto per texture
+   flat out int texLayer;
 
    void main(void)
    {
+      // 0) Instanced and multi-draw submissions carry their model matrix per instance / per draw;
+      //    the uniforms then hold view-only matrices
+      vec4 position = vec4(in_Position, 1.0);
+      vec3 normal = in_Normal;
+      if (ShaderManager::UNIFORM_USE_INSTANCING) {
+         position = in_InstanceModel * position;
+         normal = transpose(inverse(mat3(in_InstanceModel))) * normal;
+      }
+      else if (ShaderManager::UNIFORM_USE_MULTIDRAW) {
+         mat4 model = drawModel[in_DrawId];
+         position = model * position;
+         normal = transpose(inverse(mat3(model))) * normal;
+      }
+
       // 1) Transform the incoming vertex position to eye space:
-      fragPos = ShaderManager::UNIFORM_MODELVIEW_MATRIX * vec4(in_Position, 1.0);
+      fragPos = ShaderManager::UNIFORM_MODELVIEW_MATRIX * position;
 
       // 2) Transform to clip space by applying the projection.
       gl_Position = ShaderManager::UNIFORM_PROJECTION_MATRIX * fragPos;
 
       // 3) Transform the normal from object space into eye space
-      fragNormal = ShaderManager::UNIFORM_NORMAL_MATRIX * in_Normal;
+      fragNormal = ShaderManager::UNIFORM_NORMAL_MATRIX * normal;
       
       // 4) Pass texture coordinates to fragment shader
       texCoord = in_TexCoord;
+      texLayer = ShaderManager::UNIFORM_USE_MULTIDRAW ? drawLayer[in_DrawId] : -1;
    }
 )";
 
 	basicVertexShader = std::make_shared<Eng::VertexShader>();
-	basicVertexShader->load(ShaderManager::preprocessShaderCode(basicVertexCode).c_str());
+	basicVertexShader->submit(ShaderManager::preprocessShaderCode(basicVertexCode).c_str());
 
 	/**************** Shadow Mapping vertex shader *****************/
 	const std::string shadowMapVertexCode = R"(
 #version 440 core
 layout (location = ShaderManager::POSITION_LOCATION) in vec3 aPos;
+layout (location = ShaderManager::INSTANCE_MATRIX_LOCATION) in mat4 in_InstanceModel;
+layout (location = ShaderManager::DRAW_ID_LOCATION) in uint in_DrawId;
+
+layout (std430, binding = ShaderManager::DRAW_DATA_BINDING) readonly buffer DrawData {
+    mat4 drawModel[];
+};
 
 uniform mat4 ShaderManager::UNIFORM_LIGHTSPACE_MATRIX; // in this case from the view of the light
+uniform bool ShaderManager::UNIFORM_USE_INSTANCING;
+uniform bool ShaderManager::UNIFORM_USE_MULTIDRAW;
 
 void main()
 {
-    gl_Position = ShaderManager::UNIFORM_LIGHTSPACE_MATRIX * vec4(aPos, 1.0);
+    vec4 position = vec4(aPos, 1.0);
+    if (ShaderManager::UNIFORM_USE_INSTANCING)
+        position = in_InstanceModel * position;
+    else if (ShaderManager::UNIFORM_USE_MULTIDRAW)
+        position = drawModel[in_DrawId] * position;
+    gl_Position = ShaderManager::UNIFORM_LIGHTSPACE_MATRIX * position;
 }
 )";
 
 	shadowMapVertexShader = std::make_shared<Eng::VertexShader>();
-	shadowMapVertexShader->load(ShaderManager::preprocessShaderCode(shadowMapVertexCode).c_str());
+	shadowMapVertexShader->submit(ShaderManager::preprocessShaderCode(shadowMapVertexCode).c_str());
 
 	/**************** Shadow Mapping fragment shader *****************/
 	const std::string shadowMapFragmentCode = R"(
@@ -416,7 +864,7 @@ void main() {
 )";
 
 	shadowMapFragmentShader = std::make_shared<Eng::FragmentShader>();
-	shadowMapFragmentShader->load(shadowMapFragmentCode.c_str());
+	shadowMapFragmentShader->submit(shadowMapFragmentCode.c_str());
 
 	/**************** Base Color fragment shader *****************/
 	const std::string baseFragmentCode = R"(
@@ -426,6 +874,7 @@ void main() {
    in vec4 fragPos;
    in vec3 fragNormal;
    in vec2 texCoord;  // Aggiunto per texture
+   flat in int texLayer;
 
    out vec4 fragOutput; // Final color to render
 
@@ -440,6 +889,7 @@ void main() {
 
    // Texture mapping:
    layout(binding = ShaderManager::DIFFUSE_TEXTURE_UNIT) uniform sampler2D texSampler;
+   layout(binding = ShaderManager::DIFFUSE_ARRAY_UNIT) uniform sampler2DArray texArraySampler;
    uniform bool ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE;  // Flag per indicare se usare la texture
 
    void main(void)
@@ -478,7 +928,7 @@ void main() {
 
       // Final color calculation with texture
       if (ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE) {
-         vec4 texColor = texture(texSampler, texCoord);
+         vec4 texColor = texLayer >= 0 ? texture(texArraySampler, vec3(texCoord, texLayer)) : texture(texSampler, texCoord);
          fragOutput = vec4(color, 1.0) * texColor;
       } else {
          fragOutput = vec4(color, 1.0);
@@ -487,7 +937,7 @@ void main() {
    }
 )";
 	basicFragmentShader = std::make_shared<Eng::FragmentShader>();
-	basicFragmentShader->load(ShaderManager::preprocessShaderCode(baseFragmentCode).c_str());
+	basicFragmentShader->submit(ShaderManager::preprocessShaderCode(baseFragmentCode).c_str());
 
 
 	/**************** Point Light fragment shader *****************/
@@ -499,6 +949,7 @@ void main() {
    in vec4 fragPos;
    in vec3 fragNormal;
    in vec2 texCoord;  // Aggiunto per texture
+   flat in int texLayer;
 
    out vec4 fragOutput; // Final color to render
 
@@ -519,6 +970,7 @@ void main() {
    
    // Texture mapping:
    layout(binding = ShaderManager::DIFFUSE_TEXTURE_UNIT) uniform sampler2D texSampler;
+   layout(binding = ShaderManager::DIFFUSE_ARRAY_UNIT) uniform sampler2DArray texArraySampler;
    uniform bool ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE;  // Flag per indicare se usare la texture
 
    void main(void)
@@ -559,7 +1011,7 @@ void main() {
       
       // Final color calculation with texture
       if (ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE) {
-         vec4 texColor = texture(texSampler, texCoord);
+         vec4 texColor = texLayer >= 0 ? texture(texArraySampler, vec3(texCoord, texLayer)) : texture(texSampler, texCoord);
          fragOutput = vec4(color, 1.0) * texColor;
       } else {
          fragOutput = vec4(color, 1.0);
@@ -568,7 +1020,7 @@ void main() {
 )";
 
 	pointFragmentShader = std::make_shared<Eng::FragmentShader>();
-	pointFragmentShader->load(ShaderManager::preprocessShaderCode(pointLightFragmentCode).c_str());
+	pointFragmentShader->submit(ShaderManager::preprocessShaderCode(pointLightFragmentCode).c_str());
 
 	/**************** Spot Light fragment shader *****************/
 
@@ -579,6 +1031,7 @@ void main() {
    in vec4 fragPos;
    in vec3 fragNormal;
    in vec2 texCoord;  // Aggiunto per texture
+   flat in int texLayer;
 
    out vec4 fragOutput; // Final color to render
 
@@ -602,6 +1055,7 @@ void main() {
    
    // Texture mapping:
    layout(binding = ShaderManager::DIFFUSE_TEXTURE_UNIT) uniform sampler2D texSampler;
+   layout(binding = ShaderManager::DIFFUSE_ARRAY_UNIT) uniform sampler2DArray texArraySampler;
    uniform bool ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE;  // Flag per indicare se usare la texture
 
    void main(void)
@@ -661,7 +1115,7 @@ void main() {
       
       // Final color calculation with texture
       if (ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE) {
-         vec4 texColor = texture(texSampler, texCoord);
+         vec4 texColor = texLayer >= 0 ? texture(texArraySampler, vec3(texCoord, texLayer)) : texture(texSampler, texCoord);
          fragOutput = vec4(color, 1.0) * texColor;
       } else {
          fragOutput = vec4(color, 1.0);
@@ -669,7 +1123,7 @@ void main() {
    }
 )";
 	spotFragmentShader = std::make_shared<Eng::FragmentShader>();
-	spotFragmentShader->load(ShaderManager::preprocessShaderCode(spotLightFragmentCode).c_str());
+	spotFragmentShader->submit(ShaderManager::preprocessShaderCode(spotLightFragmentCode).c_str());
 
 	/**************** Directional Light vertex shader *****************/
 	const std::string dirLightVertexCode = R"(
@@ -680,39 +1134,68 @@ uniform mat4 ShaderManager::UNIFORM_PROJECTION_MATRIX;
 uniform mat4 ShaderManager::UNIFORM_MODELVIEW_MATRIX;
 uniform mat3 ShaderManager::UNIFORM_NORMAL_MATRIX;
 uniform mat4 ShaderManager::UNIFORM_LIGHTSPACE_MATRIX; // Nuovo: trasforma verso light-space
+uniform bool ShaderManager::UNIFORM_USE_INSTANCING;
+uniform bool ShaderManager::UNIFORM_USE_MULTIDRAW;
+
+// Per-draw model matrices of multi-draw submissions
+layout(std430, binding = ShaderManager::DRAW_DATA_BINDING) readonly buffer DrawData {
+   mat4 drawModel[];
+};
+
+// Per-draw diffuse texture array layers of multi-draw submissions, -1 for none
+layout(std430, binding = ShaderManager::DRAW_TEXTURE_BINDING) readonly buffer DrawTextures {
+   int drawLayer[];
+};
 
 // Attributes
 layout(location = ShaderManager::POSITION_LOCATION) in vec3 in_Position;
 layout(location = ShaderManager::NORMAL_LOCATION) in vec3 in_Normal;
 layout(location = ShaderManager::TEX_COORD_LOCATION) in vec2 in_TexCoord;
+layout(location = ShaderManager::INSTANCE_MATRIX_LOCATION) in mat4 in_InstanceModel;
+layout(location = ShaderManager::DRAW_ID_LOCATION) in uint in_DrawId;
 
 // Varying (verso il fragment shader)
 out vec4 fragPos;
 out vec3 fragNormal;
 out vec2 texCoord;
+flat out int texLayer;
 out vec4 fragPosLightSpace; // Nuovo: posizione nel light-space
 
 void main(void)
 {
+   // 0) Instanced and multi-draw submissions carry their model matrix per instance / per draw
+   vec4 position = vec4(in_Position, 1.0);
+   vec3 normal = in_Normal;
+   if (ShaderManager::UNIFORM_USE_INSTANCING) {
+      position = in_InstanceModel * position;
+      normal = transpose(inverse(mat3(in_InstanceModel))) * normal;
+   }
+   else if (ShaderManager::UNIFORM_USE_MULTIDRAW) {
+      mat4 model = drawModel[in_DrawId];
+      position = model * position;
+      normal = transpose(inverse(mat3(model))) * normal;
+   }
+
    // 1) Transform into eye space
-   fragPos = ShaderManager::UNIFORM_MODELVIEW_MATRIX * vec4(in_Position, 1.0);
+   fragPos = ShaderManager::UNIFORM_MODELVIEW_MATRIX * position;
 
    // 2) Transform into clip space
    gl_Position = ShaderManager::UNIFORM_PROJECTION_MATRIX * fragPos;
 
    // 3) Normal transformed into eye space
-   fragNormal = ShaderManager::UNIFORM_NORMAL_MATRIX * in_Normal;
+   fragNormal = ShaderManager::UNIFORM_NORMAL_MATRIX * normal;
 
    // 4) Passing through texture coordinates
    texCoord = in_TexCoord;
+   texLayer = ShaderManager::UNIFORM_USE_MULTIDRAW ? drawLayer[in_DrawId] : -1;
 
    // 5) Computing light-space coordinates of the vertex
-   fragPosLightSpace = ShaderManager::UNIFORM_LIGHTSPACE_MATRIX * vec4(in_Position, 1.0);
+   fragPosLightSpace = ShaderManager::UNIFORM_LIGHTSPACE_MATRIX * position;
 }
 
 )";
 	dirLightVertexShader = std::make_shared<Eng::VertexShader>();
-	dirLightVertexShader->load(ShaderManager::preprocessShaderCode(dirLightVertexCode).c_str());
+	dirLightVertexShader->submit(ShaderManager::preprocessShaderCode(dirLightVertexCode).c_str());
 
 	/**************** Directional Light fragment shader *****************/
 
@@ -723,6 +1206,7 @@ void main(void)
 in vec4 fragPos;
 in vec3 fragNormal;
 in vec2 texCoord;
+flat in int texLayer;
 in vec4 fragPosLightSpace;
 
 out vec4 fragOutput;
@@ -745,6 +1229,7 @@ layout(binding = ShaderManager::SHADOW_MAP_UNIT) uniform sampler2D shadowMap;
 
 // Texture mapping
 layout(binding = ShaderManager::DIFFUSE_TEXTURE_UNIT) uniform sampler2D texSampler;
+layout(binding = ShaderManager::DIFFUSE_ARRAY_UNIT) uniform sampler2DArray texArraySampler;
 uniform bool ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE;
 
 float computeShadowFactor(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir)
@@ -788,7 +1273,7 @@ void main(void)
     }
 
     if (ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE) {
-        vec4 texColor = texture(texSampler, texCoord);
+        vec4 texColor = texLayer >= 0 ? texture(texArraySampler, vec3(texCoord, texLayer)) : texture(texSampler, texCoord);
         fragOutput = vec4(color, 1.0) * texColor;
     } else {
         fragOutput = vec4(color, 1.0);
@@ -796,41 +1281,46 @@ void main(void)
 }
 )";
 	directionalFragmentShader = std::make_shared<Eng::FragmentShader>();
-	directionalFragmentShader->load(ShaderManager::preprocessShaderCode(dirLightFragmentCode).c_str());
+	directionalFragmentShader->submit(ShaderManager::preprocessShaderCode(dirLightFragmentCode).c_str());
 
 
 	//Compile and link Basic Shaders used for the first pass
 	baseColorProgram = std::make_shared<Eng::Program>();
 	baseColorProgram->bindAttribute(ShaderManager::POSITION_LOCATION, "in_Position").bindAttribute(ShaderManager::NORMAL_LOCATION, "in_Normal").bindAttribute(ShaderManager::TEX_COORD_LOCATION, "in_TexCoord");
-	baseColorProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler");
-	if (!baseColorProgram->addShader(basicFragmentShader).addShader(basicVertexShader).build())
+	baseColorProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler").bindSampler(ShaderManager::DIFFUSE_ARRAY_UNIT, "texArraySampler");
+	baseColorProgram->addShader(basicFragmentShader).addShader(basicVertexShader);
+	if (!ShaderManager::getInstance().submitProgram(baseColorProgram))
 		return false;
 
 	//Compile and link Shaders used for the Shadow Mapping pass
 	shadowMapProgram = std::make_shared<Eng::Program>();
 	shadowMapProgram->bindAttribute(ShaderManager::POSITION_LOCATION, "aPos");
-	if (!shadowMapProgram->addShader(shadowMapFragmentShader).addShader(shadowMapVertexShader).build())
+	shadowMapProgram->addShader(shadowMapFragmentShader).addShader(shadowMapVertexShader);
+	if (!ShaderManager::getInstance().submitProgram(shadowMapProgram))
 		return false;
 
 	//Compile and link Point light pass program
 	pointLightProgram = std::make_shared<Eng::Program>();
 	pointLightProgram->bindAttribute(ShaderManager::POSITION_LOCATION, "in_Position").bindAttribute(ShaderManager::NORMAL_LOCATION, "in_Normal").bindAttribute(ShaderManager::TEX_COORD_LOCATION, "in_TexCoord");
-	pointLightProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler");
-	if (!pointLightProgram->addShader(pointFragmentShader).addShader(basicVertexShader).build())
+	pointLightProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler").bindSampler(ShaderManager::DIFFUSE_ARRAY_UNIT, "texArraySampler");
+	pointLightProgram->addShader(pointFragmentShader).addShader(basicVertexShader);
+	if (!ShaderManager::getInstance().submitProgram(pointLightProgram))
 		return false;
 
 	//Compile and link Shaders used for the Spot light pass
 	spotLightProgram = std::make_shared<Eng::Program>();
 	spotLightProgram->bindAttribute(ShaderManager::POSITION_LOCATION, "in_Position").bindAttribute(ShaderManager::NORMAL_LOCATION, "in_Normal").bindAttribute(ShaderManager::TEX_COORD_LOCATION, "in_TexCoord");
-	spotLightProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler");
-	if (!spotLightProgram->addShader(spotFragmentShader).addShader(basicVertexShader).build())
+	spotLightProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler").bindSampler(ShaderManager::DIFFUSE_ARRAY_UNIT, "texArraySampler");
+	spotLightProgram->addShader(spotFragmentShader).addShader(basicVertexShader);
+	if (!ShaderManager::getInstance().submitProgram(spotLightProgram))
 		return false;
 
 	//Compile and link Shaders used for the Directional light pass
 	dirLightProgram = std::make_shared<Eng::Program>();
 	dirLightProgram->bindAttribute(ShaderManager::POSITION_LOCATION, "in_Position").bindAttribute(ShaderManager::NORMAL_LOCATION, "in_Normal").bindAttribute(ShaderManager::TEX_COORD_LOCATION, "in_TexCoord");
-	dirLightProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler").bindSampler(ShaderManager::SHADOW_MAP_UNIT, "shadowMap");
-	if (!dirLightProgram->addShader(directionalFragmentShader).addShader(dirLightVertexShader).build())
+	dirLightProgram->bindSampler(ShaderManager::DIFFUSE_TEXTURE_UNIT, "texSampler").bindSampler(ShaderManager::DIFFUSE_ARRAY_UNIT, "texArraySampler").bindSampler(ShaderManager::SHADOW_MAP_UNIT, "shadowMap");
+	dirLightProgram->addShader(directionalFragmentShader).addShader(dirLightVertexShader);
+	if (!ShaderManager::getInstance().submitProgram(dirLightProgram))
 		return false;
 
 	initialized = true;
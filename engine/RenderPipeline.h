@@ -2,18 +2,42 @@
 
 class ENG_API RenderPipeline {
 public:
+	/**
+	 * @brief CPU submission statistics accumulated by runOn() since the last reset.
+	 */
+	struct SubmissionStats {
+		size_t views = 0;					///< Calls to runOn()
+		double milliseconds = 0.0;			///< CPU time spent building and issuing the GL commands
+		size_t drawCalls = 0;				///< GL draw calls issued, in all passes
+		size_t drawnMeshes = 0;				///< Meshes those draw calls drew
+		std::vector<size_t> lodTriangles;	///< Triangles submitted at each level of detail
+	};
+
 	RenderPipeline();
 	~RenderPipeline();
 	bool init();
 	void runOn(Eng::List* renderList);
+
+	const SubmissionStats& getSubmissionStats() const;
+	void resetSubmissionStats();
+	static void printStats(const SubmissionStats& stats);
 private:
 	// Forward declarations
 	struct RenderContext;
 	struct StatusCache;
+	struct MultiDrawSet;
 
 	bool setupShadowMap(int width, int height);
 
 	void renderPass(const std::shared_ptr<RenderContext>& context);
+	bool isVisible(const std::shared_ptr<RenderContext>& context, const std::shared_ptr<Eng::ListElement>& element);
+	void loadTransforms(const std::shared_ptr<RenderContext>& context, const glm::mat4& modelMatrix);
+	void renderElement(const std::shared_ptr<RenderContext>& context, const std::shared_ptr<Eng::ListElement>& element);
+	void renderInstances(const std::shared_ptr<RenderContext>& context, const std::shared_ptr<Eng::Mesh>& mesh, const std::vector<glm::mat4>& modelMatrices);
+	void renderMultiDraw(const std::shared_ptr<RenderContext>& context, const RenderLayer& layer);
+	size_t buildMultiDraw(const std::shared_ptr<RenderContext>& context, const RenderLayer& layer);
+	void uploadMultiDraws(Eng::List* renderList);
+	void countTriangles(const std::shared_ptr<Eng::Mesh>& mesh, size_t instances);
 
 	void shadowPass(std::shared_ptr <Eng::DirectionalLight>& light, Eng::List* renderList);
 
@@ -40,4 +64,23 @@ private:
 	std::shared_ptr<Eng::Program> shadowMapProgram;
 
 	std::unique_ptr<StatusCache> prevStatus;
+
+	///> Layers gathered for multi-draw in the current view, each reused by every pass drawing it
+	std::vector<MultiDrawSet> multiDrawSets;
+	///> Indirect commands, per-draw matrices and diffuse texture array layers of those layers
+	std::vector<Eng::GeometryBuffer::DrawCommand> drawCommands;
+	std::vector<glm::mat4> drawMatrices;
+	std::vector<int> drawTextureLayers;
+	///> Culling input of the draws, and the elements they come from, when culled on the GPU
+	std::vector<Eng::GpuCuller::DrawBounds> drawBounds;
+	std::vector<std::shared_ptr<Eng::ListElement>> drawElements;
+	///> Buckets of those layers, whether their commands are uploaded, and whether the GPU culled them
+	size_t multiDrawBuckets = 0;
+	bool multiDrawUploaded = false;
+	bool multiDrawCulledOnGpu = false;
+	///> Whether a failed GPU culling has been reported, so a persistent failure is logged once
+	bool gpuCullingFailureReported = false;
+
+	///> Submission statistics since the last resetSubmissionStats()
+	SubmissionStats submissionStats;
 };
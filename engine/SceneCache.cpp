@@ -0,0 +1,558 @@
+#include "Engine.h"
+
+#include <cstdint>
+#include <functional>
+#include <stack>
+#include <typeinfo>
+#include <unordered_map>
+
+namespace {
+	///> Identifies cooked files
+	constexpr char MAGIC[8] = { 'O', 'V', 'O', 'C', 'O', 'O', 'K', '\0' };
+	///> Marks a missing material or texture
+	constexpr uint32_t NONE = 0xffffffffu;
+	///> Alignment of the data blocks, from the start of the file
+	constexpr size_t BLOCK_ALIGNMENT = 16;
+
+	/**
+	 * @brief Node classes a cooked file can hold: the ones OvoReader creates.
+	 */
+	enum class NodeType : uint32_t {
+		NODE = 0, MESH, DIRECTIONAL_LIGHT, POINT_LIGHT, SPOT_LIGHT
+	};
+
+	/**
+	 * @brief File header, followed by the string table, the material, geometry,
+	 * LOD, hull, mesh hull and node tables, and the aligned data blocks.
+	 */
+	struct Header {
+		char magic[8];
+		uint32_t version;
+		uint32_t vertexSize;		///< sizeof(Eng::Vertex) when cooked
+		uint32_t compressed;		///< Vertex format of the buffer contents
+		uint32_t vertexWelding;		///< ImportSettings::vertexWelding when cooked
+		float weldEpsilon;			///< ImportSettings::weldEpsilon when cooked, 0 without welding
+		uint32_t stringBytes;		///< Size of the string table
+		uint64_t sourceHash;		///< SceneCache::hashSource() of the OVO file
+		uint32_t materialCount;
+		uint32_t geometryCount;
+		uint32_t lodCount;
+		uint32_t nodeCount;
+		uint32_t hullCount;
+		uint32_t meshHullCount;		///< Entries of the table of hulls per mesh
+		uint64_t dataOffset;		///< Start of the data blocks in the file
+		uint64_t dataBytes;			///< Size of the data blocks
+	};
+	static_assert(sizeof(Header) == 80, "Header must be tightly packed");
+
+	struct CookedMaterial {
+		glm::vec3 albedo;
+		float alpha;
+		glm::vec3 emission;
+		float shininess;
+		uint32_t texturePath;		///< Diffuse texture file, string offset or NONE
+	};
+	static_assert(sizeof(CookedMaterial) == 36, "CookedMaterial must be tightly packed");
+
+	struct CookedGeometry {
+		uint64_t hash;				///< Eng::Geometry::getHash()
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint64_t vertices;			///< Offset of the Eng::Vertex array in the data blocks
+		uint64_t indices;			///< Offset of the 32-bit index array
+		uint64_t vertexData;		///< Offset of the vertex buffer contents
+		uint64_t vertexDataBytes;
+		uint64_t indexData;			///< Offset of the index buffer contents
+		uint64_t indexDataBytes;
+	};
+	static_assert(sizeof(CookedGeometry) == 64, "CookedGeometry must be tightly packed");
+
+	struct CookedHull {
+		uint32_t vertexCount;
+		uint32_t planeCount;
+		uint64_t vertices;			///< Offset of the glm::vec3 vertex array in the data blocks
+		uint64_t planes;			///< Offset of the glm::vec4 plane array
+	};
+	static_assert(sizeof(CookedHull) == 24, "CookedHull must be tightly packed");
+
+	struct CookedNode {
+		uint32_t type;				///< NodeType
+		uint32_t name;				///< String offset
+		uint32_t children;			///< Number of children, which follow depth first
+		uint32_t material;			///< Material index or NONE
+		glm::mat4 matrix;			///< Local matrix
+		glm::vec3 vectors[3];		///< Mesh: bounding box min, max and sphere center; lights: color, direction
+		float scalars[3];			///< Mesh: sphere radius; point light: attenuation; spot light: cutoff, falloff, radius
+		uint32_t firstLod;			///< Mesh: first geometry index in the LOD table
+		uint32_t lodCount;			///< Mesh: number of levels of detail
+		uint32_t firstHull;			///< Mesh: first hull index in the mesh hull table
+		uint32_t hullCount;			///< Mesh: number of collision hulls
+	};
+	static_assert(sizeof(CookedNode) == 144, "CookedNode must be tightly packed");
+
+	static_assert(std::is_trivially_copyable_v<Eng::Vertex>, "Vertices are cooked as raw bytes");
+
+	/**
+	 * @brief Appends a block to the data blocks, aligned.
+	 * @return uint64_t Offset of the block in the data blocks.
+	 */
+	uint64_t appendBlock(std::vector<char>& data, const void* bytes, const size_t size) {
+		data.resize((data.size() + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT);
+		const uint64_t offset = data.size();
+		if (size)
+			data.insert(data.end(), static_cast<const char*>(bytes), static_cast<const char*>(bytes) + size);
+		return offset;
+	}
+
+	/**
+	 * @brief Writes an array of records, returning false on I/O errors.
+	 */
+	template <typename T>
+	bool writeArray(FILE* file, const T* values, const size_t count) {
+		return count == 0 || fwrite(values, sizeof(T), count, file) == count;
+	}
+
+	/**
+	 * @brief Reads a table of records from the view.
+	 */
+	template <typename T>
+	bool readTable(Eng::ChunkView& view, const size_t count, std::vector<T>& table) {
+		table.resize(count);
+		return view.readArray(table.data(), count);
+	}
+}
+
+/**
+ * @brief Gets where the cooked copy of a scene file is stored.
+ * @param sourceFile Path of the OVO file.
+ * @return std::string Path of the cooked file, next to the source.
+ */
+std::string Eng::SceneCache::getCachePath(const std::string& sourceFile) {
+	return sourceFile + ".cooked";
+}
+
+/**
+ * @brief Hashes the content of a scene file.
+ *
+ * FNV-1a over 64-bit words, with the high half folded back after every step so
+ * that each input bit reaches the whole state; the size is mixed in as well.
+ *
+ * @param data Content of the file.
+ * @param size Size of the content.
+ * @return uint64_t The hash.
+ */
+uint64_t Eng::SceneCache::hashSource(const char* data, const size_t size) {
+	constexpr uint64_t PRIME = 1099511628211ull;
+	uint64_t value = 14695981039346656037ull ^ size;
+
+	size_t i = 0;
+	for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+		uint64_t word;
+		std::memcpy(&word, data + i, sizeof(uint64_t));
+		value = (value ^ word) * PRIME;
+		value ^= value >> 32;
+	}
+	for (; i < size; i++)
+		value = (value ^ static_cast<unsigned char>(data[i])) * PRIME;
+	return value;
+}
+
+/**
+ * @brief Cooks a parsed scene graph into a file.
+ *
+ * The file is written under a temporary name and renamed once complete, so a
+ * failed write never leaves a truncated cache behind. Graphs holding nodes or
+ * materials of classes OvoReader does not create are not cooked.
+ *
+ * @param cacheFile Path of the cooked file.
+ * @param root Root of the graph, as returned by OvoReader::parseOvoFile().
+ * @param sourceHash hashSource() of the OVO file the graph comes from.
+ * @param settings Import settings the graph was parsed with.
+ * @return true if the file was written.
+ */
+bool Eng::SceneCache::save(const std::string& cacheFile, const std::shared_ptr<Eng::Node>& root, const uint64_t sourceHash,
+	const ImportSettings& settings) {
+	if (!root)
+		return false;
+
+	std::string strings;
+	std::vector<CookedMaterial> materials;
+	std::vector<CookedGeometry> geometries;
+	std::vector<uint32_t> lods;
+	std::vector<CookedHull> hulls;
+	std::vector<uint32_t> meshHulls;
+	std::vector<CookedNode> nodes;
+	std::vector<char> data;
+	std::unordered_map<const Eng::Material*, uint32_t> materialIndices;
+	std::unordered_map<const Eng::Geometry*, uint32_t> geometryIndices;
+	std::unordered_map<const Eng::CollisionHull*, uint32_t> hullIndices;
+	bool supported = true;
+
+	auto addString = [&strings](const std::string& value) {
+		const auto offset = static_cast<uint32_t>(strings.size());
+		strings.append(value).push_back('\0');
+		return offset;
+	};
+
+	auto addMaterial = [&](const std::shared_ptr<Eng::Material>& material) -> uint32_t {
+		if (!material)
+			return NONE;
+		if (typeid(*material) != typeid(Eng::Material)) {
+			supported = false;
+			return NONE;
+		}
+		const auto found = materialIndices.find(material.get());
+		if (found != materialIndices.end())
+			return found->second;
+
+		const auto texture = material->getDiffuseTexture();
+		materials.push_back({ material->getAlbedo(), material->getAlpha(), material->getEmission(), material->getShininess(),
+			texture ? addString(texture->getFilePath()) : NONE });
+		return materialIndices[material.get()] = static_cast<uint32_t>(materials.size() - 1);
+	};
+
+	auto addGeometry = [&](const std::shared_ptr<Eng::Geometry>& geometry) -> uint32_t {
+		const auto found = geometryIndices.find(geometry.get());
+		if (found != geometryIndices.end())
+			return found->second;
+		if (geometry->isCompressed() != Eng::Geometry::isVertexCompressionEnabled())
+			supported = false;
+
+		const auto& vertices = geometry->getVertices();
+		const auto& indices = geometry->getIndices();
+		const auto vertexData = geometry->getVertexData();
+		const auto indexData = geometry->getIndexData();
+		CookedGeometry cooked;
+		cooked.hash = geometry->getHash();
+		cooked.vertexCount = static_cast<uint32_t>(vertices.size());
+		cooked.indexCount = static_cast<uint32_t>(indices.size());
+		cooked.vertices = appendBlock(data, vertices.data(), vertices.size() * sizeof(Eng::Vertex));
+		cooked.indices = appendBlock(data, indices.data(), indices.size() * sizeof(unsigned int));
+		cooked.vertexData = appendBlock(data, vertexData.data(), vertexData.size());
+		cooked.vertexDataBytes = vertexData.size();
+		cooked.indexData = appendBlock(data, indexData.data(), indexData.size());
+		cooked.indexDataBytes = indexData.size();
+		geometries.push_back(cooked);
+		return geometryIndices[geometry.get()] = static_cast<uint32_t>(geometries.size() - 1);
+	};
+
+	auto addHull = [&](const std::shared_ptr<Eng::CollisionHull>& hull) -> uint32_t {
+		const auto found = hullIndices.find(hull.get());
+		if (found != hullIndices.end())
+			return found->second;
+
+		const auto& vertices = hull->getVertices();
+		const auto& planes = hull->getPlanes();
+		CookedHull cooked;
+		cooked.vertexCount = static_cast<uint32_t>(vertices.size());
+		cooked.planeCount = static_cast<uint32_t>(planes.size());
+		cooked.vertices = appendBlock(data, vertices.data(), vertices.size() * sizeof(glm::vec3));
+		cooked.planes = appendBlock(data, planes.data(), planes.size() * sizeof(glm::vec4));
+		hulls.push_back(cooked);
+		return hullIndices[hull.get()] = static_cast<uint32_t>(hulls.size() - 1);
+	};
+
+	// Depth-first, children right after their parent, as in OVO files
+	std::function<void(const std::shared_ptr<Eng::Node>&)> visit = [&](const std::shared_ptr<Eng::Node>& node) {
+		CookedNode cooked{};
+		cooked.name = addString(node->getName());
+		cooked.children = static_cast<uint32_t>(node->getChildren()->size());
+		cooked.material = NONE;
+		cooked.matrix = node->getLocalMatrix();
+
+		if (const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(node)) {
+			cooked.type = static_cast<uint32_t>(NodeType::MESH);
+			cooked.material = addMaterial(mesh->getMaterial());
+			cooked.vectors[0] = mesh->getBoundingBoxMin();
+			cooked.vectors[1] = mesh->getBoundingBoxMax();
+			cooked.vectors[2] = mesh->getBoundingSphereCenter();
+			cooked.scalars[0] = mesh->getBoundingSphereRadius();
+			cooked.firstLod = static_cast<uint32_t>(lods.size());
+			cooked.lodCount = static_cast<uint32_t>(mesh->getLodCount());
+			for (size_t l = 0; l < mesh->getLodCount(); l++)
+				lods.push_back(addGeometry(mesh->getLodGeometry(l)));
+			cooked.firstHull = static_cast<uint32_t>(meshHulls.size());
+			cooked.hullCount = static_cast<uint32_t>(mesh->getCollisionHulls().size());
+			for (const auto& hull : mesh->getCollisionHulls())
+				meshHulls.push_back(addHull(hull));
+		}
+		else if (const auto light = std::dynamic_pointer_cast<Eng::DirectionalLight>(node)) {
+			cooked.type = static_cast<uint32_t>(NodeType::DIRECTIONAL_LIGHT);
+			cooked.vectors[0] = light->getColor();
+			cooked.vectors[1] = light->getDirection();
+		}
+		else if (const auto light = std::dynamic_pointer_cast<Eng::PointLight>(node)) {
+			cooked.type = static_cast<uint32_t>(NodeType::POINT_LIGHT);
+			cooked.vectors[0] = light->getColor();
+			cooked.scalars[0] = light->getAttenuation();
+		}
+		else if (const auto light = std::dynamic_pointer_cast<Eng::SpotLight>(node)) {
+			cooked.type = static_cast<uint32_t>(NodeType::SPOT_LIGHT);
+			cooked.vectors[0] = light->getColor();
+			cooked.vectors[1] = light->getDirection();
+			cooked.scalars[0] = light->getCutoffAngle();
+			cooked.scalars[1] = light->getFalloff();
+			cooked.scalars[2] = light->getRadius();
+		}
+		else {
+			cooked.type = static_cast<uint32_t>(NodeType::NODE);
+			supported = supported && typeid(*node) == typeid(Eng::Node);
+		}
+		nodes.push_back(cooked);
+
+		for (const auto& child : *node->getChildren())
+			visit(child);
+	};
+	visit(root);
+
+	if (!supported) {
+		std::cout << "[SceneCache] Scene holds classes that cannot be cooked, '" << cacheFile << "' not written" << std::endl;
+		return false;
+	}
+
+	Header header{};
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = VERSION;
+	header.vertexSize = sizeof(Eng::Vertex);
+	header.compressed = Eng::Geometry::isVertexCompressionEnabled() ? 1 : 0;
+	header.vertexWelding = settings.vertexWelding ? 1 : 0;
+	header.weldEpsilon = settings.vertexWelding ? settings.weldEpsilon : 0.0f;
+	header.stringBytes = static_cast<uint32_t>(strings.size());
+	header.sourceHash = sourceHash;
+	header.materialCount = static_cast<uint32_t>(materials.size());
+	header.geometryCount = static_cast<uint32_t>(geometries.size());
+	header.lodCount = static_cast<uint32_t>(lods.size());
+	header.nodeCount = static_cast<uint32_t>(nodes.size());
+	header.hullCount = static_cast<uint32_t>(hulls.size());
+	header.meshHullCount = static_cast<uint32_t>(meshHulls.size());
+	const size_t tablesEnd = sizeof(Header) + strings.size() + materials.size() * sizeof(CookedMaterial)
+		+ geometries.size() * sizeof(CookedGeometry) + lods.size() * sizeof(uint32_t) + hulls.size() * sizeof(CookedHull)
+		+ meshHulls.size() * sizeof(uint32_t) + nodes.size() * sizeof(CookedNode);
+	header.dataOffset = (tablesEnd + BLOCK_ALIGNMENT - 1) / BLOCK_ALIGNMENT * BLOCK_ALIGNMENT;
+	header.dataBytes = data.size();
+
+	const std::string temporaryFile = cacheFile + ".tmp";
+	FILE* file = fopen(temporaryFile.c_str(), "wb");
+	if (file == nullptr) {
+		std::cout << "ERROR: unable to write scene cache '" << cacheFile << "'" << std::endl;
+		return false;
+	}
+	const char padding[BLOCK_ALIGNMENT] = {};
+	bool written = writeArray(file, &header, 1) && writeArray(file, strings.data(), strings.size())
+		&& writeArray(file, materials.data(), materials.size()) && writeArray(file, geometries.data(), geometries.size())
+		&& writeArray(file, lods.data(), lods.size()) && writeArray(file, hulls.data(), hulls.size())
+		&& writeArray(file, meshHulls.data(), meshHulls.size()) && writeArray(file, nodes.data(), nodes.size())
+		&& writeArray(file, padding, header.dataOffset - tablesEnd) && writeArray(file, data.data(), data.size());
+	written = fclose(file) == 0 && written;
+
+	// Replace the previous cache only with a complete one
+	std::remove(cacheFile.c_str());
+	if (!written || std::rename(temporaryFile.c_str(), cacheFile.c_str()) != 0) {
+		std::remove(temporaryFile.c_str());
+		std::cout << "ERROR: unable to write scene cache '" << cacheFile << "'" << std::endl;
+		return false;
+	}
+
+	std::cout << "[SceneCache] Cooked " << nodes.size() << " nodes, " << geometries.size() << " geometries, "
+		<< materials.size() << " materials into '" << cacheFile << "' (" << (header.dataOffset + data.size()) / 1024 << " KB)" << std::endl;
+	return true;
+}
+
+/**
+ * @brief Restores a scene graph from its cooked file.
+ *
+ * Every table entry and data block is bounds-checked. A missing file, or one
+ * cooked from other source bytes, with another layout revision, vertex format
+ * or welding settings, yields nullptr so that the caller parses the source instead.
+ * Textures are queued on the given TextureStreamer, if any, as OvoReader does.
+ *
+ * @param cacheFile Path of the cooked file.
+ * @param sourceHash hashSource() of the current OVO file.
+ * @param settings Import settings the scene would be parsed with.
+ * @param textureStreamer Streamer to queue textures on, nullptr to load them right away.
+ * @return std::shared_ptr<Eng::Node> Root of the restored graph, nullptr if the cache cannot be used.
+ */
+std::shared_ptr<Eng::Node> Eng::SceneCache::load(const std::string& cacheFile, const uint64_t sourceHash, const ImportSettings& settings,
+	Eng::TextureStreamer* textureStreamer) {
+	MappedFile file;
+	if (!file.open(cacheFile))
+		return nullptr;
+
+	ChunkView view(file.getData(), file.getSize());
+	const auto header = view.read<Header>();
+	if (!view.isValid() || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+		|| header.vertexSize != sizeof(Eng::Vertex) || header.compressed != (Eng::Geometry::isVertexCompressionEnabled() ? 1u : 0u)
+		|| header.vertexWelding != (settings.vertexWelding ? 1u : 0u)
+		|| header.weldEpsilon != (settings.vertexWelding ? settings.weldEpsilon : 0.0f) || header.sourceHash != sourceHash) {
+		std::cout << "[SceneCache] '" << cacheFile << "' is out of date" << std::endl;
+		return nullptr;
+	}
+
+	const char* strings = view.take(header.stringBytes);
+	std::vector<CookedMaterial> cookedMaterials;
+	std::vector<CookedGeometry> cookedGeometries;
+	std::vector<uint32_t> lods;
+	std::vector<CookedHull> cookedHulls;
+	std::vector<uint32_t> meshHulls;
+	std::vector<CookedNode> cookedNodes;
+	bool valid = readTable(view, header.materialCount, cookedMaterials) && readTable(view, header.geometryCount, cookedGeometries)
+		&& readTable(view, header.lodCount, lods) && readTable(view, header.hullCount, cookedHulls)
+		&& readTable(view, header.meshHullCount, meshHulls) && readTable(view, header.nodeCount, cookedNodes);
+
+	ChunkView fileView(file.getData(), file.getSize());
+	valid = valid && header.dataOffset >= view.getPosition() && fileView.skip(header.dataOffset);
+	const char* data = fileView.take(header.dataBytes);
+	valid = valid && fileView.isValid() && header.nodeCount > 0;
+
+	auto string = [&](const uint32_t offset) -> std::string {
+		if (offset >= header.stringBytes) {
+			valid = false;
+			return {};
+		}
+		ChunkView stringView(strings + offset, header.stringBytes - offset);
+		const std::string value(stringView.readString());
+		valid = valid && stringView.isValid();
+		return value;
+	};
+
+	// Data blocks of count elements, overflow-safe
+	auto block = [&](const uint64_t offset, const uint64_t count, const size_t elementSize) -> const char* {
+		if (offset > header.dataBytes || (elementSize && count > (header.dataBytes - offset) / elementSize)) {
+			valid = false;
+			return nullptr;
+		}
+		return data + offset;
+	};
+
+	std::vector<std::shared_ptr<Eng::Material>> materials;
+	for (const auto& cooked : cookedMaterials) {
+		if (!valid)
+			return nullptr;
+		auto material = std::make_shared<Eng::Material>(cooked.albedo, cooked.alpha, cooked.shininess, cooked.emission);
+		if (cooked.texturePath != NONE) {
+			const auto texture = Eng::TextureManager::getInstance().load(string(cooked.texturePath), textureStreamer == nullptr);
+			if (textureStreamer)
+				textureStreamer->enqueue(texture);
+			material->setDiffuseTexture(texture);
+		}
+		materials.push_back(material);
+	}
+
+	std::vector<std::shared_ptr<Eng::Geometry>> geometries;
+	for (const auto& cooked : cookedGeometries) {
+		const char* vertexBlock = block(cooked.vertices, cooked.vertexCount, sizeof(Eng::Vertex));
+		const char* indexBlock = block(cooked.indices, cooked.indexCount, sizeof(unsigned int));
+		const char* vertexDataBlock = block(cooked.vertexData, cooked.vertexDataBytes, 1);
+		const char* indexDataBlock = block(cooked.indexData, cooked.indexDataBytes, 1);
+		valid = valid && cooked.vertexDataBytes == uint64_t(cooked.vertexCount) * Eng::Geometry::getVertexStride(header.compressed != 0)
+			&& (cooked.indexDataBytes == uint64_t(cooked.indexCount) * sizeof(uint16_t) || cooked.indexDataBytes == uint64_t(cooked.indexCount) * sizeof(unsigned int));
+		if (!valid)
+			return nullptr;
+
+		std::vector<Eng::Vertex> vertices(cooked.vertexCount);
+		std::vector<unsigned int> indices(cooked.indexCount);
+		if (!vertices.empty())
+			std::memcpy(vertices.data(), vertexBlock, vertices.size() * sizeof(Eng::Vertex));
+		if (!indices.empty())
+			std::memcpy(indices.data(), indexBlock, indices.size() * sizeof(unsigned int));
+		std::vector<unsigned char> vertexData(vertexDataBlock, vertexDataBlock + cooked.vertexDataBytes);
+		std::vector<unsigned char> indexData(indexDataBlock, indexDataBlock + cooked.indexDataBytes);
+		geometries.push_back(Eng::Geometry::createCooked(std::move(vertices), std::move(indices), static_cast<size_t>(cooked.hash),
+			std::move(vertexData), std::move(indexData)));
+	}
+
+	std::vector<std::shared_ptr<Eng::CollisionHull>> hulls;
+	for (const auto& cooked : cookedHulls) {
+		const char* vertexBlock = block(cooked.vertices, cooked.vertexCount, sizeof(glm::vec3));
+		const char* planeBlock = block(cooked.planes, cooked.planeCount, sizeof(glm::vec4));
+		if (!valid)
+			return nullptr;
+
+		std::vector<glm::vec3> vertices(cooked.vertexCount);
+		std::vector<glm::vec4> planes(cooked.planeCount);
+		if (!vertices.empty())
+			std::memcpy(vertices.data(), vertexBlock, vertices.size() * sizeof(glm::vec3));
+		if (!planes.empty())
+			std::memcpy(planes.data(), planeBlock, planes.size() * sizeof(glm::vec4));
+		hulls.push_back(std::make_shared<Eng::CollisionHull>(std::move(vertices), std::move(planes)));
+	}
+
+	// Nodes are depth-first: each one is the next child of the innermost open parent
+	std::shared_ptr<Eng::Node> root;
+	std::stack<std::pair<std::shared_ptr<Eng::Node>, uint32_t>> parents;
+	for (const auto& cooked : cookedNodes) {
+		std::shared_ptr<Eng::Node> node;
+		switch (static_cast<NodeType>(cooked.type)) {
+		case NodeType::NODE:
+			node = std::make_shared<Eng::Node>();
+			break;
+		case NodeType::MESH: {
+			auto mesh = std::make_shared<Eng::Mesh>();
+			valid = valid && (cooked.material == NONE || cooked.material < materials.size())
+				&& cooked.firstLod <= lods.size() && cooked.lodCount <= lods.size() - cooked.firstLod
+				&& cooked.firstHull <= meshHulls.size() && cooked.hullCount <= meshHulls.size() - cooked.firstHull;
+			if (!valid)
+				return nullptr;
+			for (uint32_t l = 0; l < cooked.lodCount; l++) {
+				const uint32_t geometry = lods[cooked.firstLod + l];
+				if (geometry >= geometries.size())
+					return nullptr;
+				if (l == 0)
+					mesh->setGeometry(geometries[geometry]);
+				else
+					mesh->addLod(geometries[geometry]);
+			}
+			std::vector<std::shared_ptr<Eng::CollisionHull>> meshHullList;
+			for (uint32_t h = 0; h < cooked.hullCount; h++) {
+				const uint32_t hull = meshHulls[cooked.firstHull + h];
+				if (hull >= hulls.size())
+					return nullptr;
+				meshHullList.push_back(hulls[hull]);
+			}
+			mesh->setCollisionHulls(meshHullList);
+			if (cooked.material != NONE)
+				mesh->setMaterial(materials[cooked.material]);
+			mesh->setBoundingBox(cooked.vectors[0], cooked.vectors[1]);
+			mesh->setBoundingSphereCenter(cooked.vectors[2]);
+			mesh->setBoundingSphereRadius(cooked.scalars[0]);
+			node = mesh;
+			break;
+		}
+		case NodeType::DIRECTIONAL_LIGHT:
+			node = std::make_shared<Eng::DirectionalLight>(cooked.vectors[0], cooked.vectors[1]);
+			break;
+		case NodeType::POINT_LIGHT:
+			node = std::make_shared<Eng::PointLight>(cooked.vectors[0], cooked.scalars[0]);
+			break;
+		case NodeType::SPOT_LIGHT:
+			node = std::make_shared<Eng::SpotLight>(cooked.vectors[0], cooked.vectors[1], cooked.scalars[0], cooked.scalars[1], cooked.scalars[2]);
+			break;
+		default:
+			return nullptr;
+		}
+		node->setName(string(cooked.name));
+		node->setLocalMatrix(cooked.matrix);
+
+		if (!root) {
+			root = node;
+		}
+		else {
+			// Only the root may come without a parent
+			if (parents.empty())
+				return nullptr;
+			auto& parent = parents.top();
+			parent.first->addChild(node);
+			node->setParent(parent.first.get());
+			if (--parent.second == 0)
+				parents.pop();
+		}
+		if (cooked.children > 0)
+			parents.emplace(node, cooked.children);
+	}
+	if (!valid || !parents.empty())
+		return nullptr;
+
+	std::cout << "[SceneCache] Restored " << cookedNodes.size() << " nodes, " << geometries.size() << " geometries, "
+		<< materials.size() << " materials from '" << cacheFile << "'" << std::endl;
+	return root;
+}
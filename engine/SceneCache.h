@@ -0,0 +1,39 @@
+#pragma once
+
+/**
+ * @class SceneCache
+ * @brief Cooked binary copy of a parsed scene, stored next to its OVO file.
+ *
+ * Parsing an OVO file means walking its chunks, decoding every packed vertex and
+ * building the graph node by node. A cooked file holds the result instead: a
+ * flattened node table in depth-first order, the material table with texture
+ * references, the collision hulls of the meshes, and for each geometry its
+ * vertices and indices together with the vertex and index buffer contents ready
+ * for upload. Loading one maps the file,
+ * checks it and copies the blocks out, with no per-vertex work on the CPU.
+ *
+ * A cooked file is tied to the exact bytes of its source through a hash, to
+ * the engine's vertex layout and format, and to the import settings the
+ * geometry was decoded with; load() rejects it when any of them changed, so a
+ * stale cache is simply rebuilt.
+ */
+class ENG_API SceneCache final {
+public:
+	/**
+	 * @brief Import options the cooked geometry depends on.
+	 */
+	struct ImportSettings {
+		bool vertexWelding = true;	///< Whether duplicated vertices were welded, see OvoReader::setVertexWelding()
+		float weldEpsilon = 0.0f;	///< Welding tolerance, ignored without welding
+	};
+
+	///> Revision of the cooked layout, bumped on every change
+	static constexpr unsigned int VERSION = 3;
+
+	static std::string getCachePath(const std::string& sourceFile);
+	static uint64_t hashSource(const char* data, size_t size);
+
+	static bool save(const std::string& cacheFile, const std::shared_ptr<Eng::Node>& root, uint64_t sourceHash, const ImportSettings& settings);
+	static std::shared_ptr<Eng::Node> load(const std::string& cacheFile, uint64_t sourceHash, const ImportSettings& settings,
+		Eng::TextureStreamer* textureStreamer = nullptr);
+};
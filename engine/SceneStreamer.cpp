@@ -0,0 +1,222 @@
+#include "Engine.h"
+
+#include <algorithm>
+
+/**
+ * @brief Drops pending work and waits for the workers.
+ */
+Eng::SceneStreamer::~SceneStreamer() {
+	cancel();
+}
+
+/**
+ * @brief Sets how many worker threads run jobs.
+ *
+ * Takes effect for the workers started afterwards.
+ *
+ * @param count Worker threads, 0 for one per hardware thread but the render thread.
+ */
+void Eng::SceneStreamer::setThreadCount(const unsigned int count) {
+	pool.setThreadCount(count);
+}
+
+/**
+ * @brief Gets how many worker threads run jobs.
+ * @return unsigned int Worker threads, 0 for one per hardware thread but the render thread.
+ */
+unsigned int Eng::SceneStreamer::getThreadCount() const {
+	return pool.getThreadCount();
+}
+
+/**
+ * @brief Sets the time update() may spend on uploads.
+ *
+ * The budget is checked between uploads, so one long upload can overrun it; at
+ * least one upload runs per call, so streaming always makes progress.
+ *
+ * @param milliseconds Upload time per call, 0 for no limit.
+ */
+void Eng::SceneStreamer::setFrameBudget(const double milliseconds) {
+	std::lock_guard<std::mutex> lock(mutex);
+	frameBudget = std::max(0.0, milliseconds);
+}
+
+/**
+ * @brief Gets the time update() may spend on uploads.
+ * @return double Upload time per call in milliseconds, 0 for no limit.
+ */
+double Eng::SceneStreamer::getFrameBudget() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return frameBudget;
+}
+
+/**
+ * @brief Queues a job, starting a worker for it if fewer than the thread count run.
+ *
+ * Anything the job reads must stay alive until it ran: capture it by value (e.g.
+ * a shared_ptr to the mapped file its payload points into).
+ *
+ * @param job Worker half of the job, returning its render thread half.
+ */
+void Eng::SceneStreamer::enqueue(Job job) {
+	pool.joinFinished();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (complete) {
+		stats = Stats();
+		start = std::chrono::steady_clock::now();
+		complete = false;
+	}
+	jobs.push_back(std::move(job));
+	stats.queued++;
+	pool.start([this](const unsigned int generation) { work(generation); });
+}
+
+/**
+ * @brief Registers a callback to run once every queued job has been uploaded.
+ *
+ * Callbacks run on the render thread from update(), in registration order, after
+ * the last upload; with nothing queued, they run on the next update().
+ *
+ * @param callback Function to call.
+ */
+void Eng::SceneStreamer::whenComplete(std::function<void()> callback) {
+	std::lock_guard<std::mutex> lock(mutex);
+	completions.push_back(std::move(callback));
+}
+
+/**
+ * @brief Runs the uploads of finished jobs until the frame budget is spent.
+ *
+ * Call once per frame from the render thread, before the scene is traversed.
+ * Once the last job has been uploaded, the completion callbacks run as well.
+ *
+ * @return size_t Number of uploads run.
+ */
+size_t Eng::SceneStreamer::update() {
+	const auto frameStart = std::chrono::steady_clock::now();
+	const double budget = getFrameBudget();
+
+	size_t done = 0;
+	while (true) {
+		Upload upload;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (uploads.empty())
+				break;
+			upload = std::move(uploads.front());
+			uploads.pop_front();
+		}
+		if (upload)
+			upload();
+		done++;
+
+		const double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+		if (budget > 0.0 && elapsed >= budget)
+			break;
+	}
+
+	std::vector<std::function<void()>> callbacks;
+	bool report = false;
+	Stats finishedStats;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stats.uploaded += done;
+		if (done)
+			stats.frames++;
+		if (jobs.empty() && uploads.empty() && pool.isIdle()) {
+			callbacks.swap(completions);
+			if (!complete) {
+				complete = true;
+				stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+				finishedStats = stats;
+				report = true;
+			}
+		}
+	}
+
+	pool.joinFinished();
+	if (report)
+		printStats(finishedStats);
+	for (const auto& callback : callbacks)
+		callback();
+	return done;
+}
+
+/**
+ * @brief Drops the jobs and uploads not run yet, along with the completion callbacks.
+ *
+ * Waits for the jobs being run by workers; their results are discarded.
+ */
+void Eng::SceneStreamer::cancel() {
+	pool.cancel([this]() {
+		jobs.clear();
+		uploads.clear();
+		completions.clear();
+		stats = Stats();
+		complete = true;
+	});
+}
+
+/**
+ * @brief Checks whether every queued job has been uploaded and its completion handled.
+ * @return bool True when nothing is left for update() to do.
+ */
+bool Eng::SceneStreamer::isComplete() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return complete && completions.empty();
+}
+
+/**
+ * @brief Gets the fraction of the current jobs already uploaded.
+ * @return float Progress between 0 and 1, 1 with nothing queued.
+ */
+float Eng::SceneStreamer::getProgress() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats.queued ? static_cast<float>(stats.uploaded) / static_cast<float>(stats.queued) : 1.0f;
+}
+
+/**
+ * @brief Gets the progress counters of the current, or last completed, jobs.
+ * @return Stats Counters, timing filled once complete.
+ */
+Eng::SceneStreamer::Stats Eng::SceneStreamer::getStats() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+/**
+ * @brief Prints a summary of completed streaming.
+ * @param stats Counters returned by getStats().
+ */
+void Eng::SceneStreamer::printStats(const Stats& stats) {
+	std::cout << "[SceneStreamer] " << stats.uploaded << " assets streamed in " << stats.milliseconds
+		<< " ms over " << stats.frames << " frames" << std::endl;
+}
+
+/**
+ * @brief Worker loop: runs jobs until none is left or the streamer is cancelled.
+ * @param generation Value of the cancel counter when the worker was started.
+ */
+void Eng::SceneStreamer::work(const unsigned int generation) {
+	while (true) {
+		Job job;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!pool.isCurrent(generation) || jobs.empty()) {
+				pool.leave();
+				return;
+			}
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+
+		Upload upload = job();
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (pool.isCurrent(generation)) {
+			uploads.push_back(std::move(upload));
+			stats.decoded++;
+		}
+	}
+}
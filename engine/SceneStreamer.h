@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @class SceneStreamer
+ * @brief Runs loading work on background threads and finishes it on the render thread.
+ *
+ * Progressive loading splits every asset into two halves: a job, run on a worker
+ * thread, does the CPU work (decoding a mesh payload, reading and converting an
+ * image) and returns an upload, run later on the render thread, that creates the
+ * GPU objects and attaches the result to the scene. update() is called once per
+ * frame and runs the uploads that are ready until the frame budget is spent, so
+ * a large scene fills in over several frames instead of stalling the first one.
+ *
+ * Jobs are started in the order they were queued; uploads run in the order their
+ * jobs finished. Callbacks registered with whenComplete() run on the render thread
+ * once every queued job has been uploaded. Workers only exist while jobs are
+ * pending, and cancel() drops whatever was not uploaded yet.
+ */
+class ENG_API SceneStreamer final {
+public:
+	///> Render thread half of a job, typically a GPU upload; may be empty
+	using Upload = std::function<void()>;
+	///> Worker thread half of a job, returning its upload
+	using Job = std::function<Upload()>;
+
+	/**
+	 * @brief Progress of the jobs queued since the last completion or cancel().
+	 */
+	struct Stats {
+		size_t queued = 0;			///< Jobs queued
+		size_t decoded = 0;			///< Jobs whose worker half finished
+		size_t uploaded = 0;		///< Uploads run on the render thread
+		size_t frames = 0;			///< update() calls that ran at least one upload
+		double milliseconds = 0.0;	///< Time from the first job to the last upload
+	};
+
+	///> Default time spent on uploads per frame, in milliseconds
+	static constexpr double DEFAULT_FRAME_BUDGET = 2.0;
+
+	SceneStreamer() = default;
+	~SceneStreamer();
+	SceneStreamer(const SceneStreamer&) = delete;
+	void operator=(const SceneStreamer&) = delete;
+
+	void setThreadCount(unsigned int count);
+	unsigned int getThreadCount() const;
+	void setFrameBudget(double milliseconds);
+	double getFrameBudget() const;
+
+	void enqueue(Job job);
+	void whenComplete(std::function<void()> callback);
+	size_t update();
+	void cancel();
+
+	bool isComplete() const;
+	float getProgress() const;
+	Stats getStats() const;
+	static void printStats(const Stats& stats);
+
+private:
+	void work(unsigned int generation);
+
+	///> Guards every member below
+	mutable std::mutex mutex;
+	///> Workers running jobs
+	WorkerPool pool{ mutex };
+	///> Jobs not started yet, in queue order
+	std::deque<Job> jobs;
+	///> Uploads of finished jobs, in completion order
+	std::deque<Upload> uploads;
+	///> Callbacks waiting for the current jobs to complete
+	std::vector<std::function<void()>> completions;
+	///> Progress of the current jobs
+	Stats stats;
+	///> Whether the current jobs were all uploaded and reported
+	bool complete = true;
+	///> When the first of the current jobs was queued
+	std::chrono::steady_clock::time_point start;
+	///> Upload time per update() call, in milliseconds; 0 for no limit
+	double frameBudget = DEFAULT_FRAME_BUDGET;
+};
@@ -7,7 +7,7 @@
  *
  * Initializes the internal shader ID to 0.
  */
-ENG_API Eng::Shader::Shader() : id(0)
+ENG_API Eng::Shader::Shader() : id(0), checked(false), compiled(false)
 { }
 
 /**
@@ -31,14 +31,29 @@ unsigned int ENG_API Eng::Shader::getGlId() {
 /**
  * @brief Loads and compiles a shader from source code in memory.
  *
- * This method checks the input data, destroys any existing shader,
- * creates a new shader object via create(), uploads the source,
- * compiles it, and logs any errors up to MAX_LOGSIZE.
+ * Blocking helper equivalent to submit() followed by finish(): the
+ * compile status is queried right away, stalling until the driver is done.
  *
  * @param data Pointer to a null-terminated string containing the GLSL source code.
  * @return True if compilation succeeded; false otherwise.
  */
 bool ENG_API Eng::Shader::load(const char* data) {
+	return submit(data) && finish();
+}
+
+/**
+ * @brief Hands the shader source to the driver without waiting for the result.
+ *
+ * This method checks the input data, destroys any existing shader,
+ * creates a new shader object via create(), uploads the source and
+ * issues the compile. The compile status is not queried here, so drivers
+ * supporting parallel compilation can keep working in the background
+ * until finish() (or a Program link) actually needs the result.
+ *
+ * @param data Pointer to a null-terminated string containing the GLSL source code.
+ * @return True if the compile was submitted; false otherwise.
+ */
+bool ENG_API Eng::Shader::submit(const char* data) {
 	if (data == nullptr)
 	{
 		std::cout << "[ERROR] Invalid params" << std::endl;
@@ -48,6 +63,8 @@ bool ENG_API Eng::Shader::load(const char* data) {
 	// Destroy if already loaded:
 	if (id)
 		glDeleteShader(id);
+	checked = false;
+	compiled = false;
 
 	// Load program:
 	id = create();
@@ -59,6 +76,41 @@ bool ENG_API Eng::Shader::load(const char* data) {
 	glShaderSource(id, 1, (const char**)&data, NULL);
 	glCompileShader(id);
 
+	// Done:
+	return true;
+}
+
+/**
+ * @brief Polls whether the driver has finished compiling the shader.
+ *
+ * Uses GL_COMPLETION_STATUS_KHR when parallel compilation is supported;
+ * otherwise the compile is assumed to be complete (finish() will block).
+ *
+ * @return True if finish() can be called without stalling.
+ */
+bool ENG_API Eng::Shader::isReady() {
+	if (checked || id == 0 || !isParallelCompileSupported())
+		return true;
+
+	int done = GL_FALSE;
+	glGetShaderiv(id, GL_COMPLETION_STATUS_KHR, &done);
+	return done == GL_TRUE;
+}
+
+/**
+ * @brief Waits for the submitted compile and reports its outcome.
+ *
+ * Queries GL_COMPILE_STATUS (blocking if the driver is still busy) and logs
+ * any errors up to MAX_LOGSIZE. The result is cached, so later calls are free.
+ *
+ * @return True if compilation succeeded; false otherwise.
+ */
+bool ENG_API Eng::Shader::finish() {
+	if (checked)
+		return compiled;
+	if (id == 0)
+		return false;
+
 	// Verify shader:
 	int status;
 	char buffer[MAX_LOGSIZE];
@@ -66,9 +118,11 @@ bool ENG_API Eng::Shader::load(const char* data) {
 	memset(buffer, 0, MAX_LOGSIZE);
 
 	glGetShaderiv(id, GL_COMPILE_STATUS, &status);
-	glGetShaderInfoLog(id, MAX_LOGSIZE, &length, buffer);
-	if (status == false)
+	checked = true;
+	compiled = status != GL_FALSE;
+	if (!compiled)
 	{
+		glGetShaderInfoLog(id, MAX_LOGSIZE, &length, buffer);
 		std::cout << "[ERROR] Shader not compiled: " << buffer << std::endl;
 		return false;
 	}
@@ -77,6 +131,28 @@ bool ENG_API Eng::Shader::load(const char* data) {
 	return true;
 }
 
+/**
+ * @brief Checks whether the driver exposes non-blocking shader compilation.
+ *
+ * @return True if GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile is available.
+ */
+bool ENG_API Eng::Shader::isParallelCompileSupported() {
+	return GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile;
+}
+
+/**
+ * @brief Lets the driver spawn as many compiler threads as it wants.
+ *
+ * Must be called once after GLEW initialization and before submitting shaders.
+ * Does nothing when parallel compilation is not supported.
+ */
+void ENG_API Eng::Shader::enableParallelCompile() {
+	if (GLEW_KHR_parallel_shader_compile)
+		glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+	else if (GLEW_ARB_parallel_shader_compile)
+		glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+}
+
 /**
  * @brief Binds and uses this shader program.
  *
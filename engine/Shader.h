@@ -15,12 +15,20 @@ public:
 	Shader();
 	~Shader();
 	bool load(const char* data);
+	bool submit(const char* data);
+	bool isReady();
+	bool finish();
 	void render() override;
 	
 	unsigned int getGlId();
+
+	static void enableParallelCompile();
+	static bool isParallelCompileSupported();
 protected:
 	virtual unsigned int create() = 0;
 private:
 	// OGL id:
 	unsigned int id;
+	bool checked;	///< True once the compile status has been queried
+	bool compiled;	///< Result of the last compile status query
 };
@@ -3,6 +3,128 @@
 // GLEW
 #include <GL/glew.h>
 
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <string_view>
+
+namespace {
+	/**
+	 * @brief Compile-time decimal spelling of a non-negative integer constant.
+	 *
+	 * Lets the symbol table below hold the same values as the ShaderManager
+	 * constants without any std::to_string at runtime.
+	 */
+	template <int Value>
+	struct IntSymbol {
+		static_assert(Value >= 0, "Only non-negative constants can be substituted in shaders");
+		static constexpr std::array<char, 12> digits = [] {
+			std::array<char, 12> out{};
+			int v = Value, n = 0;
+			do {
+				out[n++] = static_cast<char>('0' + v % 10);
+				v /= 10;
+			} while (v);
+			for (int i = 0; i < n / 2; ++i)
+				std::swap(out[i], out[n - 1 - i]);
+			return out;
+		}();
+		static constexpr std::string_view value{ digits.data() };
+	};
+
+	/** @brief A symbol usable in GLSL sources as "ShaderManager::<name>". */
+	struct ShaderSymbol {
+		std::string_view name;	///< Identifier following the prefix
+		std::string_view value;	///< Text it is replaced with
+	};
+
+	constexpr std::string_view SHADER_SYMBOL_PREFIX = "ShaderManager::";
+
+	using SM = Eng::ShaderManager;
+
+	///< Symbol table, kept sorted by name so lookups can bisect
+	constexpr std::array<ShaderSymbol, 42> SHADER_SYMBOLS = { {
+		{"CULL_BOUNDS_BINDING", IntSymbol<SM::CULL_BOUNDS_BINDING>::value},
+		{"CULL_COMMANDS_BINDING", IntSymbol<SM::CULL_COMMANDS_BINDING>::value},
+		{"CULL_DRAW_COUNTS_BINDING", IntSymbol<SM::CULL_DRAW_COUNTS_BINDING>::value},
+		{"CULL_SOURCE_COMMANDS_BINDING", IntSymbol<SM::CULL_SOURCE_COMMANDS_BINDING>::value},
+		{"CULL_VISIBILITY_BINDING", IntSymbol<SM::CULL_VISIBILITY_BINDING>::value},
+		{"DIFFUSE_ARRAY_UNIT", IntSymbol<SM::DIFFUSE_ARRAY_UNIT>::value},
+		{"DIFFUSE_TEXTURE_UNIT", IntSymbol<SM::DIFFUSE_TEXTURE_UNIT>::value},
+		{"DRAW_DATA_BINDING", IntSymbol<SM::DRAW_DATA_BINDING>::value},
+		{"DRAW_ID_LOCATION", IntSymbol<SM::DRAW_ID_LOCATION>::value},
+		{"DRAW_TEXTURE_BINDING", IntSymbol<SM::DRAW_TEXTURE_BINDING>::value},
+		{"INSTANCE_MATRIX_LOCATION", IntSymbol<SM::INSTANCE_MATRIX_LOCATION>::value},
+		{"NORMAL_LOCATION", IntSymbol<SM::NORMAL_LOCATION>::value},
+		{"POSITION_LOCATION", IntSymbol<SM::POSITION_LOCATION>::value},
+		{"SHADOW_MAP_UNIT", IntSymbol<SM::SHADOW_MAP_UNIT>::value},
+		{"TEX_COORD_LOCATION", IntSymbol<SM::TEX_COORD_LOCATION>::value},
+		{"UNIFORM_ATTENUATION_CONSTANT", SM::UNIFORM_ATTENUATION_CONSTANT},
+		{"UNIFORM_ATTENUATION_LINEAR", SM::UNIFORM_ATTENUATION_LINEAR},
+		{"UNIFORM_ATTENUATION_QUADRATIC", SM::UNIFORM_ATTENUATION_QUADRATIC},
+		{"UNIFORM_EYE_FRONT", SM::UNIFORM_EYE_FRONT},
+		{"UNIFORM_GLOBAL_LIGHT_COLOR", SM::UNIFORM_GLOBAL_LIGHT_COLOR},
+		{"UNIFORM_LIGHTSPACE_MATRIX", SM::UNIFORM_LIGHTSPACE_MATRIX},
+		{"UNIFORM_LIGHT_AMBIENT", SM::UNIFORM_LIGHT_AMBIENT},
+		{"UNIFORM_LIGHT_CASTS_SHADOWS", SM::UNIFORM_LIGHT_CASTS_SHADOWS},
+		{"UNIFORM_LIGHT_CUTOFF_ANGLE", SM::UNIFORM_LIGHT_CUTOFF_ANGLE},
+		{"UNIFORM_LIGHT_DIFFUSE", SM::UNIFORM_LIGHT_DIFFUSE},
+		{"UNIFORM_LIGHT_DIRECTION", SM::UNIFORM_LIGHT_DIRECTION},
+		{"UNIFORM_LIGHT_FALLOFF", SM::UNIFORM_LIGHT_FALLOFF},
+		{"UNIFORM_LIGHT_POSITION", SM::UNIFORM_LIGHT_POSITION},
+		{"UNIFORM_LIGHT_SPECULAR", SM::UNIFORM_LIGHT_SPECULAR},
+		{"UNIFORM_MATERIAL_AMBIENT", SM::UNIFORM_MATERIAL_AMBIENT},
+		{"UNIFORM_MATERIAL_DIFFUSE", SM::UNIFORM_MATERIAL_DIFFUSE},
+		{"UNIFORM_MATERIAL_EMISSION", SM::UNIFORM_MATERIAL_EMISSION},
+		{"UNIFORM_MATERIAL_SHININESS", SM::UNIFORM_MATERIAL_SHININESS},
+		{"UNIFORM_MATERIAL_SPECULAR", SM::UNIFORM_MATERIAL_SPECULAR},
+		{"UNIFORM_MODELVIEW_MATRIX", SM::UNIFORM_MODELVIEW_MATRIX},
+		{"UNIFORM_MODEL_MATRIX", SM::UNIFORM_MODEL_MATRIX},
+		{"UNIFORM_NORMAL_MATRIX", SM::UNIFORM_NORMAL_MATRIX},
+		{"UNIFORM_PROJECTION_MATRIX", SM::UNIFORM_PROJECTION_MATRIX},
+		{"UNIFORM_USE_INSTANCING", SM::UNIFORM_USE_INSTANCING},
+		{"UNIFORM_USE_MULTIDRAW", SM::UNIFORM_USE_MULTIDRAW},
+		{"UNIFORM_USE_TEXTURE_DIFFUSE", SM::UNIFORM_USE_TEXTURE_DIFFUSE},
+		{"UNIFORM_VIEW_MATRIX", SM::UNIFORM_VIEW_MATRIX}
+	} };
+
+	static_assert(std::ranges::is_sorted(SHADER_SYMBOLS, {}, &ShaderSymbol::name),
+		"SHADER_SYMBOLS must stay sorted by name");
+
+	/**
+	 * @brief Looks up a symbol name in the compile-time table.
+	 * @param name Identifier following the "ShaderManager::" prefix.
+	 * @return Pointer to the matching entry, nullptr if unknown.
+	 */
+	constexpr const ShaderSymbol* findShaderSymbol(std::string_view name) {
+		const auto it = std::ranges::lower_bound(SHADER_SYMBOLS, name, {}, &ShaderSymbol::name);
+		return (it != SHADER_SYMBOLS.end() && it->name == name) ? &*it : nullptr;
+	}
+
+	static_assert(findShaderSymbol("UNIFORM_PROJECTION_MATRIX") != nullptr);
+	static_assert(findShaderSymbol("UNIFORM_PROJECTION") == nullptr);
+
+	constexpr bool isIdentifierChar(char c) {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+	}
+
+	/**
+	 * @brief Memoised preprocessor output, keyed by source hash.
+	 *
+	 * The original source is kept alongside the result so a hash collision
+	 * can never hand back the wrong shader.
+	 */
+	struct ShaderCodeCache {
+		std::mutex mutex;
+		std::unordered_map<size_t, std::pair<std::string, std::string>> entries;
+	};
+
+	ShaderCodeCache& getShaderCodeCache() {
+		static ShaderCodeCache cache;
+		return cache;
+	}
+}
+
 
 /**
  * @brief Retrieves the singleton instance of the ShaderManager.
@@ -366,6 +488,38 @@ void ENG_API Eng::ShaderManager::setEyeFront(const glm::vec3& front) {
 	currentProgram->setVec3(eyeFrontLoc, front);
 }
 
+/**
+ * @brief Enables or disables the per-instance model matrix attribute.
+ *
+ * When enabled, the vertex shaders apply the matrix read at
+ * INSTANCE_MATRIX_LOCATION on top of the model-view uniform.
+ *
+ * @param use True for instanced draws.
+ */
+void ENG_API Eng::ShaderManager::setUseInstancing(bool use) {
+	if (useInstancingLoc == -1) {
+		//std::cerr << "[ERROR]ShaderManager: instancing use location not found in Program " << currentProgram->getGlId() << std::endl;
+		return;
+	}
+	currentProgram->setInt(useInstancingLoc, use ? 1 : 0);
+}
+
+/**
+ * @brief Enables or disables the per-draw model matrix lookup.
+ *
+ * When enabled, the vertex shaders apply the matrix stored at DRAW_DATA_BINDING
+ * for the draw index read at DRAW_ID_LOCATION on top of the model-view uniform.
+ *
+ * @param use True for multi-draw indirect submissions.
+ */
+void ENG_API Eng::ShaderManager::setUseMultiDraw(bool use) {
+	if (useMultiDrawLoc == -1) {
+		//std::cerr << "[ERROR]ShaderManager: multi-draw use location not found in Program " << currentProgram->getGlId() << std::endl;
+		return;
+	}
+	currentProgram->setInt(useMultiDrawLoc, use ? 1 : 0);
+}
+
 /**
  * @brief Compiles and loads default shaders for basic red color output.
  *
@@ -405,11 +559,11 @@ bool ENG_API Eng::ShaderManager::setDefaultShaders() {
 
 	// Compile vertex shader:
 	std::shared_ptr<Eng::VertexShader> vertexShader = std::make_shared<Eng::VertexShader>();
-	vertexShader->load(vs);
+	vertexShader->submit(vs);
 
 	// Compile fragment shader:
 	std::shared_ptr<Eng::FragmentShader> fragmentShader = std::make_shared<Eng::FragmentShader>();
-	fragmentShader->load(fs);
+	fragmentShader->submit(fs);
 
 	// Setup shader program:
 	defaultProgram = std::make_shared<Eng::Program>();
@@ -417,17 +571,68 @@ bool ENG_API Eng::ShaderManager::setDefaultShaders() {
 	// Important: position = 0, normal = 1, texture = 2
 	defaultProgram->bindAttribute(POSITION_LOCATION, "in_Position");
 
-	if (!defaultProgram->addShader(fragmentShader).addShader(vertexShader).build())
+	// Linked in the background like the other programs, and awaited on first use
+	defaultProgram->addShader(fragmentShader).addShader(vertexShader);
+	return submitProgram(defaultProgram);
+}
+
+/**
+ * @brief Issues the link of a program and tracks it until it is collected.
+ *
+ * The link proceeds on the driver's compiler threads while the caller does other
+ * work; pollPrograms() or finishPrograms() collect the result, or the program's
+ * first use does.
+ *
+ * @param program The program to link, its shaders already submitted.
+ * @return True if the link was submitted.
+ */
+bool ENG_API Eng::ShaderManager::submitProgram(const std::shared_ptr<Eng::Program>& program) {
+	if (!program || !program->submit())
 		return false;
+	pendingPrograms.push_back(program);
+	return true;
+}
+
+/**
+ * @brief Collects the submitted programs the driver has finished linking, without stalling.
+ *
+ * Without parallel compilation every link counts as finished, so this waits for them all.
+ *
+ * @return size_t Number of programs still linking.
+ */
+size_t ENG_API Eng::ShaderManager::pollPrograms() {
+	std::erase_if(pendingPrograms, [](const std::weak_ptr<Eng::Program>& pending) {
+		const auto program = pending.lock();
+		if (!program)
+			return true;
+		if (!program->isReady())
+			return false;
+		program->finish();
+		return true;
+	});
+	return pendingPrograms.size();
+}
 
-	return loadProgram(defaultProgram);
+/**
+ * @brief Waits for every submitted program and reports the failed ones.
+ *
+ * @return True if all the programs still alive linked successfully.
+ */
+bool ENG_API Eng::ShaderManager::finishPrograms() {
+	bool linked = true;
+	for (const auto& pending : pendingPrograms) {
+		if (const auto program = pending.lock())
+			linked = program->finish() && linked;
+	}
+	pendingPrograms.clear();
+	return linked;
 }
 
 /**
  * @brief Loads a shader program and retrieves uniform locations.
  *
- * Skips if the program is already active, then caches uniform locations,
- * binds the program, and updates currentProgram.
+ * Skips if the program is already active, otherwise waits for a pending link,
+ * caches uniform locations, binds the program, and updates currentProgram.
  *
  * @param program Shared pointer to the Program to load.
  * @return True if the program was bound successfully.
@@ -442,6 +647,9 @@ bool ENG_API Eng::ShaderManager::loadProgram(std::shared_ptr<Eng::Program>& prog
 		return true;
 	}
 
+	if (!program->finish())
+		return false;
+
 	projectionLocation = program->getParamLocation(UNIFORM_PROJECTION_MATRIX);
 	modelViewLocation = program->getParamLocation(UNIFORM_MODELVIEW_MATRIX);
 	modelLocation = program->getParamLocation(UNIFORM_MODEL_MATRIX);
@@ -474,6 +682,9 @@ bool ENG_API Eng::ShaderManager::loadProgram(std::shared_ptr<Eng::Program>& prog
 
 	eyeFrontLoc = program->getParamLocation(UNIFORM_EYE_FRONT);
 
+	useInstancingLoc = program->getParamLocation(UNIFORM_USE_INSTANCING);
+	useMultiDrawLoc = program->getParamLocation(UNIFORM_USE_MULTIDRAW);
+
 	program->render();
 	currentProgram = program;
 
@@ -483,66 +694,86 @@ bool ENG_API Eng::ShaderManager::loadProgram(std::shared_ptr<Eng::Program>& prog
 /**
  * @brief Preprocesses shader code by replacing predefined symbols.
  *
+ * Every "ShaderManager::<NAME>" token whose name is in the compile-time symbol
+ * table is replaced with the constant's value; unknown names are left as they are.
+ * The source is scanned once, and results are memoised by source hash, so
+ * preprocessing the same shader again only costs a hash and a lookup.
+ *
  * @param source Original GLSL source code.
  * @return Processed source with symbol substitutions.
  */
 std::string ENG_API Eng::ShaderManager::preprocessShaderCode(const std::string& source) {
-	auto symbolMap = buildShaderSymbolMap();
+	auto& cache = getShaderCodeCache();
+	const size_t key = std::hash<std::string>{}(source);
+	{
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		const auto it = cache.entries.find(key);
+		if (it != cache.entries.end() && it->second.first == source)
+			return it->second.second;
+	}
 
-	std::string result = source;
+	std::string result = substituteShaderSymbols(source);
 
-	// Sostituzione automatica dei simboli con i valori delle costanti
-	for (const auto& entry : symbolMap) {
-		size_t pos = 0;
-		const std::string& replacement = entry.second;
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	cache.entries[key] = { source, result };
+	return result;
+}
 
-		// Sostituzione della stringa
-		while ((pos = result.find(entry.first, pos)) != std::string::npos) {
-			result.replace(pos, entry.first.length(), replacement);
-			pos += replacement.length();
-		}
-	}
+/**
+ * @brief Drops all memoised preprocessor results.
+ */
+void ENG_API Eng::ShaderManager::clearShaderCodeCache() {
+	auto& cache = getShaderCodeCache();
+	std::lock_guard<std::mutex> lock(cache.mutex);
+	cache.entries.clear();
+}
 
-	return result;
+/**
+ * @brief Lists the symbols usable in GLSL sources after the "ShaderManager::" prefix.
+ * @return Symbol names, sorted.
+ */
+std::vector<std::string_view> ENG_API Eng::ShaderManager::getShaderSymbolNames() {
+	std::vector<std::string_view> names;
+	names.reserve(SHADER_SYMBOLS.size());
+	for (const auto& symbol : SHADER_SYMBOLS)
+		names.push_back(symbol.name);
+	return names;
 }
 
 /**
- * @brief Builds a map of shader symbol names to their string values.
- *
- * @return Unordered map mapping symbol strings to constant values.
- */
-std::unordered_map<std::string, std::string> ENG_API Eng::ShaderManager::buildShaderSymbolMap() {
-	return {
-		{"ShaderManager::POSITION_LOCATION", std::to_string(POSITION_LOCATION)},
-		{"ShaderManager::NORMAL_LOCATION", std::to_string(NORMAL_LOCATION)},
-		{"ShaderManager::TEX_COORD_LOCATION", std::to_string(TEX_COORD_LOCATION)},
-		{"ShaderManager::DIFFUSE_TEXTURE_UNIT", std::to_string(DIFFUSE_TEXTURE_UNIT)},
-		{"ShaderManager::SHADOW_MAP_UNIT", std::to_string(SHADOW_MAP_UNIT)},
-
-		{"ShaderManager::UNIFORM_PROJECTION_MATRIX", UNIFORM_PROJECTION_MATRIX},
-		{"ShaderManager::UNIFORM_MODELVIEW_MATRIX", UNIFORM_MODELVIEW_MATRIX},
-		{"ShaderManager::UNIFORM_MODEL_MATRIX", UNIFORM_MODEL_MATRIX},
-		{"ShaderManager::UNIFORM_VIEW_MATRIX", UNIFORM_VIEW_MATRIX},
-		{"ShaderManager::UNIFORM_NORMAL_MATRIX", UNIFORM_NORMAL_MATRIX},
-		{"ShaderManager::UNIFORM_LIGHTSPACE_MATRIX", UNIFORM_LIGHTSPACE_MATRIX},
-		{"ShaderManager::UNIFORM_MATERIAL_EMISSION", UNIFORM_MATERIAL_EMISSION},
-		{"ShaderManager::UNIFORM_MATERIAL_AMBIENT", UNIFORM_MATERIAL_AMBIENT},
-		{"ShaderManager::UNIFORM_MATERIAL_DIFFUSE", UNIFORM_MATERIAL_DIFFUSE},
-		{"ShaderManager::UNIFORM_MATERIAL_SPECULAR", UNIFORM_MATERIAL_SPECULAR},
-		{"ShaderManager::UNIFORM_MATERIAL_SHININESS", UNIFORM_MATERIAL_SHININESS},
-		{"ShaderManager::UNIFORM_USE_TEXTURE_DIFFUSE", UNIFORM_USE_TEXTURE_DIFFUSE},
-		{"ShaderManager::UNIFORM_LIGHT_POSITION", UNIFORM_LIGHT_POSITION},
-		{"ShaderManager::UNIFORM_LIGHT_DIRECTION", UNIFORM_LIGHT_DIRECTION},
-		{"ShaderManager::UNIFORM_LIGHT_AMBIENT", UNIFORM_LIGHT_AMBIENT},
-		{"ShaderManager::UNIFORM_LIGHT_DIFFUSE", UNIFORM_LIGHT_DIFFUSE},
-		{"ShaderManager::UNIFORM_LIGHT_SPECULAR", UNIFORM_LIGHT_SPECULAR},
-		{"ShaderManager::UNIFORM_LIGHT_CASTS_SHADOWS", UNIFORM_LIGHT_CASTS_SHADOWS},
-		{"ShaderManager::UNIFORM_ATTENUATION_CONSTANT", UNIFORM_ATTENUATION_CONSTANT},
-		{"ShaderManager::UNIFORM_ATTENUATION_LINEAR", UNIFORM_ATTENUATION_LINEAR},
-		{"ShaderManager::UNIFORM_ATTENUATION_QUADRATIC", UNIFORM_ATTENUATION_QUADRATIC},
-		{"ShaderManager::UNIFORM_LIGHT_CUTOFF_ANGLE", UNIFORM_LIGHT_CUTOFF_ANGLE},
-		{"ShaderManager::UNIFORM_LIGHT_FALLOFF", UNIFORM_LIGHT_FALLOFF},
-		{"ShaderManager::UNIFORM_GLOBAL_LIGHT_COLOR", UNIFORM_GLOBAL_LIGHT_COLOR},
-		{"ShaderManager::UNIFORM_EYE_FRONT", UNIFORM_EYE_FRONT}
-	};
+ * @brief Single-pass symbol substitution, bypassing the memoisation cache.
+ *
+ * Scans for the "ShaderManager::" prefix, reads the identifier that follows
+ * and copies either its value or the original token to the output.
+ *
+ * @param source Original GLSL source code.
+ * @return Processed source with symbol substitutions.
+ */
+std::string ENG_API Eng::ShaderManager::substituteShaderSymbols(const std::string& source) {
+	const std::string_view view(source);
+	std::string result;
+	result.reserve(source.size());
+
+	size_t pos = 0;
+	while (pos < view.size()) {
+		const size_t hit = view.find(SHADER_SYMBOL_PREFIX, pos);
+		if (hit == std::string_view::npos)
+			break;
+
+		const size_t nameStart = hit + SHADER_SYMBOL_PREFIX.size();
+		size_t nameEnd = nameStart;
+		while (nameEnd < view.size() && isIdentifierChar(view[nameEnd]))
+			++nameEnd;
+
+		result.append(view.substr(pos, hit - pos));
+		if (const ShaderSymbol* symbol = findShaderSymbol(view.substr(nameStart, nameEnd - nameStart)))
+			result.append(symbol->value);
+		else
+			result.append(view.substr(hit, nameEnd - hit));
+		pos = nameEnd;
+	}
+	if (pos < view.size())
+		result.append(view.substr(pos));
+
+	return result;
 }
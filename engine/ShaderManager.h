@@ -22,6 +22,16 @@ public:
 	static constexpr int TEX_COORD_LOCATION = 2;	//Location bound to texture coordinates in the Vertex Shader
 	static constexpr int DIFFUSE_TEXTURE_UNIT = 0;	//Texture Unit bound to the diffuse texture sampler in the Fragment Shader
 	static constexpr int SHADOW_MAP_UNIT = 1;		//Texture Unit bound to the shadow map sampler in the Fragment Shader
+	static constexpr int INSTANCE_MATRIX_LOCATION = 3;	//First of the 4 locations bound to the per-instance model matrix in the Vertex Shader
+	static constexpr int DRAW_ID_LOCATION = 7;		//Location bound to the multi-draw index (per instance, from the base instance) in the Vertex Shader
+	static constexpr int DRAW_DATA_BINDING = 0;		//Shader storage binding of the per-draw data (model matrices) in the Vertex Shader
+	static constexpr int DIFFUSE_ARRAY_UNIT = 2;	//Texture Unit bound to the diffuse texture array sampler in the Fragment Shader
+	static constexpr int DRAW_TEXTURE_BINDING = 6;	//Shader storage binding of the per-draw diffuse texture array layers in the Vertex Shader
+	static constexpr int CULL_SOURCE_COMMANDS_BINDING = 1;	//Shader storage binding of the indirect commands to cull in the culling Compute Shader
+	static constexpr int CULL_BOUNDS_BINDING = 2;			//Shader storage binding of the per-draw bounding spheres in the culling Compute Shader
+	static constexpr int CULL_COMMANDS_BINDING = 3;			//Shader storage binding of the culled indirect commands in the culling Compute Shader
+	static constexpr int CULL_DRAW_COUNTS_BINDING = 4;		//Shader storage binding of the per-bucket draw counts in the culling Compute Shader
+	static constexpr int CULL_VISIBILITY_BINDING = 5;		//Shader storage binding of the per-draw visibility flags in the culling Compute Shader
 
 	// VARIABLE NAMES
 	static constexpr const char* UNIFORM_PROJECTION_MATRIX = "projection";		//Projection matrix - Uniform name
@@ -56,8 +66,14 @@ public:
 
 	static constexpr const char* UNIFORM_EYE_FRONT = "eyeFront";	//Camera front vector - Uniform name
 
+	static constexpr const char* UNIFORM_USE_INSTANCING = "useInstancing";	//Per-instance model matrix use flag (bool) - Uniform name
+	static constexpr const char* UNIFORM_USE_MULTIDRAW = "useMultiDraw";	//Per-draw model matrix use flag (bool) - Uniform name
+
 
 	bool loadProgram(std::shared_ptr<Eng::Program>& program);
+	bool submitProgram(const std::shared_ptr<Eng::Program>& program);
+	size_t pollPrograms();
+	bool finishPrograms();
 
 	void setProjectionMatrix(const glm::mat4& matrix);
 	void setModelViewMatrix(const glm::mat4& matrix);
@@ -89,6 +105,9 @@ public:
 
 	void setEyeFront(const glm::vec3& front);
 
+	void setUseInstancing(bool use);
+	void setUseMultiDraw(bool use);
+
 
 	const glm::mat4& getCachedProjectionMatrix()  const { return cachedProjection; }
 	const glm::mat4& getCachedModelViewMatrix()   const { return cachedModelView; }
@@ -99,6 +118,9 @@ public:
 
 
 	static std::string preprocessShaderCode(const std::string& source);
+	static std::string substituteShaderSymbols(const std::string& source);
+	static std::vector<std::string_view> getShaderSymbolNames();
+	static void clearShaderCodeCache();
 	std::shared_ptr<Eng::Program> getCurrentProgram() const { return currentProgram; }
 
 private:
@@ -108,42 +130,45 @@ private:
 	bool initialized = false;
 	bool setDefaultShaders();
 
-	static std::unordered_map<std::string, std::string> buildShaderSymbolMap();
-
 	std::shared_ptr<Eng::Program> defaultProgram;
 	std::shared_ptr<Eng::Program> currentProgram;
+	///< Programs submitted through submitProgram() whose link has not been collected yet
+	std::vector<std::weak_ptr<Eng::Program>> pendingPrograms;
 
 	//int texSamplerLoc; not necessary, texture sampler location is set engine side when binding the texture
-	int useTextureLoc;
-
-	int projectionLocation;
-	int modelViewLocation;
-	int modelLocation;
-	int viewLocation;
-	int normalMatrixLocation;
-	int lightSpaceMatrixLocation;
-
-	int matEmissionLoc;
-	int matAmbientLoc;
-	int matDiffuseLoc;
-	int matSpecularLoc;
-	int matShininessLoc;
-
-	int lightPosLoc;
-	int lightDirLoc;
-	int lightCutoffAngleLoc;
-	int lightFalloffLoc;
-	int lightAmbientLoc;
-	int lightDiffuseLoc;
-	int lightSpecularLoc;
-	int lightCastsShadowsLoc;
-	int attenuationConstantLoc;
-	int attenuationLinearLoc;
-	int attenuationQuadraticLoc;
-
-	int globalLightColorLoc;
-
-	int eyeFrontLoc;
+	int useTextureLoc = -1;
+
+	int projectionLocation = -1;
+	int modelViewLocation = -1;
+	int modelLocation = -1;
+	int viewLocation = -1;
+	int normalMatrixLocation = -1;
+	int lightSpaceMatrixLocation = -1;
+
+	int matEmissionLoc = -1;
+	int matAmbientLoc = -1;
+	int matDiffuseLoc = -1;
+	int matSpecularLoc = -1;
+	int matShininessLoc = -1;
+
+	int lightPosLoc = -1;
+	int lightDirLoc = -1;
+	int lightCutoffAngleLoc = -1;
+	int lightFalloffLoc = -1;
+	int lightAmbientLoc = -1;
+	int lightDiffuseLoc = -1;
+	int lightSpecularLoc = -1;
+	int lightCastsShadowsLoc = -1;
+	int attenuationConstantLoc = -1;
+	int attenuationLinearLoc = -1;
+	int attenuationQuadraticLoc = -1;
+
+	int globalLightColorLoc = -1;
+
+	int eyeFrontLoc = -1;
+
+	int useInstancingLoc = -1;
+	int useMultiDrawLoc = -1;
 
 	// cache degli ultimi valori inviati agli uniform comuni
 	glm::mat4 cachedProjection = glm::mat4(1.0f);
@@ -1,6 +1,5 @@
 #include "Engine.h"
 
-#include "FreeImage.h"
 #include <GL/glew.h>
 
 // Cube vertices for the skybox (36 vertices for a cube)
@@ -112,9 +111,6 @@ Eng::Skybox::~Skybox()
     if (vbo) {
         glDeleteBuffers(1, &vbo);
     }
-    if (cubemapTexture) {
-        glDeleteTextures(1, &cubemapTexture);
-    }
 }
 
 /**
@@ -143,14 +139,14 @@ bool Eng::Skybox::init()
 
     // Build the skybox shader program.
     std::shared_ptr<VertexShader> vs = std::make_shared<VertexShader>();
-    if (!vs->load(skyboxVertShaderSrc)) {
-        std::cerr << "[Skybox] Failed to load vertex shader source." << std::endl;
+    if (!vs->submit(skyboxVertShaderSrc)) {
+        std::cerr << "[Skybox] Failed to submit vertex shader source." << std::endl;
         return false;
     }
 
     std::shared_ptr<FragmentShader> fs = std::make_shared<FragmentShader>();
-    if (!fs->load(skyboxFragShaderSrc)) {
-        std::cerr << "[Skybox] Failed to load fragment shader source." << std::endl;
+    if (!fs->submit(skyboxFragShaderSrc)) {
+        std::cerr << "[Skybox] Failed to submit fragment shader source." << std::endl;
         return false;
     }
 
@@ -161,8 +157,9 @@ bool Eng::Skybox::init()
     program->addShader(vs);
     program->addShader(fs);
 
-    if (!program->build()) {
-        std::cerr << "[Skybox] Failed to build the shader program." << std::endl;
+    // Linked in the background, awaited on first render
+    if (!ShaderManager::getInstance().submitProgram(program)) {
+        std::cerr << "[Skybox] Failed to submit the shader program." << std::endl;
         return false;
     }
     // Directly store the program as our skyboxProgram.
@@ -172,91 +169,20 @@ bool Eng::Skybox::init()
 }
 
 /**
- * @brief Loads six images into an OpenGL cubemap texture and computes global ambient color.
+ * @brief Gets the cubemap of the six faces from the TextureManager and computes global ambient color.
  *
  * @return True on successful loading of all faces; false on error.
  */
 bool Eng::Skybox::loadCubemap()
 {
-    glGenTextures(1, &cubemapTexture);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture);
-
-    // Set wrapping and filtering parameters.
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glm::vec3 faceAverageColorSum(0.0f);
-    int faceCount = faces.size();
-
-    // Load each of the six faces.
-    for (unsigned int i = 0; i < faces.size(); i++) {
-        const char* file = faces[i].c_str();
-        FREE_IMAGE_FORMAT fif = FreeImage_GetFileType(file, 0);
-        if (fif == FIF_UNKNOWN) {
-            fif = FreeImage_GetFIFFromFilename(file);
-        }
-        if (fif == FIF_UNKNOWN) {
-            std::cerr << "[Skybox] Unable to determine format for " << file << std::endl;
-            return false;
-        }
-        FIBITMAP* dib = FreeImage_Load(fif, file);
-        if (!dib) {
-            std::cerr << "[Skybox] Failed to load image " << file << std::endl;
-            return false;
-        }
-        BYTE* bits = FreeImage_GetBits(dib);
-        int width = FreeImage_GetWidth(dib);
-        int height = FreeImage_GetHeight(dib);
-
-        // Determine internal format and pixel data format.
-        // FreeImage stores pixel data in BGR(A) format, but we want OpenGL to store it internally as RGB(A).
-        GLenum internalFormat;
-        GLenum format;
-        int channels;
-        GLenum type = GL_UNSIGNED_BYTE;
-        if (FreeImage_GetBPP(dib) == 32) {
-            internalFormat = GL_RGBA;
-            format = GL_BGRA;
-			channels = 4;
-        }
-        else if (FreeImage_GetBPP(dib) == 128 || FreeImage_GetBPP(dib) == 96) { // 32 bit per canale (floating point HDR)
-            internalFormat = GL_RGB16F;
-            format = GL_RGB;
-            type = GL_FLOAT;
-            channels = 3;
-        }
-        else {
-            internalFormat = GL_RGB;
-            format = GL_BGR;
-			channels = 3;
-        }
-
-        FreeImage_FlipVertical(dib);
-        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, internalFormat, width, height,
-            0, format, type, bits);
-
-        glm::vec3 faceAverageColor;
-        if (type == GL_FLOAT) { //HDR
-            float* floatBits = (float*)bits;
-            faceAverageColor = calculateWeightedAverageColorHDR(floatBits, width, height, channels);
-        }
-        else { //LDR
-            faceAverageColor = calculateWeightedAverageColor(bits, width, height, channels);
-        }
-        faceAverageColorSum += faceAverageColor;
-
-        FreeImage_Unload(dib);
+    cubemap = TextureManager::getInstance().loadCubemap(faces);
+    if (!cubemap || !cubemap->isLoaded()) {
+        cubemap.reset();
+        return false;
     }
-    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
-
-	// Compute average color of all faces
-	glm::vec3 globalAverageColor = faceAverageColorSum / static_cast<float>(faceCount);
 
 	// Set the global color based on the average color of the skybox
-    globalColor = glm::vec3{ globalAverageColor.r * 0.2f, globalAverageColor.g * 0.2f, globalAverageColor.b * 0.2f };
+    globalColor = cubemap->getAverageColor() * 0.2f;
     return true;
 }
 
@@ -291,8 +217,7 @@ void Eng::Skybox::render(const glm::mat4& viewMatrix, const glm::mat4& projectio
 
     // Bind the VAO and cubemap texture.
     glBindVertexArray(vao);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture);
+    cubemap->render();
     // Draw the cube (36 vertices).
     glDrawArrays(GL_TRIANGLES, 0, 36);
     glBindVertexArray(0);
@@ -303,91 +228,6 @@ void Eng::Skybox::render(const glm::mat4& viewMatrix, const glm::mat4& projectio
     glDepthMask(prevDepthMask);
 }
 
-/**
- * @brief Computes weighted average color of an LDR image buffer.
- *
- * Weights each pixel by luminance to better represent perceived brightness.
- *
- * @param bits     Raw pixel data (BGR[A]).
- * @param width    Image width in pixels.
- * @param height   Image height in pixels.
- * @param channels Number of channels (3 or 4).
- * @return Weighted average RGB color (0–1 range).
- */
-glm::vec3 Eng::Skybox::calculateWeightedAverageColor(unsigned char* bits, int width, int height, int channels)
-{
-    float totalLuminance = 0.0f;
-    glm::vec3 weightedColor(0.0f);
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int pixelIndex = (y * width + x) * channels;
-
-            // Read colors (ignoring alpha if present)
-            float r = bits[pixelIndex + 2] / 255.0f;  // Red (index +2 in BGR(A))
-            float g = bits[pixelIndex + 1] / 255.0f;  // Green
-            float b = bits[pixelIndex + 0] / 255.0f;  // Blue
-
-            float luminance = 0.2126f * r + 0.7152f * g + 0.0722f * b;
-
-            weightedColor += glm::vec3(r, g, b) * luminance;
-            totalLuminance += luminance;
-        }
-    }
-
-    if (totalLuminance > 0.0f) {
-        weightedColor /= totalLuminance;
-    }
-
-    return weightedColor;
-}
-
-/**
- * @brief Computes weighted average color for HDR image buffers.
- *
- * Performs tone-mapping on high dynamic range values before weighting.
- *
- * @param floatBits Raw float pixel data (RGB[A]).
- * @param width     Image width.
- * @param height    Image height.
- * @param channels  Number of channels (3 or 4).
- * @return Weighted average color after tone mapping.
- */
-glm::vec3 Eng::Skybox::calculateWeightedAverageColorHDR(float* floatBits, int width, int height, int channels) {
-    float totalLuminance = 0.0f;
-    glm::vec3 weightedColor(0.0f);
-
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            int pixelIndex = (y * width + x) * channels;
-
-            // Read colors (ignoring alpha if present)
-            float r = floatBits[pixelIndex + 0];  // Red (index +0 in RGB(A) format for EXR)
-            float g = floatBits[pixelIndex + 1];  // Green
-            float b = floatBits[pixelIndex + 2];  // Blue
-
-            //Uses tone mapping to map color to 0 -1 range
-            if (r > 1.0f || g > 1.0f || b > 1.0f) {
-                // log compression
-                r = 1.0f + log2(r) * 0.5f;
-                g = 1.0f + log2(g) * 0.5f;
-                b = 1.0f + log2(b) * 0.5f;
-            }
-
-            float luminance = 0.2126f * r + 0.7152f * g + 0.0722f * b;
-
-            weightedColor += glm::vec3(r, g, b) * luminance;
-            totalLuminance += luminance;
-        }
-    }
-
-    if (totalLuminance > 0.0f) {
-        weightedColor /= totalLuminance;
-    }
-
-    return weightedColor;
-}
-
 /**
  * @brief Retrieves the precomputed global ambient color from the cubemap.
  *
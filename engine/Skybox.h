@@ -4,7 +4,8 @@
  * @class Skybox
  * @brief Renders a cubemap background and provides ambient scene color.
  *
- * The Skybox class loads six textures into an OpenGL cubemap, sets up a cube
+ * The Skybox class loads six textures into an OpenGL cubemap through the
+ * TextureManager, so skyboxes with the same faces share it, sets up a cube
  * mesh (VAO/VBO), and uses a specialized shader program to draw an infinitely
  * distant environment. It also calculates a weighted average color from the
  * cubemap faces to supply a global ambient color for scene lighting.
@@ -28,8 +29,10 @@ private:
     // File names for each cube face.
     std::vector<std::string> faces;
 
+    // Cubemap built from the faces, shared through the TextureManager.
+    std::shared_ptr<Eng::Texture> cubemap;
+
     // OpenGL handles.
-    unsigned int cubemapTexture = 0;
     unsigned int vao = 0;
     unsigned int vbo = 0;
 
@@ -39,6 +42,4 @@ private:
     bool loadCubemap();
 
 	glm::vec3 globalColor = glm::vec3(0.0f, 0.0f, 0.0f);
-    glm::vec3 calculateWeightedAverageColor(unsigned char* bits, int width, int height, int channels = 3);
-    glm::vec3 calculateWeightedAverageColorHDR(float* floatBits, int width, int height, int channels);
 };
\ No newline at end of file
@@ -66,3 +66,33 @@ glm::vec3 Eng::SpotLight::getDirection() const {
 glm::vec3 Eng::SpotLight::getPosition() const {
    return glm::vec3(getFinalMatrix()[3]);
 }
+
+/**
+ * @brief Gets the cutoff angle of the spotlight's cone.
+ *
+ * @return float The angle in degrees.
+ */
+
+float Eng::SpotLight::getCutoffAngle() const {
+   return cutoffAngle;
+}
+
+/**
+ * @brief Gets the intensity falloff within the spotlight's cone.
+ *
+ * @return float The falloff factor.
+ */
+
+float Eng::SpotLight::getFalloff() const {
+   return falloff;
+}
+
+/**
+ * @brief Gets the maximum distance reached by the spotlight.
+ *
+ * @return float The radius.
+ */
+
+float Eng::SpotLight::getRadius() const {
+   return radius;
+}
@@ -13,6 +13,9 @@ public:
 	SpotLight(const glm::vec3& color, const glm::vec3& direction, float cutoffAngle, float fallOff, float radius);
 	glm::vec3 getDirection() const;
 	glm::vec3 getPosition() const;
+	float getCutoffAngle() const;
+	float getFalloff() const;
+	float getRadius() const;
 
 private:
 	void configureLight(const glm::mat4& viewMatrix) override;
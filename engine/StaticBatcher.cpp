@@ -0,0 +1,230 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <typeinfo>
+
+/**
+ * @brief Sets the edge of the spatial cells meshes are grouped by.
+ *
+ * Larger cells give fewer, bigger batches; smaller cells keep culling finer.
+ * Non-positive values are ignored.
+ *
+ * @param size Cell edge, in scene units.
+ */
+void Eng::StaticBatcher::setCellSize(const float size) {
+	if (size <= 0.0f) {
+		std::cerr << "WARNING: [StaticBatcher] Invalid cell size " << size << ", keeping " << cellSize << std::endl;
+		return;
+	}
+	cellSize = size;
+}
+
+/**
+ * @brief Gets the edge of the spatial cells.
+ * @return float Cell edge, in scene units.
+ */
+float Eng::StaticBatcher::getCellSize() const {
+	return cellSize;
+}
+
+/**
+ * @brief Sets a test marking nodes as dynamic in addition to Node::isDynamic().
+ *
+ * Useful right after loading, when the client knows which objects it will move
+ * (e.g. by name) but cannot flag the nodes yet.
+ *
+ * @param filter Returns true for nodes to leave untouched; empty to disable.
+ */
+void Eng::StaticBatcher::setDynamicFilter(std::function<bool(const Eng::Node&)> filter) {
+	dynamicFilter = std::move(filter);
+}
+
+/**
+ * @brief Merges the static meshes below the given root.
+ *
+ * Groups of at least two meshes sharing material and cell are removed from their
+ * parents and replaced by one mesh per group, attached to a "StaticBatches" child
+ * of the root. Batch vertices are expressed in the root's space.
+ *
+ * @param root Root of the scene graph.
+ * @return Stats What was merged.
+ */
+Eng::StaticBatcher::Stats Eng::StaticBatcher::batch(const std::shared_ptr<Eng::Node>& root) const {
+	Stats stats;
+	if (!root)
+		return stats;
+
+	std::vector<std::shared_ptr<Eng::Mesh>> meshes;
+	for (auto& child : *root->getChildren())
+		collect(child, meshes, stats);
+
+	// Copies drawing the same geometry and material are cheaper drawn with one instanced call
+	std::map<std::pair<const Eng::Geometry*, const Eng::Material*>, size_t> copies;
+	for (const auto& mesh : meshes)
+		copies[{ mesh->getGeometry().get(), mesh->getMaterial().get() }]++;
+	const auto instanced = std::remove_if(meshes.begin(), meshes.end(), [&copies](const std::shared_ptr<Eng::Mesh>& mesh) {
+		return copies[{ mesh->getGeometry().get(), mesh->getMaterial().get() }] > 1;
+	});
+	stats.instancedMeshes = static_cast<size_t>(std::distance(instanced, meshes.end()));
+	meshes.erase(instanced, meshes.end());
+	stats.candidateMeshes = meshes.size();
+
+	// Group by material and cell, in scene order so the result is deterministic
+	using Key = std::tuple<const Eng::Material*, int, int, int>;
+	std::map<Key, size_t> groupIndex;
+	std::vector<std::vector<std::shared_ptr<Eng::Mesh>>> groups;
+	const glm::mat4 rootInverse = glm::inverse(root->getFinalMatrix());
+
+	for (const auto& mesh : meshes) {
+		const glm::vec3 center = glm::vec3(rootInverse * mesh->getFinalMatrix() * glm::vec4(mesh->getBoundingSphereCenter(), 1.0f));
+		const glm::ivec3 cell = glm::ivec3(glm::floor(center / cellSize));
+		const Key key{ mesh->getMaterial().get(), cell.x, cell.y, cell.z };
+
+		auto [it, inserted] = groupIndex.try_emplace(key, groups.size());
+		if (inserted)
+			groups.emplace_back();
+		groups[it->second].push_back(mesh);
+	}
+
+	auto batchesNode = std::make_shared<Eng::Node>();
+	batchesNode->setName("StaticBatches");
+
+	for (const auto& group : groups) {
+		if (group.size() < 2)
+			continue;
+
+		// Split groups that would overflow 16-bit indices
+		std::vector<std::shared_ptr<Eng::Mesh>> pending;
+		size_t pendingVertices = 0;
+		auto flush = [&]() {
+			if (pending.size() >= 2) {
+				auto merged = merge(pending, rootInverse);
+				merged->setName("StaticBatch_" + std::to_string(stats.batches));
+				merged->setParent(batchesNode.get());
+				batchesNode->addChild(merged);
+
+				for (const auto& mesh : pending) {
+					auto* siblings = mesh->getParent()->getChildren();
+					siblings->erase(std::remove(siblings->begin(), siblings->end(), mesh), siblings->end());
+					mesh->setParent(nullptr);
+				}
+				stats.mergedMeshes += pending.size();
+				stats.batches++;
+			}
+			pending.clear();
+			pendingVertices = 0;
+		};
+
+		for (const auto& mesh : group) {
+			const size_t vertexCount = mesh->getVertices().size();
+			if (pendingVertices + vertexCount > MAX_BATCH_VERTICES)
+				flush();
+			pending.push_back(mesh);
+			pendingVertices += vertexCount;
+		}
+		flush();
+	}
+
+	if (stats.batches) {
+		batchesNode->setParent(root.get());
+		root->addChild(batchesNode);
+	}
+	return stats;
+}
+
+/**
+ * @brief Prints the outcome of a batch() call.
+ * @param stats Stats returned by batch().
+ */
+void Eng::StaticBatcher::printStats(const Stats& stats) {
+	std::cout << "[StaticBatcher] " << stats.mergedMeshes << " of " << stats.candidateMeshes
+		<< " static meshes merged into " << stats.batches << " batches" << std::endl;
+	std::cout << "   Instanced: " << stats.instancedMeshes << " meshes left to their copies" << std::endl;
+	std::cout << "   Dynamic  : " << stats.dynamicNodes << " subtrees skipped" << std::endl;
+}
+
+/**
+ * @brief Gathers the meshes that can be merged, skipping dynamic subtrees.
+ *
+ * @param node   Node to visit.
+ * @param meshes Receives the eligible meshes.
+ * @param stats  Counts the skipped subtrees.
+ */
+void Eng::StaticBatcher::collect(const std::shared_ptr<Eng::Node>& node, std::vector<std::shared_ptr<Eng::Mesh>>& meshes, Stats& stats) const {
+	if (isDynamic(*node)) {
+		stats.dynamicNodes++;
+		return;
+	}
+
+	const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(node);
+	if (mesh && typeid(*mesh) == typeid(Eng::Mesh) && node->getChildren()->empty()) {
+		const auto material = mesh->getMaterial();
+		// Transparent meshes are sorted individually, meshes with LODs switch level on their own
+		if (material && material->getAlpha() >= 1.0f && mesh->getLodCount() == 1 && !mesh->getIndices().empty())
+			meshes.push_back(mesh);
+		return;
+	}
+
+	for (auto& child : *node->getChildren())
+		collect(child, meshes, stats);
+}
+
+/**
+ * @brief Checks whether a node must not be merged.
+ * @param node Node to check.
+ * @return true if flagged dynamic or accepted by the dynamic filter.
+ */
+bool Eng::StaticBatcher::isDynamic(const Eng::Node& node) const {
+	return node.isDynamic() || (dynamicFilter && dynamicFilter(node));
+}
+
+/**
+ * @brief Builds one mesh out of several, transforming their vertices into root space.
+ *
+ * @param meshes      Meshes to merge, all with the same material.
+ * @param rootInverse Inverse of the root's final matrix.
+ * @return std::shared_ptr<Eng::Mesh> The merged mesh, with bounds enclosing all of them.
+ */
+std::shared_ptr<Eng::Mesh> Eng::StaticBatcher::merge(const std::vector<std::shared_ptr<Eng::Mesh>>& meshes, const glm::mat4& rootInverse) {
+	std::vector<Eng::Vertex> vertices;
+	std::vector<unsigned int> indices;
+	glm::vec3 boxMin(std::numeric_limits<float>::max());
+	glm::vec3 boxMax(std::numeric_limits<float>::lowest());
+
+	for (const auto& mesh : meshes) {
+		const glm::mat4 toRoot = rootInverse * mesh->getFinalMatrix();
+		const glm::mat3 normalMatrix = glm::inverseTranspose(glm::mat3(toRoot));
+		const auto base = static_cast<unsigned int>(vertices.size());
+
+		for (const auto& vertex : mesh->getVertices()) {
+			const glm::vec3 position = glm::vec3(toRoot * glm::vec4(vertex.getPosition(), 1.0f));
+			glm::vec3 normal = normalMatrix * vertex.getNormal();
+			if (glm::dot(normal, normal) > 0.0f)
+				normal = glm::normalize(normal);
+			vertices.emplace_back(position, normal, vertex.getTexCoords());
+			boxMin = glm::min(boxMin, position);
+			boxMax = glm::max(boxMax, position);
+		}
+		for (const unsigned int index : mesh->getIndices())
+			indices.push_back(base + index);
+	}
+
+	const glm::vec3 center = (boxMin + boxMax) * 0.5f;
+	float radiusSq = 0.0f;
+	for (const auto& vertex : vertices) {
+		const glm::vec3 offset = vertex.getPosition() - center;
+		radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+	}
+
+	auto merged = std::make_shared<Eng::Mesh>();
+	merged->setGeometry(Eng::Geometry::create(vertices, indices));
+	merged->setMaterial(meshes.front()->getMaterial());
+	merged->setBoundingBox(boxMin, boxMax);
+	merged->setBoundingSphereCenter(center);
+	merged->setBoundingSphereRadius(std::sqrt(radiusSq));
+	return merged;
+}
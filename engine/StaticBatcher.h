@@ -0,0 +1,55 @@
+#pragma once
+
+/**
+ * @class StaticBatcher
+ * @brief Merges static meshes sharing a material into one mesh per spatial cell.
+ *
+ * Scenes often hold many small meshes that never move and share a handful of
+ * materials (board squares, decor); each of them costs a draw in every light pass.
+ * The batcher walks a loaded scene graph, groups the eligible meshes by material
+ * and by the grid cell their bounding sphere center falls in, and replaces every
+ * group of two or more meshes with a single mesh whose vertices are pre-transformed.
+ * Merged meshes get bounds enclosing their cell contents, so culling keeps working
+ * at cell granularity; batches stay below 65536 vertices to keep 16-bit indices.
+ *
+ * Eligible meshes are opaque leaf meshes with a material and a single level of
+ * detail; those drawing the same geometry and material as another eligible mesh
+ * are left to instancing instead. Nodes flagged with Node::setDynamic(), or
+ * accepted by the dynamic filter, are left untouched together with their whole subtree.
+ */
+class ENG_API StaticBatcher final {
+public:
+	/**
+	 * @brief Outcome of a batch() call.
+	 */
+	struct Stats {
+		size_t candidateMeshes = 0;	///< Static meshes considered for merging
+		size_t instancedMeshes = 0;	///< Static meshes left to instancing with their copies
+		size_t mergedMeshes = 0;	///< Meshes replaced by a batch
+		size_t batches = 0;			///< Batch meshes created
+		size_t dynamicNodes = 0;	///< Subtrees skipped as dynamic
+	};
+
+	///> Edge of the spatial cells, in scene units
+	static constexpr float DEFAULT_CELL_SIZE = 1.0f;
+	///> Largest batch, so merged meshes keep 16-bit indices
+	static constexpr size_t MAX_BATCH_VERTICES = 65535;
+
+	void setCellSize(float size);
+	float getCellSize() const;
+
+	void setDynamicFilter(std::function<bool(const Eng::Node&)> filter);
+
+	Stats batch(const std::shared_ptr<Eng::Node>& root) const;
+	static void printStats(const Stats& stats);
+
+private:
+	void collect(const std::shared_ptr<Eng::Node>& node, std::vector<std::shared_ptr<Eng::Mesh>>& meshes, Stats& stats) const;
+	bool isDynamic(const Eng::Node& node) const;
+	static std::shared_ptr<Eng::Mesh> merge(const std::vector<std::shared_ptr<Eng::Mesh>>& meshes, const glm::mat4& rootInverse);
+
+	///> Edge of the spatial cells
+	float cellSize = DEFAULT_CELL_SIZE;
+	///> Optional test marking nodes as dynamic besides Node::isDynamic()
+	std::function<bool(const Eng::Node&)> dynamicFilter;
+};
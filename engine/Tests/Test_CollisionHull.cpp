@@ -0,0 +1,192 @@
+#include "../Engine.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+    /**
+     * @brief Triangles of the box [-1, 1]^3, given vertex i at corner (i & 1, i & 2, i & 4).
+     */
+    const std::vector<unsigned int> BOX_FACES = {
+        0, 2, 1, 1, 2, 3,   4, 5, 6, 5, 7, 6,
+        0, 1, 4, 1, 5, 4,   2, 6, 3, 3, 6, 7,
+        0, 4, 2, 2, 4, 6,   1, 3, 5, 3, 7, 5,
+    };
+
+    /**
+     * @brief Corners of the box [-1, 1]^3.
+     */
+    std::vector<glm::vec3> boxCorners() {
+        std::vector<glm::vec3> corners;
+        for (int i = 0; i < 8; i++)
+            corners.emplace_back((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f, (i & 4) ? 1.0f : -1.0f);
+        return corners;
+    }
+
+    /**
+     * @brief Distance from a point to the box [-1, 1]^3.
+     */
+    float boxDistance(const glm::vec3& point) {
+        return glm::length(glm::max(glm::abs(point) - glm::vec3(1.0f), glm::vec3(0.0f)));
+    }
+
+    /**
+     * @brief Builds a prism with a regular polygon of the given number of sides as base.
+     */
+    std::shared_ptr<Eng::CollisionHull> buildPrism(const unsigned int sides) {
+        std::vector<glm::vec3> points;
+        std::vector<unsigned int> faces;
+        for (unsigned int s = 0; s < sides; s++) {
+            const float angle = 6.2831853f * static_cast<float>(s) / static_cast<float>(sides);
+            points.emplace_back(std::cos(angle), -1.0f, std::sin(angle));
+            points.emplace_back(std::cos(angle), 1.0f, std::sin(angle));
+        }
+        for (unsigned int s = 0; s < sides; s++) {
+            const unsigned int next = (s + 1) % sides;
+            faces.insert(faces.end(), { 2 * s, 2 * next, 2 * s + 1, 2 * s + 1, 2 * next, 2 * next + 1 });
+            if (s > 0 && next > 0)
+                faces.insert(faces.end(), { 0, 2 * s, 2 * next, 1, 2 * next + 1, 2 * s + 1 });
+        }
+        return Eng::CollisionHull::create(points, faces);
+    }
+}
+
+/**
+ * @brief Tests hull construction, point containment and ray clipping.
+ */
+void Eng::testCollisionHull() {
+    // An unused point is dropped, coplanar triangles share a plane
+    auto points = boxCorners();
+    points.emplace_back(5.0f, 5.0f, 5.0f);
+    const auto box = Eng::CollisionHull::create(points, BOX_FACES);
+    assert(box && box->getVertices().size() == 8 && "Unused vertex was kept!");
+    assert(box->getPlanes().size() == 6 && "Coplanar faces were not merged!");
+
+    // Planes face outward whatever the winding
+    std::vector<unsigned int> flipped = BOX_FACES;
+    for (size_t f = 0; f < flipped.size(); f += 3)
+        std::swap(flipped[f + 1], flipped[f + 2]);
+    const auto flippedBox = Eng::CollisionHull::create(boxCorners(), flipped);
+    for (const auto& hull : { box, flippedBox }) {
+        for (const auto& plane : hull->getPlanes())
+            assert(std::abs(plane.w - 1.0f) < 1e-6f && "Plane does not face outward!");
+        assert(hull->contains(glm::vec3(0.0f)) && hull->contains(glm::vec3(0.99f, -0.99f, 0.5f)));
+    }
+
+    assert(!box->contains(glm::vec3(1.01f, 0.0f, 0.0f)) && "Outside point was contained!");
+    assert(box->contains(glm::vec3(1.01f, 0.0f, 0.0f), 0.02f) && "Tolerance was ignored!");
+    assert(box->support(glm::vec3(1.0f, -2.0f, 0.5f)) == glm::vec3(1.0f, -1.0f, 1.0f));
+
+    // Rays: hit from outside, from inside, misses and rays moving away
+    float distance = -1.0f;
+    assert(box->intersectRay(glm::vec3(-5.0f, 0.2f, 0.3f), glm::vec3(1.0f, 0.0f, 0.0f), distance) && std::abs(distance - 4.0f) < 1e-6f);
+    assert(box->intersectRay(glm::vec3(-5.0f, 0.0f, 0.0f), glm::vec3(2.0f, 0.0f, 0.0f), distance) && std::abs(distance - 2.0f) < 1e-6f && "Ray parameter is not in direction units!");
+    assert(box->intersectRay(glm::vec3(0.5f), glm::vec3(0.0f, 1.0f, 0.0f), distance) && distance == 0.0f && "Ray from inside did not hit!");
+    assert(!box->intersectRay(glm::vec3(-5.0f, 1.5f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), distance) && "Parallel ray outside hit!");
+    assert(!box->intersectRay(glm::vec3(-5.0f, 0.0f, 0.0f), glm::vec3(-1.0f, 0.0f, 0.0f), distance) && "Ray moving away hit!");
+    assert(!box->intersectRay(glm::vec3(-5.0f, 0.0f, 0.0f), glm::normalize(glm::vec3(1.0f, 0.5f, 0.0f)), distance) && "Ray passing above the box hit!");
+    assert(box->intersectRay(glm::vec3(-5.0f, 0.0f, 0.0f), glm::normalize(glm::vec3(1.0f, 0.2f, 0.0f)), distance));
+
+    // Bad input
+    assert(Eng::CollisionHull::create({}, {}) == nullptr);
+    assert(Eng::CollisionHull::create(boxCorners(), { 0, 1, 8 }) == nullptr && "Out of range face was accepted!");
+
+    // Mesh queries place the hulls with the final matrix
+    auto parent = std::make_shared<Eng::Node>();
+    parent->setLocalMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(10.0f, 0.0f, 0.0f)));
+    auto mesh = std::make_shared<Eng::Mesh>();
+    mesh->setLocalMatrix(glm::scale(glm::mat4(1.0f), glm::vec3(2.0f)));
+    mesh->setParent(parent.get());
+    assert(!mesh->containsPoint(glm::vec3(10.0f, 0.0f, 0.0f)) && "Mesh without hulls contained a point!");
+    mesh->setCollisionHulls({ box });
+    assert(mesh->containsPoint(glm::vec3(11.9f, 1.9f, 0.0f)) && !mesh->containsPoint(glm::vec3(12.1f, 0.0f, 0.0f)));
+    assert(mesh->containsPoint(glm::vec3(12.1f, 0.0f, 0.0f), 0.15f) && "World-space tolerance was ignored!");
+    assert(mesh->intersectRay(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), distance) && std::abs(distance - 8.0f) < 1e-5f);
+    assert(std::abs(mesh->getDistance(glm::vec3(15.0f, 0.0f, 0.0f)) - 3.0f) < 1e-4f && "Point distance is not in world space!");
+
+    std::cout << "Collision Hull Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests GJK distances against closed forms, for points and for pairs of placed hulls.
+ */
+void Eng::testCollisionHullDistance() {
+    const auto box = Eng::CollisionHull::create(boxCorners(), BOX_FACES);
+
+    // Points against a rotated, uniformly scaled and translated box
+    const glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, -2.0f, 3.0f))
+        * glm::rotate(glm::mat4(1.0f), 0.7f, glm::normalize(glm::vec3(1.0f, 2.0f, 3.0f))) * glm::scale(glm::mat4(1.0f), glm::vec3(1.5f));
+    const glm::mat4 inverse = glm::inverse(matrix);
+    std::mt19937 random(5);
+    std::uniform_real_distribution<float> coordinate(-6.0f, 6.0f);
+    for (int i = 0; i < 500; i++) {
+        const glm::vec3 point(coordinate(random), coordinate(random), coordinate(random));
+        glm::vec3 closest;
+        const float distance = Eng::CollisionHull::distance(*box, matrix, point, &closest);
+        const float expected = 1.5f * boxDistance(glm::vec3(inverse * glm::vec4(point, 1.0f)));
+        assert(std::abs(distance - expected) <= 1e-3f * std::max(1.0f, expected) && "Point distance differs from the closed form!");
+        if (distance > 0.0f)
+            assert(std::abs(glm::distance(closest, point) - distance) < 1e-3f && "Closest point does not match the distance!");
+    }
+
+    // Box pairs: faces apart, corner against face, overlapping
+    const glm::mat4 identity(1.0f);
+    glm::vec3 first, second;
+    float distance = Eng::CollisionHull::distance(*box, identity, *box, glm::translate(identity, glm::vec3(3.0f, 0.5f, 0.0f)), &first, &second);
+    assert(std::abs(distance - 1.0f) < 1e-5f && std::abs(first.x - 1.0f) < 1e-5f && std::abs(second.x - 2.0f) < 1e-5f && "Face to face distance is wrong!");
+
+    const glm::mat4 turned = glm::translate(identity, glm::vec3(4.0f, 0.0f, 0.0f)) * glm::rotate(identity, glm::radians(45.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    distance = Eng::CollisionHull::distance(*box, identity, *box, turned, &first, &second);
+    assert(std::abs(distance - (3.0f - std::sqrt(2.0f))) < 1e-4f && std::abs(second.y) < 1e-4f && "Corner to face distance is wrong!");
+
+    assert(Eng::CollisionHull::distance(*box, identity, *box, glm::translate(identity, glm::vec3(1.5f, 1.0f, -0.5f))) == 0.0f && "Overlapping boxes are apart!");
+    assert(Eng::CollisionHull::distance(*box, identity, glm::vec3(0.2f)) == 0.0f && "Inner point is apart!");
+
+    // Prisms: distance between round sides along a random axis matches the sampled minimum
+    const auto prism = buildPrism(48);
+    const glm::mat4 prismMatrix = glm::translate(identity, glm::vec3(0.0f, 0.0f, 3.5f));
+    distance = Eng::CollisionHull::distance(*prism, identity, *prism, prismMatrix);
+    assert(std::abs(distance - 1.5f) < 1e-3f && "Prism distance is wrong!");
+
+    std::cout << "Collision Hull Distance Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Times hull queries on a 96-vertex prism, against the bounding box test they replace.
+ */
+void Eng::testCollisionHullBenchmark() {
+    const auto prism = buildPrism(48);
+    const auto box = Eng::CollisionHull::create(boxCorners(), BOX_FACES);
+    const glm::mat4 matrix = glm::translate(glm::mat4(1.0f), glm::vec3(0.3f, 0.0f, 0.0f));
+    std::mt19937 random(9);
+    std::uniform_real_distribution<float> coordinate(-2.0f, 2.0f);
+    std::vector<glm::vec3> points(4096);
+    for (auto& point : points)
+        point = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+
+    using Clock = std::chrono::steady_clock;
+    auto time = [&points](const char* name, const auto& query) {
+        constexpr int ROUNDS = 25;
+        float sink = 0.0f;
+        const auto start = Clock::now();
+        for (int r = 0; r < ROUNDS; r++)
+            for (const auto& point : points)
+                sink += query(point);
+        const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        std::cout << "   " << name << " : " << elapsed / (static_cast<double>(ROUNDS) * points.size()) << " ns/query" << std::endl;
+        assert(sink == sink && "Query returned a non-number!");
+    };
+
+    time("bounding box      ", [](const glm::vec3& p) { return glm::all(glm::lessThanEqual(glm::abs(p), glm::vec3(1.0f))) ? 1.0f : 0.0f; });
+    time("point in hull     ", [&prism](const glm::vec3& p) { return prism->contains(p) ? 1.0f : 0.0f; });
+    time("ray against hull  ", [&prism](const glm::vec3& p) {
+        float distance = 0.0f;
+        return prism->intersectRay(p * 4.0f, -p, distance) ? distance : 0.0f;
+    });
+    time("point distance    ", [&prism, &matrix](const glm::vec3& p) { return Eng::CollisionHull::distance(*prism, matrix, p * 2.0f); });
+    time("hull distance     ", [&prism, &box](const glm::vec3& p) {
+        return Eng::CollisionHull::distance(*prism, glm::mat4(1.0f), *box, glm::translate(glm::mat4(1.0f), p * 3.0f));
+    });
+
+    std::cout << "Collision Hull Benchmark Passed!" << std::endl;
+}
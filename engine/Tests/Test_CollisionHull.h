@@ -0,0 +1,5 @@
+#pragma once
+
+void testCollisionHull();
+void testCollisionHullDistance();
+void testCollisionHullBenchmark();
\ No newline at end of file
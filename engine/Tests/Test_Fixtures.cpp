@@ -0,0 +1,50 @@
+#include "../Engine.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Builds a right triangle in the XY plane facing +Z.
+ *
+ * @param size      Length of the two legs.
+ * @param texCoords Texture coordinates of every vertex, to tell otherwise equal triangles apart.
+ * @return std::vector<Eng::Vertex> The three vertices.
+ */
+std::vector<Eng::Vertex> Eng::makeTestTriangle(const float size, const glm::vec2& texCoords) {
+    return {
+        Eng::Vertex(glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), texCoords),
+        Eng::Vertex(glm::vec3(size, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), texCoords),
+        Eng::Vertex(glm::vec3(0.0f, size, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), texCoords)
+    };
+}
+
+/**
+ * @brief Creates a mesh drawing the given geometry under a parent, with bounds enclosing it.
+ *
+ * @param parent   Node the mesh is attached to.
+ * @param geometry Geometry of the mesh.
+ * @param material Material of the mesh.
+ * @param position Translation relative to the parent.
+ * @param name     Name of the mesh.
+ * @return std::shared_ptr<Eng::Mesh> The new mesh.
+ */
+std::shared_ptr<Eng::Mesh> Eng::addTestMesh(const std::shared_ptr<Eng::Node>& parent, const std::shared_ptr<Eng::Geometry>& geometry,
+                                            const std::shared_ptr<Eng::Material>& material, const glm::vec3& position, const std::string& name) {
+    glm::vec3 boxMin(std::numeric_limits<float>::max());
+    glm::vec3 boxMax(std::numeric_limits<float>::lowest());
+    for (const auto& vertex : geometry->getVertices()) {
+        boxMin = glm::min(boxMin, vertex.getPosition());
+        boxMax = glm::max(boxMax, vertex.getPosition());
+    }
+
+    auto mesh = std::make_shared<Eng::Mesh>();
+    mesh->setGeometry(geometry);
+    mesh->setMaterial(material);
+    mesh->setBoundingSphereCenter((boxMin + boxMax) * 0.5f);
+    mesh->setBoundingSphereRadius(glm::length(boxMax - boxMin) * 0.5f);
+    mesh->setLocalMatrix(glm::translate(glm::mat4(1.0f), position));
+    mesh->setName(std::string(name));
+    mesh->setParent(parent.get());
+    parent->addChild(mesh);
+    return mesh;
+}
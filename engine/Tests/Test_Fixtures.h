@@ -0,0 +1,5 @@
+#pragma once
+
+std::vector<Eng::Vertex> makeTestTriangle(float size, const glm::vec2& texCoords = glm::vec2(0.0f));
+std::shared_ptr<Eng::Mesh> addTestMesh(const std::shared_ptr<Eng::Node>& parent, const std::shared_ptr<Eng::Geometry>& geometry,
+                                       const std::shared_ptr<Eng::Material>& material, const glm::vec3& position, const std::string& name);
\ No newline at end of file
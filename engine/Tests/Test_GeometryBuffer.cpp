@@ -0,0 +1,84 @@
+#include "../Engine.h"
+#include <GL/glew.h>
+#include <GL/freeglut.h>
+#include <cstdlib>
+
+namespace {
+    /**
+     * @brief Creates a compressed geometry of the given number of vertices, one index each.
+     */
+    std::shared_ptr<Eng::Geometry> makeGeometry(const size_t vertices, const float offset) {
+        std::vector<Eng::Vertex> data(vertices, Eng::Vertex(glm::vec3(offset, 0.0f, 0.0f)));
+        std::vector<unsigned int> indices(vertices);
+        for (size_t i = 0; i < vertices; i++)
+            indices[i] = static_cast<unsigned int>(i);
+        return std::make_shared<Eng::Geometry>(std::move(data), std::move(indices));
+    }
+}
+
+/**
+ * @brief Tests that the ranges of destroyed geometries are reused instead of growing the buffers.
+ *
+ * Needs an OpenGL 4.3 context; skipped when no context can be created.
+ */
+void Eng::testGeometryBufferReuse() {
+#ifndef _WIN32
+    if (!std::getenv("DISPLAY")) {
+        std::cout << "Geometry Buffer Reuse Test Skipped (no display)" << std::endl;
+        return;
+    }
+#endif
+
+    glutInitDisplayMode(GLUT_RGBA);
+    glutInitContextVersion(4, 4);
+    glutInitContextProfile(GLUT_CORE_PROFILE);
+    const int window = glutCreateWindow("Geometry buffer test");
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK || !Eng::GeometryBuffer::isSupported()) {
+        glutDestroyWindow(window);
+        std::cout << "Geometry Buffer Reuse Test Skipped (no multi-draw indirect support)" << std::endl;
+        return;
+    }
+
+    const bool previous = Eng::Geometry::isVertexCompressionEnabled();
+    Eng::Geometry::setVertexCompression(true);
+
+    auto& buffer = Eng::GeometryBuffer::getInstance();
+    buffer.clear();
+
+    // Fill the initial allocation with geometries of 1024 vertices
+    std::vector<std::shared_ptr<Eng::Geometry>> geometries;
+    std::vector<Eng::GeometryBuffer::Range> ranges;
+    Eng::GeometryBuffer::Range range;
+    for (int i = 0; i < 64; i++) {
+        geometries.push_back(makeGeometry(1024, static_cast<float>(i)));
+        assert(buffer.acquire(geometries.back(), range) && "Geometry was not stored!");
+        ranges.push_back(range);
+    }
+    const size_t memory = buffer.getMemoryUsage();
+    assert(buffer.getFreeMemory() == 0 && "Full buffers report free memory!");
+
+    // Replacing every other geometry reuses the freed ranges, the buffers keep their size
+    for (size_t i = 0; i < geometries.size(); i += 2) {
+        geometries[i] = makeGeometry(1024, -static_cast<float>(i));
+        assert(buffer.acquire(geometries[i], range) && "Replacement geometry was not stored!");
+        assert(range.baseVertex < 64 * 1024 && "Replacement geometry did not reuse a freed range!");
+    }
+    assert(buffer.getMemoryUsage() == memory && "Buffers grew while ranges were free!");
+    assert(buffer.getGeometryCount() == geometries.size() && "Destroyed geometries are still stored!");
+
+    // Live geometries keep their placement
+    Eng::GeometryBuffer::Range kept;
+    assert(buffer.acquire(geometries[1], kept) && kept.firstIndex == ranges[1].firstIndex && kept.baseVertex == ranges[1].baseVertex);
+
+    // Destroyed geometries at the end of the buffers give back the space itself
+    geometries.clear();
+    assert(buffer.acquire(makeGeometry(2048, 0.5f), range) && range.baseVertex == 0 && "Freed buffers were not reused from the start!");
+
+    buffer.clear();
+    Eng::Geometry::setVertexCompression(previous);
+    glutDestroyWindow(window);
+
+    std::cout << "Geometry Buffer Reuse Test Passed!" << std::endl;
+}
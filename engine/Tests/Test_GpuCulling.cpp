@@ -0,0 +1,80 @@
+#include "../Engine.h"
+#include <GL/glew.h>
+#include <GL/freeglut.h>
+#include <algorithm>
+#include <cstdlib>
+
+/**
+ * @brief Tests that the compute shader culling matches the CPU culling of List.
+ *
+ * Culls a synthetic grid of meshes on the GPU and compares the visible set with
+ * List::isWithinCullingSphere. Needs an OpenGL 4.3 context; machines without a GPU
+ * can run it on Mesa's llvmpipe (LIBGL_ALWAYS_SOFTWARE=1). Skipped when no
+ * context can be created.
+ */
+void Eng::testGpuCullingVerification() {
+#ifndef _WIN32
+    if (!std::getenv("DISPLAY")) {
+        std::cout << "GPU Culling Verification Test Skipped (no display)" << std::endl;
+        return;
+    }
+#endif
+
+    glutInitDisplayMode(GLUT_RGBA);
+    glutInitContextVersion(4, 4);
+    glutInitContextProfile(GLUT_CORE_PROFILE);
+    const int window = glutCreateWindow("GPU culling test");
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK || !Eng::GpuCuller::isSupported()) {
+        glutDestroyWindow(window);
+        std::cout << "GPU Culling Verification Test Skipped (no compute shader support)" << std::endl;
+        return;
+    }
+
+    // Eye at the origin looking down -Z: eye and world space coincide
+    Eng::List list;
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 30.0f);
+    list.setEyeViewMatrix(view);
+    list.setEyeProjectionMatrix(projection);
+
+    // Grid of small meshes, partly inside the culling sphere
+    std::vector<std::shared_ptr<Eng::ListElement>> elements;
+    std::vector<Eng::GpuCuller::DrawBounds> bounds;
+    std::vector<Eng::GeometryBuffer::DrawCommand> commands;
+    std::vector<glm::mat4> matrices;
+    for (int x = -40; x <= 40; x += 3) {
+        for (int z = -80; z <= 40; z += 3) {
+            const glm::mat4 world = glm::translate(glm::mat4(1.0f), glm::vec3(x + 0.25f, 0.5f, z + 0.25f));
+            auto mesh = std::make_shared<Eng::Mesh>();
+            mesh->setBoundingSphereRadius(0.5f);
+            mesh->setLocalMatrix(world);
+
+            elements.push_back(std::make_shared<Eng::ListElement>(mesh, world));
+            bounds.push_back({ glm::vec4(0.0f, 0.0f, 0.0f, 0.5f), 0, 0, { 0, 0 } });
+            commands.push_back({ 3, 1, 0, 0, static_cast<unsigned int>(matrices.size()) });
+            matrices.push_back(world);
+        }
+    }
+
+    auto& geometryBuffer = Eng::GeometryBuffer::getInstance();
+    auto& culler = Eng::GpuCuller::getInstance();
+    geometryBuffer.uploadDraws(commands, matrices, std::vector<int>(commands.size(), -1));
+    assert(culler.cull(bounds, 1, view, list.getCullingSphere()) && "GPU culling program could not be built!");
+
+    const auto visibility = culler.readVisibility(elements.size());
+    const auto visible = static_cast<size_t>(std::count(visibility.begin(), visibility.end(), 1u));
+    assert(visible > 0 && visible < elements.size() && "Synthetic scene should be partially visible!");
+    assert(list.countCullingMismatches(elements, visibility) == 0 && "GPU and CPU culling disagree!");
+
+    // GPU modes are selectable once supported
+    list.setCullingMode(Eng::List::CullingMode::Verify);
+    assert(list.getCullingMode() == Eng::List::CullingMode::Verify && "Verification mode was not selected!");
+
+    culler.clear();
+    geometryBuffer.clear();
+    glutDestroyWindow(window);
+
+    std::cout << "GPU Culling Verification Test Passed! (" << visible << " of " << elements.size() << " visible)" << std::endl;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testGpuCullingVerification();
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "../Engine.h"
+
+/**
+ * @brief Tests that identical geometries are shared, that instance groups are counted and that batching skips them.
+ */
+void Eng::testInstanceDetection() {
+    const std::vector<Eng::Vertex> triangle = Eng::makeTestTriangle(0.1f);
+    const std::vector<Eng::Vertex> other = Eng::makeTestTriangle(0.2f, glm::vec2(0.5f));
+    const std::vector<unsigned int> indices = { 0, 1, 2 };
+
+    auto root = std::make_shared<Eng::Node>();
+    auto white = std::make_shared<Eng::Material>(glm::vec3(1.0f), 1.0f, 32.0f, glm::vec3(0));
+    auto black = std::make_shared<Eng::Material>(glm::vec3(0.0f), 1.0f, 32.0f, glm::vec3(0));
+
+    // Each mesh gets its own copy, as geometries built without Geometry::create() do
+    auto addCopy = [&root](const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices,
+                           const std::shared_ptr<Eng::Material>& material, const float x, const std::string& name) {
+        return Eng::addTestMesh(root, std::make_shared<Eng::Geometry>(vertices, indices), material, glm::vec3(x, 0.0f, 0.0f), name);
+    };
+
+    // Three copies with the same material, one with another material, one with other data
+    auto first = addCopy(triangle, indices, white, 0.0f, "Copy_0");
+    auto second = addCopy(triangle, indices, white, 0.2f, "Copy_1");
+    auto third = addCopy(triangle, indices, white, 0.4f, "Copy_2");
+    auto recoloured = addCopy(triangle, indices, black, 0.6f, "Recoloured");
+    auto unique = addCopy(other, indices, white, 0.8f, "Unique");
+    assert(first->getGeometry() != second->getGeometry() && "Copies already shared their geometry!");
+    const size_t copyBytes = first->getGeometry()->getCpuMemoryUsage();
+
+    const auto stats = Eng::InstanceDetector::detect(root);
+    assert(stats.meshes == 5 && stats.geometriesMerged == 3 && "Duplicated geometries were not merged!");
+    assert(first->getGeometry() == second->getGeometry() && first->getGeometry() == third->getGeometry()
+           && first->getGeometry() == recoloured->getGeometry() && first->getGeometry() != unique->getGeometry());
+    assert(stats.cpuBytesSaved == copyBytes * 3 && "Saved memory is wrong!");
+    assert(stats.groups == 1 && stats.instancedMeshes == 3 && stats.drawCallsSaved == 2 && "Instance group is wrong!");
+
+    // The shared geometry is registered, so data built later through Geometry::create() joins it
+    assert(Eng::Geometry::create(triangle, indices) == first->getGeometry() && "Merged geometry was not registered!");
+
+    // A second pass finds nothing new to merge and the same groups
+    const auto again = Eng::InstanceDetector::detect(root);
+    assert(again.geometriesMerged == 0 && again.instancedMeshes == 3 && again.cpuBytesSaved == stats.cpuBytesSaved);
+
+    // Batching leaves the copies to instancing
+    Eng::StaticBatcher batcher;
+    batcher.setCellSize(10.0f);
+    const auto batched = batcher.batch(root);
+    assert(batched.instancedMeshes == 3 && batched.mergedMeshes == 0 && "Copies were batched!");
+    size_t copies = 0;
+    for (const auto& child : *root->getChildren())
+        copies += child->getName().rfind("Copy_", 0) == 0;
+    assert(copies == 3 && "Copies were batched!");
+
+    Eng::InstanceDetector::printStats(stats);
+    std::cout << "Instance Detection Test Passed!" << std::endl;
+}
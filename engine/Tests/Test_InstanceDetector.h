@@ -0,0 +1,3 @@
+#pragma once
+
+void testInstanceDetection();
\ No newline at end of file
@@ -33,6 +33,9 @@ int main() {
         // Mesh Tests
         Eng::testMeshVerticesAndIndices();
         Eng::testMeshMaterial();
+        Eng::testMeshSharedGeometry();
+        Eng::testGeometryVertexFormat();
+        Eng::testMeshLodSelection();
 
         // CallManager Tests
         Eng::testCallbackManagerInitialization();
@@ -40,6 +43,75 @@ int main() {
         Eng::testDefaultKeyBindings();
         Eng::testCallbackExecutionOrder();
 
+        // ShaderManager Tests
+        Eng::testShaderPreprocessing();
+        Eng::testShaderPreprocessingBenchmark();
+
+        // GpuCuller Tests
+        Eng::testGpuCullingVerification();
+
+        // StaticBatcher Tests
+        Eng::testStaticBatching();
+
+        // MeshSimplifier Tests
+        Eng::testMeshSimplification();
+
+        // MeshOptimizer Tests
+        Eng::testMeshOptimization();
+
+        // OvoReader Tests
+        Eng::testChunkViewBounds();
+        Eng::testOvoReaderParsing();
+        Eng::testOvoReaderMultithreaded();
+        Eng::testOvoReaderSceneCache();
+        Eng::testOvoReaderProgressive();
+        Eng::testOvoReaderWelding();
+
+        // VertexDecoder Tests
+        Eng::testVertexDecoding();
+        Eng::testVertexDecodingBenchmark();
+
+        // SceneCache Tests
+        Eng::testSceneCache();
+
+        // SceneStreamer Tests
+        Eng::testSceneStreamer();
+        Eng::testSceneStreamerBudget();
+        Eng::testSceneStreamerCancel();
+
+        // CollisionHull Tests
+        Eng::testCollisionHull();
+        Eng::testCollisionHullDistance();
+        Eng::testCollisionHullBenchmark();
+
+        // VertexWelder Tests
+        Eng::testVertexWelding();
+
+        // InstanceDetector Tests
+        Eng::testInstanceDetection();
+
+        // TextureManager Tests
+        Eng::testTextureCache();
+
+        // Texture Tests
+        Eng::testDdsDecoding();
+        Eng::testTextureLoadBenchmark();
+
+        // TextureStreamer Tests
+        Eng::testTextureStreamerOrdering();
+        Eng::testTextureStreamerCancel();
+
+        // TextureResidency Tests
+        Eng::testTextureResidencyBudget();
+        Eng::testTextureResidencyOverBudget();
+
+        // TextureArrayPool Tests
+        Eng::testTextureArrayPoolPacking();
+        Eng::testTextureArrayPoolLayers();
+
+        // GeometryBuffer Tests
+        Eng::testGeometryBufferReuse();
+
         std::cout << "All Tests Passed!" << std::endl;
     }
     catch (const std::exception& e) {
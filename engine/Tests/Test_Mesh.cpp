@@ -43,4 +43,124 @@ void Eng::testMeshMaterial() {
     assert(retrievedMaterial == material);
 
     std::cout << "Mesh Material Test Passed!" << std::endl;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Tests that meshes with identical data share one Geometry.
+ */
+void Eng::testMeshSharedGeometry() {
+    std::vector<Eng::Vertex> vertices = {
+        Eng::Vertex(glm::vec3(1.0f, 0.0f, 0.0f)),
+        Eng::Vertex(glm::vec3(0.0f, 1.0f, 0.0f)),
+        Eng::Vertex(glm::vec3(0.0f, 0.0f, 1.0f))
+    };
+    std::vector<unsigned int> indices = { 0, 1, 2 };
+
+    Eng::Mesh first;
+    first.setVertices(vertices);
+    first.setIndices(indices);
+
+    Eng::Mesh second;
+    second.setGeometryData(vertices, indices);
+
+    // Geometries with only one of the arrays set are not registered
+    const size_t registered = Eng::Geometry::getStats().uniqueGeometries;
+    Eng::Mesh partial;
+    partial.setVertices(vertices);
+    assert(Eng::Geometry::getStats().uniqueGeometries == registered && "Half-set geometry was registered!");
+    partial.setIndices(indices);
+    assert(partial.getGeometry() == first.getGeometry() && "Geometry set array by array was not shared!");
+
+    // Same content -> same geometry object
+    assert(first.getGeometry() == second.getGeometry() && "Identical geometry was not shared!");
+    assert(second.getIndices().size() == 3 && "Shared geometry lost its indices!");
+
+    // Different content -> different geometry object
+    Eng::Mesh third;
+    third.setVertices(vertices);
+    third.setIndices({ 2, 1, 0 });
+    assert(third.getGeometry() != first.getGeometry() && "Different geometry was shared!");
+
+    // Explicit sharing
+    Eng::Mesh fourth;
+    fourth.setGeometry(first.getGeometry());
+    assert(fourth.getVertices().size() == 3 && "Explicitly shared geometry has no vertices!");
+
+    const auto stats = Eng::Geometry::getStats();
+    assert(stats.references >= 3 && stats.cpuBytesSaved > 0 && "Geometry stats do not account for sharing!");
+
+    std::cout << "Mesh Shared Geometry Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests the compressed and float vertex layouts and the choice of index size.
+ */
+void Eng::testGeometryVertexFormat() {
+    std::vector<Eng::Vertex> vertices = {
+        Eng::Vertex(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 0.0f)),
+        Eng::Vertex(glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(1.0f, 0.0f)),
+        Eng::Vertex(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(0.0f, 1.0f))
+    };
+    std::vector<unsigned int> indices = { 0, 1, 2 };
+
+    const bool previous = Eng::Geometry::isVertexCompressionEnabled();
+
+    Eng::Geometry::setVertexCompression(true);
+    const auto packed = Eng::Geometry::create(vertices, indices);
+    assert(packed->isCompressed() && packed->getVertexStride() == 20 && "Compressed vertex stride is wrong!");
+    assert(packed->getIndexSize() == 2 && "Small mesh does not use 16-bit indices!");
+    assert(packed->getGpuMemoryUsage() == 3 * 20 + 3 * 2 && "Compressed VRAM usage is wrong!");
+
+    Eng::Geometry::setVertexCompression(false);
+    const auto full = Eng::Geometry::create(vertices, indices);
+    assert(full != packed && "Geometries with different formats were shared!");
+    assert(!full->isCompressed() && full->getVertexStride() == 32 && "Float vertex stride is wrong!");
+
+    Eng::Geometry::setVertexCompression(previous);
+
+    // 16-bit indices stop at 65536 vertices
+    const auto large = std::make_shared<Eng::Geometry>(std::vector<Eng::Vertex>(65536), indices);
+    assert(large->getIndexSize() == 4 && "Large mesh does not use 32-bit indices!");
+
+    std::cout << "Geometry Vertex Format Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests the level of detail selection, its hysteresis and per-view state.
+ */
+void Eng::testMeshLodSelection() {
+    std::vector<Eng::Vertex> vertices(4);
+    Eng::Mesh mesh;
+    assert(mesh.getLodCount() == 0 && "Mesh without geometry has levels of detail!");
+
+    mesh.setGeometry(Eng::Geometry::create(vertices, { 0, 1, 2, 0, 2, 3 }));
+    mesh.addLod(Eng::Geometry::create(vertices, { 0, 1, 2 }));
+    mesh.addLod(Eng::Geometry::create(vertices, { 0, 1, 3 }));
+    assert(mesh.getLodCount() == 3 && mesh.getLodGeometry(3) == nullptr);
+
+    const auto previousThresholds = Eng::Mesh::getLodThresholds();
+    const float previousHysteresis = Eng::Mesh::getLodHysteresis();
+    Eng::Mesh::setLodThresholds({ 0.1f, 0.5f });
+    Eng::Mesh::setLodHysteresis(0.2f);
+    assert(Eng::Mesh::getLodThresholds().front() == 0.5f && "Thresholds were not sorted!");
+
+    // Clearly inside each range
+    assert(mesh.selectLod(1.0f, 0) == 0);
+    assert(mesh.selectLod(0.2f, 0) == 1 && mesh.getActiveGeometry() == mesh.getLodGeometry(1));
+    assert(mesh.selectLod(0.01f, 0) == 2 && mesh.getActiveGeometry()->getIndices().size() == 3);
+
+    // Around a threshold the level only changes past the margin
+    assert(mesh.selectLod(0.11f, 0) == 2 && "Level switched inside the hysteresis margin!");
+    assert(mesh.selectLod(0.13f, 0) == 1 && "Level did not switch past the hysteresis margin!");
+    assert(mesh.selectLod(0.09f, 0) == 1 && "Level switched inside the hysteresis margin!");
+    assert(mesh.selectLod(0.07f, 0) == 2 && "Level did not switch past the hysteresis margin!");
+
+    // Each view keeps its own level; the last selection is the one drawn
+    assert(mesh.selectLod(1.0f, 1) == 0 && mesh.getActiveLod() == 0);
+    assert(mesh.selectLod(0.09f, 0) == 2 && mesh.getActiveLod() == 2);
+
+    Eng::Mesh::setLodThresholds(previousThresholds);
+    Eng::Mesh::setLodHysteresis(previousHysteresis);
+
+    std::cout << "Mesh LOD Selection Test Passed!" << std::endl;
+}
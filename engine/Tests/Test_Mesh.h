@@ -1,4 +1,7 @@
 #pragma once
 
 void testMeshVerticesAndIndices();
-void testMeshMaterial();
\ No newline at end of file
+void testMeshMaterial();
+void testMeshSharedGeometry();
+void testGeometryVertexFormat();
+void testMeshLodSelection();
\ No newline at end of file
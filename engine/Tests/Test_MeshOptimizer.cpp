@@ -0,0 +1,128 @@
+#include "../Engine.h"
+
+#include <algorithm>
+#include <random>
+#include <tuple>
+
+namespace {
+    ///> Quads per side of the test grid
+    constexpr unsigned int GRID_SIZE = 32;
+
+    /**
+     * @brief Builds a flat grid whose triangles are listed in random order.
+     */
+    void buildShuffledGrid(std::vector<Eng::Vertex>& vertices, std::vector<unsigned int>& indices) {
+        for (unsigned int y = 0; y <= GRID_SIZE; y++) {
+            for (unsigned int x = 0; x <= GRID_SIZE; x++) {
+                const glm::vec2 uv(static_cast<float>(x) / GRID_SIZE, static_cast<float>(y) / GRID_SIZE);
+                vertices.emplace_back(glm::vec3(uv, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), uv);
+            }
+        }
+
+        std::vector<std::array<unsigned int, 3>> triangles;
+        for (unsigned int y = 0; y < GRID_SIZE; y++) {
+            for (unsigned int x = 0; x < GRID_SIZE; x++) {
+                const unsigned int corner = y * (GRID_SIZE + 1) + x;
+                triangles.push_back({ corner, corner + 1, corner + GRID_SIZE + 2 });
+                triangles.push_back({ corner, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1 });
+            }
+        }
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+        for (const auto& triangle : triangles)
+            indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+
+    /**
+     * @brief Lists the triangles by corner positions, in a canonical order, to compare meshes.
+     */
+    std::vector<std::tuple<float, float, float, float, float, float>> triangleSet(const std::vector<Eng::Vertex>& vertices, const std::vector<unsigned int>& indices) {
+        std::vector<std::tuple<float, float, float, float, float, float>> set;
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            std::array<std::pair<float, float>, 3> corners;
+            for (size_t k = 0; k < 3; k++)
+                corners[k] = { vertices[indices[i + k]].getPosition().x, vertices[indices[i + k]].getPosition().y };
+            // Rotate the smallest corner first, keeping the winding
+            const size_t first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+            std::rotate(corners.begin(), corners.begin() + first, corners.end());
+            set.emplace_back(corners[0].first, corners[0].second, corners[1].first, corners[1].second, corners[2].first, corners[2].second);
+        }
+        std::sort(set.begin(), set.end());
+        return set;
+    }
+}
+
+/**
+ * @brief Tests the vertex cache, overdraw and vertex fetch passes, and their use on a scene graph.
+ */
+void Eng::testMeshOptimization() {
+    std::vector<Eng::Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildShuffledGrid(vertices, indices);
+    const auto originalSet = triangleSet(vertices, indices);
+
+    // Random order misses the cache on almost every corner; Forsyth's order reuses it
+    const auto shuffled = Eng::MeshOptimizer::analyzeVertexCache(indices, vertices.size());
+    assert(shuffled.acmr > 2.0f && "Shuffled grid should thrash the cache!");
+
+    const auto cacheOrder = Eng::MeshOptimizer::optimizeVertexCache(indices, vertices.size());
+    const auto cached = Eng::MeshOptimizer::analyzeVertexCache(cacheOrder, vertices.size());
+    assert(cached.acmr < 1.0f && cached.atvr < 2.0f && "Vertex cache order is not cache friendly!");
+    assert(triangleSet(vertices, cacheOrder) == originalSet && "Vertex cache pass changed the triangles!");
+
+    // Clusters are moved around as a whole, so the cache efficiency barely changes
+    const auto overdrawOrder = Eng::MeshOptimizer::optimizeOverdraw(cacheOrder, vertices, Eng::MeshOptimizer::DEFAULT_OVERDRAW_THRESHOLD);
+    const auto clustered = Eng::MeshOptimizer::analyzeVertexCache(overdrawOrder, vertices.size());
+    assert(clustered.acmr < cached.acmr * 1.1f && "Overdraw pass broke the cache order!");
+    assert(triangleSet(vertices, overdrawOrder) == originalSet && "Overdraw pass changed the triangles!");
+
+    // Vertices end up in first-use order, and unused ones are dropped
+    std::vector<Eng::Vertex> fetchVertices = vertices;
+    fetchVertices.emplace_back(glm::vec3(5.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    std::vector<unsigned int> fetchIndices = overdrawOrder;
+    Eng::MeshOptimizer::optimizeVertexFetch(fetchVertices, fetchIndices);
+    assert(fetchVertices.size() == vertices.size() && "Unused vertex was kept!");
+    unsigned int nextNew = 0;
+    for (const unsigned int index : fetchIndices) {
+        assert(index <= nextNew && "Vertices are not in first-use order!");
+        if (index == nextNew)
+            nextNew++;
+    }
+    assert(triangleSet(fetchVertices, fetchIndices) == originalSet && "Vertex fetch pass changed the triangles!");
+
+    // Invalid buffers are left alone
+    const std::vector<unsigned int> invalid = { 0, 1, 99 };
+    assert(Eng::MeshOptimizer::optimizeVertexCache(invalid, 3) == invalid);
+    assert(Eng::MeshOptimizer::analyzeVertexCache(invalid, 3).acmr == 0.0f);
+
+    // On a scene graph, shared geometries are optimized once and every level is covered
+    auto root = std::make_shared<Eng::Node>();
+    const auto grid = Eng::Geometry::create(vertices, indices);
+    const auto lod = Eng::Geometry::create(vertices, std::vector<unsigned int>(indices.begin(), indices.begin() + indices.size() / 2));
+    std::shared_ptr<Eng::Mesh> meshes[2];
+    for (auto& mesh : meshes) {
+        mesh = std::make_shared<Eng::Mesh>();
+        mesh->setName("Grid");
+        mesh->setGeometry(grid);
+        mesh->addLod(lod);
+        mesh->setParent(root.get());
+        root->addChild(mesh);
+    }
+
+    Eng::MeshOptimizer optimizer;
+    const auto stats = optimizer.optimize(root);
+    assert(stats.reports.size() == 2 && "Wrong number of geometries optimized!");
+    assert(stats.reports[0].meshes == 2 && stats.reports[1].level == 1 && "Shared geometries were not counted!");
+    assert(stats.after.acmr < stats.before.acmr && "Scene was not optimized!");
+    assert(meshes[0]->getGeometry() == meshes[1]->getGeometry() && meshes[0]->getGeometry() != grid && "Optimized geometry is not shared!");
+    assert(meshes[0]->getLodGeometry(1) == meshes[1]->getLodGeometry(1) && meshes[0]->getLodGeometry(1) != lod && "Level was not optimized!");
+    assert(triangleSet(meshes[0]->getVertices(), meshes[0]->getIndices()) == originalSet && "Scene geometry changed!");
+
+    // A geometry the passes cannot improve keeps its loaded copy
+    auto single = std::make_shared<Eng::Mesh>();
+    const auto triangle = Eng::Geometry::create(std::vector<Eng::Vertex>(vertices.begin(), vertices.begin() + 3), { 0, 1, 2 });
+    single->setGeometry(triangle);
+    const auto kept = optimizer.optimize(single);
+    assert(kept.reports.size() == 1 && !kept.reports[0].replaced && single->getGeometry() == triangle && "Unimproved geometry was replaced!");
+
+    std::cout << "Mesh Optimization Test Passed!" << std::endl;
+}
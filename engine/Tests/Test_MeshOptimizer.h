@@ -0,0 +1,3 @@
+#pragma once
+
+void testMeshOptimization();
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "../Engine.h"
+
+#include <algorithm>
+
+namespace {
+    ///> Quads per side of the test grid
+    constexpr unsigned int GRID_SIZE = 16;
+
+    /**
+     * @brief Builds a flat, unit-sized grid in the XY plane.
+     */
+    void buildGrid(std::vector<Eng::Vertex>& vertices, std::vector<unsigned int>& indices) {
+        for (unsigned int y = 0; y <= GRID_SIZE; y++) {
+            for (unsigned int x = 0; x <= GRID_SIZE; x++) {
+                const glm::vec2 uv(static_cast<float>(x) / GRID_SIZE, static_cast<float>(y) / GRID_SIZE);
+                vertices.emplace_back(glm::vec3(uv, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), uv);
+            }
+        }
+        for (unsigned int y = 0; y < GRID_SIZE; y++) {
+            for (unsigned int x = 0; x < GRID_SIZE; x++) {
+                const unsigned int corner = y * (GRID_SIZE + 1) + x;
+                indices.insert(indices.end(), { corner, corner + 1, corner + GRID_SIZE + 2 });
+                indices.insert(indices.end(), { corner, corner + GRID_SIZE + 2, corner + GRID_SIZE + 1 });
+            }
+        }
+    }
+
+    /**
+     * @brief Creates a mesh node sharing the given geometry.
+     */
+    std::shared_ptr<Eng::Mesh> addMesh(const std::shared_ptr<Eng::Node>& parent, const std::shared_ptr<Eng::Geometry>& geometry) {
+        auto mesh = std::make_shared<Eng::Mesh>();
+        mesh->setGeometry(geometry);
+        mesh->setParent(parent.get());
+        parent->addChild(mesh);
+        return mesh;
+    }
+}
+
+/**
+ * @brief Tests quadric simplification of a flat grid and LOD generation over a scene graph.
+ */
+void Eng::testMeshSimplification() {
+    std::vector<Eng::Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildGrid(vertices, indices);
+    const size_t fullTriangles = indices.size() / 3;
+
+    // A flat surface collapses almost for free, down to the target
+    std::vector<Eng::Vertex> outVertices;
+    std::vector<unsigned int> outIndices;
+    const float error = Eng::MeshSimplifier::simplify(vertices, indices, fullTriangles / 4, 0.01f, outVertices, outIndices);
+    assert(outIndices.size() / 3 <= fullTriangles / 4 && "Flat grid was not simplified to the target!");
+    assert(!outIndices.empty() && error < 0.01f && "Flat grid simplification failed!");
+
+    // Half-edge collapses keep original vertices, and borders hold the outline in place
+    glm::vec3 boxMin(std::numeric_limits<float>::max());
+    glm::vec3 boxMax(std::numeric_limits<float>::lowest());
+    for (const auto& vertex : outVertices) {
+        const bool original = std::any_of(vertices.begin(), vertices.end(), [&vertex](const Eng::Vertex& input) {
+            return input.getPosition() == vertex.getPosition() && input.getTexCoords() == vertex.getTexCoords();
+        });
+        assert(original && "Simplified vertex is not an input vertex!");
+        boxMin = glm::min(boxMin, vertex.getPosition());
+        boxMax = glm::max(boxMax, vertex.getPosition());
+    }
+    for (const unsigned int index : outIndices)
+        assert(index < outVertices.size() && "Simplified index out of range!");
+    assert(glm::length(boxMin - glm::vec3(0.0f)) < 1e-6f && glm::length(boxMax - glm::vec3(1.0f, 1.0f, 0.0f)) < 1e-6f && "Grid outline was not preserved!");
+
+    // The error limit stops simplification before the outline is bent, whatever the target
+    Eng::MeshSimplifier::simplify(vertices, indices, 0, 0.001f, outVertices, outIndices);
+    assert(!outIndices.empty() && outIndices.size() < indices.size() / 4 && "Error-limited simplification is wrong!");
+    float area = 0.0f;
+    for (size_t i = 0; i < outIndices.size(); i += 3) {
+        const glm::vec3 a = outVertices[outIndices[i]].getPosition();
+        const glm::vec3 b = outVertices[outIndices[i + 1]].getPosition();
+        const glm::vec3 c = outVertices[outIndices[i + 2]].getPosition();
+        area += glm::cross(b - a, c - a).z * 0.5f;
+    }
+    assert(std::abs(area - 1.0f) < 1e-4f && "Simplified grid does not cover the same area!");
+
+    // Meshes sharing a geometry share its levels; small meshes are left alone
+    auto root = std::make_shared<Eng::Node>();
+    const auto grid = Eng::Geometry::create(vertices, indices);
+    auto first = addMesh(root, grid);
+    auto second = addMesh(root, grid);
+    auto small = addMesh(root, Eng::Geometry::create(vertices, { 0, 1, GRID_SIZE + 2 }));
+
+    Eng::MeshSimplifier simplifier;
+    simplifier.setThreadCount(2);
+    simplifier.setLodSettings({ { 0.5f, 0.01f }, { 0.1f, 0.01f } });
+    const auto stats = simplifier.generateLods(root);
+
+    assert(stats.geometries == 1 && stats.meshes == 2 && "Wrong meshes simplified!");
+    assert(stats.lods == 2 && first->getLodCount() == 3 && second->getLodCount() == 3 && "Levels were not added!");
+    assert(first->getLodGeometry(1) == second->getLodGeometry(1) && "Levels of a shared geometry are not shared!");
+    assert(small->getLodCount() == 1 && "Small mesh was simplified!");
+    assert(stats.triangles.size() == 3 && stats.triangles[0] == fullTriangles);
+    assert(stats.triangles[1] <= fullTriangles / 2 && stats.triangles[2] <= fullTriangles / 10 && stats.triangles[2] > 0);
+
+    // Meshes that already have levels are not simplified again
+    const auto again = simplifier.generateLods(root);
+    assert(again.geometries == 0 && first->getLodCount() == 3 && "Levels were generated twice!");
+
+    std::cout << "Mesh Simplification Test Passed!" << std::endl;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testMeshSimplification();
\ No newline at end of file
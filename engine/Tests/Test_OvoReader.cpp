@@ -0,0 +1,471 @@
+#include "../Engine.h"
+
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace {
+    ///> Scratch file written by the tests
+    const std::string TEST_FILE = "test_scene.ovo";
+
+    /**
+     * @brief Appends the raw bytes of a value.
+     */
+    template <typename T>
+    void append(std::vector<char>& out, const T& value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    /**
+     * @brief Appends a NUL-terminated string.
+     */
+    void appendString(std::vector<char>& out, const std::string& value) {
+        out.insert(out.end(), value.begin(), value.end());
+        out.push_back('\0');
+    }
+
+    /**
+     * @brief Appends a chunk header followed by its payload.
+     */
+    void appendChunk(std::vector<char>& out, const unsigned int id, const std::vector<char>& payload) {
+        append(out, id);
+        append(out, static_cast<unsigned int>(payload.size()));
+        out.insert(out.end(), payload.begin(), payload.end());
+    }
+
+    /**
+     * @brief Builds a node chunk payload.
+     */
+    std::vector<char> nodePayload(const std::string& name, const unsigned int children, const glm::vec3& position) {
+        std::vector<char> payload;
+        appendString(payload, name);
+        append(payload, glm::translate(glm::mat4(1.0f), position));
+        append(payload, children);
+        appendString(payload, "[none]");
+        return payload;
+    }
+
+    /**
+     * @brief Builds a small scene: version, a material and a root node with one child.
+     */
+    std::vector<char> buildScene() {
+        constexpr unsigned int OBJECT = 0, NODE = 1, MATERIAL = 9;
+        std::vector<char> file;
+
+        std::vector<char> version;
+        append(version, 8u);
+        appendChunk(file, OBJECT, version);
+
+        std::vector<char> material;
+        appendString(material, "Marble");
+        append(material, glm::vec3(0.0f));
+        append(material, glm::vec3(0.8f));
+        append(material, 0.5f);
+        append(material, 0.0f);
+        append(material, 1.0f);
+        for (int map = 0; map < 5; map++)
+            appendString(material, "[none]");
+        appendChunk(file, MATERIAL, material);
+
+        appendChunk(file, NODE, nodePayload("[root]", 1, glm::vec3(0.0f)));
+        appendChunk(file, NODE, nodePayload("Child", 0, glm::vec3(1.0f, 2.0f, 3.0f)));
+        return file;
+    }
+
+    /**
+     * @brief Builds a mesh chunk payload with two levels of detail of a triangle fan.
+     *
+     * Vertex values depend on the seed, so every mesh decodes to different data.
+     * A duplicated mesh stores every vertex twice, odd triangles using the second
+     * copy, and ends with a triangle that welding collapses, as exporters do.
+     */
+    std::vector<char> meshPayload(const std::string& name, const unsigned int children, const unsigned int seed, const bool duplicated = false) {
+        std::vector<char> payload;
+        appendString(payload, name);
+        append(payload, glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(seed), 0.0f, 0.0f)));
+        append(payload, children);
+        appendString(payload, "[none]");
+        append(payload, static_cast<unsigned char>(0));
+        appendString(payload, "Marble");
+        append(payload, 2.0f);
+        append(payload, glm::vec3(-1.0f));
+        append(payload, glm::vec3(1.0f));
+
+        // Physics properties with one tetrahedral hull
+        append(payload, static_cast<unsigned char>(1));
+        append(payload, std::array<unsigned char, 4>{});
+        append(payload, glm::vec3(0.0f));
+        append(payload, std::array<float, 6>{ 1.0f });
+        append(payload, 1u);
+        append(payload, 0u);
+        append(payload, std::array<uint64_t, 2>{});
+        append(payload, 4u);
+        append(payload, 4u);
+        append(payload, glm::vec3(0.25f));
+        for (const auto& corner : { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) })
+            append(payload, corner * static_cast<float>(seed + 1));
+        for (const unsigned int index : { 0u, 1u, 2u, 0u, 1u, 3u, 0u, 2u, 3u, 1u, 2u, 3u })
+            append(payload, index);
+
+        constexpr unsigned int LODS = 2;
+        append(payload, LODS);
+        for (unsigned int l = 0; l < LODS; l++) {
+            const unsigned int vertexCount = 64 >> l;
+            const unsigned int copies = duplicated ? 2 : 1;
+            append(payload, vertexCount * copies);
+            append(payload, vertexCount - 2 + copies - 1);
+            for (unsigned int copy = 0; copy < copies; copy++) {
+                for (unsigned int v = 0; v < vertexCount; v++) {
+                    const float angle = static_cast<float>(v + seed) * 0.1f;
+                    append(payload, glm::vec3(std::cos(angle), std::sin(angle), static_cast<float>(seed)));
+                    append(payload, glm::packSnorm3x10_1x2(glm::vec4(glm::normalize(glm::vec3(std::cos(angle), std::sin(angle), 1.0f)), 0.0f)));
+                    append(payload, glm::packHalf2x16(glm::vec2(angle, static_cast<float>(l))));
+                    append(payload, 0u);
+                }
+            }
+            for (unsigned int f = 1; f + 1 < vertexCount; f++) {
+                const unsigned int copy = duplicated && f % 2 ? vertexCount : 0;
+                append(payload, copy);
+                append(payload, f + copy);
+                append(payload, f + 1 + copy);
+            }
+            if (duplicated) {
+                append(payload, 1u);
+                append(payload, 1u + vertexCount);
+                append(payload, 2u);
+            }
+        }
+        return payload;
+    }
+
+    /**
+     * @brief Builds a scene of nested meshes: a root node with meshes holding meshes and plain nodes.
+     */
+    std::vector<char> buildMeshScene() {
+        constexpr unsigned int MESH = 18;
+        std::vector<char> scene = buildScene();
+        // Drop the child node and let the root own the meshes instead
+        scene.resize(scene.size() - nodePayload("Child", 0, glm::vec3(0.0f)).size() - 2 * sizeof(unsigned int));
+        const size_t rootChildren = scene.size() - sizeof(unsigned int) - std::string("[none]").size() - 1;
+        const unsigned int meshCount = 6;
+        std::memcpy(scene.data() + rootChildren, &meshCount, sizeof(unsigned int));
+
+        unsigned int seed = 0;
+        for (unsigned int m = 0; m < meshCount; m++) {
+            appendChunk(scene, MESH, meshPayload("Mesh" + std::to_string(m), 2, seed++));
+            appendChunk(scene, MESH, meshPayload("Mesh" + std::to_string(m) + ".a", 0, seed++));
+            appendChunk(scene, 1, nodePayload("Node" + std::to_string(m), 1, glm::vec3(1.0f)));
+            appendChunk(scene, MESH, meshPayload("Mesh" + std::to_string(m) + ".b", 0, seed++));
+        }
+        return scene;
+    }
+
+    /**
+     * @brief Checks that two parsed graphs are identical, node by node.
+     */
+    void compareGraphs(Eng::Node& first, Eng::Node& second) {
+        assert(first.getName() == second.getName() && "Node order differs!");
+        assert(first.getLocalMatrix() == second.getLocalMatrix());
+        assert(first.getChildren()->size() == second.getChildren()->size() && "Hierarchy differs!");
+
+        const auto firstMesh = dynamic_cast<Eng::Mesh*>(&first);
+        const auto secondMesh = dynamic_cast<Eng::Mesh*>(&second);
+        assert((firstMesh == nullptr) == (secondMesh == nullptr) && "Node type differs!");
+        if (firstMesh) {
+            assert(firstMesh->getLodCount() == secondMesh->getLodCount() && "Levels of detail differ!");
+            assert(firstMesh->getMaterial() && secondMesh->getMaterial() && "Material was not assigned!");
+            assert(firstMesh->getBoundingBoxMin() == secondMesh->getBoundingBoxMin() && firstMesh->getBoundingBoxMax() == secondMesh->getBoundingBoxMax());
+            assert(firstMesh->getBoundingSphereRadius() == secondMesh->getBoundingSphereRadius());
+            assert(firstMesh->getCollisionHulls().size() == secondMesh->getCollisionHulls().size() && "Collision hulls differ!");
+            for (size_t h = 0; h < firstMesh->getCollisionHulls().size(); h++)
+                assert(firstMesh->getCollisionHulls()[h]->getPlanes() == secondMesh->getCollisionHulls()[h]->getPlanes());
+            for (size_t l = 0; l < firstMesh->getLodCount(); l++) {
+                const auto& firstVertices = firstMesh->getLodGeometry(l)->getVertices();
+                const auto& secondVertices = secondMesh->getLodGeometry(l)->getVertices();
+                assert(firstVertices.size() == secondVertices.size());
+                for (size_t v = 0; v < firstVertices.size(); v++) {
+                    assert(firstVertices[v].getPosition() == secondVertices[v].getPosition() && "Vertex position differs!");
+                    assert(firstVertices[v].getNormal() == secondVertices[v].getNormal() && "Vertex normal differs!");
+                    assert(firstVertices[v].getTexCoords() == secondVertices[v].getTexCoords() && "Vertex texture coordinates differ!");
+                }
+                assert(firstMesh->getLodGeometry(l)->getIndices() == secondMesh->getLodGeometry(l)->getIndices() && "Indices differ!");
+            }
+        }
+
+        auto firstChild = first.getChildren()->begin();
+        auto secondChild = second.getChildren()->begin();
+        for (; firstChild != first.getChildren()->end(); ++firstChild, ++secondChild)
+            compareGraphs(**firstChild, **secondChild);
+    }
+
+    /**
+     * @brief Writes bytes to the scratch file.
+     */
+    void writeScene(const std::vector<char>& bytes) {
+        FILE* file = fopen(TEST_FILE.c_str(), "wb");
+        assert(file && "Unable to write the test scene!");
+        if (!bytes.empty())
+            fwrite(bytes.data(), 1, bytes.size(), file);
+        fclose(file);
+    }
+
+    /**
+     * @brief Writes bytes to the scratch file and parses it.
+     * @param threadCount Mesh decoding threads, 0 for one per hardware thread.
+     */
+    std::shared_ptr<Eng::Node> parse(const std::vector<char>& bytes, const unsigned int threadCount = 0) {
+        writeScene(bytes);
+
+        Eng::OvoReader reader;
+        reader.setThreadCount(threadCount);
+        auto root = reader.parseOvoFile(TEST_FILE);
+        std::remove(TEST_FILE.c_str());
+        return root;
+    }
+}
+
+/**
+ * @brief Tests that ChunkView reads in place and fails, without moving, on out of bounds reads.
+ */
+void Eng::testChunkViewBounds() {
+    std::vector<char> bytes;
+    append(bytes, 42u);
+    appendString(bytes, "name");
+    append(bytes, 1.5f);
+    append(bytes, 2.5f);
+
+    Eng::ChunkView view(bytes.data(), bytes.size());
+    assert(view.read<unsigned int>() == 42u);
+    assert(view.readString() == "name");
+    float values[2];
+    assert(view.readArray(values, 2) && values[0] == 1.5f && values[1] == 2.5f);
+    assert(view.getRemaining() == 0 && view.isValid());
+
+    // Past the end: zeroed value, then every read keeps failing
+    assert(view.read<unsigned int>() == 0u && !view.isValid() && "Out of bounds read was not detected!");
+    assert(view.readString().empty() && view.take(0) == nullptr);
+
+    // Counts that would overflow the requested length are rejected
+    Eng::ChunkView counts(bytes.data(), bytes.size());
+    assert(counts.take(std::numeric_limits<size_t>::max(), 8) == nullptr && !counts.isValid());
+
+    // Strings must be terminated within the view, and sub-views are bounded
+    Eng::ChunkView unterminated(bytes.data() + 4, 3);
+    assert(unterminated.readString().empty() && !unterminated.isValid());
+    Eng::ChunkView outer(bytes.data(), bytes.size());
+    Eng::ChunkView inner = outer.subView(4);
+    assert(inner.read<unsigned int>() == 42u && inner.getRemaining() == 0 && outer.getPosition() == 4);
+    assert(inner.read<char>() == 0 && !inner.isValid() && outer.isValid() && "Sub-view was not bounded!");
+    assert(!outer.subView(bytes.size()).isValid() && !outer.isValid());
+
+    std::cout << "ChunkView Bounds Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests parsing a mapped OVO file, and rejecting truncated or corrupted ones.
+ */
+void Eng::testOvoReaderParsing() {
+    const auto scene = buildScene();
+    const auto root = parse(scene);
+    assert(root && root->getName() == "[root]" && "Scene was not parsed!");
+    assert(root->getChildren()->size() == 1 && "Child node is missing!");
+    const auto child = root->getChildren()->front();
+    assert(child->getName() == "Child" && child->getParent() == root.get());
+    assert(child->getLocalMatrix()[3] == glm::vec4(1.0f, 2.0f, 3.0f, 1.0f) && "Node matrix was not read!");
+
+    // Missing and empty files
+    Eng::OvoReader missing;
+    assert(missing.parseOvoFile("missing_scene.ovo") == nullptr && "Missing file was parsed!");
+    assert(parse({}) == nullptr && "Empty file produced a scene!");
+
+    // A file cut in the middle of a chunk
+    std::vector<char> truncated(scene.begin(), scene.end() - 5);
+    assert(parse(truncated) == nullptr && "Truncated file was parsed!");
+
+    // A chunk whose declared size is too small for its fields
+    std::vector<char> corrupted = scene;
+    const size_t lastChunk = scene.size() - nodePayload("Child", 0, glm::vec3(0.0f)).size() - 2 * sizeof(unsigned int);
+    const unsigned int shortSize = 10;
+    std::memcpy(corrupted.data() + lastChunk + sizeof(unsigned int), &shortSize, sizeof(unsigned int));
+    corrupted.resize(lastChunk + 2 * sizeof(unsigned int) + shortSize);
+    assert(parse(corrupted) == nullptr && "Chunk overrun was not detected!");
+
+    // A face referring to a vertex past the end of its level of detail
+    constexpr unsigned int MESH = 18;
+    std::vector<char> badFaces(scene.begin(), scene.begin() + lastChunk);
+    appendChunk(badFaces, MESH, meshPayload("Child", 0, 0));
+    const unsigned int missingVertex = 32;
+    std::memcpy(badFaces.data() + badFaces.size() - sizeof(unsigned int), &missingVertex, sizeof(unsigned int));
+    assert(parse(badFaces) == nullptr && "Out of range face index was not detected!");
+
+    std::cout << "OvoReader Parsing Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that decoding meshes on several threads builds the same graph as decoding them serially.
+ */
+void Eng::testOvoReaderMultithreaded() {
+    const auto scene = buildMeshScene();
+    const auto serial = parse(scene, 1);
+    const auto parallel = parse(scene, 4);
+    assert(serial && parallel && "Mesh scene was not parsed!");
+    assert(serial->getChildren()->size() == 6 && "Root children are missing!");
+    compareGraphs(*serial, *parallel);
+
+    // Meshes are stitched in file order, with their decoded payload
+    const auto first = std::dynamic_pointer_cast<Eng::Mesh>(parallel->getChildren()->front());
+    assert(first && first->getName() == "Mesh0" && first->getChildren()->size() == 2);
+    assert(first->getChildren()->front()->getName() == "Mesh0.a" && first->getChildren()->back()->getName() == "Node0");
+    assert(first->getChildren()->back()->getChildren()->front()->getName() == "Mesh0.b" && "Nested mesh is misplaced!");
+    assert(first->getLodCount() == 2 && first->getLodGeometry(1)->getVertices().size() == 32 && "Levels of detail were not decoded!");
+    assert(first->getIndices().size() == 62 * 3 && first->getIndices()[4] == 2u);
+    const auto& vertex = first->getVertices()[10];
+    assert(glm::length(vertex.getPosition() - glm::vec3(std::cos(1.0f), std::sin(1.0f), 0.0f)) < 1e-6f && "Vertex position was not decoded!");
+    assert(std::abs(glm::length(vertex.getNormal()) - 1.0f) < 0.01f && vertex.getNormal().z > 0.5f && "Vertex normal was not decoded!");
+    assert(std::abs(vertex.getTexCoords().x - 1.0f) < 1e-3f && "Vertex texture coordinates were not decoded!");
+    assert(first->getCollisionHulls().size() == 1 && first->getCollisionHulls()[0]->getPlanes().size() == 4 && "Physics hull was not kept!");
+    assert(first->getCollisionHulls()[0]->contains(glm::vec3(0.2f)) && !first->getCollisionHulls()[0]->contains(glm::vec3(0.5f)));
+
+    // A mesh chunk cut in its vertex block is rejected whatever the thread count
+    std::vector<char> truncated(scene.begin(), scene.end() - 100);
+    assert(parse(truncated, 4) == nullptr && "Truncated mesh was parsed!");
+
+    std::cout << "OvoReader Multithreaded Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that a scene restored from its cooked copy matches the parsed one, and that edits invalidate it.
+ *
+ * Prints the cold parse and cooked load times.
+ */
+void Eng::testOvoReaderSceneCache() {
+    using Clock = std::chrono::steady_clock;
+    const std::string cacheFile = Eng::SceneCache::getCachePath(TEST_FILE);
+    std::remove(cacheFile.c_str());
+    auto scene = buildMeshScene();
+    writeScene(scene);
+
+    Eng::OvoReader cold;
+    cold.setSceneCache(true);
+    auto start = Clock::now();
+    const auto parsed = cold.parseOvoFile(TEST_FILE);
+    const double coldTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    assert(parsed && "Scene was not parsed!");
+    FILE* cooked = fopen(cacheFile.c_str(), "rb");
+    assert(cooked && "Cooked copy was not written!");
+    fclose(cooked);
+
+    Eng::OvoReader warm;
+    warm.setSceneCache(true);
+    start = Clock::now();
+    const auto restored = warm.parseOvoFile(TEST_FILE);
+    const double cookedTime = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    assert(restored && restored != parsed && "Scene was not restored!");
+    compareGraphs(*parsed, *restored);
+
+    // Renaming a node changes the source bytes: the cache is stale and cooked again
+    const std::string oldName = "Mesh0.a", newName = "Mesh9.a";
+    const auto position = std::search(scene.begin(), scene.end(), oldName.begin(), oldName.end());
+    std::copy(newName.begin(), newName.end(), position);
+    writeScene(scene);
+    Eng::OvoReader edited;
+    edited.setSceneCache(true);
+    const auto reparsed = edited.parseOvoFile(TEST_FILE);
+    assert(reparsed && reparsed->getChildren()->front()->getChildren()->front()->getName() == newName && "Stale cache was used!");
+
+    std::remove(TEST_FILE.c_str());
+    std::remove(cacheFile.c_str());
+    std::cout << "   cold parse  : " << coldTime << " ms" << std::endl;
+    std::cout << "   cooked load : " << cookedTime << " ms" << std::endl;
+    std::cout << "OvoReader Scene Cache Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that a streamed parse returns the full hierarchy and bounds before any geometry, and queues every mesh.
+ *
+ * Uploads need a GL context, so the decoded meshes are dropped with cancel() instead.
+ */
+void Eng::testOvoReaderProgressive() {
+    const auto scene = buildMeshScene();
+    const auto blocking = parse(scene);
+    writeScene(scene);
+
+    Eng::SceneStreamer streamer;
+    streamer.setThreadCount(2);
+    Eng::OvoReader reader;
+    reader.setStreamer(&streamer);
+    const auto streamed = reader.parseOvoFile(TEST_FILE);
+    assert(streamed && "Scene was not indexed!");
+    assert(streamer.getStats().queued == 18 && "Meshes were not queued!");
+
+    // Same graph and bounds, but meshes have no geometry until uploaded
+    std::function<void(Eng::Node&, Eng::Node&)> compare = [&compare](Eng::Node& first, Eng::Node& second) {
+        assert(first.getName() == second.getName() && first.getLocalMatrix() == second.getLocalMatrix());
+        assert(first.getChildren()->size() == second.getChildren()->size() && "Hierarchy differs!");
+        if (const auto mesh = dynamic_cast<Eng::Mesh*>(&second)) {
+            const auto reference = dynamic_cast<Eng::Mesh*>(&first);
+            assert(reference && mesh->getMaterial() && "Mesh was not built!");
+            assert(mesh->getLodCount() == 0 && mesh->getActiveGeometry() == nullptr && "Geometry was attached before its upload!");
+            assert(mesh->getBoundingBoxMin() == reference->getBoundingBoxMin() && mesh->getBoundingBoxMax() == reference->getBoundingBoxMax());
+            assert(mesh->getBoundingSphereRadius() == reference->getBoundingSphereRadius() && "Bounds are missing!");
+            assert(mesh->getCollisionHulls().size() == reference->getCollisionHulls().size() && "Collision hulls are missing!");
+        }
+        for (size_t c = 0; c < first.getChildren()->size(); c++)
+            compare(*(*first.getChildren())[c], *(*second.getChildren())[c]);
+    };
+    compare(*blocking, *streamed);
+
+    // Payloads are decoded in the background, the reader itself being gone
+    for (int wait = 0; wait < 2000 && streamer.getStats().decoded < 18; wait++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    assert(streamer.getStats().decoded == 18 && "Meshes were not decoded!");
+    assert(streamer.getProgress() == 0.0f && !streamer.isComplete() && "Uploads ran outside update()!");
+
+    streamer.cancel();
+    assert(streamer.isComplete() && streamed->getChildren()->front()->getName() == "Mesh0");
+    std::remove(TEST_FILE.c_str());
+    std::cout << "OvoReader Progressive Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that duplicated vertices are welded while decoding, keeping the triangles but the collapsed one.
+ */
+void Eng::testOvoReaderWelding() {
+    constexpr unsigned int MESH = 18;
+    std::vector<char> scene = buildScene();
+    // The root owns a duplicated mesh instead of the child node
+    scene.resize(scene.size() - nodePayload("Child", 0, glm::vec3(0.0f)).size() - 2 * sizeof(unsigned int));
+    appendChunk(scene, MESH, meshPayload("Child", 0, 0, true));
+    writeScene(scene);
+
+    Eng::OvoReader plain;
+    plain.setVertexWelding(false);
+    const auto plainRoot = plain.parseOvoFile(TEST_FILE);
+    Eng::OvoReader welding;
+    welding.setWeldEpsilon(-1.0f);
+    assert(welding.isVertexWeldingEnabled() && welding.getWeldEpsilon() == 0.0f && "Welding is not on by default!");
+    const auto weldedRoot = welding.parseOvoFile(TEST_FILE);
+    std::remove(TEST_FILE.c_str());
+    assert(plainRoot && weldedRoot && "Duplicated mesh was not parsed!");
+
+    const auto plainMesh = std::dynamic_pointer_cast<Eng::Mesh>(plainRoot->getChildren()->front());
+    const auto weldedMesh = std::dynamic_pointer_cast<Eng::Mesh>(weldedRoot->getChildren()->front());
+    assert(plainMesh->getVertices().size() == 128 && plainMesh->getIndices().size() == 63 * 3);
+    assert(weldedMesh->getVertices().size() == 64 && "Duplicated vertices were not welded!");
+    assert(weldedMesh->getIndices().size() == 62 * 3 && "Collapsed triangle was not dropped!");
+    assert(weldedMesh->getLodGeometry(1)->getVertices().size() == 32 && "Lower level of detail was not welded!");
+
+    // Triangles keep their order and corners
+    const auto& plainVertices = plainMesh->getVertices();
+    const auto& weldedVertices = weldedMesh->getVertices();
+    for (size_t i = 0; i < weldedMesh->getIndices().size(); i++) {
+        const auto& plainVertex = plainVertices[plainMesh->getIndices()[i]];
+        const auto& weldedVertex = weldedVertices[weldedMesh->getIndices()[i]];
+        assert(plainVertex.getPosition() == weldedVertex.getPosition() && plainVertex.getNormal() == weldedVertex.getNormal()
+            && plainVertex.getTexCoords() == weldedVertex.getTexCoords() && "Welded triangle differs!");
+    }
+
+    std::cout << "OvoReader Welding Test Passed!" << std::endl;
+}
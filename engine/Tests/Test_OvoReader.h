@@ -0,0 +1,8 @@
+#pragma once
+
+void testChunkViewBounds();
+void testOvoReaderParsing();
+void testOvoReaderMultithreaded();
+void testOvoReaderSceneCache();
+void testOvoReaderProgressive();
+void testOvoReaderWelding();
\ No newline at end of file
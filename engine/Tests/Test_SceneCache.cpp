@@ -0,0 +1,119 @@
+#include "../Engine.h"
+
+namespace {
+    ///> Scratch file written by the tests
+    const std::string TEST_CACHE = "test_scene.ovo.cooked";
+
+    /**
+     * @brief Builds a graph of every class a cooked file holds, with a geometry shared by two meshes.
+     */
+    std::shared_ptr<Eng::Node> buildGraph() {
+        std::vector<Eng::Vertex> vertices;
+        std::vector<unsigned int> indices;
+        for (unsigned int i = 0; i < 16; i++) {
+            const float angle = static_cast<float>(i) * 0.4f;
+            vertices.emplace_back(glm::vec3(std::cos(angle), std::sin(angle), 0.5f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec2(angle, 1.0f - angle));
+        }
+        for (unsigned int i = 1; i + 1 < 16; i++)
+            indices.insert(indices.end(), { 0u, i, i + 1 });
+        const auto shared = Eng::Geometry::create(vertices, indices);
+        const auto lod = Eng::Geometry::create(vertices, std::vector<unsigned int>(indices.begin(), indices.begin() + 9));
+        const auto material = std::make_shared<Eng::Material>(glm::vec3(0.2f, 0.4f, 0.6f), 0.5f, 32.0f, glm::vec3(0.1f));
+        const auto hull = Eng::CollisionHull::create(
+            { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) },
+            { 0, 1, 2, 0, 1, 3, 0, 2, 3, 1, 2, 3 });
+
+        auto root = std::make_shared<Eng::Node>();
+        root->setName("[root]");
+        auto attach = [](const std::shared_ptr<Eng::Node>& parent, const std::shared_ptr<Eng::Node>& child, const std::string& name) {
+            child->setName(std::string(name));
+            child->setLocalMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(static_cast<float>(name.size()), 1.0f, 2.0f)));
+            parent->addChild(child);
+            child->setParent(parent.get());
+        };
+
+        for (int m = 0; m < 2; m++) {
+            auto mesh = std::make_shared<Eng::Mesh>();
+            mesh->setGeometry(shared);
+            mesh->addLod(lod);
+            mesh->setMaterial(material);
+            mesh->setBoundingBox(glm::vec3(-1.0f), glm::vec3(1.0f));
+            mesh->setBoundingSphereCenter(glm::vec3(0.0f, 0.0f, 0.5f));
+            mesh->setBoundingSphereRadius(1.5f);
+            mesh->setCollisionHulls({ hull });
+            attach(root, mesh, "Mesh" + std::to_string(m));
+        }
+        auto group = std::make_shared<Eng::Node>();
+        attach(root, group, "Group");
+        attach(group, std::make_shared<Eng::PointLight>(glm::vec3(1.0f, 0.5f, 0.25f), 8.0f), "Omni");
+        attach(group, std::make_shared<Eng::SpotLight>(glm::vec3(0.5f), glm::vec3(0.0f, -1.0f, 0.0f), 30.0f, 2.0f, 12.0f), "Spot");
+        attach(root, std::make_shared<Eng::DirectionalLight>(glm::vec3(0.9f), glm::vec3(0.0f, -1.0f, 1.0f)), "Sun");
+        return root;
+    }
+}
+
+/**
+ * @brief Tests that a cooked scene restores the same graph, and that stale or damaged caches are rejected.
+ */
+void Eng::testSceneCache() {
+    const auto graph = buildGraph();
+    const uint64_t hash = Eng::SceneCache::hashSource("scene bytes", 11);
+    assert(hash != Eng::SceneCache::hashSource("scene bytez", 11) && "Source hash ignores content!");
+    assert(Eng::SceneCache::getCachePath("scene.ovo") == "scene.ovo.cooked");
+
+    const Eng::SceneCache::ImportSettings settings = { true, 0.001f };
+    assert(Eng::SceneCache::save(TEST_CACHE, graph, hash, settings) && "Scene was not cooked!");
+    const auto restored = Eng::SceneCache::load(TEST_CACHE, hash, settings);
+    assert(restored && restored->getName() == "[root]" && restored->getChildren()->size() == 4 && "Scene was not restored!");
+
+    const auto mesh0 = std::dynamic_pointer_cast<Eng::Mesh>(restored->getChildren()->front());
+    const auto mesh1 = std::dynamic_pointer_cast<Eng::Mesh>((*restored->getChildren())[1]);
+    const auto original = std::dynamic_pointer_cast<Eng::Mesh>(graph->getChildren()->front());
+    assert(mesh0 && mesh1 && mesh0->getName() == "Mesh0" && mesh0->getParent() == restored.get());
+    assert(mesh0->getLocalMatrix() == original->getLocalMatrix() && "Node matrix was not restored!");
+    assert(mesh0->getGeometry() == mesh1->getGeometry() && mesh0->getMaterial() == mesh1->getMaterial() && "Sharing was not restored!");
+    assert(mesh0->getGeometry() == original->getGeometry() && "Live geometry with the same content was not shared!");
+    assert(mesh0->getLodCount() == 2 && mesh0->getLodGeometry(1)->getIndices().size() == 9);
+    assert(mesh0->getBoundingSphereRadius() == 1.5f && mesh0->getBoundingBoxMax() == glm::vec3(1.0f));
+    assert(mesh0->getCollisionHulls().size() == 1 && mesh0->getCollisionHulls() == mesh1->getCollisionHulls() && "Hull sharing was not restored!");
+    assert(mesh0->getCollisionHulls()[0]->getPlanes() == original->getCollisionHulls()[0]->getPlanes()
+        && mesh0->getCollisionHulls()[0]->getVertices().size() == 4 && "Hull was not restored!");
+    assert(mesh0->getMaterial()->getAlbedo() == glm::vec3(0.2f, 0.4f, 0.6f) && mesh0->getMaterial()->getShininess() == 32.0f);
+
+    const auto group = (*restored->getChildren())[2];
+    assert(group->getName() == "Group" && group->getChildren()->size() == 2 && "Nested nodes were not restored!");
+    const auto omni = std::dynamic_pointer_cast<Eng::PointLight>(group->getChildren()->front());
+    const auto spot = std::dynamic_pointer_cast<Eng::SpotLight>(group->getChildren()->back());
+    assert(omni && omni->getAttenuation() == 8.0f && omni->getColor() == glm::vec3(1.0f, 0.5f, 0.25f));
+    assert(spot && spot->getCutoffAngle() == 30.0f && spot->getFalloff() == 2.0f && spot->getRadius() == 12.0f);
+    const auto sun = std::dynamic_pointer_cast<Eng::DirectionalLight>(restored->getChildren()->back());
+    // Directions are normalized again on construction, which may move the last bit
+    const auto sunDirection = std::dynamic_pointer_cast<Eng::DirectionalLight>(graph->getChildren()->back())->getDirection();
+    assert(sun && glm::length(sun->getDirection() - sunDirection) < 1e-6f && "Directional light was not restored!");
+
+    // Read the cooked bytes back, to damage them
+    std::vector<char> bytes;
+    {
+        FILE* file = fopen(TEST_CACHE.c_str(), "rb");
+        char chunk[4096];
+        size_t read;
+        while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+            bytes.insert(bytes.end(), chunk, chunk + read);
+        fclose(file);
+    }
+
+    // Another source, other welding settings, or a damaged file, make the cache unusable
+    assert(Eng::SceneCache::load(TEST_CACHE, hash + 1, settings) == nullptr && "Stale cache was used!");
+    assert(Eng::SceneCache::load(TEST_CACHE, hash, { false, 0.001f }) == nullptr && "Welded cache was used without welding!");
+    assert(Eng::SceneCache::load(TEST_CACHE, hash, { true, 0.0f }) == nullptr && "Cache welded with another tolerance was used!");
+    assert(Eng::SceneCache::load("missing_scene.ovo.cooked", hash, settings) == nullptr);
+    for (const size_t cut : { bytes.size() - 1, bytes.size() / 2, size_t(70) }) {
+        FILE* file = fopen(TEST_CACHE.c_str(), "wb");
+        fwrite(bytes.data(), 1, cut, file);
+        fclose(file);
+        assert(Eng::SceneCache::load(TEST_CACHE, hash, settings) == nullptr && "Truncated cache was used!");
+    }
+    std::remove(TEST_CACHE.c_str());
+
+    std::cout << "Scene Cache Test Passed!" << std::endl;
+}
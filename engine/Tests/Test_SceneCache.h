@@ -0,0 +1,3 @@
+#pragma once
+
+void testSceneCache();
\ No newline at end of file
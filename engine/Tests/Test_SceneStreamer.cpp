@@ -0,0 +1,165 @@
+#include "../Engine.h"
+
+#include <atomic>
+
+namespace {
+    /**
+     * @brief Runs update() until the streamer completes, or gives up.
+     * @return size_t Number of update() calls.
+     */
+    size_t updateUntilComplete(Eng::SceneStreamer& streamer) {
+        size_t frames = 0;
+        while (!streamer.isComplete() && frames < 100000) {
+            streamer.update();
+            frames++;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        return frames;
+    }
+
+    /**
+     * @brief Waits until the worker half of every queued job has run.
+     */
+    void waitForDecoding(const Eng::SceneStreamer& streamer) {
+        for (int wait = 0; wait < 2000 && streamer.getStats().decoded < streamer.getStats().queued; wait++)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        assert(streamer.getStats().decoded == streamer.getStats().queued && "Jobs were not run!");
+    }
+}
+
+/**
+ * @brief Tests that jobs run on workers, uploads on the calling thread in order, and completion callbacks last.
+ */
+void Eng::testSceneStreamer() {
+    const auto renderThread = std::this_thread::get_id();
+
+    // One worker: uploads follow queue order
+    Eng::SceneStreamer streamer;
+    streamer.setThreadCount(1);
+    streamer.setFrameBudget(0.0);
+    std::vector<int> order;
+    std::atomic<int> offRenderThread{ 0 };
+    for (int i = 0; i < 20; i++) {
+        streamer.enqueue([i, &order, &offRenderThread, renderThread]() -> Eng::SceneStreamer::Upload {
+            if (std::this_thread::get_id() != renderThread)
+                offRenderThread++;
+            return [i, &order, renderThread]() {
+                assert(std::this_thread::get_id() == renderThread && "Upload ran on a worker!");
+                order.push_back(i);
+            };
+        });
+    }
+    int completions = 0;
+    size_t uploadedAtCompletion = 0;
+    streamer.whenComplete([&]() {
+        completions++;
+        uploadedAtCompletion = order.size();
+    });
+    assert(!streamer.isComplete());
+    updateUntilComplete(streamer);
+
+    assert(offRenderThread == 20 && "Jobs ran on the render thread!");
+    assert(order.size() == 20 && completions == 1 && uploadedAtCompletion == 20 && "Completion ran before the last upload!");
+    for (int i = 0; i < 20; i++)
+        assert(order[i] == i && "Uploads are out of order!");
+    assert(streamer.getProgress() == 1.0f && streamer.getStats().uploaded == 20);
+
+    // Several workers: every job completes once, whatever the order
+    streamer.setThreadCount(4);
+    std::atomic<int> sum{ 0 };
+    int uploads = 0;
+    for (int i = 1; i <= 64; i++) {
+        streamer.enqueue([i, &sum, &uploads]() -> Eng::SceneStreamer::Upload {
+            sum += i;
+            return [&uploads]() { uploads++; };
+        });
+    }
+    // A job without upload counts as done once run
+    streamer.enqueue([]() { return Eng::SceneStreamer::Upload(); });
+    updateUntilComplete(streamer);
+    assert(sum == 64 * 65 / 2 && uploads == 64 && streamer.getStats().uploaded == 65 && "Jobs were lost!");
+
+    // Nothing queued: callbacks run on the next update
+    bool idleCallback = false;
+    streamer.whenComplete([&idleCallback]() { idleCallback = true; });
+    assert(!streamer.isComplete());
+    streamer.update();
+    assert(idleCallback && streamer.isComplete());
+
+    std::cout << "SceneStreamer Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that update() stops uploading once the frame budget is spent, but always makes progress.
+ */
+void Eng::testSceneStreamerBudget() {
+    Eng::SceneStreamer streamer;
+    assert(streamer.getFrameBudget() == Eng::SceneStreamer::DEFAULT_FRAME_BUDGET);
+    streamer.setFrameBudget(5.0);
+
+    for (int i = 0; i < 12; i++) {
+        streamer.enqueue([]() -> Eng::SceneStreamer::Upload {
+            return []() { std::this_thread::sleep_for(std::chrono::milliseconds(2)); };
+        });
+    }
+    waitForDecoding(streamer);
+
+    // 2 ms uploads in a 5 ms budget: the third one crosses it
+    size_t frames = 0;
+    while (!streamer.isComplete()) {
+        const size_t uploaded = streamer.update();
+        assert(uploaded >= 1 && uploaded <= 3 && "Frame budget was not respected!");
+        frames++;
+    }
+    assert(frames >= 4 && streamer.getStats().frames == frames && "Uploads were not spread over frames!");
+
+    // An upload longer than the budget still runs, alone
+    streamer.setFrameBudget(0.5);
+    for (int i = 0; i < 3; i++) {
+        streamer.enqueue([]() -> Eng::SceneStreamer::Upload {
+            return []() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); };
+        });
+    }
+    waitForDecoding(streamer);
+    assert(streamer.update() == 1 && streamer.update() == 1 && streamer.update() == 1 && streamer.isComplete());
+
+    std::cout << "SceneStreamer Budget Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that cancel() drops queued jobs, pending uploads and callbacks, and waits for running jobs.
+ */
+void Eng::testSceneStreamerCancel() {
+    Eng::SceneStreamer streamer;
+    streamer.setThreadCount(2);
+    std::atomic<int> started{ 0 };
+    std::atomic<int> finished{ 0 };
+    int uploads = 0;
+    for (int i = 0; i < 50; i++) {
+        streamer.enqueue([&started, &finished, &uploads]() -> Eng::SceneStreamer::Upload {
+            started++;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            finished++;
+            return [&uploads]() { uploads++; };
+        });
+    }
+    bool completed = false;
+    streamer.whenComplete([&completed]() { completed = true; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    streamer.cancel();
+    assert(started == finished && "Cancel returned while a job was running!");
+    assert(started < 50 && "Queued jobs were not dropped!");
+    assert(streamer.isComplete() && streamer.getStats().queued == 0);
+    streamer.update();
+    assert(uploads == 0 && !completed && "Cancelled work was uploaded!");
+
+    // The streamer is reusable afterwards
+    streamer.enqueue([&uploads]() -> Eng::SceneStreamer::Upload {
+        return [&uploads]() { uploads++; };
+    });
+    updateUntilComplete(streamer);
+    assert(uploads == 1 && !completed);
+
+    std::cout << "SceneStreamer Cancel Test Passed!" << std::endl;
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+void testSceneStreamer();
+void testSceneStreamerBudget();
+void testSceneStreamerCancel();
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "../Engine.h"
+#include <chrono>
+
+/**
+ * @brief Tests symbol substitution and memoisation of ShaderManager::preprocessShaderCode.
+ */
+void Eng::testShaderPreprocessing() {
+    const std::string source =
+        "layout(location = ShaderManager::POSITION_LOCATION) in vec3 in_Position;\n"
+        "uniform mat4 ShaderManager::UNIFORM_PROJECTION_MATRIX;\n"
+        "uniform vec3 ShaderManager::UNIFORM_UNKNOWN;\n"
+        "uniform vec3 ShaderManager::UNIFORM_EYE_FRONT_OFFSET;\n";
+
+    const std::string expected =
+        "layout(location = " + std::to_string(ShaderManager::POSITION_LOCATION) + ") in vec3 in_Position;\n"
+        "uniform mat4 " + std::string(ShaderManager::UNIFORM_PROJECTION_MATRIX) + ";\n"
+        "uniform vec3 ShaderManager::UNIFORM_UNKNOWN;\n"
+        "uniform vec3 ShaderManager::UNIFORM_EYE_FRONT_OFFSET;\n";
+
+    ShaderManager::clearShaderCodeCache();
+    const std::string first = ShaderManager::preprocessShaderCode(source);
+    assert(first == expected && "Symbols were not substituted correctly!");
+
+    // Second call is served from the cache and must be identical
+    const std::string second = ShaderManager::preprocessShaderCode(source);
+    assert(second == first && "Memoised result differs from the original one!");
+
+    // Sources without symbols pass through untouched
+    const std::string plain = "void main() { gl_Position = vec4(0.0); }";
+    assert(ShaderManager::preprocessShaderCode(plain) == plain && "Plain source was modified!");
+
+    std::cout << "Shader Preprocessing Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Microbenchmark of shader preprocessing, with and without memoisation.
+ *
+ * The source is generated from ShaderManager::getShaderSymbolNames(), so it
+ * references every symbol in the table as the table grows. Prints the average
+ * time per call.
+ */
+void Eng::testShaderPreprocessingBenchmark() {
+    std::string body = "#version 440 core\n";
+    const auto names = ShaderManager::getShaderSymbolNames();
+    for (size_t i = 0; i < names.size(); i++)
+        body += "#define SYMBOL_" + std::to_string(i) + " ShaderManager::" + std::string(names[i]) + "\n";
+    assert(ShaderManager::substituteShaderSymbols(body).find("ShaderManager::") == std::string::npos && "A symbol was not substituted!");
+
+    // Eight shaders, like the ones built by the render pipeline
+    std::vector<std::string> sources;
+    for (int i = 0; i < 8; i++)
+        sources.push_back(body + "// shader " + std::to_string(i) + "\nvoid main() {}\n");
+
+    const int iterations = 1000;
+    using Clock = std::chrono::steady_clock;
+
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++)
+        for (const auto& source : sources)
+            ShaderManager::substituteShaderSymbols(source);
+    const double uncached = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    ShaderManager::clearShaderCodeCache();
+    start = Clock::now();
+    for (int i = 0; i < iterations; i++)
+        for (const auto& source : sources)
+            ShaderManager::preprocessShaderCode(source);
+    const double cached = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+    const double calls = static_cast<double>(iterations * sources.size());
+    std::cout << "   preprocess (single pass) : " << uncached / calls << " us/shader" << std::endl;
+    std::cout << "   preprocess (memoised)    : " << cached / calls << " us/shader" << std::endl;
+    std::cout << "Shader Preprocessing Benchmark Passed!" << std::endl;
+}
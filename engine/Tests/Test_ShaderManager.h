@@ -0,0 +1,4 @@
+#pragma once
+
+void testShaderPreprocessing();
+void testShaderPreprocessingBenchmark();
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "../Engine.h"
+
+/**
+ * @brief Tests that static meshes are merged per material and cell, and that dynamic ones are kept.
+ */
+void Eng::testStaticBatching() {
+    auto root = std::make_shared<Eng::Node>();
+    auto group = std::make_shared<Eng::Node>();
+    group->setLocalMatrix(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 2.0f)));
+    group->setParent(root.get());
+    root->addChild(group);
+
+    auto white = std::make_shared<Eng::Material>(glm::vec3(1.0f), 1.0f, 32.0f, glm::vec3(0));
+    auto black = std::make_shared<Eng::Material>(glm::vec3(0.0f), 1.0f, 32.0f, glm::vec3(0));
+    auto glass = std::make_shared<Eng::Material>(glm::vec3(0.5f), 0.5f, 32.0f, glm::vec3(0));
+
+    // Every triangle gets its own texture coordinates, so none is left to instancing with a copy
+    float variant = 0.0f;
+    auto addTriangle = [&variant](const std::shared_ptr<Eng::Node>& parent, const std::shared_ptr<Eng::Material>& material,
+                                  const glm::vec3& position, const std::string& name) {
+        variant += 1.0f;
+        return Eng::addTestMesh(parent, Eng::Geometry::create(Eng::makeTestTriangle(0.1f, glm::vec2(variant)), { 0, 1, 2 }),
+                                material, position, name);
+    };
+
+    // Same cell: three white squares merge, the single black one stays
+    addTriangle(group, white, glm::vec3(0.0f), "Square_0");
+    addTriangle(group, white, glm::vec3(0.2f, 0.0f, 0.0f), "Square_1");
+    addTriangle(root, white, glm::vec3(0.4f, 0.0f, 2.0f), "Square_2");
+    addTriangle(group, black, glm::vec3(0.6f, 0.0f, 0.0f), "Square_3");
+    // Another cell
+    addTriangle(group, white, glm::vec3(5.0f, 0.0f, 0.0f), "Far_0");
+    addTriangle(group, white, glm::vec3(5.2f, 0.0f, 0.0f), "Far_1");
+    // Transparent meshes are never merged
+    addTriangle(group, glass, glm::vec3(0.0f, 0.5f, 0.0f), "Glass_0");
+    addTriangle(group, glass, glm::vec3(0.2f, 0.5f, 0.0f), "Glass_1");
+    // Dynamic: flagged, and selected by the filter
+    auto piece = addTriangle(group, white, glm::vec3(0.3f, 0.0f, 0.0f), "W_Pawn");
+    auto flagged = addTriangle(group, white, glm::vec3(0.5f, 0.0f, 0.0f), "Flagged");
+    flagged->setDynamic(true);
+
+    Eng::StaticBatcher batcher;
+    batcher.setCellSize(1.0f);
+    batcher.setDynamicFilter([](const Eng::Node& node) {
+        return node.getName().rfind("W_", 0) == 0;
+    });
+    const auto stats = batcher.batch(root);
+
+    assert(stats.candidateMeshes == 6 && stats.instancedMeshes == 0 && "Wrong number of static meshes considered!");
+    assert(stats.mergedMeshes == 5 && "Wrong number of meshes merged!");
+    assert(stats.batches == 2 && "Wrong number of batches created!");
+    assert(stats.dynamicNodes == 2 && "Dynamic nodes were not skipped!");
+
+    // Dynamic and unmerged meshes keep their place
+    assert(piece->getParent() == group.get() && "Dynamic mesh was moved!");
+    assert(flagged->getParent() == group.get() && "Flagged mesh was moved!");
+    assert(group->getChildren()->size() == 5 && "Unexpected children left in the group!");
+    assert(root->getChildren()->size() == 2 && "Batches were not attached to the root!");
+
+    // Batch vertices are pre-transformed and its bounds enclose them all
+    const auto batches = root->getChildren()->back();
+    assert(batches->getName() == "StaticBatches" && batches->getChildren()->size() == 2);
+    const auto nearBatch = std::dynamic_pointer_cast<Eng::Mesh>(batches->getChildren()->front());
+    assert(nearBatch && nearBatch->getMaterial() == white && nearBatch->getVertices().size() == 9);
+    assert(nearBatch->getIndices() == std::vector<unsigned int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8 }));
+    assert(glm::length(nearBatch->getVertices()[3].getPosition() - glm::vec3(0.2f, 0.0f, 2.0f)) < 1e-5f && "Batch vertex was not transformed!");
+    assert(glm::length(nearBatch->getBoundingBoxMax() - glm::vec3(0.5f, 0.1f, 2.0f)) < 1e-5f && "Batch bounding box is wrong!");
+    for (const auto& vertex : nearBatch->getVertices()) {
+        const float distance = glm::length(vertex.getPosition() - nearBatch->getBoundingSphereCenter());
+        assert(distance <= nearBatch->getBoundingSphereRadius() + 1e-5f && "Batch bounding sphere misses a vertex!");
+    }
+
+    // A second pass finds nothing left to merge
+    const auto again = batcher.batch(root);
+    assert(again.batches == 0 && "Batches were merged again!");
+
+    std::cout << "Static Batching Test Passed!" << std::endl;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testStaticBatching();
\ No newline at end of file
@@ -0,0 +1,184 @@
+#include "../Engine.h"
+#include <GL/glew.h>
+#include <GL/freeglut.h>
+#include <cstdlib>
+#include <random>
+
+namespace {
+    /**
+     * @brief Builds a DDS file header for a FourCC format.
+     */
+    std::vector<char> ddsHeader(const char* code, const uint32_t width, const uint32_t height, const uint32_t levels) {
+        std::vector<char> file(128, 0);
+        auto put = [&file](const size_t offset, const uint32_t value) { std::memcpy(file.data() + offset, &value, sizeof(value)); };
+        std::memcpy(file.data(), "DDS ", 4);
+        put(4, 124);
+        put(8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000);
+        put(12, height);
+        put(16, width);
+        put(28, levels);
+        put(76, 32);
+        put(80, 0x4);
+        std::memcpy(file.data() + 84, code, 4);
+        put(108, 0x1000);
+        return file;
+    }
+
+    /**
+     * @brief Appends blocks whose bytes encode their level, block row and block column.
+     */
+    void appendBlocks(std::vector<char>& file, const size_t blockSize, const uint32_t width, const uint32_t height, const uint32_t levels) {
+        for (uint32_t level = 0; level < levels; level++) {
+            const uint32_t blocksWide = (std::max(width >> level, 1u) + 3) / 4;
+            const uint32_t blocksHigh = (std::max(height >> level, 1u) + 3) / 4;
+            for (uint32_t y = 0; y < blocksHigh; y++) {
+                for (uint32_t x = 0; x < blocksWide; x++) {
+                    for (size_t b = 0; b < blockSize; b++)
+                        file.push_back(static_cast<char>(level * 64 + y * 16 + x * 8 + b));
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests that DDS block-compressed files are read with their mip chain and flipped bottom row first.
+ */
+void Eng::testDdsDecoding() {
+    // BC1: an 8x16 image with its full chain of 5 levels
+    std::vector<char> file = ddsHeader("DXT1", 8, 16, 5);
+    appendBlocks(file, 8, 8, 16, 5);
+    Eng::Texture::Image image;
+    assert(Eng::Texture::decodeDds(file.data(), file.size(), image) && "BC1 file was not decoded!");
+    assert(image.width == 8 && image.height == 16 && image.compressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT);
+    assert(image.pixels.size() == file.size() - 128 && "Blocks were expanded!");
+    const std::vector<size_t> expectedLevels = { 0, 64, 80, 88, 96 };
+    assert(image.levels == expectedLevels && "Mip levels are misplaced!");
+
+    // The last block row comes first, and the four index rows of each block are reversed
+    const auto stored = [&file](const size_t offset) { return static_cast<unsigned char>(file[128 + offset]); };
+    assert(image.pixels[0] == stored(3 * 16) && image.pixels[8] == stored(3 * 16 + 8) && "Block rows were not flipped!");
+    assert(image.pixels[4] == stored(3 * 16 + 7) && image.pixels[7] == stored(3 * 16 + 4) && "Block was not flipped!");
+    assert(image.pixels[0 + 2] == stored(3 * 16 + 2) && "Block colors were changed!");
+    // 1x2 level: only the two rows in use swap
+    assert(image.pixels[88 + 4] == stored(88 + 5) && image.pixels[88 + 5] == stored(88 + 4) && image.pixels[88 + 6] == stored(88 + 6));
+
+    // BC3: interpolated alpha indices are reversed 12 bits per row, colors as in BC1
+    file = ddsHeader("DXT5", 4, 4, 1);
+    const unsigned char alpha[16] = { 1, 2, 0x01, 0x20, 0x03, 0x04, 0x50, 0x06, 9, 9, 9, 9, 0xA, 0xB, 0xC, 0xD };
+    file.insert(file.end(), alpha, alpha + 16);
+    assert(Eng::Texture::decodeDds(file.data(), file.size(), image) && image.compressedFormat == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT);
+    const unsigned char flipped[16] = { 1, 2, 0x65, 0x40, 0x00, 0x32, 0x10, 0x00, 9, 9, 9, 9, 0xD, 0xC, 0xB, 0xA };
+    assert(std::memcmp(image.pixels.data(), flipped, 16) == 0 && "BC3 block was not flipped!");
+    assert(image.levels.size() == 1 && image.levels[0] == 0);
+
+    // Single and dual channel formats
+    file = ddsHeader("ATI1", 4, 4, 1);
+    appendBlocks(file, 8, 4, 4, 1);
+    assert(Eng::Texture::decodeDds(file.data(), file.size(), image) && image.compressedFormat == GL_COMPRESSED_RED_RGTC1);
+    file = ddsHeader("ATI2", 4, 4, 1);
+    appendBlocks(file, 16, 4, 4, 1);
+    assert(Eng::Texture::decodeDds(file.data(), file.size(), image) && image.compressedFormat == GL_COMPRESSED_RG_RGTC2);
+
+    // Left to FreeImage: truncated data, unknown formats, heights that cannot be flipped by blocks
+    file = ddsHeader("DXT1", 8, 8, 4);
+    appendBlocks(file, 8, 8, 8, 4);
+    file.pop_back();
+    assert(!Eng::Texture::decodeDds(file.data(), file.size(), image) && "Truncated file was decoded!");
+    file = ddsHeader("DXT2", 4, 4, 1);
+    appendBlocks(file, 16, 4, 4, 1);
+    assert(!Eng::Texture::decodeDds(file.data(), file.size(), image) && "Unsupported format was decoded!");
+    file = ddsHeader("DXT1", 8, 6, 1);
+    appendBlocks(file, 8, 8, 6, 1);
+    assert(!Eng::Texture::decodeDds(file.data(), file.size(), image) && "Unflippable height was decoded!");
+    assert(!Eng::Texture::decodeDds("DDS ", 4, image));
+
+    std::cout << "DDS Decoding Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Measures texture load throughput: DDS decoding on the CPU, then uploads with their mipmaps.
+ *
+ * Uploads need an OpenGL context and are skipped without one. The mipmap chain of
+ * uncompressed images is built with glGenerateMipmap, as Texture::upload() does,
+ * and with the gluBuild2DMipmaps CPU path it replaced, for comparison.
+ */
+void Eng::testTextureLoadBenchmark() {
+    constexpr uint32_t SIZE = 2048;
+    constexpr double MB = 1024.0 * 1024.0;
+    using Clock = std::chrono::steady_clock;
+    auto throughput = [](const double bytes, const Clock::time_point start) {
+        return bytes / MB / std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    // BC1 with its full chain, as the shipped 2K textures
+    std::vector<char> file = ddsHeader("DXT1", SIZE, SIZE, 12);
+    appendBlocks(file, 8, SIZE, SIZE, 12);
+    Eng::Texture::Image compressed;
+    const int decodes = 20;
+    bool decoded = true;
+    auto start = Clock::now();
+    for (int i = 0; i < decodes; i++)
+        decoded = Eng::Texture::decodeDds(file.data(), file.size(), compressed) && decoded;
+    std::cout << "   DDS decode . . . . . . . : " << throughput(static_cast<double>(file.size()) * decodes, start) << " MB/s" << std::endl;
+    assert(decoded && compressed.levels.size() == 12 && "Benchmark file was not decoded!");
+
+#ifndef _WIN32
+    if (!std::getenv("DISPLAY")) {
+        std::cout << "Texture Load Benchmark Passed! (uploads skipped, no display)" << std::endl;
+        return;
+    }
+#endif
+    glutInitDisplayMode(GLUT_RGBA);
+    glutInitContextVersion(4, 4);
+    glutInitContextProfile(GLUT_COMPATIBILITY_PROFILE);
+    const int window = glutCreateWindow("Texture load benchmark");
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        glutDestroyWindow(window);
+        std::cout << "Texture Load Benchmark Passed! (uploads skipped, no OpenGL)" << std::endl;
+        return;
+    }
+
+    Eng::Texture::Image pixels;
+    pixels.width = pixels.height = SIZE;
+    pixels.pixels.resize(static_cast<size_t>(SIZE) * SIZE * 4);
+    std::mt19937 random(5);
+    for (auto& value : pixels.pixels)
+        value = static_cast<unsigned char>(random());
+    const double pixelBytes = static_cast<double>(pixels.pixels.size());
+    const int uploads = 3;
+
+    Eng::Texture texture("", false);
+    bool uploaded = true;
+    start = Clock::now();
+    for (int i = 0; i < uploads; i++) {
+        uploaded = texture.upload(pixels) && uploaded;
+        glFinish();
+    }
+    std::cout << "   RGBA8 + glGenerateMipmap : " << throughput(pixelBytes * uploads, start) << " MB/s" << std::endl;
+    assert(uploaded && texture.isLoaded() && !texture.isCompressed());
+
+    unsigned int reference = 0;
+    glGenTextures(1, &reference);
+    glBindTexture(GL_TEXTURE_2D, reference);
+    start = Clock::now();
+    for (int i = 0; i < uploads; i++) {
+        gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA8, SIZE, SIZE, GL_BGRA_EXT, GL_UNSIGNED_BYTE, pixels.pixels.data());
+        glFinish();
+    }
+    std::cout << "   RGBA8 + gluBuild2DMipmaps: " << throughput(pixelBytes * uploads, start) << " MB/s" << std::endl;
+    glDeleteTextures(1, &reference);
+
+    start = Clock::now();
+    for (int i = 0; i < uploads; i++) {
+        uploaded = texture.upload(compressed) && uploaded;
+        glFinish();
+    }
+    std::cout << "   BC1 with stored mipmaps  : " << throughput(static_cast<double>(compressed.pixels.size()) * uploads, start)
+              << " MB/s (" << throughput(pixelBytes * uploads, start) << " MB/s of RGBA8 texels)" << std::endl;
+    assert(uploaded && texture.isCompressed() && texture.getMemoryUsage() == compressed.pixels.size());
+
+    glutDestroyWindow(window);
+    std::cout << "Texture Load Benchmark Passed!" << std::endl;
+}
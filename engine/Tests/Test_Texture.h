@@ -0,0 +1,4 @@
+#pragma once
+
+void testDdsDecoding();
+void testTextureLoadBenchmark();
\ No newline at end of file
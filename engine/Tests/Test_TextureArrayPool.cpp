@@ -0,0 +1,114 @@
+#include "../Engine.h"
+#include <GL/glew.h>
+#include <GL/freeglut.h>
+#include <cstdlib>
+
+namespace {
+    /**
+     * @brief Creates a texture filled with one BGRA color.
+     */
+    std::shared_ptr<Eng::Texture> makeTexture(const int width, const int height, const unsigned char value) {
+        Eng::Texture::Image image;
+        image.width = width;
+        image.height = height;
+        image.pixels.assign(static_cast<size_t>(width) * height * 4, value);
+
+        auto texture = std::make_shared<Eng::Texture>();
+        const bool uploaded = texture->upload(image);
+        assert(uploaded && "Test texture could not be uploaded!");
+        return texture;
+    }
+}
+
+/**
+ * @brief Tests that only loaded 2D textures at full resolution are packed.
+ */
+void Eng::testTextureArrayPoolPacking() {
+    auto& pool = Eng::TextureArrayPool::getInstance();
+    const auto placeholder = std::make_shared<Eng::Texture>();
+    Eng::TextureArrayPool::Slot slot;
+
+    // Textures still streaming render as placeholders and keep being bound on their own
+    assert(!Eng::TextureArrayPool::canPack(*placeholder) && "Unloaded texture can be packed!");
+    assert(!pool.acquire(placeholder, slot) && "Unloaded texture was packed!");
+    assert(!pool.acquire(nullptr, slot) && "Missing texture was packed!");
+    assert(slot.layer == -1 && "Slot was filled for a texture that is not packed!");
+
+    const auto stats = pool.getStats();
+    assert(stats.textures == 0 && stats.arrays == 0 && "Pool holds textures it refused!");
+
+    std::cout << "Texture Array Pool Packing Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that same-format textures share an array and that layers follow texture changes.
+ *
+ * Needs an OpenGL 4.3 context; skipped when no context can be created.
+ */
+void Eng::testTextureArrayPoolLayers() {
+#ifndef _WIN32
+    if (!std::getenv("DISPLAY")) {
+        std::cout << "Texture Array Pool Layers Test Skipped (no display)" << std::endl;
+        return;
+    }
+#endif
+
+    glutInitDisplayMode(GLUT_RGBA);
+    glutInitContextVersion(4, 4);
+    glutInitContextProfile(GLUT_CORE_PROFILE);
+    const int window = glutCreateWindow("Texture array test");
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK || !Eng::TextureArrayPool::isSupported()) {
+        glutDestroyWindow(window);
+        std::cout << "Texture Array Pool Layers Test Skipped (no image copy support)" << std::endl;
+        return;
+    }
+
+    auto& pool = Eng::TextureArrayPool::getInstance();
+    pool.clear();
+
+    // Same size and format: one array, distinct layers, more than the initial capacity
+    std::vector<std::shared_ptr<Eng::Texture>> textures;
+    std::vector<Eng::TextureArrayPool::Slot> slots;
+    for (size_t i = 0; i < Eng::TextureArrayPool::MIN_LAYER_CAPACITY + 1; i++) {
+        textures.push_back(makeTexture(64, 64, static_cast<unsigned char>(i * 40)));
+        Eng::TextureArrayPool::Slot slot;
+        assert(pool.acquire(textures.back(), slot) && "Texture was not packed!");
+        for (const auto& other : slots)
+            assert(other.array == slot.array && other.layer != slot.layer && "Same-format textures do not share an array!");
+        slots.push_back(slot);
+    }
+    assert(pool.getStats().arrays == 1 && pool.getStats().layers > Eng::TextureArrayPool::MIN_LAYER_CAPACITY);
+
+    // Asking again is free, while another size gets its own array
+    Eng::TextureArrayPool::Slot slot;
+    assert(pool.acquire(textures[0], slot) && slot.array == slots[0].array && slot.layer == slots[0].layer);
+    const auto larger = makeTexture(128, 128, 255);
+    assert(pool.acquire(larger, slot) && slot.array != slots[0].array && "Different sizes share an array!");
+    const size_t copies = pool.getStats().copies;
+
+    // A re-uploaded texture is copied again; a trimmed one falls back to its own binding
+    Eng::Texture::Image image;
+    image.width = image.height = 64;
+    image.pixels.assign(64 * 64 * 4, 128);
+    textures[1]->upload(image);
+    assert(pool.acquire(textures[1], slot) && pool.getStats().copies == copies + 1 && "Stale copy was reused!");
+    assert(textures[2]->dropLevels(1));
+    assert(!pool.acquire(textures[2], slot) && "Trimmed texture was packed!");
+
+    // Layers of destroyed textures are handed out again before the array grows
+    const size_t layers = pool.getStats().layers;
+    textures.resize(1);
+    for (int i = 0; i < 4; i++) {
+        textures.push_back(makeTexture(64, 64, 16));
+        assert(pool.acquire(textures.back(), slot) && slot.array == slots[0].array);
+    }
+    assert(pool.getStats().layers == layers && "Array grew while layers were free!");
+
+    pool.clear();
+    textures.clear();
+    glutDestroyWindow(window);
+
+    std::cout << "Texture Array Pool Layers Test Passed!" << std::endl;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+void testTextureArrayPoolPacking();
+void testTextureArrayPoolLayers();
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "../Engine.h"
+
+/**
+ * @brief Tests that textures are shared by normalized path and released with their last owner.
+ */
+void Eng::testTextureCache() {
+    auto& manager = Eng::TextureManager::getInstance();
+    assert(Eng::TextureManager::normalizePath("textures//wood/../Board.dds") == "textures/Board.dds" && "Path was not normalized!");
+    const auto before = manager.getStats();
+
+    // Deferred textures are cached without touching the file or OpenGL
+    auto board = manager.load("textures/Board.dds", false);
+    auto sameBoard = manager.load("textures/./wood/../Board.dds", false);
+    auto pawn = manager.load("textures/Pawn.dds", false);
+    assert(board && board == sameBoard && "Same file gave two textures!");
+    assert(board != pawn && "Different files share a texture!");
+    assert(board->getFilePath() == "textures/Board.dds" && !board->isLoaded());
+    assert(manager.find("textures/Board.dds") == board);
+
+    auto stats = manager.getStats();
+    assert(stats.uniqueTextures == before.uniqueTextures + 2 && stats.references == before.references + 3);
+    assert(stats.requests == before.requests + 3 && stats.hits == before.hits + 1 && "Cache hits were not counted!");
+
+    // Weak references: the texture goes with its last owner and is reloaded on request
+    board.reset();
+    assert(manager.find("textures/Board.dds") == sameBoard && "Texture released while still used!");
+    sameBoard.reset();
+    assert(!manager.find("textures/Board.dds") && "Unused texture was kept alive!");
+    stats = manager.getStats();
+    assert(stats.uniqueTextures == before.uniqueTextures + 1 && stats.references == before.references + 1);
+    auto reloaded = manager.load("textures/Board.dds", false);
+    assert(reloaded && reloaded != pawn && manager.getStats().hits == before.hits + 1);
+
+    std::cout << "Texture Cache Test Passed!" << std::endl;
+}
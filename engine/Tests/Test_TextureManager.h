@@ -0,0 +1,3 @@
+#pragma once
+
+void testTextureCache();
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "../Engine.h"
+
+namespace {
+    ///> Width and height of the simulated textures
+    constexpr int TEXTURE_SIZE = 1024;
+    ///> Simulated textures
+    constexpr size_t TEXTURE_COUNT = 8;
+    ///> Frames a texture must go unrendered before it may be trimmed
+    constexpr uint64_t IDLE_FRAMES = 10;
+
+    /**
+     * @brief A mipmapped RGBA8 texture, trimmed, evicted and restored without OpenGL.
+     */
+    struct SimulatedTexture {
+        Eng::TextureResidency::Candidate candidate;
+        unsigned int droppedLevels = 0;
+        bool evicted = false;
+    };
+
+    /**
+     * @brief VRAM of a simulated texture with some top levels dropped.
+     */
+    size_t bytesOf(const unsigned int droppedLevels) {
+        size_t bytes = 0;
+        for (int size = TEXTURE_SIZE >> droppedLevels; size > 0; size >>= 1)
+            bytes += static_cast<size_t>(size) * size * 4;
+        return bytes;
+    }
+
+    /**
+     * @brief Refreshes the candidate of a simulated texture after a change.
+     */
+    void refresh(SimulatedTexture& texture) {
+        Eng::TextureResidency::Candidate& candidate = texture.candidate;
+        candidate.bytes = texture.evicted ? 0 : bytesOf(texture.droppedLevels);
+        candidate.fullBytes = bytesOf(0);
+        const bool canDrop = !texture.evicted && (TEXTURE_SIZE >> (texture.droppedLevels + 1)) >= Eng::TextureResidency::MIN_TRIMMED_SIZE;
+        candidate.trimmedBytes = canDrop ? bytesOf(texture.droppedLevels + 1) : 0;
+    }
+
+    /**
+     * @brief Simulates frames rendering some of the textures, applying the plan after each one.
+     */
+    void renderFrames(std::vector<SimulatedTexture>& textures, uint64_t& frame, const uint64_t frames,
+                      const std::vector<size_t>& visible, const size_t budget) {
+        for (uint64_t i = 0; i < frames; i++, frame++) {
+            for (const size_t index : visible)
+                textures[index].candidate.lastUsed = frame;
+
+            std::vector<Eng::TextureResidency::Candidate> candidates;
+            for (const auto& texture : textures)
+                candidates.push_back(texture.candidate);
+            const auto actions = Eng::TextureResidency::plan(candidates, budget, frame, IDLE_FRAMES);
+            assert(actions.size() == textures.size());
+
+            for (size_t t = 0; t < textures.size(); t++) {
+                SimulatedTexture& texture = textures[t];
+                switch (actions[t]) {
+                    case Eng::TextureResidency::Action::DropLevel:
+                        assert(texture.candidate.trimmedBytes && "Texture trimmed past its smallest size!");
+                        texture.droppedLevels++;
+                        break;
+                    case Eng::TextureResidency::Action::Evict:
+                        texture.evicted = true;
+                        texture.droppedLevels = 0;
+                        break;
+                    case Eng::TextureResidency::Action::Restore:
+                        texture.evicted = false;
+                        texture.droppedLevels = 0;
+                        break;
+                    case Eng::TextureResidency::Action::Keep:
+                        break;
+                }
+                refresh(texture);
+            }
+        }
+    }
+
+    /**
+     * @brief Sums the VRAM held by the simulated textures.
+     */
+    size_t totalBytes(const std::vector<SimulatedTexture>& textures) {
+        size_t total = 0;
+        for (const auto& texture : textures)
+            total += texture.candidate.bytes;
+        return total;
+    }
+
+    /**
+     * @brief Creates the simulated textures, resident at full resolution.
+     */
+    std::vector<SimulatedTexture> makeTextures() {
+        std::vector<SimulatedTexture> textures(TEXTURE_COUNT);
+        for (auto& texture : textures)
+            refresh(texture);
+        return textures;
+    }
+}
+
+/**
+ * @brief Tests that idle textures are trimmed to fit the budget and restored once used again.
+ */
+void Eng::testTextureResidencyBudget() {
+    const size_t fullBytes = bytesOf(0);
+    const size_t budget = fullBytes * TEXTURE_COUNT / 2 + fullBytes / 2;
+    const std::vector<size_t> first = { 0, 1, 2, 3 };
+    const std::vector<size_t> second = { 4, 5, 6, 7 };
+    auto textures = makeTextures();
+    uint64_t frame = 1;
+
+    // Nothing is idle yet: the budget is exceeded rather than trimming textures just loaded
+    renderFrames(textures, frame, IDLE_FRAMES - 1, first, budget);
+    assert(totalBytes(textures) == fullBytes * TEXTURE_COUNT && "Textures trimmed before going idle!");
+
+    // The unused half is trimmed, not evicted, while the visible half stays at full resolution
+    renderFrames(textures, frame, IDLE_FRAMES, first, budget);
+    assert(totalBytes(textures) <= budget && "Textures do not fit the budget!");
+    for (const size_t index : first)
+        assert(textures[index].candidate.bytes == fullBytes && "Visible texture was trimmed!");
+    for (const size_t index : second)
+        assert(!textures[index].evicted && textures[index].droppedLevels > 0 && "Idle texture was not trimmed first!");
+
+    // Looking at the other half restores it once the first half went idle and made room
+    renderFrames(textures, frame, 2 * IDLE_FRAMES, second, budget);
+    assert(totalBytes(textures) <= budget && "Textures do not fit the budget!");
+    for (const size_t index : second)
+        assert(textures[index].candidate.bytes == fullBytes && "Visible texture was not restored!");
+    for (const size_t index : first)
+        assert(textures[index].droppedLevels > 0 && "Idle texture was not trimmed!");
+
+    // Without a budget every texture in use comes back and nothing is trimmed
+    renderFrames(textures, frame, 1, { 0, 1, 2, 3, 4, 5, 6, 7 }, 0);
+    assert(totalBytes(textures) == fullBytes * TEXTURE_COUNT && "Textures were not restored without a budget!");
+
+    // Textures being restored count at full size and are left alone
+    std::vector<Eng::TextureResidency::Candidate> candidates(2);
+    candidates[0] = { 0, fullBytes, 0, 0, true };
+    candidates[1] = { fullBytes, fullBytes, bytesOf(1), 0, false };
+    const auto actions = Eng::TextureResidency::plan(candidates, fullBytes, 100, IDLE_FRAMES);
+    assert(actions[0] == Eng::TextureResidency::Action::Keep && actions[1] == Eng::TextureResidency::Action::DropLevel);
+
+    std::cout << "Texture Residency Budget Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests that idle textures are evicted, least recently used first, when trimming is not enough.
+ */
+void Eng::testTextureResidencyOverBudget() {
+    const size_t fullBytes = bytesOf(0);
+    auto textures = makeTextures();
+    uint64_t frame = 1;
+
+    // Textures 6 and 7 go idle last, so with room for one more texture they are the ones kept
+    renderFrames(textures, frame, 5, { 0, 1, 2, 3, 4, 5, 6, 7 }, 0);
+    renderFrames(textures, frame, 5, { 0, 1, 6, 7 }, 0);
+    const size_t budget = 3 * fullBytes - fullBytes / 2;
+    renderFrames(textures, frame, 4 * IDLE_FRAMES, { 0, 1 }, budget);
+    assert(totalBytes(textures) <= budget && "Textures do not fit the budget!");
+    assert(textures[0].candidate.bytes == fullBytes && textures[1].candidate.bytes == fullBytes && "Visible texture was changed!");
+    for (const size_t index : { 2, 3, 4, 5 })
+        assert(textures[index].evicted && "Least recently used texture was not evicted!");
+    assert(!textures[7].evicted && "Most recently used texture was evicted before older ones!");
+
+    // A budget smaller than the visible textures is exceeded, never trimming them
+    renderFrames(textures, frame, 2 * IDLE_FRAMES, { 0, 1 }, fullBytes);
+    assert(textures[0].candidate.bytes == fullBytes && textures[1].candidate.bytes == fullBytes && "Visible texture was changed!");
+    for (size_t index = 2; index < TEXTURE_COUNT; index++)
+        assert(textures[index].evicted && "Idle texture was kept over budget!");
+
+    // Evicted textures rendered again come back as the budget allows
+    renderFrames(textures, frame, 1, { 2, 3 }, 4 * fullBytes);
+    assert(textures[2].candidate.bytes == fullBytes && textures[3].candidate.bytes == fullBytes && "Evicted texture was not restored!");
+    assert(totalBytes(textures) == 4 * fullBytes);
+
+    std::cout << "Texture Residency Over Budget Test Passed!" << std::endl;
+}
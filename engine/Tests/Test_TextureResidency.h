@@ -0,0 +1,4 @@
+#pragma once
+
+void testTextureResidencyBudget();
+void testTextureResidencyOverBudget();
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "../Engine.h"
+
+#include <atomic>
+
+namespace {
+    ///> Image bytes decoded per test texture
+    constexpr size_t IMAGE_BYTES = 1000;
+
+    /**
+     * @brief Creates textures named "0.png", "1.png"... that are not loaded.
+     */
+    std::vector<std::shared_ptr<Eng::Texture>> makeTextures(const int count) {
+        std::vector<std::shared_ptr<Eng::Texture>> textures;
+        for (int i = 0; i < count; i++)
+            textures.push_back(std::make_shared<Eng::Texture>(std::to_string(i) + ".png", false));
+        return textures;
+    }
+
+    /**
+     * @brief Gets the number a test texture file is named after.
+     */
+    int indexOf(const std::string& filePath) {
+        return std::stoi(filePath.substr(0, filePath.find('.')));
+    }
+
+    /**
+     * @brief Runs update() until the streamer completes, or gives up.
+     */
+    void updateUntilComplete(Eng::TextureStreamer& streamer) {
+        for (int frame = 0; frame < 100000 && !streamer.isComplete(); frame++) {
+            streamer.update();
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        assert(streamer.isComplete() && "Streaming did not complete!");
+    }
+}
+
+/**
+ * @brief Tests that textures decode on workers and upload in queue order, within the frame budget.
+ */
+void Eng::testTextureStreamerOrdering() {
+    const auto renderThread = std::this_thread::get_id();
+    Eng::TextureStreamer streamer;
+    streamer.setThreadCount(4);
+    streamer.setFrameBudget(IMAGE_BYTES * 5 / 2);
+
+    // Earlier textures take longer, so workers finish them out of order; "3.png" fails
+    std::atomic<int> offRenderThread{ 0 };
+    streamer.setDecoder([&offRenderThread, renderThread](const std::string& filePath, Eng::Texture::Image& image) {
+        const int index = indexOf(filePath);
+        if (std::this_thread::get_id() != renderThread)
+            offRenderThread++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(12 - index));
+        image.width = index;
+        image.pixels.assign(IMAGE_BYTES, static_cast<unsigned char>(index));
+        return index != 3;
+    });
+    std::vector<int> order;
+    std::vector<size_t> perFrame;
+    streamer.setUploader([&order, renderThread](Eng::Texture& texture, const Eng::Texture::Image& image) {
+        assert(std::this_thread::get_id() == renderThread && "Upload ran on a worker!");
+        assert(indexOf(texture.getFilePath()) == image.width && "Image went to the wrong texture!");
+        order.push_back(image.width);
+    });
+
+    auto textures = makeTextures(12);
+    for (const auto& texture : textures)
+        assert(streamer.enqueue(texture) && "Texture was not queued!");
+    assert(!streamer.enqueue(textures[0]) && "Texture was queued twice!");
+    assert(!streamer.enqueue(nullptr) && !streamer.enqueue(std::make_shared<Eng::Texture>("", false)));
+    assert(streamer.getPendingCount() == 12 && !streamer.isComplete());
+
+    for (int frame = 0; frame < 100000 && !streamer.isComplete(); frame++) {
+        if (const size_t uploaded = streamer.update())
+            perFrame.push_back(uploaded);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    assert(streamer.isComplete() && streamer.getPendingCount() == 0);
+
+    const std::vector<int> expected = { 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11 };
+    assert(order == expected && "Uploads are not in queue order!");
+    assert(offRenderThread == 12 && "Decoding ran on the render thread!");
+    for (const size_t uploaded : perFrame)
+        assert(uploaded <= 2 && "Frame budget was exceeded!");
+
+    const auto stats = streamer.getStats();
+    assert(stats.queued == 12 && stats.decoded == 11 && stats.failed == 1 && stats.uploaded == 11 && stats.cancelled == 0);
+    assert(stats.bytesUploaded == 11 * IMAGE_BYTES && stats.frames == perFrame.size());
+
+    // Uploaded textures can be queued again, and a budget smaller than one image still uploads one per frame
+    streamer.setFrameBudget(1);
+    order.clear();
+    assert(streamer.enqueue(textures[0]) && streamer.enqueue(textures[1]));
+    updateUntilComplete(streamer);
+    assert(order.size() == 2 && order[0] == 0 && order[1] == 1);
+
+    Eng::TextureStreamer::printStats(streamer.getStats());
+    std::cout << "Texture Streamer Ordering Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Tests cancelling single textures, released textures and everything pending.
+ */
+void Eng::testTextureStreamerCancel() {
+    Eng::TextureStreamer streamer;
+    streamer.setThreadCount(2);
+    streamer.setFrameBudget(0);
+
+    // Decoding waits for the gate, so nothing is uploaded while cancelling
+    std::atomic<bool> gate{ false };
+    std::atomic<int> decodes{ 0 };
+    streamer.setDecoder([&gate, &decodes](const std::string& filePath, Eng::Texture::Image& image) {
+        while (!gate)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        decodes++;
+        image.width = indexOf(filePath);
+        image.pixels.assign(IMAGE_BYTES, 0);
+        return true;
+    });
+    std::vector<int> order;
+    streamer.setUploader([&order](Eng::Texture&, const Eng::Texture::Image& image) { order.push_back(image.width); });
+
+    auto textures = makeTextures(10);
+    for (const auto& texture : textures)
+        streamer.enqueue(texture);
+
+    // Texture 0 is being decoded, 7 is still queued, 5 loses its last owner
+    assert(streamer.cancel(textures[0]) && streamer.cancel(textures[7]) && "Pending textures were not cancelled!");
+    assert(!streamer.cancel(textures[7]) && "Texture was cancelled twice!");
+    const std::weak_ptr<Eng::Texture> released = textures[5];
+    textures[5].reset();
+    assert(released.expired());
+
+    assert(streamer.update() == 0 && !streamer.isComplete());
+    gate = true;
+    updateUntilComplete(streamer);
+    const std::vector<int> expected = { 1, 2, 3, 4, 6, 8, 9 };
+    assert(order == expected && "Cancelled textures were uploaded!");
+    assert(streamer.getStats().cancelled == 3 && streamer.getStats().uploaded == 7);
+    assert(decodes < 10 && "Queued cancelled textures were decoded!");
+
+    // A cancelled texture can be queued again
+    order.clear();
+    assert(streamer.enqueue(textures[7]));
+    updateUntilComplete(streamer);
+    assert(order.size() == 1 && order[0] == 7 && "Cancelled texture could not be requeued!");
+
+    // Cancelling everything drops queued and decoded textures alike
+    gate = false;
+    order.clear();
+    for (int i = 0; i < 4; i++)
+        streamer.enqueue(textures[i]);
+    gate = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    streamer.cancel();
+    assert(streamer.isComplete() && streamer.getPendingCount() == 0 && streamer.getStats().queued == 0);
+    assert(streamer.update() == 0 && order.empty() && "Uploads ran after cancel()!");
+    assert(streamer.enqueue(textures[2]) && "Texture could not be queued after cancel()!");
+    updateUntilComplete(streamer);
+    assert(order.size() == 1 && order[0] == 2);
+
+    std::cout << "Texture Streamer Cancel Test Passed!" << std::endl;
+}
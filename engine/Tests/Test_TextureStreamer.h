@@ -0,0 +1,4 @@
+#pragma once
+
+void testTextureStreamerOrdering();
+void testTextureStreamerCancel();
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "../Engine.h"
+
+#include <chrono>
+#include <glm/gtc/packing.hpp>
+#include <random>
+
+namespace {
+    ///> Every decoding path, scalar first
+    constexpr Eng::VertexDecoder::Path PATHS[] = { Eng::VertexDecoder::Path::SCALAR, Eng::VertexDecoder::Path::SSE2, Eng::VertexDecoder::Path::AVX2 };
+
+    /**
+     * @brief Compares floats bit by bit, so signed zeros and NaN payloads count.
+     */
+    bool sameBits(const float first, const float second) {
+        return std::memcmp(&first, &second, sizeof(float)) == 0;
+    }
+}
+
+/**
+ * @brief Tests that every decoding path is bit-exact with the glm helpers.
+ *
+ * Every 10-bit normal component and every half float is decoded, in each SIMD
+ * lane and in the scalar tails.
+ */
+void Eng::testVertexDecoding() {
+    // Each 10-bit value in every field, with shifted neighbours and random W bits
+    std::vector<unsigned int> normals;
+    std::mt19937 random(7);
+    for (unsigned int value = 0; value < 1024; value++)
+        for (unsigned int shift = 0; shift < 3; shift++)
+            normals.push_back(value | (((value + 341 * shift) & 1023) << 10) | (((value * 7 + shift) & 1023) << 20) | (random() << 30));
+    normals.push_back(0x3ff); // Odd count, so the tails are covered too
+
+    // Each half float as U and as V: signed zeros, subnormals, infinities and NaNs included
+    std::vector<unsigned int> texCoords;
+    for (unsigned int half = 0; half < 65536; half++)
+        texCoords.push_back(half | ((half ^ 0x8001u) << 16));
+    texCoords.push_back(0x7c01fc00u);
+
+    std::vector<float> x(normals.size()), y(normals.size()), z(normals.size());
+    std::vector<float> u(texCoords.size()), v(texCoords.size());
+    for (const auto path : PATHS) {
+        if (!Eng::VertexDecoder::isSupported(path)) {
+            std::cout << "   " << Eng::VertexDecoder::getPathName(path) << " not supported, skipped" << std::endl;
+            continue;
+        }
+
+        Eng::VertexDecoder::decodeNormals(normals.data(), normals.size(), x.data(), y.data(), z.data(), path);
+        for (size_t i = 0; i < normals.size(); i++) {
+            const glm::vec4 expected = glm::unpackSnorm3x10_1x2(normals[i]);
+            assert(sameBits(x[i], expected.x) && sameBits(y[i], expected.y) && sameBits(z[i], expected.z) && "Normal differs from glm!");
+        }
+
+        Eng::VertexDecoder::decodeTexCoords(texCoords.data(), texCoords.size(), u.data(), v.data(), path);
+        for (size_t i = 0; i < texCoords.size(); i++) {
+            const glm::vec2 expected = glm::unpackHalf2x16(texCoords[i]);
+            assert(sameBits(u[i], expected.x) && sameBits(v[i], expected.y) && "Texture coordinates differ from glm!");
+        }
+    }
+
+    // Range limits of the formats
+    float limit[3];
+    Eng::VertexDecoder::decodeNormals(&normals[512 * 3], 1, &limit[0], &limit[1], &limit[2]);
+    assert(limit[0] == -1.0f && "Most negative component was not clamped!");
+    assert(Eng::VertexDecoder::isSupported(Eng::VertexDecoder::getBestPath()));
+
+    std::cout << "Vertex Decoding Test Passed!" << std::endl;
+}
+
+/**
+ * @brief Microbenchmark of vertex attribute decoding on each path.
+ *
+ * Decodes a mesh-sized batch of random normals and texture coordinates and
+ * prints the average time per vertex, the scalar path being the former per-vertex decoding.
+ */
+void Eng::testVertexDecodingBenchmark() {
+    constexpr size_t VERTICES = 65536;
+    std::vector<unsigned int> normals(VERTICES), texCoords(VERTICES);
+    std::mt19937 random(11);
+    for (size_t i = 0; i < VERTICES; i++) {
+        const glm::vec3 direction = glm::normalize(glm::vec3(random() % 200 - 100.0f, random() % 200 - 100.0f, random() % 200 - 99.5f));
+        normals[i] = glm::packSnorm3x10_1x2(glm::vec4(direction, 0.0f));
+        texCoords[i] = glm::packHalf2x16(glm::vec2((random() % 1000) / 999.0f, (random() % 1000) / 999.0f));
+    }
+
+    std::vector<float> decoded(VERTICES * 5);
+    float* x = decoded.data(), * y = x + VERTICES, * z = y + VERTICES, * u = z + VERTICES, * v = u + VERTICES;
+    const int iterations = 50;
+    using Clock = std::chrono::steady_clock;
+
+    float checksum = 0.0f;
+    for (const auto path : PATHS) {
+        if (!Eng::VertexDecoder::isSupported(path))
+            continue;
+        const auto start = Clock::now();
+        for (int i = 0; i < iterations; i++) {
+            Eng::VertexDecoder::decodeNormals(normals.data(), VERTICES, x, y, z, path);
+            Eng::VertexDecoder::decodeTexCoords(texCoords.data(), VERTICES, u, v, path);
+            checksum += x[i] + v[i];
+        }
+        const double elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        std::cout << "   decode (" << Eng::VertexDecoder::getPathName(path) << ") : "
+                  << elapsed / (static_cast<double>(iterations) * VERTICES) << " ns/vertex" << std::endl;
+    }
+    assert(checksum == checksum && "Decoded values are not numbers!");
+
+    std::cout << "Vertex Decoding Benchmark Passed!" << std::endl;
+}
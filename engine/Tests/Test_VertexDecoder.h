@@ -0,0 +1,4 @@
+#pragma once
+
+void testVertexDecoding();
+void testVertexDecodingBenchmark();
\ No newline at end of file
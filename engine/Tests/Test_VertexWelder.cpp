@@ -0,0 +1,90 @@
+#include "../Engine.h"
+
+#include <algorithm>
+
+namespace {
+    ///> Quads per side of the test grid
+    constexpr unsigned int GRID_SIZE = 16;
+
+    /**
+     * @brief Builds a flat grid where every triangle has its own three vertices, offset by jitter.
+     */
+    void buildSplitGrid(std::vector<Eng::Vertex>& vertices, std::vector<unsigned int>& indices, const float jitter) {
+        auto corner = [jitter, &vertices](const unsigned int x, const unsigned int y) {
+            const glm::vec2 uv(static_cast<float>(x) / GRID_SIZE, static_cast<float>(y) / GRID_SIZE);
+            const float offset = (vertices.size() % 2) ? jitter : -jitter;
+            vertices.emplace_back(glm::vec3(uv + glm::vec2(offset), 0.0f), glm::vec3(0.0f, 0.0f, 1.0f), uv);
+        };
+        for (unsigned int y = 0; y < GRID_SIZE; y++) {
+            for (unsigned int x = 0; x < GRID_SIZE; x++) {
+                const unsigned int first = static_cast<unsigned int>(vertices.size());
+                corner(x, y);
+                corner(x + 1, y);
+                corner(x + 1, y + 1);
+                corner(x, y);
+                corner(x + 1, y + 1);
+                corner(x, y + 1);
+                for (unsigned int k = 0; k < 6; k++)
+                    indices.push_back(first + k);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests exact and tolerant welding, dropped triangles and rejected input.
+ */
+void Eng::testVertexWelding() {
+    constexpr unsigned int GRID_VERTICES = (GRID_SIZE + 1) * (GRID_SIZE + 1);
+    constexpr unsigned int GRID_TRIANGLES = GRID_SIZE * GRID_SIZE * 2;
+
+    // Bit-identical copies are merged, triangles keep their order and corners
+    std::vector<Eng::Vertex> vertices;
+    std::vector<unsigned int> indices;
+    buildSplitGrid(vertices, indices, 0.0f);
+    const auto split = vertices;
+    const auto splitIndices = indices;
+    auto stats = Eng::VertexWelder::weld(vertices, indices);
+    assert(stats.verticesBefore == GRID_TRIANGLES * 3 && stats.verticesAfter == GRID_VERTICES && "Copies were not welded!");
+    assert(vertices.size() == GRID_VERTICES && stats.trianglesAfter == GRID_TRIANGLES && indices.size() == splitIndices.size());
+    for (size_t i = 0; i < indices.size(); i++)
+        assert(vertices[indices[i]].getPosition() == split[splitIndices[i]].getPosition() && "Triangle corner moved!");
+    assert(indices[0] == 0 && indices[1] == 1 && indices[2] == 2 && indices[3] == 0 && "Vertices are not in first-use order!");
+
+    // Nearly equal copies need a tolerance
+    vertices.clear();
+    indices.clear();
+    buildSplitGrid(vertices, indices, 1e-4f);
+    std::vector<Eng::Vertex> jittered = vertices;
+    std::vector<unsigned int> jitteredIndices = indices;
+    stats = Eng::VertexWelder::weld(jittered, jitteredIndices);
+    assert(stats.verticesAfter > GRID_VERTICES && "Distinct vertices were welded without a tolerance!");
+    stats = Eng::VertexWelder::weld(vertices, indices, 1e-3f);
+    assert(stats.verticesAfter == GRID_VERTICES && stats.trianglesAfter == GRID_TRIANGLES && "Close vertices were not welded!");
+
+    // A tolerance as large as a quad collapses triangles, which are dropped with their unused vertices
+    vertices.clear();
+    indices.clear();
+    buildSplitGrid(vertices, indices, 0.0f);
+    stats = Eng::VertexWelder::weld(vertices, indices, 1.5f / GRID_SIZE);
+    assert(stats.trianglesAfter < GRID_TRIANGLES && indices.size() == stats.trianglesAfter * 3 && "Collapsed triangles were kept!");
+    for (size_t i = 0; i < indices.size(); i += 3)
+        assert(indices[i] != indices[i + 1] && indices[i + 1] != indices[i + 2] && indices[i] != indices[i + 2]);
+    std::vector<bool> used(vertices.size(), false);
+    for (const unsigned int index : indices)
+        used[index] = true;
+    assert(std::find(used.begin(), used.end(), false) == used.end() && "Unused vertex was kept!");
+
+    // Out of range indices leave the buffers untouched
+    vertices = split;
+    indices = { 0, 1, static_cast<unsigned int>(split.size()) };
+    stats = Eng::VertexWelder::weld(vertices, indices);
+    assert(vertices.size() == split.size() && indices.size() == 3 && stats.verticesAfter == stats.verticesBefore);
+
+    Eng::VertexWelder::Stats total;
+    total += stats;
+    total += stats;
+    assert(total.verticesBefore == 2 * split.size() && total.trianglesAfter == 2);
+
+    std::cout << "Vertex Welding Test Passed!" << std::endl;
+}
@@ -0,0 +1,3 @@
+#pragma once
+
+void testVertexWelding();
\ No newline at end of file
@@ -3,13 +3,240 @@
 #include <GL/freeglut.h>
 #include <FreeImage.h>
 
+#include <algorithm>
+
+namespace {
+   /**
+    * @brief Gets the 1x1 white texture bound in place of textures not loaded yet.
+    *
+    * Created on first use, on the render thread; white leaves the material color as it is.
+    */
+   unsigned int placeholderTexture() {
+      static unsigned int placeholder = 0;
+      if (!placeholder) {
+         const unsigned char white[4] = { 255, 255, 255, 255 };
+         glGenTextures(1, &placeholder);
+         glBindTexture(GL_TEXTURE_2D, placeholder);
+         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE, white);
+         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      }
+      return placeholder;
+   }
+
+   ///> Bytes of the "DDS " magic and the header following it
+   constexpr size_t DDS_HEADER_SIZE = 128;
+   ///> Bytes of the extended header following a "DX10" FourCC
+   constexpr size_t DDS_DX10_HEADER_SIZE = 20;
+   ///> Header flag: the mip map count is valid
+   constexpr uint32_t DDSD_MIPMAPCOUNT = 0x20000;
+   ///> Pixel format flag: the FourCC is valid
+   constexpr uint32_t DDPF_FOURCC = 0x4;
+   ///> Caps2 flags of cubemaps and volume textures
+   constexpr uint32_t DDSCAPS2_CUBEMAP_OR_VOLUME = 0x200 | 0x200000;
+
+   /**
+    * @brief Bytes of one mip level of a texture in the given internal format.
+    */
+   size_t levelBytes(const unsigned int internalFormat, const int width, const int height) {
+      switch (internalFormat) {
+         case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+         case GL_COMPRESSED_RED_RGTC1:
+            return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 8;
+         case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+         case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+         case GL_COMPRESSED_RG_RGTC2:
+            return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * 16;
+         default:
+            return static_cast<size_t>(width) * height * 4;
+      }
+   }
+
+   /**
+    * @brief Block layouts of the supported compressed formats.
+    */
+   enum class BlockLayout { BC1, BC2, BC3, BC4, BC5 };
+
+   /**
+    * @brief Reads a little-endian 32-bit value.
+    */
+   uint32_t readU32(const char *data) {
+      uint32_t value;
+      std::memcpy(&value, data, sizeof(value));
+      return value;
+   }
+
+   /**
+    * @brief Builds a FourCC code from its four characters.
+    */
+   constexpr uint32_t fourCC(const char (&code)[5]) {
+      return static_cast<uint32_t>(code[0]) | static_cast<uint32_t>(code[1]) << 8 |
+             static_cast<uint32_t>(code[2]) << 16 | static_cast<uint32_t>(code[3]) << 24;
+   }
+
+   /**
+    * @brief Maps a DDS FourCC, or a DX10 DXGI format, to a block layout.
+    * @return True if the format is one of BC1-BC5.
+    */
+   bool findLayout(const uint32_t code, const uint32_t dxgiFormat, BlockLayout &layout) {
+      if (code == fourCC("DX10")) {
+         switch (dxgiFormat) {
+            case 71: case 72: layout = BlockLayout::BC1; return true; // BC1_UNORM(_SRGB)
+            case 74: case 75: layout = BlockLayout::BC2; return true; // BC2_UNORM(_SRGB)
+            case 77: case 78: layout = BlockLayout::BC3; return true; // BC3_UNORM(_SRGB)
+            case 80: layout = BlockLayout::BC4; return true;          // BC4_UNORM
+            case 83: layout = BlockLayout::BC5; return true;          // BC5_UNORM
+            default: return false;
+         }
+      }
+      if (code == fourCC("DXT1")) layout = BlockLayout::BC1;
+      else if (code == fourCC("DXT3")) layout = BlockLayout::BC2;
+      else if (code == fourCC("DXT5")) layout = BlockLayout::BC3;
+      else if (code == fourCC("ATI1") || code == fourCC("BC4U")) layout = BlockLayout::BC4;
+      else if (code == fourCC("ATI2") || code == fourCC("BC5U")) layout = BlockLayout::BC5;
+      else return false;
+      return true;
+   }
+
+   /**
+    * @brief Reverses the first rows of a BC1 color block (one byte of indices per row).
+    */
+   void flipColorBlock(unsigned char *block, const int rows) {
+      std::reverse(block + 4, block + 4 + rows);
+   }
+
+   /**
+    * @brief Reverses the first rows of a BC2 alpha block (16 bits of alpha per row).
+    */
+   void flipExplicitAlphaBlock(unsigned char *block, const int rows) {
+      for (int r = 0; r < rows / 2; r++) {
+         std::swap(block[2 * r], block[2 * (rows - 1 - r)]);
+         std::swap(block[2 * r + 1], block[2 * (rows - 1 - r) + 1]);
+      }
+   }
+
+   /**
+    * @brief Reverses the first rows of a BC3 alpha or BC4 block (12 bits of indices per row).
+    */
+   void flipInterpolatedBlock(unsigned char *block, const int rows) {
+      uint64_t bits = 0;
+      for (int i = 0; i < 6; i++)
+         bits |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+      uint64_t flipped = bits;
+      for (int r = 0; r < rows; r++) {
+         const uint64_t row = (bits >> (12 * r)) & 0xFFF;
+         flipped &= ~(0xFFFull << (12 * (rows - 1 - r)));
+         flipped |= row << (12 * (rows - 1 - r));
+      }
+      for (int i = 0; i < 6; i++)
+         block[2 + i] = static_cast<unsigned char>(flipped >> (8 * i));
+   }
+
+   /**
+    * @brief Reverses the first rows of one block of the given layout.
+    */
+   void flipBlock(unsigned char *block, const BlockLayout layout, const int rows) {
+      switch (layout) {
+         case BlockLayout::BC1: flipColorBlock(block, rows); break;
+         case BlockLayout::BC2: flipExplicitAlphaBlock(block, rows); flipColorBlock(block + 8, rows); break;
+         case BlockLayout::BC3: flipInterpolatedBlock(block, rows); flipColorBlock(block + 8, rows); break;
+         case BlockLayout::BC4: flipInterpolatedBlock(block, rows); break;
+         case BlockLayout::BC5: flipInterpolatedBlock(block, rows); flipInterpolatedBlock(block + 8, rows); break;
+      }
+   }
+
+   /**
+    * @brief Computes the luminance-weighted average color of an LDR image buffer.
+    *
+    * Weights each pixel by luminance to better represent perceived brightness.
+    *
+    * @param bits     Raw pixel data (BGR[A]).
+    * @param width    Image width in pixels.
+    * @param height   Image height in pixels.
+    * @param channels Number of channels (3 or 4).
+    * @return Weighted average RGB color (0-1 range).
+    */
+   glm::vec3 weightedAverageColor(const unsigned char *bits, const int width, const int height, const int channels) {
+      float totalLuminance = 0.0f;
+      glm::vec3 weightedColor(0.0f);
+
+      for (int y = 0; y < height; ++y) {
+         for (int x = 0; x < width; ++x) {
+            const int pixelIndex = (y * width + x) * channels;
+
+            // Read colors (ignoring alpha if present)
+            const float r = bits[pixelIndex + 2] / 255.0f; // Red (index +2 in BGR(A))
+            const float g = bits[pixelIndex + 1] / 255.0f; // Green
+            const float b = bits[pixelIndex + 0] / 255.0f; // Blue
+
+            const float luminance = 0.2126f * r + 0.7152f * g + 0.0722f * b;
+            weightedColor += glm::vec3(r, g, b) * luminance;
+            totalLuminance += luminance;
+         }
+      }
+
+      if (totalLuminance > 0.0f) {
+         weightedColor /= totalLuminance;
+      }
+      return weightedColor;
+   }
+
+   /**
+    * @brief Computes the luminance-weighted average color of an HDR image buffer.
+    *
+    * Performs tone-mapping on high dynamic range values before weighting.
+    *
+    * @param floatBits Raw float pixel data (RGB[A]).
+    * @param width     Image width.
+    * @param height    Image height.
+    * @param channels  Number of channels (3 or 4).
+    * @return Weighted average color after tone mapping.
+    */
+   glm::vec3 weightedAverageColorHDR(const float *floatBits, const int width, const int height, const int channels) {
+      float totalLuminance = 0.0f;
+      glm::vec3 weightedColor(0.0f);
+
+      for (int y = 0; y < height; ++y) {
+         for (int x = 0; x < width; ++x) {
+            const int pixelIndex = (y * width + x) * channels;
+
+            // Read colors (ignoring alpha if present)
+            float r = floatBits[pixelIndex + 0]; // Red (index +0 in RGB(A) format for EXR)
+            float g = floatBits[pixelIndex + 1]; // Green
+            float b = floatBits[pixelIndex + 2]; // Blue
+
+            // Uses tone mapping to map color to 0-1 range
+            if (r > 1.0f || g > 1.0f || b > 1.0f) {
+               // log compression
+               r = 1.0f + log2(r) * 0.5f;
+               g = 1.0f + log2(g) * 0.5f;
+               b = 1.0f + log2(b) * 0.5f;
+            }
+
+            const float luminance = 0.2126f * r + 0.7152f * g + 0.0722f * b;
+            weightedColor += glm::vec3(r, g, b) * luminance;
+            totalLuminance += luminance;
+         }
+      }
+
+      if (totalLuminance > 0.0f) {
+         weightedColor /= totalLuminance;
+      }
+      return weightedColor;
+   }
+}
+
+uint64_t Eng::Texture::currentFrame = 0;
+
 /**
  * @brief Constructs a Texture object and optionally loads a texture from a file.
  * @param filePath Path to the texture file to load (optional).
+ * @param load Whether to load the file now; otherwise the path is only recorded and
+ *             the pixels are expected later through upload().
  */
-Eng::Texture::Texture(const std::string &filePath)
+Eng::Texture::Texture(const std::string &filePath, const bool load)
    : textureID(0), width(0), height(0), filePath(filePath) {
-   if (!filePath.empty()) {
+   if (load && !filePath.empty()) {
       loadFromFile(filePath);
    }
 }
@@ -29,6 +256,28 @@ Eng::Texture::~Texture() {
  * @return True if the texture was loaded successfully, false otherwise.
  */
 bool Eng::Texture::loadFromFile(const std::string &filePath) {
+   Image image;
+   return decodeFile(filePath, image) && upload(image);
+}
+
+/**
+ * @brief Reads an image file, keeping DDS compressed blocks or converting it to 32-bit BGRA pixels.
+ *
+ * Does not touch OpenGL, so it can run on a loading thread.
+ *
+ * @param filePath Path to the texture file.
+ * @param image Receives the pixels and size.
+ * @return True if the file was decoded successfully, false otherwise.
+ */
+bool Eng::Texture::decodeFile(const std::string &filePath, Image &image) {
+   // Block-compressed DDS files are used as they are
+   MappedFile file;
+   if (file.open(filePath) && file.getSize() >= 4 && std::memcmp(file.getData(), "DDS ", 4) == 0
+       && decodeDds(file.getData(), file.getSize(), image)) {
+      return true;
+   }
+   file.close();
+
    FIBITMAP *bitmap = FreeImage_Load(FreeImage_GetFileType(filePath.c_str(), 0), filePath.c_str());
    if (!bitmap) {
       std::cerr << "Failed to load texture: " << filePath << std::endl;
@@ -43,38 +292,363 @@ bool Eng::Texture::loadFromFile(const std::string &filePath) {
       return false;
    }
 
+   // 32-bit rows need no padding, so the bits are copied as a whole
+   image.width = static_cast<int>(FreeImage_GetWidth(bitmap32));
+   image.height = static_cast<int>(FreeImage_GetHeight(bitmap32));
+   const unsigned char *bits = FreeImage_GetBits(bitmap32);
+   image.pixels.assign(bits, bits + static_cast<size_t>(image.width) * image.height * 4);
+
+   image.compressedFormat = 0;
+   image.levels.clear();
+
+   FreeImage_Unload(bitmap32);
+   return true;
+}
+
+/**
+ * @brief Reads the BC1-BC5 blocks of a DDS file, with its stored mip chain.
+ *
+ * Blocks are reordered, and the rows inside each block reversed, so that the
+ * image is bottom row first like the ones decoded by FreeImage. Other DDS
+ * formats, cubemaps, volumes and arrays are left to FreeImage, as are images
+ * with a mip level that cannot be flipped block-wise (height above 4 and not a
+ * multiple of 4). Does not touch OpenGL.
+ *
+ * @param data Content of the file, starting with the "DDS " magic.
+ * @param size Bytes of content.
+ * @param image Receives the blocks, the mip level offsets and the OpenGL format.
+ * @return True if the content was decoded, false if it is not a supported DDS file.
+ */
+bool Eng::Texture::decodeDds(const char *data, const size_t size, Image &image) {
+   if (size < DDS_HEADER_SIZE || std::memcmp(data, "DDS ", 4) != 0 || readU32(data + 4) != 124) {
+      return false;
+   }
+   const uint32_t flags = readU32(data + 8);
+   const uint32_t height = readU32(data + 12);
+   const uint32_t width = readU32(data + 16);
+   const uint32_t storedLevels = (flags & DDSD_MIPMAPCOUNT) ? std::max(readU32(data + 28), 1u) : 1u;
+   const uint32_t formatFlags = readU32(data + 80);
+   const uint32_t code = readU32(data + 84);
+   const uint32_t caps2 = readU32(data + 112);
+   if (!(formatFlags & DDPF_FOURCC) || (caps2 & DDSCAPS2_CUBEMAP_OR_VOLUME) || width == 0 || height == 0
+       || width > 16384 || height > 16384) {
+      return false;
+   }
+
+   size_t offset = DDS_HEADER_SIZE;
+   uint32_t dxgiFormat = 0;
+   if (code == fourCC("DX10")) {
+      if (size < DDS_HEADER_SIZE + DDS_DX10_HEADER_SIZE)
+         return false;
+      dxgiFormat = readU32(data + offset);
+      // 2D texture (resource dimension 3) without array layers
+      if (readU32(data + offset + 4) != 3 || readU32(data + offset + 12) > 1)
+         return false;
+      offset += DDS_DX10_HEADER_SIZE;
+   }
+   BlockLayout layout;
+   if (!findLayout(code, dxgiFormat, layout)) {
+      return false;
+   }
+   const size_t blockSize = (layout == BlockLayout::BC1 || layout == BlockLayout::BC4) ? 8 : 16;
+
+   // Extra levels past 1x1 are ignored
+   uint32_t levelCount = 0;
+   while (levelCount < storedLevels && ((width >> levelCount) || (height >> levelCount)))
+      levelCount++;
+
+   std::vector<unsigned char> blocks;
+   std::vector<size_t> levels;
+   for (uint32_t level = 0; level < levelCount; level++) {
+      const uint32_t levelWidth = std::max(width >> level, 1u);
+      const uint32_t levelHeight = std::max(height >> level, 1u);
+      if (levelHeight > 4 && levelHeight % 4 != 0)
+         return false;
+      const size_t blocksWide = (levelWidth + 3) / 4;
+      const size_t blocksHigh = (levelHeight + 3) / 4;
+      const size_t rowBytes = blocksWide * blockSize;
+      if (size - offset < rowBytes * blocksHigh) {
+         std::cerr << "WARNING: [Texture] Truncated DDS mip level " << level << ", loading it uncompressed" << std::endl;
+         return false;
+      }
+
+      // Bottom block row first, each block flipped vertically
+      levels.push_back(blocks.size());
+      const int rows = static_cast<int>(std::min(levelHeight, 4u));
+      for (size_t row = blocksHigh; row-- > 0;) {
+         const size_t start = blocks.size();
+         const unsigned char *source = reinterpret_cast<const unsigned char *>(data + offset + row * rowBytes);
+         blocks.insert(blocks.end(), source, source + rowBytes);
+         for (size_t b = 0; b < blocksWide; b++)
+            flipBlock(blocks.data() + start + b * blockSize, layout, rows);
+      }
+      offset += rowBytes * blocksHigh;
+   }
+
+   static constexpr unsigned int FORMATS[] = {
+      GL_COMPRESSED_RGBA_S3TC_DXT1_EXT, GL_COMPRESSED_RGBA_S3TC_DXT3_EXT, GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+      GL_COMPRESSED_RED_RGTC1, GL_COMPRESSED_RG_RGTC2
+   };
+   image.pixels.swap(blocks);
+   image.levels.swap(levels);
+   image.width = static_cast<int>(width);
+   image.height = static_cast<int>(height);
+   image.compressedFormat = FORMATS[static_cast<int>(layout)];
+   return true;
+}
+
+/**
+ * @brief Creates the OpenGL texture, with its mipmaps, from decoded pixels.
+ *
+ * Compressed images bring their own mip chain; for BGRA pixels only level 0 is
+ * uploaded and the other levels are generated by the GPU.
+ *
+ * @param image Pixels returned by decodeFile().
+ * @param fromPixelBuffer Whether a copy of image.pixels is in the bound GL_PIXEL_UNPACK_BUFFER,
+ *                        to be read from there instead of from the image.
+ * @return True if the texture was uploaded, false for an empty image.
+ */
+bool Eng::Texture::upload(const Image &image, const bool fromPixelBuffer) {
+   if (image.pixels.empty()) {
+      return false;
+   }
+   // Offsets into the pixel buffer, or addresses in the image
+   auto source = [&image, fromPixelBuffer](const size_t offset) -> const void * {
+      return fromPixelBuffer ? reinterpret_cast<const void *>(offset) : image.pixels.data() + offset;
+   };
 
    // Usa sempre RGBA come formato
    if (textureID) {
       glDeleteTextures(1, &textureID);
    }
 
-   width = FreeImage_GetWidth(bitmap32);
-   height = FreeImage_GetHeight(bitmap32);
+   width = image.width;
+   height = image.height;
+   cubemap = false;
+   averageColor = glm::vec3(0.0f);
+   droppedLevels = 0;
+   evicted = false;
+   revision++;
+   // Just loaded counts as used, or it would look idle until first rendered
+   lastUsedFrame = currentFrame;
 
    glGenTextures(1, &textureID);
    glBindTexture(GL_TEXTURE_2D, textureID);
 
+   // Compressed blocks go up as they are, with the mip levels stored in the file
+   if (image.compressedFormat) {
+      const size_t levelCount = image.levels.size();
+      for (size_t level = 0; level < levelCount; level++) {
+         const size_t end = level + 1 < levelCount ? image.levels[level + 1] : image.pixels.size();
+         glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.compressedFormat,
+                                std::max(width >> level, 1), std::max(height >> level, 1), 0,
+                                static_cast<GLsizei>(end - image.levels[level]), source(image.levels[level]));
+      }
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levelCount) - 1);
+      // Single channel textures are grey, not red
+      if (image.compressedFormat == GL_COMPRESSED_RED_RGTC1) {
+         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+      }
+      compressed = true;
+      internalFormat = image.compressedFormat;
+      this->levelCount = static_cast<unsigned int>(levelCount);
+      memoryUsage = image.pixels.size();
+      configureTextureParameters();
+      return true;
+   }
+
+   compressed = false;
+   internalFormat = GL_RGBA8;
+   levelCount = 1;
+   while ((width >> levelCount) || (height >> levelCount))
+      levelCount++;
+   memoryUsage = estimateMemoryUsage(0);
+
    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
                 width,
                 height,
                 0, GL_BGRA_EXT, GL_UNSIGNED_BYTE,
-                FreeImage_GetBits(bitmap32));
+                source(0));
+
+   // Mipmaps are filtered on the GPU from level 0, without resampling or uploading them on the CPU
+   glGenerateMipmap(GL_TEXTURE_2D);
+
+   configureTextureParameters();
+   return true;
+}
+
+/**
+ * @brief Loads six images into an OpenGL cubemap and computes their average color.
+ *
+ * 32-bit images are stored as RGBA, 96 and 128-bit floating point (HDR) images as
+ * RGB16F, anything else as RGB. The luminance-weighted average color of all faces
+ * is available afterwards through getAverageColor().
+ *
+ * @param faces Six image file paths, ordered as +X, -X, +Y, -Y, +Z, -Z.
+ * @return True if all the faces were loaded, false otherwise.
+ */
+bool Eng::Texture::loadCubemap(const std::vector<std::string> &faces) {
+   if (faces.size() != 6) {
+      std::cerr << "[Texture] A cubemap needs 6 faces, " << faces.size() << " given" << std::endl;
+      return false;
+   }
+   if (textureID) {
+      glDeleteTextures(1, &textureID);
+      textureID = 0;
+   }
+
+   unsigned int id = 0;
+   glGenTextures(1, &id);
+   glBindTexture(GL_TEXTURE_CUBE_MAP, id);
+
+   // Set wrapping and filtering parameters.
+   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+   glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+   glm::vec3 faceAverageColorSum(0.0f);
+   size_t bytes = 0;
 
-   // Genera mipmaps
-   gluBuild2DMipmaps(GL_TEXTURE_2D, GL_RGBA8,
-                     width,
-                     height,
-                     GL_BGRA_EXT, GL_UNSIGNED_BYTE,
-                     FreeImage_GetBits(bitmap32));
+   // Load each of the six faces.
+   for (unsigned int i = 0; i < faces.size(); i++) {
+      const char *file = faces[i].c_str();
+      FREE_IMAGE_FORMAT fif = FreeImage_GetFileType(file, 0);
+      if (fif == FIF_UNKNOWN) {
+         fif = FreeImage_GetFIFFromFilename(file);
+      }
+      FIBITMAP *dib = fif == FIF_UNKNOWN ? nullptr : FreeImage_Load(fif, file);
+      if (!dib) {
+         std::cerr << "[Texture] Failed to load cubemap face " << file << std::endl;
+         glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+         glDeleteTextures(1, &id);
+         return false;
+      }
+      BYTE *bits = FreeImage_GetBits(dib);
+      const int faceWidth = static_cast<int>(FreeImage_GetWidth(dib));
+      const int faceHeight = static_cast<int>(FreeImage_GetHeight(dib));
 
+      // FreeImage stores pixel data in BGR(A) format, but we want OpenGL to store it internally as RGB(A).
+      GLenum internalFormat = GL_RGB;
+      GLenum format = GL_BGR;
+      GLenum type = GL_UNSIGNED_BYTE;
+      int channels = 3;
+      size_t texelSize = 3;
+      if (FreeImage_GetBPP(dib) == 32) {
+         internalFormat = GL_RGBA;
+         format = GL_BGRA;
+         channels = 4;
+         texelSize = 4;
+      } else if (FreeImage_GetBPP(dib) == 128 || FreeImage_GetBPP(dib) == 96) { // 32 bit per channel (floating point HDR)
+         internalFormat = GL_RGB16F;
+         format = GL_RGB;
+         type = GL_FLOAT;
+         texelSize = 6;
+      }
 
+      FreeImage_FlipVertical(dib);
+      glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, internalFormat, faceWidth, faceHeight, 0, format, type, bits);
+
+      if (type == GL_FLOAT) {
+         faceAverageColorSum += weightedAverageColorHDR(reinterpret_cast<const float *>(bits), faceWidth, faceHeight, channels);
+      } else {
+         faceAverageColorSum += weightedAverageColor(bits, faceWidth, faceHeight, channels);
+      }
+      bytes += static_cast<size_t>(faceWidth) * faceHeight * texelSize;
+      width = faceWidth;
+      height = faceHeight;
+
+      FreeImage_Unload(dib);
+   }
+   glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+   textureID = id;
+   cubemap = true;
+   levelCount = 1;
+   droppedLevels = 0;
+   evicted = false;
+   revision++;
+   memoryUsage = bytes;
+   averageColor = faceAverageColorSum / static_cast<float>(faces.size());
+   return true;
+}
+
+/**
+ * @brief Frees the top mip levels of a 2D texture, keeping the smaller ones.
+ *
+ * The remaining levels are copied on the GPU into a texture with storage for
+ * them only, which replaces the current one. The texture stays usable at a
+ * lower resolution; upload() brings it back to full resolution.
+ *
+ * @param count Levels to drop, at least one level is always kept.
+ * @return True if the levels were dropped, false if the texture is not loaded, is a cubemap or has too few levels.
+ */
+bool Eng::Texture::dropLevels(const unsigned int count) {
+   if (!textureID || cubemap || count == 0 || droppedLevels + count >= levelCount) {
+      return false;
+   }
+   const unsigned int first = droppedLevels + count;
+   const GLsizei levels = static_cast<GLsizei>(levelCount - first);
+
+   unsigned int trimmed = 0;
+   glGenTextures(1, &trimmed);
+   glBindTexture(GL_TEXTURE_2D, trimmed);
+   glTexStorage2D(GL_TEXTURE_2D, levels, internalFormat, std::max(width >> first, 1), std::max(height >> first, 1));
+   for (GLsizei level = 0; level < levels; level++) {
+      const unsigned int full = first + static_cast<unsigned int>(level);
+      glCopyImageSubData(textureID, GL_TEXTURE_2D, static_cast<GLint>(full - droppedLevels), 0, 0, 0,
+                         trimmed, GL_TEXTURE_2D, level, 0, 0, 0,
+                         std::max(width >> full, 1), std::max(height >> full, 1), 1);
+   }
+   if (internalFormat == GL_COMPRESSED_RED_RGTC1) {
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_RED);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_RED);
+   }
    configureTextureParameters();
 
-   FreeImage_Unload(bitmap32);
+   glDeleteTextures(1, &textureID);
+   textureID = trimmed;
+   droppedLevels = first;
+   revision++;
+   memoryUsage = estimateMemoryUsage(droppedLevels);
    return true;
 }
 
+/**
+ * @brief Frees a 2D texture, which renders as the placeholder until uploaded again.
+ *
+ * The file path and size are kept, so the texture can be loaded back from its file.
+ *
+ * @return True if the texture was evicted, false if it is not loaded or is a cubemap.
+ */
+bool Eng::Texture::evict() {
+   if (!textureID || cubemap) {
+      return false;
+   }
+   glDeleteTextures(1, &textureID);
+   textureID = 0;
+   droppedLevels = 0;
+   memoryUsage = 0;
+   evicted = true;
+   revision++;
+   return true;
+}
+
+/**
+ * @brief Estimates the VRAM a 2D texture holds with some of its top mip levels dropped.
+ * @param dropped Top levels dropped, 0 for the full resolution texture.
+ * @return size_t Bytes of the remaining levels, 0 if none remain.
+ */
+size_t Eng::Texture::estimateMemoryUsage(const unsigned int dropped) const {
+   size_t bytes = 0;
+   for (unsigned int level = dropped; level < levelCount; level++) {
+      bytes += levelBytes(internalFormat, std::max(width >> level, 1), std::max(height >> level, 1));
+   }
+   return bytes;
+}
+
 /**
  * @brief Configures default OpenGL texture parameters.
  */
@@ -87,11 +661,18 @@ void Eng::Texture::configureTextureParameters() {
 
 /**
  * @brief Renders the texture, applying it to the OpenGL context.
- * @param index Optional index parameter (default is -1).
+ *
+ * A 2D texture not loaded yet (e.g. still streaming or evicted) binds a 1x1 white placeholder.
+ * The current frame is recorded as the last one the texture was used in.
  */
 void Eng::Texture::render() {
+   lastUsedFrame = currentFrame;
    // Activate the correct texture unit based on the shader manager parameters
    glActiveTexture(GL_TEXTURE0 + ShaderManager::DIFFUSE_TEXTURE_UNIT);
    // Bind the texture to the current OpenGL context in the given unit.
-   glBindTexture(GL_TEXTURE_2D, textureID);
+   if (!textureID && !cubemap) {
+      glBindTexture(GL_TEXTURE_2D, placeholderTexture());
+      return;
+   }
+   glBindTexture(cubemap ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D, textureID);
 }
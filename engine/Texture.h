@@ -6,17 +6,68 @@
  *
  * The `Texture` class provides functionality for loading a texture from a file, binding it to a specific texture
  * unit, and managing its OpenGL texture ID.
+ *
+ * Loading is split in two so that it can be streamed: decodeFile() reads and converts the image on any
+ * thread, and upload() creates the OpenGL texture on the render thread.
+ *
+ * DDS files holding BC1-BC5 blocks are read natively and uploaded as they are, stored mip chain
+ * included, at a fraction of the memory of RGBA8; other formats go through FreeImage.
+ *
+ * Until it is loaded, a 2D texture renders as a 1x1 white placeholder.
+ *
+ * To stay within a VRAM budget, the TextureResidency can drop the top mip levels of a 2D texture
+ * with dropLevels() or free it with evict(); render() records the frame each texture was last used
+ * in, so idle textures go first and used ones are loaded back from their file.
+ *
+ * A texture can also hold a cubemap built from six face images with loadCubemap(). Textures are
+ * usually obtained through the TextureManager, which shares one instance per file.
  */
 class ENG_API Texture : public Eng::Object {
 public:
-   explicit Texture(const std::string &filePath = "");
+   /**
+    * @brief Image decoded by decodeFile(), ready for upload().
+    */
+   struct Image {
+      std::vector<unsigned char> pixels; ///< 32-bit BGRA pixels, or compressed blocks of every mip level; bottom row first
+      int width = 0; ///< Width in pixels
+      int height = 0; ///< Height in pixels
+      unsigned int compressedFormat = 0; ///< OpenGL compressed internal format of the blocks, 0 for BGRA pixels
+      std::vector<size_t> levels; ///< Offset of each stored mip level in pixels, compressed images only
+   };
+
+   explicit Texture(const std::string &filePath = "", bool load = true);
    ~Texture();
 
    bool loadFromFile(const std::string &filePath);
+   static bool decodeFile(const std::string &filePath, Image &image);
+   static bool decodeDds(const char *data, size_t size, Image &image);
+   bool upload(const Image &image, bool fromPixelBuffer = false);
+   bool loadCubemap(const std::vector<std::string> &faces);
+   bool dropLevels(unsigned int count);
+   bool evict();
    void render() override;
 
+   bool isLoaded() const { return textureID != 0; }
+   bool isCubemap() const { return cubemap; }
+   bool isCompressed() const { return compressed; }
+   unsigned int getTextureID() const { return textureID; }
+   unsigned int getInternalFormat() const { return internalFormat; }
+   size_t getMemoryUsage() const { return memoryUsage; }
+   size_t estimateMemoryUsage(unsigned int dropped) const;
+   unsigned int getLevelCount() const { return levelCount; }
+   unsigned int getDroppedLevels() const { return droppedLevels; }
+   bool isEvicted() const { return evicted; }
+   uint64_t getLastUsedFrame() const { return lastUsedFrame; }
+   void touch() { lastUsedFrame = currentFrame; }
+   uint64_t getRevision() const { return revision; }
+   const glm::vec3 &getAverageColor() const { return averageColor; }
+
    int getWidth() const { return width; }
    int getHeight() const { return height; }
+   const std::string &getFilePath() const { return filePath; }
+
+   static void setCurrentFrame(uint64_t frame) { currentFrame = frame; }
+   static uint64_t getCurrentFrame() { return currentFrame; }
 
 private:
    ///> OpenGL texture ID.
@@ -27,6 +78,28 @@ private:
    int width;
    ///> Texture height.
    int height;
+   ///> Whether the texture is a cubemap rather than a 2D texture.
+   bool cubemap = false;
+   ///> Whether the texture holds block-compressed data.
+   bool compressed = false;
+   ///> Estimated VRAM held by the texture, mipmaps included.
+   size_t memoryUsage = 0;
+   ///> OpenGL internal format of the 2D texture.
+   unsigned int internalFormat = 0;
+   ///> Mip levels of the full resolution 2D texture.
+   unsigned int levelCount = 0;
+   ///> Top mip levels dropped since the texture was uploaded.
+   unsigned int droppedLevels = 0;
+   ///> Whether the texture was evicted and is to be loaded again from its file.
+   bool evicted = false;
+   ///> Frame the texture was last rendered in.
+   uint64_t lastUsedFrame = 0;
+   ///> Bumped whenever the OpenGL texture is replaced or freed, so copies of it can tell they are stale.
+   uint64_t revision = 0;
+   ///> Frame being rendered, stamped on the textures rendered.
+   static uint64_t currentFrame;
+   ///> Luminance-weighted average color of a cubemap, (0, 0, 0) for 2D textures.
+   glm::vec3 averageColor = glm::vec3(0.0f);
 
    void configureTextureParameters();
 };
@@ -0,0 +1,253 @@
+#include "Engine.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <tuple>
+
+namespace {
+	/**
+	 * @brief Copies layers of every mip level from one texture to another.
+	 */
+	void copyLayers(const unsigned int source, const GLenum sourceTarget, const int sourceLayer, const unsigned int destination,
+		const int destinationLayer, const int layers, const int width, const int height, const unsigned int levels) {
+		for (unsigned int level = 0; level < levels; level++) {
+			glCopyImageSubData(source, sourceTarget, static_cast<GLint>(level), 0, 0, sourceLayer,
+				destination, GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level), 0, 0, destinationLayer,
+				std::max(width >> level, 1), std::max(height >> level, 1), layers);
+		}
+	}
+}
+
+/**
+ * @brief Orders formats so they can key a map.
+ * @param other Format to compare with.
+ * @return true if this format sorts first.
+ */
+bool Eng::TextureArrayPool::Format::operator<(const Format& other) const {
+	return std::tie(internalFormat, width, height, levels) < std::tie(other.internalFormat, other.width, other.height, other.levels);
+}
+
+/**
+ * @brief Gets the singleton instance of the TextureArrayPool.
+ * @return TextureArrayPool& Reference to the singleton instance.
+ */
+Eng::TextureArrayPool& Eng::TextureArrayPool::getInstance() {
+	static TextureArrayPool instance;
+	return instance;
+}
+
+/**
+ * @brief Checks whether the context can copy textures into immutable texture arrays.
+ *
+ * Requires image copies and immutable storage (core in OpenGL 4.3).
+ *
+ * @return true if TextureArrayPool can be used.
+ */
+bool Eng::TextureArrayPool::isSupported() {
+	return GLEW_VERSION_4_3 || (GLEW_ARB_copy_image && GLEW_ARB_texture_storage);
+}
+
+/**
+ * @brief Checks whether a texture can go into an array, without touching OpenGL.
+ *
+ * Only loaded 2D textures at full resolution are packed; placeholders, cubemaps
+ * and trimmed textures keep being bound on their own.
+ *
+ * @param texture The texture to check.
+ * @return true if acquire() may pack it.
+ */
+bool Eng::TextureArrayPool::canPack(const Eng::Texture& texture) {
+	return texture.isLoaded() && !texture.isCubemap() && !texture.getDroppedLevels() && texture.getLevelCount() > 0
+		&& texture.getWidth() > 0 && texture.getHeight() > 0;
+}
+
+/**
+ * @brief Finds or copies a texture into the array of its format.
+ *
+ * A texture changed since it was copied gives its layer back and is copied again.
+ *
+ * @param texture The texture to look up.
+ * @param slot    Receives the placement of the texture.
+ * @return true if the texture can be sampled from the pool.
+ */
+bool Eng::TextureArrayPool::acquire(const std::shared_ptr<Eng::Texture>& texture, Slot& slot) {
+	if (!texture)
+		return false;
+
+	if (const auto it = entries.find(texture.get()); it != entries.end()) {
+		if (it->second.texture.lock() == texture && it->second.revision == texture->getRevision()) {
+			slot = { it->second.array, it->second.layer };
+			return true;
+		}
+		// Stale copy, or address reused by a new texture: the layer is free again
+		release(it->second);
+		entries.erase(it);
+	}
+
+	if (!canPack(*texture))
+		return false;
+
+	const Format format = { texture->getInternalFormat(), texture->getWidth(), texture->getHeight(), texture->getLevelCount() };
+	auto found = arrayByFormat.find(format);
+	if (found == arrayByFormat.end()) {
+		if (!maxLayers) {
+			GLint layers = 0;
+			glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &layers);
+			maxLayers = static_cast<size_t>(std::max(layers, 1));
+		}
+
+		Array array;
+		array.format = format;
+		array.layerBytes = texture->estimateMemoryUsage(0);
+		if (!allocate(array, std::min(MIN_LAYER_CAPACITY, maxLayers)))
+			return false;
+		arrays.push_back(std::move(array));
+		found = arrayByFormat.emplace(format, arrays.size() - 1).first;
+	}
+
+	const size_t index = found->second;
+	Array& array = arrays[index];
+	if (array.freeLayers.empty() && array.used == array.capacity)
+		reclaim(index);
+	if (array.freeLayers.empty() && array.used == array.capacity
+		&& (array.capacity >= maxLayers || !allocate(array, std::min(array.capacity * 2, maxLayers))))
+		return false;
+
+	int layer;
+	if (!array.freeLayers.empty()) {
+		layer = array.freeLayers.back();
+		array.freeLayers.pop_back();
+	} else {
+		layer = static_cast<int>(array.used++);
+	}
+
+	copyLayers(texture->getTextureID(), GL_TEXTURE_2D, 0, array.id, layer, 1, format.width, format.height, format.levels);
+	entries[texture.get()] = { texture, texture->getRevision(), index, layer };
+	copies++;
+
+	slot = { index, layer };
+	return true;
+}
+
+/**
+ * @brief Binds a texture array to ShaderManager::DIFFUSE_ARRAY_UNIT.
+ * @param array Index of the array, as given by acquire().
+ */
+void Eng::TextureArrayPool::bind(const size_t array) {
+	if (array >= arrays.size())
+		return;
+	glActiveTexture(GL_TEXTURE0 + ShaderManager::DIFFUSE_ARRAY_UNIT);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, arrays[array].id);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+ * @brief Releases the texture arrays and forgets every copied texture.
+ */
+void Eng::TextureArrayPool::clear() {
+	for (const Array& array : arrays)
+		glDeleteTextures(1, &array.id);
+
+	arrays.clear();
+	arrayByFormat.clear();
+	entries.clear();
+	copies = 0;
+}
+
+/**
+ * @brief Gets the contents and memory of the pool.
+ * @return Stats The statistics.
+ */
+Eng::TextureArrayPool::Stats Eng::TextureArrayPool::getStats() const {
+	Stats stats;
+	stats.arrays = arrays.size();
+	stats.textures = entries.size();
+	stats.copies = copies;
+	for (const Array& array : arrays) {
+		stats.layers += array.capacity;
+		stats.gpuBytes += array.capacity * array.layerBytes;
+	}
+	return stats;
+}
+
+/**
+ * @brief Prints pool statistics to the console.
+ * @param stats Statistics returned by getStats().
+ */
+void Eng::TextureArrayPool::printStats(const Stats& stats) {
+	constexpr double MB = 1024.0 * 1024.0;
+	std::cout << "[TextureArrayPool] " << stats.textures << " textures in " << stats.layers << " layers of "
+		<< stats.arrays << " arrays, " << stats.gpuBytes / MB << " MB VRAM, " << stats.copies << " copies so far" << std::endl;
+}
+
+/**
+ * @brief Gives the layer of a copied texture back to its array.
+ * @param entry The copy to release.
+ */
+void Eng::TextureArrayPool::release(const Entry& entry) {
+	arrays[entry.array].freeLayers.push_back(entry.layer);
+}
+
+/**
+ * @brief Releases the layers of the textures of an array destroyed since they were copied.
+ * @param array Index of the array.
+ */
+void Eng::TextureArrayPool::reclaim(const size_t array) {
+	for (auto it = entries.begin(); it != entries.end();) {
+		if (it->second.array == array && it->second.texture.expired()) {
+			release(it->second);
+			it = entries.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+/**
+ * @brief Allocates storage for more layers, keeping the layers handed out.
+ *
+ * The new array replaces the old one under the same index.
+ *
+ * @param array    The array to grow, or to create when it has no storage yet.
+ * @param capacity Layers to hold.
+ * @return true if the storage was allocated.
+ */
+bool Eng::TextureArrayPool::allocate(Array& array, const size_t capacity) {
+	const Format& format = array.format;
+	unsigned int id = 0;
+	glGenTextures(1, &id);
+	glBindTexture(GL_TEXTURE_2D_ARRAY, id);
+	glTexStorage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLsizei>(format.levels), format.internalFormat,
+		format.width, format.height, static_cast<GLsizei>(capacity));
+	GLint immutable = GL_FALSE;
+	glGetTexParameteriv(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+	if (!immutable) {
+		std::cerr << "ERROR: Failed to allocate a " << format.width << "x" << format.height << " texture array of "
+			<< capacity << " layers" << std::endl;
+		glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+		glDeleteTextures(1, &id);
+		return false;
+	}
+
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(format.levels) - 1);
+	if (format.internalFormat == GL_COMPRESSED_RED_RGTC1) {
+		// Single-channel BC4 reads as grey, like the texture it was copied from
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_G, GL_RED);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_SWIZZLE_B, GL_RED);
+	}
+	glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+	if (array.id) {
+		if (array.used)
+			copyLayers(array.id, GL_TEXTURE_2D_ARRAY, 0, id, 0, static_cast<int>(array.used), format.width, format.height, format.levels);
+		glDeleteTextures(1, &array.id);
+	}
+	array.id = id;
+	array.capacity = capacity;
+	return true;
+}
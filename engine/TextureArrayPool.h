@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @class TextureArrayPool
+ * @brief Packs same-format material textures into shared texture arrays, so draws select them by index.
+ *
+ * The TextureArrayPool implements the Singleton pattern, like the GeometryBuffer it
+ * complements. Each 2D texture is copied on the GPU into a layer of a
+ * GL_TEXTURE_2D_ARRAY holding textures of the same internal format, size and mip
+ * count; a multi-draw then binds the array once and each draw samples its layer
+ * (see GeometryBuffer::uploadDraws()), so meshes whose materials differ only by
+ * texture can share one glMultiDrawElementsIndirect call.
+ *
+ * Textures are copied the first time they are requested. A texture whose storage
+ * changed since (re-uploaded, trimmed or evicted, see Texture::getRevision()) gives
+ * its layer back and is copied again once it is at full resolution. Arrays grow
+ * geometrically, up to GL_MAX_ARRAY_TEXTURE_LAYERS, and keep their index, so a
+ * Slot stays valid until clear(). The copies take VRAM on top of the textures
+ * themselves, which the TextureResidency budget does not cover.
+ */
+class ENG_API TextureArrayPool final {
+public:
+	/**
+	 * @brief Placement of a texture inside the pool.
+	 */
+	struct Slot {
+		size_t array = 0;	///< Index of the texture array, see bind()
+		int layer = -1;		///< Layer holding the texture
+	};
+
+	/**
+	 * @brief Contents and memory of the pool.
+	 */
+	struct Stats {
+		size_t arrays = 0;		///< Texture arrays, one per format
+		size_t textures = 0;	///< Textures holding a layer
+		size_t layers = 0;		///< Layers allocated
+		size_t copies = 0;		///< Textures copied in so far
+		size_t gpuBytes = 0;	///< VRAM allocated for the layers
+	};
+
+	///> Layers allocated for a new array
+	static constexpr size_t MIN_LAYER_CAPACITY = 4;
+
+	static TextureArrayPool& getInstance();
+	static bool isSupported();
+	static bool canPack(const Eng::Texture& texture);
+
+	TextureArrayPool(const TextureArrayPool&) = delete;
+	TextureArrayPool& operator=(const TextureArrayPool&) = delete;
+
+	bool acquire(const std::shared_ptr<Eng::Texture>& texture, Slot& slot);
+	void bind(size_t array);
+	void clear();
+
+	Stats getStats() const;
+	static void printStats(const Stats& stats);
+
+private:
+	/** @brief Private constructor to enforce singleton pattern */
+	TextureArrayPool() = default;
+
+	/**
+	 * @brief What textures sharing an array have in common.
+	 */
+	struct Format {
+		unsigned int internalFormat = 0;	///< OpenGL internal format
+		int width = 0;						///< Width of level 0
+		int height = 0;						///< Height of level 0
+		unsigned int levels = 0;			///< Mip levels
+
+		bool operator<(const Format& other) const;
+	};
+
+	/**
+	 * @brief A texture array and its layers.
+	 */
+	struct Array {
+		Format format;					///< Format of every layer
+		unsigned int id = 0;			///< OpenGL texture id
+		size_t layerBytes = 0;			///< VRAM of one layer, mip levels included
+		size_t capacity = 0;			///< Layers allocated
+		size_t used = 0;				///< Layers handed out at least once
+		std::vector<int> freeLayers;	///< Layers given back, reused first
+	};
+
+	/**
+	 * @brief A texture copied into an array.
+	 */
+	struct Entry {
+		std::weak_ptr<Eng::Texture> texture;	///< Detects reuse of the address by another texture
+		uint64_t revision = 0;					///< Texture revision the copy was made from
+		size_t array = 0;						///< Index of the array in arrays
+		int layer = -1;							///< Layer holding the copy
+	};
+
+	void release(const Entry& entry);
+	void reclaim(size_t array);
+	bool allocate(Array& array, size_t capacity);
+
+	///> Arrays in creation order
+	std::vector<Array> arrays;
+	///> Index of the array of each format
+	std::map<Format, size_t> arrayByFormat;
+	///> Copied textures, by address
+	std::unordered_map<const Eng::Texture*, Entry> entries;
+	///> Textures copied in so far
+	size_t copies = 0;
+	///> Layers an array may hold, queried on first use
+	size_t maxLayers = 0;
+};
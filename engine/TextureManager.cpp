@@ -0,0 +1,178 @@
+#include "Engine.h"
+
+#include <filesystem>
+
+/**
+ * @brief Retrieves the singleton instance of the TextureManager.
+ *
+ * @return Reference to the unique TextureManager instance.
+ */
+ENG_API Eng::TextureManager& Eng::TextureManager::getInstance() {
+	static Eng::TextureManager instance;
+	return instance;
+}
+
+/**
+ * @brief Returns the texture of a file, loading it only if no live copy is cached.
+ *
+ * A texture that fails to load is returned but not cached, so a later request
+ * tries the file again. Deferred textures (upload false) are cached right away:
+ * whoever streams their pixels in updates the shared instance.
+ *
+ * @param filePath Path to the image file.
+ * @param upload   Whether to load the file now if it is not cached; otherwise only
+ *                 the path is recorded and the pixels are expected through Texture::upload().
+ * @return std::shared_ptr<Eng::Texture> The shared texture.
+ */
+std::shared_ptr<Eng::Texture> Eng::TextureManager::load(const std::string& filePath, const bool upload) {
+	const std::string key = normalizePath(filePath);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	requests++;
+	if (auto cached = findCached(key)) {
+		hits++;
+		return cached;
+	}
+
+	auto texture = std::make_shared<Eng::Texture>(filePath, upload);
+	if (!upload || texture->isLoaded())
+		entries[key] = texture;
+	return texture;
+}
+
+/**
+ * @brief Returns the cubemap of six faces, loading it only if no live copy is cached.
+ *
+ * @param faces Six image file paths, ordered as +X, -X, +Y, -Y, +Z, -Z.
+ * @return std::shared_ptr<Eng::Texture> The shared cubemap, or nullptr if it could not be loaded.
+ */
+std::shared_ptr<Eng::Texture> Eng::TextureManager::loadCubemap(const std::vector<std::string>& faces) {
+	// Newlines never appear in a path, so a cubemap key cannot match a file key
+	std::string key;
+	for (const auto& face : faces)
+		key += "\n" + normalizePath(face);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	requests++;
+	if (auto cached = findCached(key)) {
+		hits++;
+		return cached;
+	}
+
+	auto texture = std::make_shared<Eng::Texture>("", false);
+	if (!texture->loadCubemap(faces))
+		return nullptr;
+	entries[key] = texture;
+	return texture;
+}
+
+/**
+ * @brief Looks up the cached texture of a file without loading it.
+ * @param filePath Path to the image file.
+ * @return std::shared_ptr<Eng::Texture> The live cached texture, or nullptr.
+ */
+std::shared_ptr<Eng::Texture> Eng::TextureManager::find(const std::string& filePath) {
+	const std::string key = normalizePath(filePath);
+	std::lock_guard<std::mutex> lock(mutex);
+	return findCached(key);
+}
+
+/**
+ * @brief Lists the live cached textures, cubemaps included, dropping expired entries.
+ * @return std::vector<std::shared_ptr<Eng::Texture>> The textures, in no particular order.
+ */
+std::vector<std::shared_ptr<Eng::Texture>> Eng::TextureManager::getTextures() {
+	std::vector<std::shared_ptr<Eng::Texture>> textures;
+	std::lock_guard<std::mutex> lock(mutex);
+	textures.reserve(entries.size());
+	for (auto it = entries.begin(); it != entries.end();) {
+		if (auto texture = it->second.lock()) {
+			textures.push_back(std::move(texture));
+			++it;
+		} else {
+			it = entries.erase(it);
+		}
+	}
+	return textures;
+}
+
+/**
+ * @brief Finds a live cached texture, dropping its entry if it expired.
+ *
+ * The cache lock must be held by the caller.
+ *
+ * @param key Normalized path, or joined face paths.
+ * @return std::shared_ptr<Eng::Texture> The texture, or nullptr.
+ */
+std::shared_ptr<Eng::Texture> Eng::TextureManager::findCached(const std::string& key) {
+	const auto found = entries.find(key);
+	if (found == entries.end())
+		return nullptr;
+	auto texture = found->second.lock();
+	if (!texture)
+		entries.erase(found);
+	return texture;
+}
+
+/**
+ * @brief Collects usage and memory of the cached textures.
+ *
+ * Savings are computed against every owner loading its own copy, which is
+ * what each material did before textures were shared.
+ *
+ * @return Stats The current statistics.
+ */
+Eng::TextureManager::Stats Eng::TextureManager::getStats() {
+	Stats stats;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	stats.requests = requests;
+	stats.hits = hits;
+	for (auto it = entries.begin(); it != entries.end();) {
+		const long owners = it->second.use_count();
+		auto texture = it->second.lock();
+		if (!texture) {
+			it = entries.erase(it);
+			continue;
+		}
+
+		const size_t gpu = texture->getMemoryUsage();
+		stats.uniqueTextures++;
+		stats.references += owners;
+		stats.gpuBytes += gpu;
+		stats.gpuBytesSaved += gpu * (owners - 1);
+		if (texture->isCompressed()) {
+			const size_t uncompressed = static_cast<size_t>(texture->getWidth()) * texture->getHeight() * 4 * 4 / 3;
+			stats.compressedTextures++;
+			stats.gpuBytesCompressionSaved += uncompressed > gpu ? uncompressed - gpu : 0;
+		}
+		++it;
+	}
+	return stats;
+}
+
+/**
+ * @brief Prints the texture cache statistics to the console.
+ */
+void Eng::TextureManager::printStats() {
+	const Stats stats = getStats();
+	std::cout << "[TextureManager] " << stats.uniqueTextures << " unique textures, "
+		<< stats.references << " references" << std::endl;
+	std::cout << "   Requests : " << stats.requests << " (" << stats.hits << " cache hits)" << std::endl;
+	std::cout << "   VRAM . . : " << stats.gpuBytes / 1024 << " KB (saved " << stats.gpuBytesSaved / 1024 << " KB)" << std::endl;
+	std::cout << "   Blocks . : " << stats.compressedTextures << " compressed textures (saved "
+		<< stats.gpuBytesCompressionSaved / 1024 << " KB over RGBA8)" << std::endl;
+}
+
+/**
+ * @brief Normalizes a path for use as a cache key.
+ *
+ * Removes "." and ".." segments and redundant separators, and uses forward
+ * slashes. The file system is not accessed.
+ *
+ * @param filePath Path to normalize.
+ * @return std::string The normalized path.
+ */
+std::string Eng::TextureManager::normalizePath(const std::string& filePath) {
+	return std::filesystem::path(filePath).lexically_normal().generic_string();
+}
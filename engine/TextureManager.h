@@ -0,0 +1,58 @@
+#pragma once
+
+/**
+ * @class TextureManager
+ * @brief Shares one Texture per image file, so each file is decoded and uploaded once.
+ *
+ * Materials referencing the same file get the same Texture instance. The cache
+ * holds weak references only: a texture is released with the last material (or
+ * skybox) using it, and requested again it is simply reloaded. Paths are
+ * normalized before lookup, so "textures/../Board.dds" and "Board.dds" match.
+ *
+ * Cubemaps are cached the same way, keyed by their six face paths.
+ */
+class ENG_API TextureManager final {
+public:
+	/**
+	 * @brief Usage and memory summary of the cached textures.
+	 */
+	struct Stats {
+		size_t uniqueTextures = 0;	///< Live cached textures
+		size_t references = 0;		///< Owners (materials, skyboxes) pointing at them
+		size_t requests = 0;		///< load() and loadCubemap() calls so far
+		size_t hits = 0;			///< Requests answered with a live cached texture
+		size_t gpuBytes = 0;		///< VRAM held by the cached textures
+		size_t gpuBytesSaved = 0;	///< VRAM one copy per owner would have needed on top
+		size_t compressedTextures = 0;	///< Cached textures holding block-compressed data
+		size_t gpuBytesCompressionSaved = 0;	///< VRAM the compressed ones would need on top as mipmapped RGBA8
+	};
+
+	static TextureManager& getInstance();
+	TextureManager(const TextureManager&) = delete;
+	TextureManager& operator=(const TextureManager&) = delete;
+
+	std::shared_ptr<Eng::Texture> load(const std::string& filePath, bool upload = true);
+	std::shared_ptr<Eng::Texture> loadCubemap(const std::vector<std::string>& faces);
+	std::shared_ptr<Eng::Texture> find(const std::string& filePath);
+	std::vector<std::shared_ptr<Eng::Texture>> getTextures();
+
+	Stats getStats();
+	void printStats();
+
+	static std::string normalizePath(const std::string& filePath);
+
+private:
+	/** @brief Private constructor to enforce singleton pattern */
+	TextureManager() = default;
+
+	std::shared_ptr<Eng::Texture> findCached(const std::string& key);
+
+	///> Cached textures by normalized path (or joined face paths for cubemaps)
+	std::unordered_map<std::string, std::weak_ptr<Eng::Texture>> entries;
+	///> Guards the cache, as scenes may be loaded off the render thread
+	std::mutex mutex;
+	///> Requests served so far
+	size_t requests = 0;
+	///> Requests answered from the cache
+	size_t hits = 0;
+};
@@ -0,0 +1,240 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <numeric>
+
+/**
+ * @brief Sets the VRAM the cached textures may hold.
+ * @param bytes Budget in bytes, 0 for no limit.
+ */
+void Eng::TextureResidency::setBudget(const size_t bytes) {
+	budget = bytes;
+}
+
+/**
+ * @brief Gets the VRAM the cached textures may hold.
+ * @return size_t Budget in bytes, 0 for no limit.
+ */
+size_t Eng::TextureResidency::getBudget() const {
+	return budget;
+}
+
+/**
+ * @brief Sets how long a texture must go unrendered before it may be trimmed.
+ * @param frames Frames without being rendered, at least 1.
+ */
+void Eng::TextureResidency::setIdleFrames(const uint64_t frames) {
+	idleFrames = std::max<uint64_t>(frames, 1);
+}
+
+/**
+ * @brief Gets how long a texture must go unrendered before it may be trimmed.
+ * @return uint64_t Frames without being rendered.
+ */
+uint64_t Eng::TextureResidency::getIdleFrames() const {
+	return idleFrames;
+}
+
+/**
+ * @brief Sets the streamer textures are loaded back through.
+ * @param streamer Texture streamer, nullptr to load them on the render thread instead.
+ */
+void Eng::TextureResidency::setTextureStreamer(Eng::TextureStreamer* streamer) {
+	this->streamer = streamer;
+	restoring.clear();
+}
+
+/**
+ * @brief Trims, evicts and restores the cached textures for the frame just rendered, then starts the next one.
+ *
+ * Call once per frame on the render thread. Cubemaps and textures not loaded
+ * yet are left alone.
+ */
+void Eng::TextureResidency::update() {
+	std::vector<std::shared_ptr<Eng::Texture>> textures;
+	std::vector<Candidate> candidates;
+	for (auto& texture : Eng::TextureManager::getInstance().getTextures()) {
+		if (texture->isCubemap() || texture->getFilePath().empty() || (!texture->isLoaded() && !texture->isEvicted()))
+			continue;
+
+		Candidate candidate;
+		candidate.bytes = texture->getMemoryUsage();
+		candidate.fullBytes = texture->estimateMemoryUsage(0);
+		candidate.lastUsed = texture->getLastUsedFrame();
+		const unsigned int dropped = texture->getDroppedLevels() + 1;
+		if (texture->isLoaded() && dropped < texture->getLevelCount()
+			&& std::max(texture->getWidth() >> dropped, texture->getHeight() >> dropped) >= MIN_TRIMMED_SIZE)
+			candidate.trimmedBytes = texture->estimateMemoryUsage(dropped);
+
+		// A restore is pending until the texture is back at full resolution, or gives up after the idle time
+		if (const auto found = restoring.find(texture.get()); found != restoring.end()) {
+			const bool reduced = !texture->isLoaded() || texture->getDroppedLevels();
+			if (found->second.texture.lock() == texture && reduced && frame - found->second.frame < idleFrames)
+				candidate.restoring = true;
+			else
+				restoring.erase(found);
+		}
+
+		candidates.push_back(candidate);
+		textures.push_back(std::move(texture));
+	}
+
+	std::erase_if(restoring, [](const auto& entry) { return entry.second.texture.expired(); });
+
+	const std::vector<Action> actions = plan(candidates, budget, frame, idleFrames);
+	for (size_t i = 0; i < textures.size(); i++) {
+		switch (actions[i]) {
+			case Action::DropLevel:
+				if (textures[i]->dropLevels(1))
+					stats.levelsDropped++;
+				break;
+			case Action::Evict:
+				if (textures[i]->evict())
+					stats.evictions++;
+				break;
+			case Action::Restore:
+				if (restore(textures[i]))
+					stats.restores++;
+				break;
+			case Action::Keep:
+				break;
+		}
+	}
+
+	stats.textures = textures.size();
+	stats.budget = budget;
+	stats.residentBytes = stats.fullBytes = 0;
+	stats.trimmedTextures = stats.evictedTextures = 0;
+	for (const auto& texture : textures) {
+		stats.residentBytes += texture->getMemoryUsage();
+		stats.fullBytes += texture->estimateMemoryUsage(0);
+		stats.trimmedTextures += texture->isLoaded() && texture->getDroppedLevels();
+		stats.evictedTextures += !texture->isLoaded();
+	}
+
+	frame++;
+	stats.frame = frame;
+	Eng::Texture::setCurrentFrame(frame);
+}
+
+/**
+ * @brief Decides what to do with each texture to fit the budget.
+ *
+ * While the textures, plus the ones in use waiting to be back at full
+ * resolution, exceed the budget, idle textures lose their top level, least
+ * recently used first; idle textures already at their smallest size are
+ * evicted in the same order. Textures in use and not at full resolution are
+ * then restored, most recently used first, if they fit. Textures being
+ * restored count at their full size and are left alone.
+ *
+ * @param candidates Residency of each texture.
+ * @param budget     VRAM budget in bytes, 0 for no limit.
+ * @param frame      Frame just rendered.
+ * @param idleFrames Frames without being rendered after which a texture may be trimmed.
+ * @return std::vector<Action> The action of each candidate, in the same order.
+ */
+std::vector<Eng::TextureResidency::Action> Eng::TextureResidency::plan(const std::vector<Candidate>& candidates, const size_t budget,
+	const uint64_t frame, const uint64_t idleFrames) {
+	std::vector<Action> actions(candidates.size(), Action::Keep);
+	auto isIdle = [frame, idleFrames](const Candidate& candidate) {
+		return candidate.lastUsed + idleFrames <= frame;
+	};
+	auto isReduced = [&isIdle](const Candidate& candidate) {
+		return !candidate.restoring && candidate.bytes < candidate.fullBytes && !isIdle(candidate);
+	};
+
+	// VRAM held, and needed on top to bring back the textures in use
+	size_t total = 0;
+	size_t wanted = 0;
+	for (const Candidate& candidate : candidates) {
+		total += candidate.restoring ? candidate.fullBytes : candidate.bytes;
+		if (isReduced(candidate))
+			wanted += candidate.fullBytes - candidate.bytes;
+	}
+
+	std::vector<size_t> order(candidates.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&candidates](const size_t first, const size_t second) {
+		return candidates[first].lastUsed < candidates[second].lastUsed;
+	});
+
+	// The least recently used idle textures make room, a level per frame until they are evicted at their smallest size
+	if (budget) {
+		for (const size_t index : order) {
+			const Candidate& candidate = candidates[index];
+			if (total + wanted <= budget || !isIdle(candidate))
+				break;
+			if (candidate.restoring || !candidate.bytes)
+				continue;
+			if (candidate.trimmedBytes) {
+				actions[index] = Action::DropLevel;
+				total -= candidate.bytes - candidate.trimmedBytes;
+			}
+		}
+		for (const size_t index : order) {
+			const Candidate& candidate = candidates[index];
+			if (total + wanted <= budget || !isIdle(candidate))
+				break;
+			if (!candidate.restoring && candidate.bytes && !candidate.trimmedBytes) {
+				actions[index] = Action::Evict;
+				total -= candidate.bytes;
+			}
+		}
+	}
+
+	// Textures in use come back as they fit, the most recent ones first
+	for (auto it = order.rbegin(); it != order.rend(); ++it) {
+		const Candidate& candidate = candidates[*it];
+		if (!isReduced(candidate))
+			continue;
+		if (!budget || total - candidate.bytes + candidate.fullBytes <= budget) {
+			actions[*it] = Action::Restore;
+			total += candidate.fullBytes - candidate.bytes;
+		}
+	}
+	return actions;
+}
+
+/**
+ * @brief Gets the residency after the last update() and the counters so far.
+ * @return Stats The statistics.
+ */
+Eng::TextureResidency::Stats Eng::TextureResidency::getStats() const {
+	return stats;
+}
+
+/**
+ * @brief Prints residency statistics to the console.
+ * @param stats Statistics returned by getStats().
+ */
+void Eng::TextureResidency::printStats(const Stats& stats) {
+	constexpr double MB = 1024.0 * 1024.0;
+	std::cout << "[TextureResidency] " << stats.residentBytes / MB << " of " << stats.fullBytes / MB << " MB resident for "
+		<< stats.textures << " textures, budget ";
+	if (stats.budget)
+		std::cout << stats.budget / MB << " MB" << std::endl;
+	else
+		std::cout << "unlimited" << std::endl;
+	std::cout << "   Now . . : " << stats.trimmedTextures << " trimmed, " << stats.evictedTextures << " evicted" << std::endl;
+	std::cout << "   So far  : " << stats.levelsDropped << " levels dropped, " << stats.evictions << " evictions, "
+		<< stats.restores << " restores in " << stats.frame << " frames" << std::endl;
+}
+
+/**
+ * @brief Loads a trimmed or evicted texture back at full resolution.
+ *
+ * A texture that cannot be loaded is left alone for the idle time before it is tried again.
+ *
+ * @param texture Texture to restore.
+ * @return bool True if it was queued or loaded.
+ */
+bool Eng::TextureResidency::restore(const std::shared_ptr<Eng::Texture>& texture) {
+	if (streamer) {
+		if (!streamer->enqueue(texture))
+			return false;
+	} else if (texture->loadFromFile(texture->getFilePath())) {
+		return true;
+	}
+	restoring[texture.get()] = { texture, frame };
+	return streamer != nullptr;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @class TextureResidency
+ * @brief Keeps the textures of the TextureManager within a VRAM budget, least recently used first.
+ *
+ * Textures stay in VRAM as long as a material holds them, so a large scene
+ * either fits or exhausts the driver. Every frame, update() adds up the memory
+ * of the cached 2D textures and, while it exceeds the budget, frees memory from
+ * the textures not rendered for a while (see Texture::render()), oldest first:
+ * their top mip level is dropped, which saves three quarters of their memory,
+ * and once at MIN_TRIMMED_SIZE they are evicted. Once rendered again, a trimmed
+ * or evicted texture is streamed back from its file, through the TextureStreamer
+ * when one is set, as soon as it fits in the budget.
+ *
+ * Trims go one level per texture and frame, so the memory in use converges to
+ * the budget over a few frames. Textures in use are never trimmed: a budget
+ * smaller than the textures of one view is exceeded rather than thrashed.
+ */
+class ENG_API TextureResidency final {
+public:
+	/**
+	 * @brief What update() does to a texture.
+	 */
+	enum class Action { Keep, DropLevel, Evict, Restore };
+
+	/**
+	 * @brief Residency of one texture, as seen by plan().
+	 */
+	struct Candidate {
+		size_t bytes = 0;			///< VRAM held now, 0 if evicted
+		size_t fullBytes = 0;		///< VRAM held at full resolution
+		size_t trimmedBytes = 0;	///< VRAM held with one more top level dropped, 0 if it cannot be dropped
+		uint64_t lastUsed = 0;		///< Frame the texture was last rendered in
+		bool restoring = false;		///< Whether it is being streamed back already
+	};
+
+	/**
+	 * @brief Residency of the cached textures after the last update(), and counters since the start.
+	 */
+	struct Stats {
+		size_t textures = 0;		///< 2D textures tracked
+		size_t budget = 0;			///< VRAM budget, 0 for no limit
+		size_t residentBytes = 0;	///< VRAM held by the tracked textures
+		size_t fullBytes = 0;		///< VRAM they would hold at full resolution
+		size_t trimmedTextures = 0;	///< Textures resident with top levels dropped
+		size_t evictedTextures = 0;	///< Textures evicted, rendering as placeholders
+		size_t levelsDropped = 0;	///< Top mip levels dropped so far
+		size_t evictions = 0;		///< Textures evicted so far
+		size_t restores = 0;		///< Textures loaded back at full resolution so far
+		uint64_t frame = 0;			///< Frames updated
+	};
+
+	///> Default frames without being rendered after which a texture may be trimmed
+	static constexpr uint64_t DEFAULT_IDLE_FRAMES = 120;
+	///> Smallest width or height a texture is trimmed to
+	static constexpr int MIN_TRIMMED_SIZE = 64;
+
+	TextureResidency() = default;
+	TextureResidency(const TextureResidency&) = delete;
+	void operator=(const TextureResidency&) = delete;
+
+	void setBudget(size_t bytes);
+	size_t getBudget() const;
+	void setIdleFrames(uint64_t frames);
+	uint64_t getIdleFrames() const;
+	void setTextureStreamer(Eng::TextureStreamer* streamer);
+
+	void update();
+	static std::vector<Action> plan(const std::vector<Candidate>& candidates, size_t budget, uint64_t frame, uint64_t idleFrames);
+
+	Stats getStats() const;
+	static void printStats(const Stats& stats);
+
+private:
+	/**
+	 * @brief A texture streamed back, until it is resident at full resolution.
+	 */
+	struct Restore {
+		std::weak_ptr<Eng::Texture> texture;	///< Texture queued on the streamer
+		uint64_t frame = 0;						///< Frame it was queued in
+	};
+
+	bool restore(const std::shared_ptr<Eng::Texture>& texture);
+
+	///> VRAM budget of the cached textures, 0 for no limit
+	size_t budget = 0;
+	///> Frames without being rendered after which a texture may be trimmed
+	uint64_t idleFrames = DEFAULT_IDLE_FRAMES;
+	///> Streams textures back, nullptr to load them on the render thread
+	Eng::TextureStreamer* streamer = nullptr;
+	///> Textures queued on the streamer, by address
+	std::unordered_map<const Eng::Texture*, Restore> restoring;
+	///> Frame being rendered
+	uint64_t frame = 0;
+	///> Residency after the last update() and counters so far
+	Stats stats;
+};
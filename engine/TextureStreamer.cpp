@@ -0,0 +1,349 @@
+#include "Engine.h"
+
+// GLEW
+#include <GL/glew.h>
+
+#include <algorithm>
+
+/**
+ * @brief Drops pending textures and waits for the workers.
+ *
+ * The pixel buffers are left to releaseBuffers(), which needs the OpenGL context.
+ */
+Eng::TextureStreamer::~TextureStreamer() {
+	cancel();
+}
+
+/**
+ * @brief Sets how many worker threads decode textures.
+ *
+ * Takes effect for the workers started afterwards.
+ *
+ * @param count Worker threads, 0 for one per hardware thread but the render thread.
+ */
+void Eng::TextureStreamer::setThreadCount(const unsigned int count) {
+	pool.setThreadCount(count);
+}
+
+/**
+ * @brief Gets how many worker threads decode textures.
+ * @return unsigned int Worker threads, 0 for one per hardware thread but the render thread.
+ */
+unsigned int Eng::TextureStreamer::getThreadCount() const {
+	return pool.getThreadCount();
+}
+
+/**
+ * @brief Sets the image bytes update() may upload.
+ *
+ * A texture that would exceed the budget waits for the next frame, unless it is
+ * the first of the frame: larger textures still go, one per frame.
+ *
+ * @param bytes Image bytes per call, 0 for no limit.
+ */
+void Eng::TextureStreamer::setFrameBudget(const size_t bytes) {
+	std::lock_guard<std::mutex> lock(mutex);
+	frameBudget = bytes;
+}
+
+/**
+ * @brief Gets the image bytes update() may upload.
+ * @return size_t Image bytes per call, 0 for no limit.
+ */
+size_t Eng::TextureStreamer::getFrameBudget() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return frameBudget;
+}
+
+/**
+ * @brief Replaces the function workers decode files with.
+ *
+ * Must be safe to call from several threads at once.
+ *
+ * @param decoder Decoding function, empty for Texture::decodeFile().
+ */
+void Eng::TextureStreamer::setDecoder(Decoder decoder) {
+	std::lock_guard<std::mutex> lock(mutex);
+	this->decoder = std::move(decoder);
+}
+
+/**
+ * @brief Replaces the function update() creates textures with.
+ * @param uploader Upload function, empty for the pixel buffer ring.
+ */
+void Eng::TextureStreamer::setUploader(Uploader uploader) {
+	std::lock_guard<std::mutex> lock(mutex);
+	this->uploader = std::move(uploader);
+}
+
+/**
+ * @brief Queues a texture for decoding, starting a worker if fewer than the thread count run.
+ *
+ * Returns at once; the texture renders as a placeholder until update() uploads it.
+ * A texture with top mip levels dropped (see Texture::dropLevels()) keeps rendering
+ * at its lower resolution until then.
+ *
+ * @param texture Texture created without loading (see TextureManager::load()), or
+ *                evicted or trimmed since, naming its file.
+ * @return bool True if queued, false if it is already loaded at full resolution, already queued or has no file.
+ */
+bool Eng::TextureStreamer::enqueue(const std::shared_ptr<Eng::Texture>& texture) {
+	if (!texture || (texture->isLoaded() && !texture->getDroppedLevels()) || texture->getFilePath().empty())
+		return false;
+
+	pool.joinFinished();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (const auto found = pending.find(texture.get()); found != pending.end()) {
+		Request& previous = requests.at(found->second);
+		if (!previous.texture.expired())
+			return false;
+		// A released texture whose address was reused
+		drop(found->second, previous);
+	}
+
+	const uint64_t sequence = nextSequence++;
+	requests[sequence] = { texture, texture.get(), texture->getFilePath(), nullptr, false, false };
+	pending[texture.get()] = sequence;
+	queue.push_back(sequence);
+	stats.queued++;
+	pool.start([this](const unsigned int generation) { work(generation); });
+	return true;
+}
+
+/**
+ * @brief Drops a queued texture, leaving it unloaded.
+ *
+ * A texture being decoded is dropped once its worker is done.
+ *
+ * @param texture Texture given to enqueue().
+ * @return bool True if it was pending, false if it was already uploaded or never queued.
+ */
+bool Eng::TextureStreamer::cancel(const std::shared_ptr<Eng::Texture>& texture) {
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto found = texture ? pending.find(texture.get()) : pending.end();
+	if (found == pending.end())
+		return false;
+	drop(found->second, requests.at(found->second));
+	return true;
+}
+
+/**
+ * @brief Drops every pending texture.
+ *
+ * Waits for the textures being decoded by workers; their images are discarded.
+ */
+void Eng::TextureStreamer::cancel() {
+	pool.cancel([this]() {
+		queue.clear();
+		requests.clear();
+		pending.clear();
+		nextUpload = nextSequence;
+		stats = Stats();
+	});
+}
+
+/**
+ * @brief Uploads decoded textures, in queue order, until the frame budget is spent.
+ *
+ * Call once per frame from the render thread, before the scene is traversed.
+ * Uploads stop at the first texture still being decoded, so later ones wait.
+ *
+ * @return size_t Number of textures swapped in.
+ */
+size_t Eng::TextureStreamer::update() {
+	size_t done = 0;
+	size_t bytes = 0;
+	while (true) {
+		std::shared_ptr<Eng::Texture> texture;
+		std::shared_ptr<Eng::Texture::Image> image;
+		Uploader upload;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			const auto found = requests.find(nextUpload);
+			if (nextUpload == nextSequence || found == requests.end() || !found->second.ready)
+				break;
+			Request& request = found->second;
+			texture = request.texture.lock();
+			if (!texture && !request.cancelled)
+				drop(nextUpload, request);
+			if (request.image && frameBudget && bytes && bytes + request.image->pixels.size() > frameBudget)
+				break;
+
+			image = std::move(request.image);
+			if (const auto owner = pending.find(request.key); owner != pending.end() && owner->second == nextUpload)
+				pending.erase(owner);
+			requests.erase(found);
+			nextUpload++;
+			upload = uploader;
+		}
+		if (!texture || !image)
+			continue;
+
+		if (upload)
+			upload(*texture, *image);
+		else
+			uploadThroughPixelBuffer(*texture, *image);
+		bytes += image->pixels.size();
+		done++;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stats.uploaded += done;
+		stats.bytesUploaded += bytes;
+		if (done)
+			stats.frames++;
+	}
+	pool.joinFinished();
+	return done;
+}
+
+/**
+ * @brief Deletes the pixel buffers; call while the OpenGL context is alive.
+ */
+void Eng::TextureStreamer::releaseBuffers() {
+	if (pixelBuffers[0]) {
+		glDeleteBuffers(PIXEL_BUFFER_COUNT, pixelBuffers.data());
+		pixelBuffers.fill(0);
+	}
+}
+
+/**
+ * @brief Checks whether every queued texture was uploaded or dropped.
+ * @return bool True when nothing is left for update() to do.
+ */
+bool Eng::TextureStreamer::isComplete() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return nextUpload == nextSequence;
+}
+
+/**
+ * @brief Gets how many queued textures were not uploaded or dropped yet.
+ * @return size_t Pending textures.
+ */
+size_t Eng::TextureStreamer::getPendingCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return static_cast<size_t>(nextSequence - nextUpload);
+}
+
+/**
+ * @brief Gets the counters since the last cancel().
+ * @return Stats Counters.
+ */
+Eng::TextureStreamer::Stats Eng::TextureStreamer::getStats() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+/**
+ * @brief Prints the texture streaming counters.
+ * @param stats Counters returned by getStats().
+ */
+void Eng::TextureStreamer::printStats(const Stats& stats) {
+	std::cout << "[TextureStreamer] " << stats.uploaded << " of " << stats.queued << " textures streamed ("
+		<< stats.bytesUploaded / (1024.0 * 1024.0) << " MB over " << stats.frames << " frames), "
+		<< stats.failed << " failed, " << stats.cancelled << " cancelled" << std::endl;
+}
+
+/**
+ * @brief Marks a request as dropped, so update() skips it.
+ *
+ * The lock must be held by the caller.
+ *
+ * @param sequence Sequence number of the request.
+ * @param request  The request.
+ */
+void Eng::TextureStreamer::drop(const uint64_t sequence, Request& request) {
+	if (request.cancelled)
+		return;
+	request.cancelled = true;
+	request.image.reset();
+	stats.cancelled++;
+	if (const auto owner = pending.find(request.key); owner != pending.end() && owner->second == sequence)
+		pending.erase(owner);
+	// Not picked by a worker yet: nothing left to wait for
+	if (const auto queued = std::find(queue.begin(), queue.end(), sequence); queued != queue.end()) {
+		queue.erase(queued);
+		request.ready = true;
+	}
+}
+
+/**
+ * @brief Worker loop: decodes textures until none is left or the streamer is cancelled.
+ * @param generation Value of the cancel counter when the worker was started.
+ */
+void Eng::TextureStreamer::work(const unsigned int generation) {
+	while (true) {
+		uint64_t sequence;
+		std::string filePath;
+		Decoder decode;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!pool.isCurrent(generation) || queue.empty()) {
+				pool.leave();
+				return;
+			}
+			sequence = queue.front();
+			queue.pop_front();
+			Request& request = requests.at(sequence);
+			if (request.texture.expired()) {
+				drop(sequence, request);
+				request.ready = true;
+				continue;
+			}
+			filePath = request.filePath;
+			decode = decoder;
+		}
+
+		auto image = std::make_shared<Eng::Texture::Image>();
+		const bool decoded = decode ? decode(filePath, *image) : Eng::Texture::decodeFile(filePath, *image);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!pool.isCurrent(generation))
+			continue;
+		Request& request = requests.at(sequence);
+		request.ready = true;
+		if (request.cancelled)
+			continue;
+		if (decoded) {
+			request.image = std::move(image);
+			stats.decoded++;
+		} else {
+			stats.failed++;
+		}
+	}
+}
+
+/**
+ * @brief Creates a texture from an image staged in the next pixel buffer of the ring.
+ *
+ * The buffer is orphaned before being mapped, so the copy never waits for the GPU
+ * to finish reading it from an earlier frame; the texture then sources its pixels
+ * from the buffer. Falls back to a direct upload if the buffer cannot be mapped.
+ *
+ * @param texture Texture to fill in.
+ * @param image   Decoded image.
+ */
+void Eng::TextureStreamer::uploadThroughPixelBuffer(Eng::Texture& texture, const Eng::Texture::Image& image) {
+	if (!pixelBuffers[0])
+		glGenBuffers(PIXEL_BUFFER_COUNT, pixelBuffers.data());
+	const unsigned int buffer = pixelBuffers[nextPixelBuffer];
+	nextPixelBuffer = (nextPixelBuffer + 1) % PIXEL_BUFFER_COUNT;
+
+	const GLsizeiptr size = static_cast<GLsizeiptr>(image.pixels.size());
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+	void* staging = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (staging) {
+		std::memcpy(staging, image.pixels.data(), image.pixels.size());
+		const bool unmapped = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+		if (unmapped) {
+			texture.upload(image, true);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+			return;
+		}
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	texture.upload(image);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @class TextureStreamer
+ * @brief Decodes textures on worker threads and uploads them through a ring of pixel buffers.
+ *
+ * enqueue() returns at once: until its pixels arrive, a texture renders as a 1x1
+ * white placeholder (see Texture::render()). Files are decoded by a pool of
+ * workers; update(), called once per frame on the render thread, then copies the
+ * decoded images into pixel buffer objects and creates the textures from them,
+ * within a byte budget per frame, so a scene with dozens of 2K textures fills in
+ * over a few frames instead of stalling.
+ *
+ * Uploads run in the order textures were queued, whatever order the workers
+ * finish in. A texture can be cancelled with cancel(texture); one whose last
+ * owner went away is dropped as well, since only weak references are held.
+ */
+class ENG_API TextureStreamer final {
+public:
+	///> Reads a file into an image, on a worker thread
+	using Decoder = std::function<bool(const std::string& filePath, Eng::Texture::Image& image)>;
+	///> Creates the texture from a decoded image, on the render thread
+	using Uploader = std::function<void(Eng::Texture& texture, const Eng::Texture::Image& image)>;
+
+	/**
+	 * @brief Counters of the textures streamed since the last cancel().
+	 */
+	struct Stats {
+		size_t queued = 0;			///< Textures queued
+		size_t decoded = 0;			///< Textures decoded by a worker
+		size_t failed = 0;			///< Textures whose file could not be decoded
+		size_t cancelled = 0;		///< Textures cancelled or released before their upload
+		size_t uploaded = 0;		///< Textures swapped in by update()
+		size_t bytesUploaded = 0;	///< Image bytes uploaded
+		size_t frames = 0;			///< update() calls that uploaded at least one texture
+	};
+
+	///> Default image bytes uploaded per frame
+	static constexpr size_t DEFAULT_FRAME_BUDGET = 8 * 1024 * 1024;
+	///> Pixel buffer objects uploads cycle through
+	static constexpr unsigned int PIXEL_BUFFER_COUNT = 3;
+
+	TextureStreamer() = default;
+	~TextureStreamer();
+	TextureStreamer(const TextureStreamer&) = delete;
+	void operator=(const TextureStreamer&) = delete;
+
+	void setThreadCount(unsigned int count);
+	unsigned int getThreadCount() const;
+	void setFrameBudget(size_t bytes);
+	size_t getFrameBudget() const;
+	void setDecoder(Decoder decoder);
+	void setUploader(Uploader uploader);
+
+	bool enqueue(const std::shared_ptr<Eng::Texture>& texture);
+	bool cancel(const std::shared_ptr<Eng::Texture>& texture);
+	void cancel();
+	size_t update();
+	void releaseBuffers();
+
+	bool isComplete() const;
+	size_t getPendingCount() const;
+	Stats getStats() const;
+	static void printStats(const Stats& stats);
+
+private:
+	/**
+	 * @brief A queued texture, then its decoded image waiting for upload.
+	 */
+	struct Request {
+		std::weak_ptr<Eng::Texture> texture;			///< Texture to fill in
+		const Eng::Texture* key = nullptr;				///< Texture address, identifying the request
+		std::string filePath;							///< File to decode
+		std::shared_ptr<Eng::Texture::Image> image;		///< Decoded image, null if dropped or failed
+		bool ready = false;								///< Whether decoding finished or was skipped
+		bool cancelled = false;							///< Whether the image is to be dropped
+	};
+
+	void drop(uint64_t sequence, Request& request);
+	void work(unsigned int generation);
+	void uploadThroughPixelBuffer(Eng::Texture& texture, const Eng::Texture::Image& image);
+
+	///> Guards every member below but the pixel buffers
+	mutable std::mutex mutex;
+	///> Workers decoding textures
+	WorkerPool pool{ mutex };
+	///> Sequence numbers of the textures not decoded yet, in queue order
+	std::deque<uint64_t> queue;
+	///> Requests by sequence number, until uploaded
+	std::unordered_map<uint64_t, Request> requests;
+	///> Sequence number of the pending request of each texture
+	std::unordered_map<const Eng::Texture*, uint64_t> pending;
+	///> Sequence number of the next texture queued
+	uint64_t nextSequence = 0;
+	///> Sequence number of the next texture to upload
+	uint64_t nextUpload = 0;
+	///> Counters since the last cancel()
+	Stats stats;
+	///> Image bytes uploaded per update() call; 0 for no limit
+	size_t frameBudget = DEFAULT_FRAME_BUDGET;
+	///> Decoder used by workers, Texture::decodeFile() when empty
+	Decoder decoder;
+	///> Uploader used by update(), uploadThroughPixelBuffer() when empty
+	Uploader uploader;
+
+	///> Pixel buffer objects, created on first upload (render thread only)
+	std::array<unsigned int, PIXEL_BUFFER_COUNT> pixelBuffers{};
+	///> Next pixel buffer of the ring
+	unsigned int nextPixelBuffer = 0;
+};
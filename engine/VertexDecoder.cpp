@@ -0,0 +1,284 @@
+#include "Engine.h"
+
+#include <glm/gtc/packing.hpp>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define ENG_VERTEX_DECODER_X86
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define ENG_TARGET_AVX2
+	#else
+		#define ENG_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#endif
+
+namespace {
+	/**
+	 * @brief Reference decoders, also used for the tails of the SIMD loops.
+	 */
+	void decodeNormalsScalar(const unsigned int* packed, const size_t begin, const size_t count, float* x, float* y, float* z) {
+		for (size_t i = begin; i < count; i++) {
+			const glm::vec4 normal = glm::unpackSnorm3x10_1x2(packed[i]);
+			x[i] = normal.x;
+			y[i] = normal.y;
+			z[i] = normal.z;
+		}
+	}
+
+	void decodeTexCoordsScalar(const unsigned int* packed, const size_t begin, const size_t count, float* u, float* v) {
+		for (size_t i = begin; i < count; i++) {
+			const glm::vec2 texCoords = glm::unpackHalf2x16(packed[i]);
+			u[i] = texCoords.x;
+			v[i] = texCoords.y;
+		}
+	}
+
+#ifdef ENG_VERTEX_DECODER_X86
+	/**
+	 * @brief Detects AVX2, including the OS support for the 256-bit registers.
+	 */
+	bool hasAvx2() {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7)
+			return false;
+		__cpuid(info, 1);
+		const bool osSaves = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+		if (!osSaves || (_xgetbv(0) & 0x6) != 0x6)
+			return false;
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	/**
+	 * @brief Converts the half floats in the low 16 bits of each lane.
+	 *
+	 * Exact for every input: normals only move the exponent, subnormals are
+	 * renormalized by a float subtraction that cannot round, and infinities and
+	 * NaNs keep their payload, as in glm's software conversion.
+	 */
+	__m128 halfToFloat(const __m128i half) {
+		const __m128i exponentMask = _mm_set1_epi32(0x7c00 << 13);
+		__m128i bits = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x7fff)), 13);
+		const __m128i exponent = _mm_and_si128(bits, exponentMask);
+		bits = _mm_add_epi32(bits, _mm_set1_epi32((127 - 15) << 23));
+
+		// Infinity and NaN: move the exponent to 255
+		const __m128i special = _mm_cmpeq_epi32(exponent, exponentMask);
+		bits = _mm_add_epi32(bits, _mm_and_si128(special, _mm_set1_epi32((128 - 16) << 23)));
+
+		// Zero and subnormals: renormalize
+		const __m128i subnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+		const __m128 renormalized = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))),
+			_mm_castsi128_ps(_mm_set1_epi32(113 << 23)));
+		bits = _mm_or_si128(_mm_and_si128(subnormal, _mm_castps_si128(renormalized)), _mm_andnot_si128(subnormal, bits));
+
+		const __m128i sign = _mm_slli_epi32(_mm_and_si128(half, _mm_set1_epi32(0x8000)), 16);
+		return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+	}
+
+	void decodeNormalsSse2(const unsigned int* packed, const size_t count, float* x, float* y, float* z) {
+		const __m128 scale = _mm_set1_ps(1.0f / 511.0f);
+		const __m128 lower = _mm_set1_ps(-1.0f);
+		const __m128 upper = _mm_set1_ps(1.0f);
+		const size_t end = count & ~size_t(3);
+		for (size_t i = 0; i < end; i += 4) {
+			const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + i));
+			// Shift each 10-bit field to the top, then back with sign extension
+			const __m128i xi = _mm_srai_epi32(_mm_slli_epi32(value, 22), 22);
+			const __m128i yi = _mm_srai_epi32(_mm_slli_epi32(value, 12), 22);
+			const __m128i zi = _mm_srai_epi32(_mm_slli_epi32(value, 2), 22);
+			_mm_storeu_ps(x + i, _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(xi), scale), lower), upper));
+			_mm_storeu_ps(y + i, _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(yi), scale), lower), upper));
+			_mm_storeu_ps(z + i, _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(zi), scale), lower), upper));
+		}
+		decodeNormalsScalar(packed, end, count, x, y, z);
+	}
+
+	void decodeTexCoordsSse2(const unsigned int* packed, const size_t count, float* u, float* v) {
+		const size_t end = count & ~size_t(3);
+		for (size_t i = 0; i < end; i += 4) {
+			const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + i));
+			_mm_storeu_ps(u + i, halfToFloat(_mm_and_si128(value, _mm_set1_epi32(0xffff))));
+			_mm_storeu_ps(v + i, halfToFloat(_mm_srli_epi32(value, 16)));
+		}
+		decodeTexCoordsScalar(packed, end, count, u, v);
+	}
+
+	/**
+	 * @brief AVX2 version of halfToFloat().
+	 */
+	ENG_TARGET_AVX2 __m256 halfToFloatAvx2(const __m256i half) {
+		const __m256i exponentMask = _mm256_set1_epi32(0x7c00 << 13);
+		__m256i bits = _mm256_slli_epi32(_mm256_and_si256(half, _mm256_set1_epi32(0x7fff)), 13);
+		const __m256i exponent = _mm256_and_si256(bits, exponentMask);
+		bits = _mm256_add_epi32(bits, _mm256_set1_epi32((127 - 15) << 23));
+
+		const __m256i special = _mm256_cmpeq_epi32(exponent, exponentMask);
+		bits = _mm256_add_epi32(bits, _mm256_and_si256(special, _mm256_set1_epi32((128 - 16) << 23)));
+
+		const __m256i subnormal = _mm256_cmpeq_epi32(exponent, _mm256_setzero_si256());
+		const __m256 renormalized = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_add_epi32(bits, _mm256_set1_epi32(1 << 23))),
+			_mm256_castsi256_ps(_mm256_set1_epi32(113 << 23)));
+		bits = _mm256_blendv_epi8(bits, _mm256_castps_si256(renormalized), subnormal);
+
+		const __m256i sign = _mm256_slli_epi32(_mm256_and_si256(half, _mm256_set1_epi32(0x8000)), 16);
+		return _mm256_castsi256_ps(_mm256_or_si256(bits, sign));
+	}
+
+	ENG_TARGET_AVX2 void decodeNormalsAvx2(const unsigned int* packed, const size_t count, float* x, float* y, float* z) {
+		const __m256 scale = _mm256_set1_ps(1.0f / 511.0f);
+		const __m256 lower = _mm256_set1_ps(-1.0f);
+		const __m256 upper = _mm256_set1_ps(1.0f);
+		const size_t end = count & ~size_t(7);
+		for (size_t i = 0; i < end; i += 8) {
+			const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(packed + i));
+			const __m256i xi = _mm256_srai_epi32(_mm256_slli_epi32(value, 22), 22);
+			const __m256i yi = _mm256_srai_epi32(_mm256_slli_epi32(value, 12), 22);
+			const __m256i zi = _mm256_srai_epi32(_mm256_slli_epi32(value, 2), 22);
+			_mm256_storeu_ps(x + i, _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(xi), scale), lower), upper));
+			_mm256_storeu_ps(y + i, _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(yi), scale), lower), upper));
+			_mm256_storeu_ps(z + i, _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(zi), scale), lower), upper));
+		}
+		decodeNormalsScalar(packed, end, count, x, y, z);
+	}
+
+	ENG_TARGET_AVX2 void decodeTexCoordsAvx2(const unsigned int* packed, const size_t count, float* u, float* v) {
+		const size_t end = count & ~size_t(7);
+		for (size_t i = 0; i < end; i += 8) {
+			const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(packed + i));
+			_mm256_storeu_ps(u + i, halfToFloatAvx2(_mm256_and_si256(value, _mm256_set1_epi32(0xffff))));
+			_mm256_storeu_ps(v + i, halfToFloatAvx2(_mm256_srli_epi32(value, 16)));
+		}
+		decodeTexCoordsScalar(packed, end, count, u, v);
+	}
+#endif
+}
+
+/**
+ * @brief Gets the fastest path supported by this CPU, detected once.
+ * @return Path The path used when none is requested.
+ */
+Eng::VertexDecoder::Path Eng::VertexDecoder::getBestPath() {
+	static const Path best = isSupported(Path::AVX2) ? Path::AVX2 : isSupported(Path::SSE2) ? Path::SSE2 : Path::SCALAR;
+	return best;
+}
+
+/**
+ * @brief Checks whether a path can run on this CPU.
+ * @param path Path to check.
+ * @return true if it is compiled in and supported by the CPU.
+ */
+bool Eng::VertexDecoder::isSupported(const Path path) {
+	switch (path) {
+	case Path::SCALAR:
+		return true;
+#ifdef ENG_VERTEX_DECODER_X86
+	case Path::SSE2:
+		// Part of every x86-64 CPU, and of the engine's 32-bit baseline
+		return true;
+	case Path::AVX2: {
+		static const bool supported = hasAvx2();
+		return supported;
+	}
+#endif
+	default:
+		return false;
+	}
+}
+
+/**
+ * @brief Gets a readable name for a path.
+ * @param path Path to name.
+ * @return const char* The name of its instruction set.
+ */
+const char* Eng::VertexDecoder::getPathName(const Path path) {
+	switch (path) {
+	case Path::SSE2: return "SSE2";
+	case Path::AVX2: return "AVX2";
+	default: return "scalar";
+	}
+}
+
+/**
+ * @brief Decodes packed 10:10:10:2 normals on the fastest path.
+ *
+ * @param packed Packed normals.
+ * @param count Number of normals.
+ * @param x Receives the X components, count floats.
+ * @param y Receives the Y components, count floats.
+ * @param z Receives the Z components, count floats.
+ */
+void Eng::VertexDecoder::decodeNormals(const unsigned int* packed, const size_t count, float* x, float* y, float* z) {
+	decodeNormals(packed, count, x, y, z, getBestPath());
+}
+
+/**
+ * @brief Decodes packed 10:10:10:2 normals on a given path.
+ *
+ * Unsupported paths fall back to the scalar one. The 2-bit W field is ignored.
+ *
+ * @param packed Packed normals.
+ * @param count Number of normals.
+ * @param x Receives the X components, count floats.
+ * @param y Receives the Y components, count floats.
+ * @param z Receives the Z components, count floats.
+ * @param path Instruction set to use.
+ */
+void Eng::VertexDecoder::decodeNormals(const unsigned int* packed, const size_t count, float* x, float* y, float* z, const Path path) {
+	if (!isSupported(path)) {
+		decodeNormalsScalar(packed, 0, count, x, y, z);
+		return;
+	}
+
+	switch (path) {
+#ifdef ENG_VERTEX_DECODER_X86
+	case Path::SSE2: decodeNormalsSse2(packed, count, x, y, z); break;
+	case Path::AVX2: decodeNormalsAvx2(packed, count, x, y, z); break;
+#endif
+	default: decodeNormalsScalar(packed, 0, count, x, y, z);
+	}
+}
+
+/**
+ * @brief Decodes pairs of half float texture coordinates on the fastest path.
+ *
+ * @param packed Packed coordinates, U in the low 16 bits.
+ * @param count Number of coordinate pairs.
+ * @param u Receives the U coordinates, count floats.
+ * @param v Receives the V coordinates, count floats.
+ */
+void Eng::VertexDecoder::decodeTexCoords(const unsigned int* packed, const size_t count, float* u, float* v) {
+	decodeTexCoords(packed, count, u, v, getBestPath());
+}
+
+/**
+ * @brief Decodes pairs of half float texture coordinates on a given path.
+ *
+ * Unsupported paths fall back to the scalar one.
+ *
+ * @param packed Packed coordinates, U in the low 16 bits.
+ * @param count Number of coordinate pairs.
+ * @param u Receives the U coordinates, count floats.
+ * @param v Receives the V coordinates, count floats.
+ * @param path Instruction set to use.
+ */
+void Eng::VertexDecoder::decodeTexCoords(const unsigned int* packed, const size_t count, float* u, float* v, const Path path) {
+	if (!isSupported(path)) {
+		decodeTexCoordsScalar(packed, 0, count, u, v);
+		return;
+	}
+
+	switch (path) {
+#ifdef ENG_VERTEX_DECODER_X86
+	case Path::SSE2: decodeTexCoordsSse2(packed, count, u, v); break;
+	case Path::AVX2: decodeTexCoordsAvx2(packed, count, u, v); break;
+#endif
+	default: decodeTexCoordsScalar(packed, 0, count, u, v);
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @class VertexDecoder
+ * @brief Batch decoders for the packed vertex attributes stored in OVO files.
+ *
+ * Normals are packed as signed 10:10:10:2 integers and texture coordinates as
+ * two half floats. Decoding them one value at a time through the glm helpers
+ * dominates mesh loading, so these decoders unpack whole arrays into separate
+ * component arrays (structure of arrays), four or eight values per step with
+ * SSE2 or AVX2. The path is picked at runtime from the CPU features, with a
+ * scalar fallback on other architectures; every path gives bit-exact results
+ * with glm::unpackSnorm3x10_1x2() and glm::unpackHalf2x16().
+ */
+class ENG_API VertexDecoder final {
+public:
+	/**
+	 * @brief Instruction set used to decode.
+	 */
+	enum class Path {
+		SCALAR,	///< One value at a time with the glm helpers
+		SSE2,	///< Four values per step
+		AVX2	///< Eight values per step
+	};
+
+	static Path getBestPath();
+	static bool isSupported(Path path);
+	static const char* getPathName(Path path);
+
+	static void decodeNormals(const unsigned int* packed, size_t count, float* x, float* y, float* z);
+	static void decodeNormals(const unsigned int* packed, size_t count, float* x, float* y, float* z, Path path);
+	static void decodeTexCoords(const unsigned int* packed, size_t count, float* u, float* v);
+	static void decodeTexCoords(const unsigned int* packed, size_t count, float* u, float* v, Path path);
+};
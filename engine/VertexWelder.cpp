@@ -0,0 +1,194 @@
+#include "Engine.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+	///> Floats compared per vertex: position, normal and texture coordinates
+	constexpr size_t COMPONENTS = 8;
+	///> Marks a vertex not stored yet
+	constexpr unsigned int UNUSED = std::numeric_limits<unsigned int>::max();
+	///> Largest grid cell coordinate, keeping huge positions over a tiny epsilon in range
+	constexpr double CELL_LIMIT = 1e18;
+
+	using Components = std::array<float, COMPONENTS>;
+	using Bits = std::array<uint32_t, COMPONENTS>;
+
+	/**
+	 * @brief Lists the compared components of a vertex.
+	 */
+	Components componentsOf(const Eng::Vertex& vertex) {
+		const glm::vec3& position = vertex.getPosition();
+		const glm::vec3& normal = vertex.getNormal();
+		const glm::vec2& texCoords = vertex.getTexCoords();
+		return { position.x, position.y, position.z, normal.x, normal.y, normal.z, texCoords.x, texCoords.y };
+	}
+
+	/**
+	 * @brief Hashes the bits of a vertex.
+	 */
+	struct BitsHash {
+		size_t operator()(const Bits& bits) const {
+			uint64_t hash = 14695981039346656037ull;
+			for (const uint32_t word : bits)
+				hash = (hash ^ word) * 1099511628211ull;
+			return static_cast<size_t>(hash ^ (hash >> 32));
+		}
+	};
+
+	/**
+	 * @brief Hashes a grid cell.
+	 */
+	struct CellHash {
+		size_t operator()(const std::array<int64_t, 3>& cell) const {
+			uint64_t hash = static_cast<uint64_t>(cell[0]) * 73856093ull;
+			hash ^= static_cast<uint64_t>(cell[1]) * 19349663ull;
+			hash ^= static_cast<uint64_t>(cell[2]) * 83492791ull;
+			return static_cast<size_t>(hash);
+		}
+	};
+
+	/**
+	 * @brief Maps every vertex to the first one with the same bits.
+	 */
+	std::vector<unsigned int> findDuplicates(const std::vector<Eng::Vertex>& vertices) {
+		std::unordered_map<Bits, unsigned int, BitsHash> firsts;
+		firsts.reserve(vertices.size());
+		std::vector<unsigned int> remap(vertices.size());
+		for (size_t v = 0; v < vertices.size(); v++) {
+			const Components components = componentsOf(vertices[v]);
+			Bits bits;
+			std::memcpy(bits.data(), components.data(), sizeof(bits));
+			remap[v] = firsts.try_emplace(bits, static_cast<unsigned int>(v)).first->second;
+		}
+		return remap;
+	}
+
+	/**
+	 * @brief Maps every vertex to the first one with all components within epsilon.
+	 *
+	 * Positions are bucketed in cells of epsilon, so a match lies in the vertex's
+	 * cell or one of its neighbours.
+	 */
+	std::vector<unsigned int> findNearDuplicates(const std::vector<Eng::Vertex>& vertices, const float epsilon) {
+		auto cellOf = [epsilon](const glm::vec3& position) {
+			std::array<int64_t, 3> cell;
+			for (int k = 0; k < 3; k++)
+				cell[k] = static_cast<int64_t>(std::clamp(std::floor(static_cast<double>(position[k]) / epsilon), -CELL_LIMIT, CELL_LIMIT));
+			return cell;
+		};
+
+		std::unordered_map<std::array<int64_t, 3>, std::vector<unsigned int>, CellHash> cells;
+		cells.reserve(vertices.size());
+		std::vector<unsigned int> remap(vertices.size());
+		for (size_t v = 0; v < vertices.size(); v++) {
+			const Components components = componentsOf(vertices[v]);
+			const std::array<int64_t, 3> cell = cellOf(vertices[v].getPosition());
+			remap[v] = static_cast<unsigned int>(v);
+
+			bool found = false;
+			for (int64_t dz = -1; dz <= 1 && !found; dz++) {
+				for (int64_t dy = -1; dy <= 1 && !found; dy++) {
+					for (int64_t dx = -1; dx <= 1 && !found; dx++) {
+						const auto neighbour = cells.find({ cell[0] + dx, cell[1] + dy, cell[2] + dz });
+						if (neighbour == cells.end())
+							continue;
+						for (const unsigned int candidate : neighbour->second) {
+							const Components other = componentsOf(vertices[candidate]);
+							bool equal = true;
+							for (size_t k = 0; k < COMPONENTS && equal; k++)
+								equal = std::abs(components[k] - other[k]) <= epsilon;
+							if (equal) {
+								remap[v] = candidate;
+								found = true;
+								break;
+							}
+						}
+					}
+				}
+			}
+			if (!found)
+				cells[cell].push_back(static_cast<unsigned int>(v));
+		}
+		return remap;
+	}
+}
+
+/**
+ * @brief Adds the counts of another welding.
+ * @param other Counts to add.
+ * @return Stats& These counts.
+ */
+Eng::VertexWelder::Stats& Eng::VertexWelder::Stats::operator+=(const Stats& other) {
+	verticesBefore += other.verticesBefore;
+	verticesAfter += other.verticesAfter;
+	trianglesBefore += other.trianglesBefore;
+	trianglesAfter += other.trianglesAfter;
+	return *this;
+}
+
+/**
+ * @brief Welds duplicated vertices and drops the triangles it collapses.
+ *
+ * With a zero epsilon only bit-identical vertices are merged, which leaves the
+ * rendered mesh unchanged. A positive epsilon also merges vertices whose
+ * position, normal and texture coordinates all differ by at most epsilon; each
+ * vertex is merged into the first earlier match found. Vertices no triangle
+ * uses are dropped. Buffers with an index out of range are left as they are.
+ *
+ * @param vertices Vertices, replaced by the welded ones.
+ * @param indices  Triangle list, rewritten for the welded vertices.
+ * @param epsilon  Largest difference per component between merged vertices.
+ * @return Stats Vertex and triangle counts before and after.
+ */
+Eng::VertexWelder::Stats Eng::VertexWelder::weld(std::vector<Eng::Vertex>& vertices, std::vector<unsigned int>& indices, const float epsilon) {
+	Stats stats;
+	stats.verticesBefore = stats.verticesAfter = vertices.size();
+	stats.trianglesBefore = stats.trianglesAfter = indices.size() / 3;
+	if (indices.empty() || indices.size() % 3 != 0)
+		return stats;
+	if (std::any_of(indices.begin(), indices.end(), [&vertices](const unsigned int index) { return index >= vertices.size(); })) {
+		std::cerr << "WARNING: [VertexWelder] Index out of range, vertices not welded" << std::endl;
+		return stats;
+	}
+
+	const std::vector<unsigned int> remap = epsilon > 0.0f ? findNearDuplicates(vertices, epsilon) : findDuplicates(vertices);
+
+	// Rewrite the triangles, storing the vertices they use in first-use order
+	std::vector<unsigned int> stored(vertices.size(), UNUSED);
+	std::vector<Eng::Vertex> welded;
+	welded.reserve(vertices.size());
+	std::vector<unsigned int> weldedIndices;
+	weldedIndices.reserve(indices.size());
+	for (size_t i = 0; i < indices.size(); i += 3) {
+		const unsigned int corners[3] = { remap[indices[i]], remap[indices[i + 1]], remap[indices[i + 2]] };
+		if (corners[0] == corners[1] || corners[1] == corners[2] || corners[0] == corners[2])
+			continue;
+		for (const unsigned int corner : corners) {
+			if (stored[corner] == UNUSED) {
+				stored[corner] = static_cast<unsigned int>(welded.size());
+				welded.push_back(vertices[corner]);
+			}
+			weldedIndices.push_back(stored[corner]);
+		}
+	}
+
+	vertices.swap(welded);
+	indices.swap(weldedIndices);
+	stats.verticesAfter = vertices.size();
+	stats.trianglesAfter = indices.size() / 3;
+	return stats;
+}
+
+/**
+ * @brief Prints the outcome of one or more weld() calls.
+ * @param stats Counts returned by weld(), possibly summed.
+ */
+void Eng::VertexWelder::printStats(const Stats& stats) {
+	const double saved = stats.verticesBefore
+		? 100.0 * static_cast<double>(stats.verticesBefore - stats.verticesAfter) / static_cast<double>(stats.verticesBefore) : 0.0;
+	std::cout << "[VertexWelder] " << stats.verticesBefore << " -> " << stats.verticesAfter << " vertices (" << saved << "% fewer), "
+		<< stats.trianglesBefore - stats.trianglesAfter << " degenerate triangles dropped" << std::endl;
+}
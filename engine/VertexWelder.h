@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * @class VertexWelder
+ * @brief Merges duplicated vertices of an indexed triangle list.
+ *
+ * Exporters often split vertices that are in fact identical, e.g. one copy per
+ * face, so meshes are loaded with more vertices than they need: more memory,
+ * more data to upload and fewer post-transform cache hits in every pass.
+ *
+ * Welding looks vertices up in a hash map, either by their exact bits or, with
+ * a tolerance, by the grid cell of their position, and maps every duplicate to
+ * the first vertex it equals. Indices are then rewritten, triangles left with
+ * two equal corners are dropped and the vertices still used are stored in
+ * first-use order. Triangles keep their order and winding.
+ */
+class ENG_API VertexWelder final {
+public:
+	/**
+	 * @brief Vertex and triangle counts before and after welding.
+	 */
+	struct Stats {
+		size_t verticesBefore = 0;	///< Vertices given
+		size_t verticesAfter = 0;	///< Vertices kept
+		size_t trianglesBefore = 0;	///< Triangles given
+		size_t trianglesAfter = 0;	///< Triangles kept
+
+		Stats& operator+=(const Stats& other);
+	};
+
+	static Stats weld(std::vector<Eng::Vertex>& vertices, std::vector<unsigned int>& indices, float epsilon = 0.0f);
+	static void printStats(const Stats& stats);
+};
@@ -0,0 +1,106 @@
+#include "Engine.h"
+
+#include <algorithm>
+
+/**
+ * @brief Creates an empty pool.
+ * @param mutex Mutex of the owner, guarding its queue and the pool.
+ */
+Eng::WorkerPool::WorkerPool(std::mutex& mutex) : mutex(mutex) {
+}
+
+/**
+ * @brief Sets how many worker threads may run at once.
+ *
+ * Takes effect for the workers started afterwards. Locks the mutex.
+ *
+ * @param count Worker threads, 0 for one per hardware thread but the render thread.
+ */
+void Eng::WorkerPool::setThreadCount(const unsigned int count) {
+	std::lock_guard<std::mutex> lock(mutex);
+	threadCount = count;
+}
+
+/**
+ * @brief Gets how many worker threads may run at once. Locks the mutex.
+ * @return unsigned int Worker threads, 0 for one per hardware thread but the render thread.
+ */
+unsigned int Eng::WorkerPool::getThreadCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return threadCount;
+}
+
+/**
+ * @brief Starts a worker if fewer than the thread count run.
+ *
+ * Call with the mutex held, after queueing the work.
+ *
+ * @param work Worker loop; it must call leave(), with the mutex held, when it returns.
+ */
+void Eng::WorkerPool::start(const Work& work) {
+	const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+	const unsigned int limit = threadCount ? threadCount : std::max(1u, hardwareThreads > 1 ? hardwareThreads - 1 : 1u);
+	if (activeWorkers < limit) {
+		activeWorkers++;
+		workers.emplace_back(work, generation);
+	}
+}
+
+/**
+ * @brief Checks whether a worker was started since the last cancel(). Call with the mutex held.
+ * @param generation Generation the worker was started in.
+ * @return bool True if its results are still wanted.
+ */
+bool Eng::WorkerPool::isCurrent(const unsigned int generation) const {
+	return generation == this->generation;
+}
+
+/**
+ * @brief Records that a worker stopped taking work. Call with the mutex held.
+ */
+void Eng::WorkerPool::leave() {
+	activeWorkers--;
+}
+
+/**
+ * @brief Checks whether every worker stopped taking work. Call with the mutex held.
+ * @return bool True with no worker running.
+ */
+bool Eng::WorkerPool::isIdle() const {
+	return activeWorkers == 0;
+}
+
+/**
+ * @brief Joins the worker threads once all of them ran out of work.
+ *
+ * Does nothing while some still run. Locks the mutex, so call without it.
+ */
+void Eng::WorkerPool::joinFinished() {
+	std::vector<std::thread> finished;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (activeWorkers == 0)
+			finished.swap(workers);
+	}
+	for (auto& thread : finished)
+		thread.join();
+}
+
+/**
+ * @brief Discards the running workers and waits for them.
+ *
+ * Locks the mutex, so call without it.
+ *
+ * @param drop Clears the owner's queue; called with the mutex held.
+ */
+void Eng::WorkerPool::cancel(const std::function<void()>& drop) {
+	std::vector<std::thread> threads;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		generation++;
+		drop();
+		threads.swap(workers);
+	}
+	for (auto& thread : threads)
+		thread.join();
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+/**
+ * @class WorkerPool
+ * @brief Worker threads of a streamer, started on demand and joined once idle.
+ *
+ * The pool shares the mutex of its owner, which guards the owner's queue and the
+ * pool alike: a worker finding the queue empty leaves in the same critical section,
+ * so a job queued meanwhile always starts a new worker. Workers are started by
+ * start() while the queue fills, up to the thread count, and run the owner's loop
+ * with the generation they were started in; cancel() bumps it, so the results of
+ * workers started before are recognised and discarded.
+ */
+class ENG_API WorkerPool final {
+public:
+	///> Worker loop, given the generation it was started in
+	using Work = std::function<void(unsigned int generation)>;
+
+	explicit WorkerPool(std::mutex& mutex);
+	WorkerPool(const WorkerPool&) = delete;
+	void operator=(const WorkerPool&) = delete;
+
+	void setThreadCount(unsigned int count);
+	unsigned int getThreadCount() const;
+
+	void start(const Work& work);
+	bool isCurrent(unsigned int generation) const;
+	void leave();
+	bool isIdle() const;
+
+	void joinFinished();
+	void cancel(const std::function<void()>& drop);
+
+private:
+	///> Mutex of the owner, guarding every member below
+	std::mutex& mutex;
+	///> Worker threads, joined once they ran out of work
+	std::vector<std::thread> workers;
+	///> Workers still taking work
+	unsigned int activeWorkers = 0;
+	///> Bumped by cancel(), so results of dropped work are discarded
+	unsigned int generation = 0;
+	///> Worker threads, 0 for one per hardware thread but the render thread
+	unsigned int threadCount = 0;
+};
@@ -10,6 +10,7 @@
 #include <algorithm>
 // C/C++:
 #include <chrono>
+#include <functional>
 #include <iostream>
 #include <source_location>
 #include <utility>
@@ -30,6 +31,50 @@
 #define __stdcall // Just defined as an empty macro under Linux
 #endif
 
+namespace {
+    ///> Shows the post-processed frame on screen
+    std::shared_ptr<Eng::Program> displayProgram;
+
+    /**
+     * @brief Submits the program showing the post-processed frame, linked in the background.
+     */
+    void submitDisplayProgram() {
+        const char* vsCode = R"(
+        #version 440 core
+        layout (location = 0) in vec3 aPos;
+        layout (location = 1) in vec2 aTexCoords;
+        out vec2 TexCoords;
+        void main() {
+            TexCoords = aTexCoords;
+            gl_Position = vec4(aPos, 1.0);
+        }
+        )";
+
+        const char* fsCode = R"(
+        #version 440 core
+        out vec4 FragColor;
+        in vec2 TexCoords;
+        uniform sampler2D screenTexture;
+        void main() {
+            FragColor = texture(screenTexture, TexCoords);
+        }
+        )";
+
+        std::shared_ptr<Eng::VertexShader> vs = std::make_shared<Eng::VertexShader>();
+        vs->submit(vsCode);
+
+        std::shared_ptr<Eng::FragmentShader> fs = std::make_shared<Eng::FragmentShader>();
+        fs->submit(fsCode);
+
+        displayProgram = std::make_shared<Eng::Program>();
+        displayProgram->bindAttribute(0, "aPos");
+        displayProgram->bindAttribute(1, "aTexCoords");
+        displayProgram->bindSampler(0, "screenTexture");
+        displayProgram->addShader(vs).addShader(fs);
+        Eng::ShaderManager::getInstance().submitProgram(displayProgram);
+    }
+}
+
 /**
  * Debug message callback for OpenGL. See https://www.opengl.org/wiki/Debug_Output
  */
@@ -87,6 +132,7 @@ struct Eng::Base::Reserved {
 ENG_API Eng::Base::Base() : reserved(std::make_unique<Eng::Base::Reserved>()), windowId{ 0 },
 leftEyeFbo(nullptr), rightEyeFbo(nullptr),
 leftEyeTexture(0), rightEyeTexture(0), eyeDistance(0.065f) {
+    textureResidency.setTextureStreamer(&textureStreamer);
 #ifdef _DEBUG
     std::cout << "[+] " << std::source_location::current().function_name() << " invoked" << std::endl;
 #endif
@@ -291,6 +337,14 @@ bool ENG_API Eng::Base::free() {
         return false;
     }
 
+    // Stop streaming, then release the shared geometry, texture arrays and culling resources while the context is still alive
+    sceneStreamer.cancel();
+    textureStreamer.cancel();
+    textureStreamer.releaseBuffers();
+    Eng::GpuCuller::getInstance().clear();
+    Eng::GeometryBuffer::getInstance().clear();
+    Eng::TextureArrayPool::getInstance().clear();
+
     freeOpenGL();
 
     FreeImage_DeInitialise();
@@ -406,6 +460,9 @@ bool ENG_API Eng::Base::initOpenGL() {
     glCullFace(GL_BACK);     // Cull back faces
     glFrontFace(GL_CCW);     // Counter-clockwise front faces
 
+    // Let the driver compile and link shaders on its own threads:
+    Eng::Shader::enableParallelCompile();
+
     std::cout << "OpenGL context initialized successfully" << std::endl;
 
     // Check OpenGL version:
@@ -413,6 +470,7 @@ bool ENG_API Eng::Base::initOpenGL() {
     std::cout << "   version  . . : " << glGetString(GL_VERSION) << std::endl;
     std::cout << "   vendor . . . : " << glGetString(GL_VENDOR) << std::endl;
     std::cout << "   renderer . . : " << glGetString(GL_RENDERER) << std::endl;
+    std::cout << "   parallel shader compile . . : " << (Eng::Shader::isParallelCompileSupported() ? "yes" : "no") << std::endl;
 
     int oglVersion[2];
     glGetIntegerv(GL_MAJOR_VERSION, &oglVersion[0]);
@@ -481,6 +539,11 @@ std::shared_ptr<Eng::Camera> ENG_API Eng::Base::getActiveCamera() const {
  * @brief Renders the entire scene, with optional stereoscopic or post-processing.
  */
 void ENG_API Eng::Base::renderScene() {
+    // Progressively loaded scenes fill in within the per-frame upload budget
+    sceneStreamer.update();
+    textureStreamer.update();
+    textureResidency.update();
+
     if (engIsEnabled(ENG_STEREO_RENDERING)) {
         renderStereoscopic();
         return;
@@ -532,6 +595,7 @@ void ENG_API Eng::Base::renderScene() {
     // Render scene
     renderList.setEyeViewMatrix(viewMatrix);
     renderList.setEyeProjectionMatrix(projectionMatrix);
+    renderList.setViewIndex(0);
     renderPipeline.runOn(&renderList);
 
     // Apply post-processing if enabled
@@ -569,43 +633,9 @@ void ENG_API Eng::Base::renderScene() {
             glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
         }
 
-        // Use a simple shader to display the final texture
-        static std::shared_ptr<Program> displayProgram = nullptr;
-        if (!displayProgram) {
-            const char* vsCode = R"(
-            #version 440 core
-            layout (location = 0) in vec3 aPos;
-            layout (location = 1) in vec2 aTexCoords;
-            out vec2 TexCoords;
-            void main() {
-                TexCoords = aTexCoords;
-                gl_Position = vec4(aPos, 1.0);
-            }
-            )";
-
-            const char* fsCode = R"(
-            #version 440 core
-            out vec4 FragColor;
-            in vec2 TexCoords;
-            uniform sampler2D screenTexture;
-            void main() {
-                FragColor = texture(screenTexture, TexCoords);
-            }
-            )";
-
-            std::shared_ptr<VertexShader> vs = std::make_shared<VertexShader>();
-            vs->load(vsCode);
-
-            std::shared_ptr<FragmentShader> fs = std::make_shared<FragmentShader>();
-            fs->load(fsCode);
-
-            displayProgram = std::make_shared<Program>();
-            displayProgram->bindAttribute(0, "aPos");
-            displayProgram->bindAttribute(1, "aTexCoords");
-            displayProgram->bindSampler(0, "screenTexture");
-            displayProgram->addShader(vs).addShader(fs).build();
-        }
-
+        // Use a simple shader to display the final texture, submitted with the scene's programs
+        if (!displayProgram)
+            submitDisplayProgram();
         displayProgram->render();
         glActiveTexture(GL_TEXTURE0);
         glBindTexture(GL_TEXTURE_2D, outputTexture);
@@ -675,20 +705,173 @@ void ENG_API Eng::Base::run() {
 /**
  * @brief Loads a scene from a file.
  *
- * Parses the specified scene file in `.ovo` format and builds the scene graph.
+ * Parses the specified scene file in `.ovo` format and builds the scene graph,
+ * restoring it from its cooked copy with ENG_SCENE_CACHE enabled (see SceneCache).
+ * The load-time passes and uploads are left to prepareScene(); with
+ * ENG_PROGRESSIVE_LOADING or ENG_TEXTURE_STREAMING enabled, geometry and textures
+ * are filled in later by the SceneStreamer and TextureStreamer. Shader programs
+ * link while the file is read and are awaited at the end.
  *
  * @param fileName The name of the file containing the scene description.
  */
 void ENG_API Eng::Base::loadScene(const std::string& fileName) {
-    Eng::OvoReader reader;
-    rootNode = reader.parseOvoFile(fileName);
-    std::cout << "Printing scene " << fileName << std::endl;
-    reader.printGraph();
+    // Whatever still streams belongs to the previous scene
+    sceneStreamer.cancel();
+    textureStreamer.cancel();
+
+    // Every program is submitted first, so the driver links them while the scene loads
     auto& shaderManager = ShaderManager::getInstance();
+    const auto shaderStart = std::chrono::steady_clock::now();
     if (shaderManager.initialize())
         std::cout << "   ShaderManager initialized successfully!" << std::endl;
     if (renderPipeline.init())
-        std::cout << "   Render pipeline and shaders loaded successfully!" << std::endl;
+        std::cout << "   Render pipeline and shaders submitted successfully!" << std::endl;
+    if (!displayProgram)
+        submitDisplayProgram();
+    if (Eng::GpuCuller::isSupported())
+        Eng::GpuCuller::getInstance().submit();
+    const double submitTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - shaderStart).count();
+
+    Eng::OvoReader reader;
+    reader.setSceneCache(engIsEnabled(ENG_SCENE_CACHE));
+    if (engIsEnabled(ENG_PROGRESSIVE_LOADING))
+        reader.setStreamer(&sceneStreamer);
+    if (engIsEnabled(ENG_TEXTURE_STREAMING))
+        reader.setTextureStreamer(&textureStreamer);
+    rootNode = reader.parseOvoFile(fileName);
+    std::cout << "Printing scene " << fileName << std::endl;
+    reader.printGraph();
+    if (sceneStreamer.isComplete())
+        prepareScene();
+    else
+        sceneStreamer.whenComplete([this]() { prepareScene(); });
+
+    // Links still running are awaited together, rather than one by one on first draw
+    const auto waitStart = std::chrono::steady_clock::now();
+    const size_t pending = shaderManager.pollPrograms();
+    if (!shaderManager.finishPrograms())
+        std::cerr << "ERROR: Some shader programs failed to link" << std::endl;
+    const auto shaderEnd = std::chrono::steady_clock::now();
+    std::cout << "   Shaders ready " << std::chrono::duration<double, std::milli>(shaderEnd - shaderStart).count()
+        << " ms after submission (" << submitTime << " ms submitting, "
+        << std::chrono::duration<double, std::milli>(shaderEnd - waitStart).count() << " ms waiting for "
+        << pending << " programs after the scene load)" << std::endl;
+}
+
+/**
+ * @brief Runs the load-time passes on the loaded scene and uploads its geometries.
+ *
+ * The InstanceDetector first makes meshes with identical geometry share one copy,
+ * whatever the rendering mode, since ENG_INSTANCED_RENDERING can be toggled later.
+ * Then, as enabled, the StaticBatcher merges static meshes sharing a material,
+ * the MeshSimplifier gives single-level meshes simplified levels of detail, and
+ * the MeshOptimizer reorders every level for the vertex cache, overdraw and fetch.
+ * Geometries are uploaded once all passes are done (see Mesh::initBuffers()), so
+ * no buffers are created for the ones they replace.
+ *
+ * Called by loadScene(), or by the streamer once a progressively loaded scene has
+ * all its geometry, so both end up with the same graph.
+ */
+void Eng::Base::prepareScene() {
+    Eng::InstanceDetector::printStats(Eng::InstanceDetector::detect(rootNode));
+    if (engIsEnabled(ENG_STATIC_BATCHING))
+        Eng::StaticBatcher::printStats(staticBatcher.batch(rootNode));
+    if (engIsEnabled(ENG_LOD_GENERATION))
+        Eng::MeshSimplifier::printStats(meshSimplifier.generateLods(rootNode));
+    if (engIsEnabled(ENG_MESH_OPTIMIZATION))
+        Eng::MeshOptimizer::printStats(meshOptimizer.optimize(rootNode));
+    std::function<void(const std::shared_ptr<Eng::Node>&)> upload = [&](const std::shared_ptr<Eng::Node>& node) {
+        if (const auto mesh = std::dynamic_pointer_cast<Eng::Mesh>(node))
+            mesh->initBuffers();
+        for (const auto& child : *node->getChildren())
+            upload(child);
+    };
+    if (rootNode)
+        upload(rootNode);
+    Eng::Geometry::printStats();
+    Eng::TextureManager::getInstance().printStats();
+}
+
+/**
+ * @brief Retrieves the render pipeline drawing the scene
+ *
+ * Its submission statistics accumulate until resetSubmissionStats() is called.
+ *
+ * @return RenderPipeline& The engine's render pipeline
+ */
+Eng::RenderPipeline& Eng::Base::getRenderPipeline() {
+    return renderPipeline;
+}
+
+/**
+ * @brief Retrieves the batcher applied to scenes loaded with ENG_STATIC_BATCHING enabled
+ *
+ * Configure it (cell size, dynamic filter) before calling loadScene().
+ *
+ * @return StaticBatcher& The engine's static batcher
+ */
+Eng::StaticBatcher& Eng::Base::getStaticBatcher() {
+    return staticBatcher;
+}
+
+/**
+ * @brief Retrieves the simplifier applied to scenes loaded with ENG_LOD_GENERATION enabled
+ *
+ * Configure it (level settings, threads) before calling loadScene().
+ *
+ * @return MeshSimplifier& The engine's mesh simplifier
+ */
+Eng::MeshSimplifier& Eng::Base::getMeshSimplifier() {
+    return meshSimplifier;
+}
+
+/**
+ * @brief Retrieves the optimizer applied to scenes loaded with ENG_MESH_OPTIMIZATION enabled
+ *
+ * Configure it (overdraw threshold) before calling loadScene().
+ *
+ * @return MeshOptimizer& The engine's mesh optimizer
+ */
+Eng::MeshOptimizer& Eng::Base::getMeshOptimizer() {
+    return meshOptimizer;
+}
+
+/**
+ * @brief Retrieves the streamer filling in scenes loaded with ENG_PROGRESSIVE_LOADING enabled
+ *
+ * loadScene() then returns once the node hierarchy and bounds are read: meshes
+ * render as soon as their geometry is streamed in, within the streamer's frame
+ * budget, and prepareScene() runs when the last one arrived.
+ * Configure it (frame budget, threads) before calling loadScene().
+ *
+ * @return SceneStreamer& The engine's scene streamer
+ */
+Eng::SceneStreamer& Eng::Base::getSceneStreamer() {
+    return sceneStreamer;
+}
+
+/**
+ * @brief Retrieves the streamer filling in textures of scenes loaded with ENG_TEXTURE_STREAMING enabled
+ *
+ * Textures then render as placeholders until they are decoded and uploaded, within
+ * a per-frame byte budget.
+ * Configure it (frame budget, threads) before calling loadScene().
+ *
+ * @return TextureStreamer& The engine's texture streamer
+ */
+Eng::TextureStreamer& Eng::Base::getTextureStreamer() {
+    return textureStreamer;
+}
+
+/**
+ * @brief Retrieves the manager keeping the cached textures within a VRAM budget
+ *
+ * Without a budget (the default) it only tracks texture memory and restores nothing.
+ *
+ * @return TextureResidency& The engine's texture residency manager
+ */
+Eng::TextureResidency& Eng::Base::getTextureResidency() {
+    return textureResidency;
 }
 
 /**
@@ -900,6 +1083,7 @@ void Eng::Base::renderEye(Fbo* eyeFbo, glm::mat4& viewMatrix, glm::mat4& project
     }
     renderList.setEyeViewMatrix(viewMatrix);
     renderList.setEyeProjectionMatrix(projectionMatrix);
+    renderList.setViewIndex(eyeFbo == leftEyeFbo.get() ? 0 : 1);
 
     // Pass the current FBO to the render list
     renderList.setCurrentFBO(eyeFbo);
@@ -1035,6 +1219,7 @@ void Eng::Base::renderStereoscopic() {
 
             renderList.setEyeViewMatrix(viewEye);
             renderList.setEyeProjectionMatrix(projEyeFix);
+            renderList.setViewIndex(static_cast<unsigned int>(eye));
             renderList.setCurrentFBO(eyeFbo.get());
             renderPipeline.runOn(&renderList);
 
@@ -1171,6 +1356,26 @@ bool ENG_API Eng::Base::isPostProcessingEnabled() const {
     return PostProcessorManager::getInstance().isPostProcessingEnabled();
 }
 
+/**
+ * @brief Selects how the render list culls meshes.
+ *
+ * GPU modes fall back to CPU culling when compute culling is unsupported.
+ *
+ * @param mode Culling mode to use.
+ */
+void ENG_API Eng::Base::setCullingMode(const List::CullingMode mode) {
+    renderList.setCullingMode(mode);
+}
+
+/**
+ * @brief Gets how the render list culls meshes.
+ *
+ * @return List::CullingMode Current culling mode.
+ */
+Eng::List::CullingMode ENG_API Eng::Base::getCullingMode() const {
+    return renderList.getCullingMode();
+}
+
 /**
  * @brief Retrieves or lazily creates the head node in the scene graph.
  *
@@ -18,7 +18,16 @@
 #include <unordered_map>
 #include <cassert>
 #include <functional>
+#include <array>
 #include <cstdio>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
 #define GLM_ENABLE_EXPERIMENTAL
 
 
@@ -60,6 +69,15 @@
 // Engine capability flags
 #define ENG_RENDER_NORMAL   0x0001
 #define ENG_STEREO_RENDERING  0x0002
+#define ENG_INSTANCED_RENDERING  0x0004
+#define ENG_MULTIDRAW_RENDERING  0x0008
+#define ENG_STATIC_BATCHING  0x0010
+#define ENG_LOD_GENERATION  0x0020
+#define ENG_MESH_OPTIMIZATION  0x0040
+#define ENG_SCENE_CACHE  0x0080
+#define ENG_PROGRESSIVE_LOADING  0x0100
+#define ENG_TEXTURE_STREAMING  0x0200
+#define ENG_TEXTURE_ARRAYS  0x0400
 
 // Window and FBO size constants
 #define APP_WINDOWSIZEX   1024
@@ -94,23 +112,43 @@ namespace Eng {
 #include "SpotLight.h"
 #include "DirectionalLight.h"
 #include "Texture.h"
+#include "TextureManager.h"
 #include "Material.h"
 #include "Vertex.h"
+#include "Geometry.h"
+#include "GeometryBuffer.h"
+#include "CollisionHull.h"
 #include "Mesh.h"
 #include "Shader.h"
 #include "VertexShader.h"
 #include "FragmentShader.h"
+#include "ComputeShader.h"
 #include "Program.h"
+#include "GpuCuller.h"
 #include "RenderLayer.h"
 #include "ListElement.h"
 #include "ListIterator.h"
 #include "List.h"
+#include "MappedFile.h"
+#include "ChunkView.h"
+#include "VertexDecoder.h"
+#include "VertexWelder.h"
+#include "WorkerPool.h"
+#include "SceneStreamer.h"
+#include "TextureStreamer.h"
+#include "SceneCache.h"
+#include "TextureResidency.h"
+#include "TextureArrayPool.h"
 #include "OvoReader.h"
 #include "CallbackManager.h"
 #include "PostProcessor.h"
 #include "PostProcessorManager.h"
 #include "BloomEffect.h"
 #include "Builder.h"
+#include "InstanceDetector.h"
+#include "StaticBatcher.h"
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
 #include "ShaderManager.h"
 #include "Skybox.h"
 #include "HolographicMaterial.h"
@@ -121,12 +159,31 @@ namespace Eng {
     //// Tests ///
     /////////////
 
+#include "Tests/Test_Fixtures.h"
 #include "Tests/Test_Camera.h"
 #include "Tests/Test_Light.h"
 #include "Tests/Test_Node.h"
 #include "Tests/Test_List.h"
 #include "Tests/Test_Mesh.h"
 #include "Tests/Test_CallManager.h" 
+#include "Tests/Test_ShaderManager.h"
+#include "Tests/Test_GpuCulling.h"
+#include "Tests/Test_StaticBatcher.h"
+#include "Tests/Test_MeshSimplifier.h"
+#include "Tests/Test_MeshOptimizer.h"
+#include "Tests/Test_OvoReader.h"
+#include "Tests/Test_VertexDecoder.h"
+#include "Tests/Test_SceneCache.h"
+#include "Tests/Test_SceneStreamer.h"
+#include "Tests/Test_CollisionHull.h"
+#include "Tests/Test_VertexWelder.h"
+#include "Tests/Test_InstanceDetector.h"
+#include "Tests/Test_TextureManager.h"
+#include "Tests/Test_Texture.h"
+#include "Tests/Test_TextureStreamer.h"
+#include "Tests/Test_TextureResidency.h"
+#include "Tests/Test_TextureArrayPool.h"
+#include "Tests/Test_GeometryBuffer.h"
 
    /**
     * @class Base
@@ -142,7 +199,7 @@ namespace Eng {
     * As a singleton, only one instance can exist at any time, accessed via getInstance().
     */
    ///> Eng state
-   static unsigned int engineState = 0;
+   static unsigned int engineState = ENG_INSTANCED_RENDERING | ENG_MULTIDRAW_RENDERING;
    class ENG_API Base final {
    public:
       static Base &getInstance();
@@ -159,6 +216,13 @@ namespace Eng {
 
       void renderScene();
       void loadScene(const std::string &fileName);
+      RenderPipeline &getRenderPipeline();
+      StaticBatcher &getStaticBatcher();
+      MeshSimplifier &getMeshSimplifier();
+      MeshOptimizer &getMeshOptimizer();
+      SceneStreamer &getSceneStreamer();
+      TextureStreamer &getTextureStreamer();
+      TextureResidency &getTextureResidency();
       std::shared_ptr<Node> getRootNode();
 
       void SetActiveCamera(std::shared_ptr<Camera> camera);
@@ -186,6 +250,10 @@ namespace Eng {
       void setBodyPosition(const glm::mat4& position);
       glm::mat4 getBodyPosition() const;
 
+      // Culling
+      void setCullingMode(List::CullingMode mode);
+      List::CullingMode getCullingMode() const;
+
       //post processing
       bool addPostProcessor(std::shared_ptr<PostProcessor> postProcessor);
       bool removePostProcessor(const std::string& name);
@@ -223,6 +291,7 @@ namespace Eng {
       void freeOpenGL();
 
       void traverseAndAddToRenderList(const std::shared_ptr<Node> &node);
+      void prepareScene();
 
       ///> Root node of the scene graph
       std::shared_ptr<Node> rootNode;
@@ -230,6 +299,18 @@ namespace Eng {
       std::shared_ptr<Camera> activeCamera;
       ///> List of objects to be rendered
       List renderList;
+      ///> Merges static meshes of loaded scenes (see ENG_STATIC_BATCHING)
+      StaticBatcher staticBatcher;
+      ///> Generates levels of detail for loaded scenes (see ENG_LOD_GENERATION)
+      MeshSimplifier meshSimplifier;
+      ///> Reorders the geometries of loaded scenes for the GPU caches (see ENG_MESH_OPTIMIZATION)
+      MeshOptimizer meshOptimizer;
+      ///> Streams the meshes and textures of loaded scenes (see ENG_PROGRESSIVE_LOADING)
+      SceneStreamer sceneStreamer;
+      ///> Streams the textures of loaded scenes (see ENG_TEXTURE_STREAMING)
+      TextureStreamer textureStreamer;
+      ///> Keeps the cached textures within a VRAM budget, streaming them back through textureStreamer
+      TextureResidency textureResidency;
       ///>  FreeGLUT window identifier
       int windowId;
 